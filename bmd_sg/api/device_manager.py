@@ -205,11 +205,12 @@ class APIDeviceManager:
                     # Use existing validate_color function with device
                     validate_color(color, self._device)
 
-                # Generate new pattern with validated colors
-                image = self._generator.generate(colors)
-
-                # Display the pattern
-                self._device.display_frame(image)
+                # Describe the pattern as rectangles and let the native
+                # library pack it, instead of uploading a full image
+                rects = self._generator.generate_rects(colors)
+                self._device.display_rect_pattern(
+                    self._generator.width, self._generator.height, rects
+                )
 
                 # Update stored state
                 self._current_colors = colors.copy()
@@ -288,6 +289,7 @@ class APIDeviceManager:
                 }
                 if not self._settings.no_hdr
                 else {},
+                "latency": self._device.latency_stats,
             }
 
     def get_health(self) -> dict[str, Any]:
@@ -11,6 +11,7 @@ from contextlib import asynccontextmanager
 from typing import Any
 
 from fastapi import FastAPI, HTTPException, Request, status
+from fastapi.concurrency import run_in_threadpool
 from fastapi.responses import JSONResponse
 
 from bmd_sg.api.device_manager import device_manager
@@ -161,7 +162,10 @@ async def update_color(request: ColorUpdateRequest) -> ColorUpdateResponse:
         )
 
     try:
-        result = device_manager.update_colors(request.colors)
+        # The display blocks until the frame is on screen; running it on a
+        # worker thread keeps the event loop serving other requests, since
+        # the library calls release the GIL while they pack and display
+        result = await run_in_threadpool(device_manager.update_colors, request.colors)
 
         if not result["success"]:
             raise HTTPException(
@@ -226,7 +230,8 @@ async def get_status() -> DeviceStatusResponse:
     ... }
     """
     try:
-        status_info = device_manager.get_status()
+        # Waits for the device lock while a color update is being displayed
+        status_info = await run_in_threadpool(device_manager.get_status)
         return DeviceStatusResponse(**status_info)
 
     except Exception as e:
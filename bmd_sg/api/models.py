@@ -132,6 +132,8 @@ class DeviceStatusResponse(BaseModel):
         Whether HDR metadata is enabled
     hdr_metadata : dict, optional
         Current HDR metadata parameters
+    latency : dict, optional
+        Per-stage frame path latency (count, p50/p99/max/mean in microseconds)
 
     Examples
     --------
@@ -154,6 +156,9 @@ class DeviceStatusResponse(BaseModel):
     hdr_metadata: dict = Field(
         default_factory=dict, description="HDR metadata parameters"
     )
+    latency: dict = Field(
+        default_factory=dict, description="Per-stage frame path latency"
+    )
 
 
 class HealthResponse(BaseModel):
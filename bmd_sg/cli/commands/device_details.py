@@ -61,6 +61,16 @@ def _print_device_details(idx: int, device_name: str, use_mock: bool = False) ->
                     f"    {format_idx}: {pixel_format.name} ({pixel_format.bit_depth}-bit)"
                 )
 
+            # Display modes come from the cached capability matrix
+            modes = list(
+                dict.fromkeys(
+                    capability["display_mode"]
+                    for capability in decklink.get_capabilities()
+                    if capability["default_connection"]
+                )
+            )
+            typer.echo(f"  Supported display modes ({len(modes)}): {', '.join(modes)}")
+
             # Check HDR support
             hdr_support = decklink.supports_hdr
             typer.echo(f"  HDR Support: {'Yes' if hdr_support else 'No'}")
@@ -113,6 +123,7 @@ def device_details_command(
     - DeckLink SDK and driver version information (unless list_only)
     - List of connected devices with indices
     - Supported pixel formats for each device (unless list_only)
+    - Supported display modes for each device (unless list_only)
     - HDR support status for each device (unless list_only)
 
     Examples
@@ -10,31 +10,64 @@ without requiring physical hardware.
 
 # Main DeckLink exports
 from bmd_sg.decklink.bmd_decklink import (
+    MOCK_DEVICE_INDEX,
     BMDDeckLink,
+    BMDDeckLinkGroup,
+    BMDFrameLibrary,
+    BMDFrameLibraryWriter,
+    ChromaFilter,
     DecklinkSettings,
     EOTFType,
     HDRMetadata,
+    LogLevel,
+    LoopbackStatus,
     PixelFormatType,
+    VideoConnection,
+    YCbCrMatrix,
+    flush_log,
+    get_decklink_device_info,
     get_decklink_devices,
     get_decklink_driver_version,
     get_decklink_sdk_version,
+    get_log_level,
+    get_pack_thread_count,
+    set_log_level,
+    set_pack_thread_count,
 )
 
 __all__ = [
+    "MOCK_DEVICE_INDEX",
     "BMDDeckLink",
+    "BMDDeckLinkGroup",
+    "BMDFrameLibrary",
+    "BMDFrameLibraryWriter",
+    "ChromaFilter",
     "DecklinkSettings",
     "EOTFType",
     "HDRMetadata",
+    "LogLevel",
+    "LoopbackStatus",
     "PixelFormatType",
+    "VideoConnection",
+    "YCbCrMatrix",
+    "flush_log",
+    "get_decklink_device_info",
     "get_decklink_devices",
     "get_decklink_driver_version",
     "get_decklink_sdk_version",
+    "get_log_level",
+    "get_pack_thread_count",
+    "set_log_level",
+    "set_pack_thread_count",
 ]
 
 # Optional mock exports for development/testing
 try:
     from bmd_sg.decklink.mock import (  # noqa: F401
         MockBMDDeckLink,
+        MockBMDDeckLinkGroup,
+        MockBMDFrameLibrary,
+        MockBMDFrameLibraryWriter,
         patch_decklink_module,
         reset_mock_state,
         set_available_devices,
@@ -45,6 +78,9 @@ try:
     __all__.extend(
         [
             "MockBMDDeckLink",
+            "MockBMDDeckLinkGroup",
+            "MockBMDFrameLibrary",
+            "MockBMDFrameLibraryWriter",
             "patch_decklink_module",
             "reset_mock_state",
             "set_available_devices",
@@ -9,6 +9,8 @@ device management.
 
 The module includes:
 - ctypes-based wrapper for the DeckLink SDK C++ library
+- Optional native binding that takes frames through the buffer protocol and
+  packs and displays them with the GIL released
 - HDR metadata structures with standard color space definitions
 - Device enumeration and management
 - Frame data handling with numpy integration
@@ -47,10 +49,15 @@ bmd_sg.decklink.decklink_types : Type definitions for the SDK wrapper
 bmd_sg.decklink_control : High-level device control interface
 """
 
+import asyncio
+import contextlib
 import ctypes
+import importlib
+import os
 import re
+from collections.abc import Callable, Iterator
 from dataclasses import dataclass
-from enum import Enum
+from enum import Enum, IntEnum, IntFlag
 from pathlib import Path
 from typing import Any, ClassVar, Self
 
@@ -243,6 +250,122 @@ class PixelFormatType(str, Enum):
         )
 
 
+class LogLevel(IntEnum):
+    """
+    Verbosity of the native library's log output.
+
+    Each level includes every level below it. Messages are written to
+    stderr by a background thread, so logging does not block frame output.
+
+    Attributes
+    ----------
+    NONE : int
+        No output (0)
+    ERROR : int
+        Failures only (1)
+    WARNING : int
+        Failures and recoverable problems (2)
+    INFO : int
+        Configuration changes, the default (3)
+    DEBUG : int
+        Per-frame details (4), only present in ``make DEBUG=1`` builds
+    """
+
+    NONE = 0
+    ERROR = 1
+    WARNING = 2
+    INFO = 3
+    DEBUG = 4
+
+
+class YCbCrMatrix(IntEnum):
+    """
+    Matrix used to convert RGB frames to Y'CbCr for the 4:2:2 formats.
+
+    Only applies when the output pixel format is 2vuy, v210 or Ay10; RGB
+    formats are packed unchanged.
+
+    Attributes
+    ----------
+    AUTO : int
+        Rec.2020 while HDR metadata is set, otherwise Rec.601 for SD and
+        Rec.709 for larger modes (0), the default
+    REC601 : int
+        ITU-R BT.601 (1)
+    REC709 : int
+        ITU-R BT.709 (2)
+    REC2020 : int
+        ITU-R BT.2020 non-constant luminance (3)
+    NONE : int
+        No conversion; frames already hold Y', Cb, Cr in place of R, G, B (4)
+    """
+
+    AUTO = 0
+    REC601 = 1
+    REC709 = 2
+    REC2020 = 3
+    NONE = 4
+
+
+class ChromaFilter(IntEnum):
+    """
+    Filter used to subsample chroma horizontally to 4:2:2.
+
+    Attributes
+    ----------
+    COSITED : int
+        Take the chroma of the even pixel of each pair (0), the default
+    AVERAGE : int
+        Average the chroma of both pixels of each pair (1)
+    TRIANGLE : int
+        [1 2 1]/4 filter centred on the even pixel (2)
+    """
+
+    COSITED = 0
+    AVERAGE = 1
+    TRIANGLE = 2
+
+
+class LoopbackStatus(IntEnum):
+    """
+    Outcome of checking one captured frame of a loopback.
+
+    Attributes
+    ----------
+    MATCH : int
+        Bit-exact copy of an output frame (0)
+    MISMATCH : int
+        Differs from the output frame it should be; see ``max_error`` (1)
+    NO_REFERENCE : int
+        Nothing was output since verification started (2)
+    FORMAT_MISMATCH : int
+        Captured in another size or pixel format than the output (3)
+    NO_SIGNAL : int
+        The input reported no signal (4)
+    """
+
+    MATCH = 0
+    MISMATCH = 1
+    NO_REFERENCE = 2
+    FORMAT_MISMATCH = 3
+    NO_SIGNAL = 4
+
+
+class VideoConnection(IntFlag):
+    """
+    Video output connections, as reported in the capability matrix.
+
+    Values match BMDVideoConnection in the DeckLink SDK.
+    """
+
+    SDI = 1 << 0
+    HDMI = 1 << 1
+    OPTICAL_SDI = 1 << 2
+    COMPONENT = 1 << 3
+    COMPOSITE = 1 << 4
+    SVIDEO = 1 << 5
+
+
 class EOTFType(str, Enum):
     """
     Enumeration of Electro-Optical Transfer Function (EOTF) types.
@@ -564,544 +687,3836 @@ class HDRMetadata(ctypes.Structure):
         self.referencePrimaries = Gamut_Chromaticities_REC2020
 
 
-# Video resolution constants for standard formats
-DEFAULT_WIDTH = 1920  # Full HD/4K width
-DEFAULT_HEIGHT = 1080  # Full HD height
-
-# HDR metadata constants following industry standards
-DEFAULT_MAX_CLL = 10000.0  # Maximum Content Light Level (cd/m²)
-DEFAULT_MAX_FALL = 400.0  # Maximum Frame Average Light Level (cd/m²)
-DEFAULT_MAX_DISPLAY_MASTERING_LUMINANCE = 1000.0  # Display mastering luminance (cd/m²)
-DEFAULT_MIN_DISPLAY_MASTERING_LUMINANCE = 0.0001  # Minimum display luminance (cd/m²)
-
-
-@dataclass
-class DecklinkSettings:
+class PatternRect(ctypes.Structure):
     """
-    Comprehensive configuration settings for DeckLink device initialization and operation.
+    Rectangle of a natively packed pattern frame.
 
-    This dataclass consolidates all settings required for configuring a DeckLink device
-    including device selection, video resolution, pixel format, region of interest,
-    HDR metadata parameters, and color space information. It provides a unified
-    interface for all DeckLink-related configuration.
+    Pixel ``(x, y)`` inside the rectangle takes
+    ``colors[((y - rect_y) & 1) + 2 * ((x - rect_x) & 1)]``, the same
+    checkerboard cell order as ``PatternGenerator``. A flat rectangle repeats
+    one color four times.
 
     Parameters
     ----------
-    device : int, optional
-        Index of the DeckLink device to use. Default is 0.
-    pixel_format : PixelFormatType | None, optional
-        Pixel format enum, None for auto-selection. Default is None.
-    width : int, optional
-        Frame width in pixels. Default is 1920.
-    height : int, optional
-        Frame height in pixels. Default is 1080.
-    roi_x : int, optional
-        Region of interest X offset. Default is 0.
-    roi_y : int, optional
-        Region of interest Y offset. Default is 0.
-    roi_width : int, optional
-        Region of interest width. Default is 1920.
-    roi_height : int, optional
-        Region of interest height. Default is 1080.
-    no_hdr : bool, optional
-        Whether to disable HDR metadata output. Default is False.
-    eotf : EOTFType, optional
-        Electro-Optical Transfer Function type. Default is PQ (HDR10).
-    max_cll : float, optional
-        Maximum Content Light Level in cd/m². Default is 10000.0.
-    max_fall : float, optional
-        Maximum Frame Average Light Level in cd/m². Default is 400.0.
-    max_display_mastering_luminance : float, optional
-        Maximum display mastering luminance in cd/m². Default is 1000.0.
-    min_display_mastering_luminance : float, optional
-        Minimum display mastering luminance in cd/m². Default is 0.0001.
-    gamut_chromaticities : Gamut_Chromaticities, optional
-        Complete color gamut definition including red, green, blue primaries
-        and white point chromaticity coordinates. Default is Rec.2020.
+    x, y : int
+        Top-left corner in pixels. May lie outside the frame.
+    width, height : int
+        Size in pixels.
+    colors : ArrayLike
+        One RGB color with shape (3,), or four cell colors with shape (4, 3).
+    """
+
+    _fields_: ClassVar = [
+        ("x", ctypes.c_int32),
+        ("y", ctypes.c_int32),
+        ("width", ctypes.c_int32),
+        ("height", ctypes.c_int32),
+        ("colors", (ctypes.c_uint16 * 3) * 4),
+    ]
+
+    def __init__(
+        self, x: int, y: int, width: int, height: int, colors: Any
+    ) -> None:
+        super().__init__(x, y, width, height)
+        cells = np.broadcast_to(np.asarray(colors, dtype=np.uint16), (4, 3))
+        for cell, color in enumerate(cells):
+            self.colors[cell][:] = [int(v) for v in color]
+
+
+class GeneratedPattern(ctypes.Structure):
+    """
+    Ramp or zone plate computed by the native library while packing.
+
+    Colors are in the bit depth of the pixel format. A zone plate follows
+    ``cos(pi * frequency * r**2 / width)`` around the frame center, from
+    ``start_color`` where it is -1 to ``end_color`` where it is 1.
 
     Attributes
     ----------
-    device : int
-        Index of the DeckLink device to use
-    pixel_format : PixelFormatType | None
-        Pixel format enum, None for auto-selection
-    width : int
-        Frame width in pixels
-    height : int
-        Frame height in pixels
-    roi_x : int
-        Region of interest X offset
-    roi_y : int
-        Region of interest Y offset
-    roi_width : int
-        Region of interest width
-    roi_height : int
-        Region of interest height
-    no_hdr : bool
-        Whether to disable HDR metadata output
-    eotf : EOTFType
-        Electro-Optical Transfer Function type
-    max_cll : float
-        Maximum Content Light Level in cd/m²
-    max_fall : float
-        Maximum Frame Average Light Level in cd/m²
-    max_display_mastering_luminance : float
-        Maximum display mastering luminance in cd/m²
-    min_display_mastering_luminance : float
-        Minimum display mastering luminance in cd/m²
-    gamut_chromaticities : Gamut_Chromaticities
-        Complete color gamut definition including red, green, blue primaries
-        and white point chromaticity coordinates
+    kind : int
+        ``HORIZONTAL_RAMP``, ``VERTICAL_RAMP`` or ``ZONE_PLATE``
+    steps : int
+        Number of flat steps of a ramp, 0 or 1 for a continuous ramp
+    start_color, end_color : ctypes.c_uint16 * 3
+        RGB colors at the start and end of the ramp
+    frequency : float
+        Zone plate frequency; 1 reaches Nyquist at the left and right edges
+    """
 
-    Examples
-    --------
-    Create settings with defaults:
+    HORIZONTAL_RAMP: ClassVar = 0
+    VERTICAL_RAMP: ClassVar = 1
+    ZONE_PLATE: ClassVar = 2
 
-    >>> settings = DecklinkSettings()
-    >>> print(f"Device: {settings.device}, Resolution: {settings.width}x{settings.height}")
-    Device: 0, Resolution: 1920x1080
+    _fields_: ClassVar = [
+        ("kind", ctypes.c_int32),
+        ("steps", ctypes.c_int32),
+        ("start_color", ctypes.c_uint16 * 3),
+        ("end_color", ctypes.c_uint16 * 3),
+        ("frequency", ctypes.c_double),
+    ]
 
-    Create settings for specific device with custom HDR:
 
-    >>> settings = DecklinkSettings(
-    ...     device=1,
-    ...     width=3840,
-    ...     height=2160,
-    ...     eotf=EOTFType.HLG,
-    ...     max_cll=4000.0
-    ... )
-    >>> print(f"EOTF: {settings.eotf}, Max CLL: {settings.max_cll}")
-    EOTF: HLG, Max CLL: 4000.0
+class SequencePatch(ctypes.Structure):
+    """
+    One patch of a sequence uploaded with ``BMDDeckLink.load_sequence``.
 
-    Create settings with custom ROI:
+    Attributes
+    ----------
+    image : ctypes.POINTER(ctypes.c_uint16)
+        RGB image of the sequence size, or null for a solid color
+    rgb : ctypes.c_uint16 * 3
+        Solid color, used when image is null
+    dwellFrames : int
+        Frames the patch stays on screen
+    """
 
-    >>> settings = DecklinkSettings(
-    ...     roi_x=100,
-    ...     roi_y=100,
-    ...     roi_width=1720,
-    ...     roi_height=880
-    ... )
-    >>> print(f"ROI: {settings.roi_x},{settings.roi_y} {settings.roi_width}x{settings.roi_height}")
-    ROI: 100,100 1720x880
+    _fields_: ClassVar = [
+        ("image", ctypes.POINTER(ctypes.c_uint16)),
+        ("rgb", ctypes.c_uint16 * 3),
+        ("dwellFrames", ctypes.c_int32),
+    ]
 
-    Notes
-    -----
-    This class consolidates all DeckLink device configuration into a single
-    interface, eliminating the need for multiple settings classes and conversion
-    functions. It supports complete HDR metadata configuration following
-    industry standards (SMPTE ST 2086, CEA-861.3).
 
-    The default color primaries are set to Rec.2020 (ITU-R BT.2020) which is
-    the standard for Ultra HD and HDR content. The default EOTF is PQ
-    (Perceptual Quantizer) as specified in SMPTE ST 2084 for HDR10.
+class SequenceEvent(ctypes.Structure):
+    """
+    Completion of one patch of a playing sequence.
 
-    See Also
-    --------
-    HDRMetadata : HDR metadata structure for device configuration
-    PixelFormatType : Available pixel format options
-    EOTFType : Electro-Optical Transfer Function types
+    Attributes
+    ----------
+    startTime : int
+        Stream time the patch went on screen
+    endTime : int
+        Stream time it was replaced
+    timeScale : int
+        Units of startTime and endTime per second
+    completionTimestamp : int
+        Hardware reference time of the completion in ns (0 = unavailable)
+    patchIndex : int
+        Index of the patch in the uploaded list
+    pass_ : int
+        How often the sequence had looped before this patch
+    result : int
+        Completion result of the patch's last frame (0 = on time, 1 = late,
+        2 = dropped, 3 = flushed)
     """
 
-    # Device parameters
-    device: int = 0
-    pixel_format: PixelFormatType | None = None
-    width: int = DEFAULT_WIDTH
-    height: int = DEFAULT_HEIGHT
+    _fields_: ClassVar = [
+        ("startTime", ctypes.c_int64),
+        ("endTime", ctypes.c_int64),
+        ("timeScale", ctypes.c_int64),
+        ("completionTimestamp", ctypes.c_int64),
+        ("patchIndex", ctypes.c_int32),
+        ("pass_", ctypes.c_int32),
+        ("result", ctypes.c_int32),
+    ]
 
-    # ROI parameters
-    roi_x: int = 0
-    roi_y: int = 0
-    roi_width: int = DEFAULT_WIDTH
-    roi_height: int = DEFAULT_HEIGHT
 
-    # HDR metadata settings
-    no_hdr: bool = False
-    eotf: EOTFType = EOTFType.PQ
-    max_cll: float = DEFAULT_MAX_CLL
-    max_fall: float = DEFAULT_MAX_FALL
-    max_display_mastering_luminance: float = DEFAULT_MAX_DISPLAY_MASTERING_LUMINANCE
-    min_display_mastering_luminance: float = DEFAULT_MIN_DISPLAY_MASTERING_LUMINANCE
+class SequenceStatus(ctypes.Structure):
+    """
+    Playback state of the uploaded patch sequence.
 
-    # Color space primaries and white point
-    gamut_chromaticities: GamutChromaticities = Gamut_Chromaticities_REC2020
+    Attributes
+    ----------
+    completedPatches : int
+        Patches that finished their dwell time
+    lateFrames : int
+        Frames displayed late
+    droppedFrames : int
+        Frames dropped by the hardware
+    eventsDropped : int
+        Events lost because they were not read in time
+    patchCount : int
+        Patches in the uploaded list
+    running : int
+        1 until the last patch completed or the sequence was stopped
+    queuedFrames : int
+        Frames handed to the hardware and not completed yet
+    lastError : int
+        Code of a failed pack or schedule (0 = none)
+    """
 
+    _fields_: ClassVar = [
+        ("completedPatches", ctypes.c_uint64),
+        ("lateFrames", ctypes.c_uint64),
+        ("droppedFrames", ctypes.c_uint64),
+        ("eventsDropped", ctypes.c_uint64),
+        ("patchCount", ctypes.c_int32),
+        ("running", ctypes.c_int32),
+        ("queuedFrames", ctypes.c_int32),
+        ("lastError", ctypes.c_int32),
+    ]
 
-def _configure_function_signatures(lib: ctypes.CDLL) -> None:  # noqa: C901
-    """Configure ctypes function signatures for all DeckLink SDK functions.
 
-    Sets up argument types and return types for all C functions in the DeckLink
-    SDK library to ensure proper type safety and memory management when calling
-    from Python.
+class FrameCompletionEvent(ctypes.Structure):
+    """
+    Completion of one scheduled frame, read from the completion descriptor.
 
-    Parameters
+    Attributes
     ----------
-    lib : ctypes.CDLL
-        The loaded DeckLink SDK library instance.
-
-    Notes
-    -----
-    This function configures signatures for:
-    - Device enumeration (count, names)
-    - Device management (open, close, start, stop)
-    - Pixel format management
-    - HDR metadata handling
-    - Frame data operations
-    - Version information
+    frameNumber : int
+        Position among every frame the output scheduled, from 0
+    streamTime : int
+        Stream time the frame was scheduled at
+    timeScale : int
+        Units of streamTime per second
+    completionTimestamp : int
+        Hardware reference time of the completion in ns (0 = unavailable)
+    result : int
+        Completion result (0 = on time, 1 = late, 2 = dropped, 3 = flushed)
     """
 
-    # Device enumeration functions
-    if hasattr(lib, "decklink_get_device_count"):
-        lib.decklink_get_device_count.argtypes = []
-        lib.decklink_get_device_count.restype = ctypes.c_int
+    _fields_: ClassVar = [
+        ("frameNumber", ctypes.c_uint64),
+        ("streamTime", ctypes.c_int64),
+        ("timeScale", ctypes.c_int64),
+        ("completionTimestamp", ctypes.c_int64),
+        ("result", ctypes.c_int32),
+        ("reserved", ctypes.c_int32),
+    ]
 
-    if hasattr(lib, "decklink_get_device_name_by_index"):
-        lib.decklink_get_device_name_by_index.argtypes = [
-            ctypes.c_int,
-            ctypes.c_char_p,
-            ctypes.c_int,
-        ]
-        lib.decklink_get_device_name_by_index.restype = ctypes.c_int
 
-    # Device management functions
-    if hasattr(lib, "decklink_open_output_by_index"):
-        lib.decklink_open_output_by_index.argtypes = [ctypes.c_int]
-        lib.decklink_open_output_by_index.restype = ctypes.c_void_p
+class CompletionStatus(ctypes.Structure):
+    """
+    State of the frame completion events of one output.
 
-    if hasattr(lib, "decklink_close"):
-        lib.decklink_close.argtypes = [ctypes.c_void_p]
-        lib.decklink_close.restype = None
+    Attributes
+    ----------
+    scheduledFrames : int
+        Frames scheduled so far; the latest one is number scheduledFrames - 1
+    pendingEvents : int
+        Completions waiting to be read
+    eventsDropped : int
+        Events lost because they were not read in time
+    enabled : int
+        1 while the completion descriptor is open
+    """
 
-    # Output control functions
-    if hasattr(lib, "decklink_start_output"):
-        lib.decklink_start_output.argtypes = [ctypes.c_void_p]
-        lib.decklink_start_output.restype = ctypes.c_int
+    _fields_: ClassVar = [
+        ("scheduledFrames", ctypes.c_uint64),
+        ("pendingEvents", ctypes.c_uint64),
+        ("eventsDropped", ctypes.c_uint64),
+        ("enabled", ctypes.c_int32),
+        ("reserved", ctypes.c_int32),
+    ]
 
-    if hasattr(lib, "decklink_start_output_with_mode"):
-        lib.decklink_start_output_with_mode.argtypes = [
-            ctypes.c_void_p,
-            ctypes.c_uint32,
-        ]
-        lib.decklink_start_output_with_mode.restype = ctypes.c_int
 
-    if hasattr(lib, "decklink_stop_output"):
-        lib.decklink_stop_output.argtypes = [ctypes.c_void_p]
-        lib.decklink_stop_output.restype = ctypes.c_int
+class OutputSwitchReport(ctypes.Structure):
+    """
+    What a switch of the output format did.
 
-    # Pixel format functions
-    if hasattr(lib, "decklink_get_supported_pixel_format_count"):
-        lib.decklink_get_supported_pixel_format_count.argtypes = [ctypes.c_void_p]
-        lib.decklink_get_supported_pixel_format_count.restype = ctypes.c_int
+    Attributes
+    ----------
+    elapsedNs : int
+        Time spent in the switch in nanoseconds
+    relinked : int
+        1 if video output was disabled and re-enabled, which makes the sink
+        lock again
+    framesReady : int
+        1 if frames for the new format were already allocated
+    """
 
-    if hasattr(lib, "decklink_get_supported_pixel_format_name"):
-        lib.decklink_get_supported_pixel_format_name.argtypes = [
-            ctypes.c_void_p,
-            ctypes.c_int,
-            ctypes.c_char_p,
-            ctypes.c_int,
-        ]
-        lib.decklink_get_supported_pixel_format_name.restype = ctypes.c_int
+    _fields_: ClassVar = [
+        ("elapsedNs", ctypes.c_uint64),
+        ("relinked", ctypes.c_int32),
+        ("framesReady", ctypes.c_int32),
+    ]
 
-    if hasattr(lib, "decklink_set_pixel_format"):
-        lib.decklink_set_pixel_format.argtypes = [
-            ctypes.c_void_p,
-            ctypes.c_uint32,
-        ]
-        lib.decklink_set_pixel_format.restype = ctypes.c_int
 
-    if hasattr(lib, "decklink_get_pixel_format"):
-        lib.decklink_get_pixel_format.argtypes = [ctypes.c_void_p]
-        lib.decklink_get_pixel_format.restype = ctypes.c_uint32
+class FrameLibraryEntry(ctypes.Structure):
+    """
+    Index entry of one packed frame in a frame library file.
 
-    # HDR metadata functions
-    if hasattr(lib, "decklink_set_hdr_metadata"):
-        lib.decklink_set_hdr_metadata.argtypes = [
-            ctypes.c_void_p,
-            ctypes.POINTER(HDRMetadata),
-        ]
-        lib.decklink_set_hdr_metadata.restype = ctypes.c_int
+    Attributes
+    ----------
+    payloadOffset : int
+        Byte offset of the packed pixels in the file
+    payloadSize : int
+        Size of the packed pixels in bytes
+    pixelFormat : int
+        SDK code of the pixel format the frame is packed in
+    width : int
+        Frame width in pixels
+    height : int
+        Frame height in pixels
+    rowBytes : int
+        Bytes per packed row
+    eotf : int
+        EOTF of the HDR metadata shown with the frame
+    primaries : ctypes.c_double * 8
+        Red, green, blue and white point chromaticities, x then y
+    maxDisplayMasteringLuminance : float
+        Maximum mastering display luminance (cd/m²)
+    minDisplayMasteringLuminance : float
+        Minimum mastering display luminance (cd/m²)
+    maxCLL : float
+        Maximum Content Light Level (cd/m²)
+    maxFALL : float
+        Maximum Frame Average Light Level (cd/m²)
+    name : bytes
+        Label given when the frame was added
+    """
 
-    # Frame data management functions
-    if hasattr(lib, "decklink_set_frame_data"):
-        lib.decklink_set_frame_data.argtypes = [
-            ctypes.c_void_p,
-            ctypes.POINTER(ctypes.c_uint16),
-            ctypes.c_int,
-            ctypes.c_int,
-        ]
-        lib.decklink_set_frame_data.restype = ctypes.c_int
+    _fields_: ClassVar = [
+        ("payloadOffset", ctypes.c_uint64),
+        ("payloadSize", ctypes.c_uint64),
+        ("pixelFormat", ctypes.c_uint32),
+        ("width", ctypes.c_int32),
+        ("height", ctypes.c_int32),
+        ("rowBytes", ctypes.c_int32),
+        ("eotf", ctypes.c_int64),
+        ("primaries", ctypes.c_double * 8),
+        ("maxDisplayMasteringLuminance", ctypes.c_double),
+        ("minDisplayMasteringLuminance", ctypes.c_double),
+        ("maxCLL", ctypes.c_double),
+        ("maxFALL", ctypes.c_double),
+        ("name", ctypes.c_char * 64),
+    ]
 
-    # Frame management functions
-    if hasattr(lib, "decklink_create_frame_from_data"):
-        lib.decklink_create_frame_from_data.argtypes = [ctypes.c_void_p]
-        lib.decklink_create_frame_from_data.restype = ctypes.c_int
 
-    # Synchronous display function
-    if hasattr(lib, "decklink_display_frame_sync"):
-        lib.decklink_display_frame_sync.argtypes = [ctypes.c_void_p]
-        lib.decklink_display_frame_sync.restype = ctypes.c_int
+class DeckLinkDeviceInfo(ctypes.Structure):
+    """
+    Attributes of one DeckLink device, read when the device arrives.
 
-    # HDR capability detection functions
-    if hasattr(lib, "decklink_device_supports_hdr"):
-        lib.decklink_device_supports_hdr.argtypes = [ctypes.c_void_p]
-        lib.decklink_device_supports_hdr.restype = ctypes.c_bool
+    Attributes
+    ----------
+    displayName : bytes
+        Name shown for the device
+    modelName : bytes
+        Hardware model name
+    persistentId : int
+        ID that stays the same across reboots (0 if not reported)
+    topologicalId : int
+        ID of the device's connection slot (0 if not reported)
+    supportsPlayback : int
+        Non-zero if the device has video output
+    supportsHDR : int
+        Non-zero if the device can output HDR metadata
+    """
 
-    # Version info functions
-    if hasattr(lib, "decklink_get_driver_version"):
-        lib.decklink_get_driver_version.argtypes = []
-        lib.decklink_get_driver_version.restype = ctypes.c_char_p
+    _fields_: ClassVar = [
+        ("displayName", ctypes.c_char * 256),
+        ("modelName", ctypes.c_char * 256),
+        ("persistentId", ctypes.c_int64),
+        ("topologicalId", ctypes.c_int64),
+        ("supportsPlayback", ctypes.c_int32),
+        ("supportsHDR", ctypes.c_int32),
+    ]
 
-    if hasattr(lib, "decklink_get_sdk_version"):
-        lib.decklink_get_sdk_version.argtypes = []
-        lib.decklink_get_sdk_version.restype = ctypes.c_char_p
 
+class DeckLinkCapability(ctypes.Structure):
+    """
+    One supported display mode and pixel format pair of an output.
 
-def _try_load_decklink_sdk() -> ctypes.CDLL:
-    """Load the DeckLink SDK library and configure function signatures.
+    Attributes
+    ----------
+    displayMode : int
+        BMDDisplayMode code
+    pixelFormat : int
+        BMDPixelFormat code
+    connections : int
+        VideoConnection bits the pair is supported on
+    defaultConnection : int
+        Non-zero if supported on the connection output uses by default
+    width : int
+        Frame width of the display mode
+    height : int
+        Frame height of the display mode
+    frameDuration : int
+        Frame duration of the display mode in timeScale units
+    timeScale : int
+        Ticks per second of frameDuration
+    """
 
-    Attempts to load the compiled libdecklink.dylib from the same directory
-    as this Python module, then configures all ctypes function signatures
-    for type safety.
+    _fields_: ClassVar = [
+        ("displayMode", ctypes.c_uint32),
+        ("pixelFormat", ctypes.c_uint32),
+        ("connections", ctypes.c_uint32),
+        ("defaultConnection", ctypes.c_int32),
+        ("width", ctypes.c_int32),
+        ("height", ctypes.c_int32),
+        ("frameDuration", ctypes.c_int64),
+        ("timeScale", ctypes.c_int64),
+    ]
 
-    Returns
-    -------
-    ctypes.CDLL
-        The loaded and configured DeckLink SDK library instance.
 
-    Raises
-    ------
-    FileNotFoundError
-        If libdecklink.dylib cannot be found in the expected location.
-    OSError
-        If the library exists but cannot be loaded (e.g., architecture mismatch,
-        missing dependencies, or permission issues).
+class FrameCacheStats(ctypes.Structure):
+    """
+    Counters of the native packed-frame cache.
 
-    Notes
-    -----
-    The library file must be built from the C++ source in the cpp/ directory
-    and placed in the same directory as this module.
+    Attributes
+    ----------
+    hits : int
+        Frames reused from the cache without packing
+    misses : int
+        Frames that had to be packed
+    evictions : int
+        Entries dropped to stay within the budget
+    entries : int
+        Frames currently cached
+    bytes : int
+        Frame buffer bytes currently cached
+    budgetBytes : int
+        Configured memory budget in bytes (0 = disabled)
     """
-    lib_path = Path(__file__).parent.joinpath("libdecklink.dylib")
-    try:
-        # Try to load from the lib directory relative to this script
-        if lib_path.exists() and lib_path.is_file():
-            decklink_lib = ctypes.CDLL(lib_path)
-        else:
-            raise FileNotFoundError(
-                f"Could not find libdecklink.dylib in Python project: {lib_path.absolute()}"
-            )
-    except OSError as error:
-        raise OSError(
-            f"Failed to load DeckLink library from {lib_path.absolute()}"
-        ) from error
 
-    # Configure all function signatures
-    _configure_function_signatures(decklink_lib)
+    _fields_: ClassVar = [
+        ("hits", ctypes.c_uint64),
+        ("misses", ctypes.c_uint64),
+        ("evictions", ctypes.c_uint64),
+        ("entries", ctypes.c_uint64),
+        ("bytes", ctypes.c_uint64),
+        ("budgetBytes", ctypes.c_uint64),
+    ]
 
-    return decklink_lib
 
+class FramePipelineStats(ctypes.Structure):
+    """
+    Counters and queue depths of the native frame pipeline.
+
+    Attributes
+    ----------
+    submitted : int
+        Frames accepted by submit_frame
+    displayed : int
+        Frames shown on the output
+    failed : int
+        Frames that failed to pack or display
+    producerStalls : int
+        Submits that had to wait for a free slot
+    sourceDepth : int
+        Submitted frames waiting to be packed
+    frameDepth : int
+        Packed frames waiting to be displayed
+    capacity : int
+        Slots in each of the two queues
+    lastError : int
+        Code of the last failed pack or display (0 = none)
+    """
 
-DecklinkSDKWrapper: ctypes.CDLL = _try_load_decklink_sdk()
+    _fields_: ClassVar = [
+        ("submitted", ctypes.c_uint64),
+        ("displayed", ctypes.c_uint64),
+        ("failed", ctypes.c_uint64),
+        ("producerStalls", ctypes.c_uint64),
+        ("sourceDepth", ctypes.c_uint32),
+        ("frameDepth", ctypes.c_uint32),
+        ("capacity", ctypes.c_uint32),
+        ("lastError", ctypes.c_int32),
+    ]
 
 
-def get_decklink_driver_version() -> str:
+class StageLatencyStats(ctypes.Structure):
     """
-    Get the DeckLink driver version string.
+    Latency summary of one stage of the native frame path, in nanoseconds.
+
+    Attributes
+    ----------
+    count : int
+        Number of samples recorded
+    p50Ns : int
+        Median latency
+    p99Ns : int
+        99th percentile latency
+    maxNs : int
+        Largest latency recorded
+    totalNs : int
+        Sum of all samples
+    """
+
+    _fields_: ClassVar = [
+        ("count", ctypes.c_uint64),
+        ("p50Ns", ctypes.c_uint64),
+        ("p99Ns", ctypes.c_uint64),
+        ("maxNs", ctypes.c_uint64),
+        ("totalNs", ctypes.c_uint64),
+    ]
+
+
+class DeckLinkStats(ctypes.Structure):
+    """
+    Per-stage latency of the native frame path.
+
+    Attributes
+    ----------
+    setFrameData : StageLatencyStats
+        Copying caller data into the pending frame buffer
+    pack : StageLatencyStats
+        Packing RGB data into the output pixel format
+    createFrame : StageLatencyStats
+        Whole frame creation, including packing and HDR metadata
+    applyHDRMetadata : StageLatencyStats
+        Attaching HDR metadata to a frame. Frames keep their metadata, so
+        this only runs for new frames and after the metadata changes.
+    displayFrameSync : StageLatencyStats
+        Waiting for DisplayVideoFrameSync
+    scheduleFrame : StageLatencyStats
+        Queueing a frame for scheduled playback
+    """
+
+    _fields_: ClassVar = [
+        ("setFrameData", StageLatencyStats),
+        ("pack", StageLatencyStats),
+        ("createFrame", StageLatencyStats),
+        ("applyHDRMetadata", StageLatencyStats),
+        ("displayFrameSync", StageLatencyStats),
+        ("scheduleFrame", StageLatencyStats),
+    ]
+
+
+# Public stage names and the matching DeckLinkStats fields
+_LATENCY_STAGES = (
+    ("set_frame_data", "setFrameData"),
+    ("pack", "pack"),
+    ("create_frame", "createFrame"),
+    ("apply_hdr_metadata", "applyHDRMetadata"),
+    ("display_frame_sync", "displayFrameSync"),
+    ("schedule_frame", "scheduleFrame"),
+)
+
+
+def _stage_latency_dict(stage: StageLatencyStats) -> dict[str, float]:
+    """Convert one native stage summary to microseconds."""
+    mean_ns = stage.totalNs / stage.count if stage.count else 0.0
+    return {
+        "count": stage.count,
+        "p50_us": stage.p50Ns / 1000.0,
+        "p99_us": stage.p99Ns / 1000.0,
+        "max_us": stage.maxNs / 1000.0,
+        "mean_us": mean_ns / 1000.0,
+    }
+
+
+class FrameTelemetrySample(ctypes.Structure):
+    """
+    Output timing of one frame on the hardware reference clock.
+
+    Times are in nanoseconds; timestamps are 0 where the driver could not
+    provide them.
+
+    Attributes
+    ----------
+    frameNumber : int
+        Number of the scheduled frame, as in FrameCompletionEvent; -1 for
+        synchronous displays
+    submitTimestamp : int
+        When the frame was handed to the driver
+    scanoutTimestamp : int
+        When scanout of the frame started
+    completionTimestamp : int
+        Completion timestamp of a scheduled frame, 0 for synchronous displays
+    streamTime : int
+        Stream time the frame was scheduled at
+    queueLead : int
+        How far ahead of the playback position the frame was scheduled,
+        negative if it was already late
+    latency : int
+        Submit to scanout, 0 if either is unknown
+    interval : int
+        Since the scanout of the previous frame, 0 unless that frame directly
+        preceded this one
+    frameDuration : int
+        Frame duration of the display mode
+    result : int
+        BMDOutputFrameCompletionResult
+    """
+
+    _fields_: ClassVar = [
+        ("frameNumber", ctypes.c_int64),
+        ("submitTimestamp", ctypes.c_int64),
+        ("scanoutTimestamp", ctypes.c_int64),
+        ("completionTimestamp", ctypes.c_int64),
+        ("streamTime", ctypes.c_int64),
+        ("queueLead", ctypes.c_int64),
+        ("latency", ctypes.c_int64),
+        ("interval", ctypes.c_int64),
+        ("frameDuration", ctypes.c_int64),
+        ("result", ctypes.c_int32),
+        ("reserved", ctypes.c_int32),
+    ]
+
+
+class FrameTelemetryStats(ctypes.Structure):
+    """
+    Frame telemetry summary since the device was opened or last reset.
+
+    Attributes
+    ----------
+    displayedFrames : int
+        Frames that reached the output, on time or late
+    lateFrames : int
+        Scheduled frames displayed late
+    droppedFrames : int
+        Scheduled frames dropped
+    flushedFrames : int
+        Scheduled frames flushed without being displayed
+    pendingSamples : int
+        Samples waiting to be read
+    samplesDropped : int
+        Samples overwritten before they were read
+    submitToScanout : StageLatencyStats
+        Latency from handing a frame to the driver to its scanout
+    scanoutJitter : StageLatencyStats
+        Deviation of frame-to-frame scanout intervals from the frame duration
+    """
+
+    _fields_: ClassVar = [
+        ("displayedFrames", ctypes.c_uint64),
+        ("lateFrames", ctypes.c_uint64),
+        ("droppedFrames", ctypes.c_uint64),
+        ("flushedFrames", ctypes.c_uint64),
+        ("pendingSamples", ctypes.c_uint64),
+        ("samplesDropped", ctypes.c_uint64),
+        ("submitToScanout", StageLatencyStats),
+        ("scanoutJitter", StageLatencyStats),
+    ]
+
+
+class LoopbackResult(ctypes.Structure):
+    """
+    One captured frame of a loopback, checked against the output.
+
+    Attributes
+    ----------
+    captureNumber : int
+        Position among every frame captured since verification started
+    referenceNumber : int
+        Output frame it was compared with, numbered from 0 at the start; -1
+        if none
+    captureTimestamp : int
+        Hardware reference time of the capture in nanoseconds, 0 if
+        unavailable
+    compareDuration : int
+        Nanoseconds spent matching and comparing
+    mismatchedSamples : int
+        Components that differ from the reference
+    mismatchedRows : int
+        Rows with at least one differing component
+    status : int
+        LoopbackStatus
+    maxError : ctypes.c_uint16 * 3
+        Largest difference per channel, R, G, B or Y, Cb, Cr, in codes of
+        the pixel format
+    """
+
+    _fields_: ClassVar = [
+        ("captureNumber", ctypes.c_uint64),
+        ("referenceNumber", ctypes.c_int64),
+        ("captureTimestamp", ctypes.c_int64),
+        ("compareDuration", ctypes.c_int64),
+        ("mismatchedSamples", ctypes.c_uint64),
+        ("mismatchedRows", ctypes.c_uint32),
+        ("status", ctypes.c_int32),
+        ("maxError", ctypes.c_uint16 * 3),
+        ("reserved", ctypes.c_uint16),
+    ]
+
+
+class LoopbackStats(ctypes.Structure):
+    """
+    Loopback verification summary since it started or was last reset.
+
+    Attributes
+    ----------
+    capturedFrames : int
+        Every frame the input delivered
+    matchedFrames : int
+        Captures that were bit-exact copies of an output frame
+    mismatchedFrames : int
+        Captures that differed from the expected output frame
+    uncomparedFrames : int
+        Captures without a reference, in another format or without signal
+    skippedFrames : int
+        Captures that arrived while the comparison queue was full
+    pendingResults : int
+        Results waiting to be read
+    resultsDropped : int
+        Results overwritten before they were read
+    maxError : ctypes.c_uint16 * 3
+        Worst difference per channel of every mismatched capture
+    running : int
+        1 while captures are being verified
+    lastStatus : int
+        LoopbackStatus of the newest result, -1 before the first
+    compare : StageLatencyStats
+        Matching and comparing one capture
+    referenceCopy : StageLatencyStats
+        Copying an output frame into a reference, off the output path
+    """
+
+    _fields_: ClassVar = [
+        ("capturedFrames", ctypes.c_uint64),
+        ("matchedFrames", ctypes.c_uint64),
+        ("mismatchedFrames", ctypes.c_uint64),
+        ("uncomparedFrames", ctypes.c_uint64),
+        ("skippedFrames", ctypes.c_uint64),
+        ("pendingResults", ctypes.c_uint64),
+        ("resultsDropped", ctypes.c_uint64),
+        ("maxError", ctypes.c_uint16 * 3),
+        ("reserved", ctypes.c_uint16),
+        ("running", ctypes.c_int32),
+        ("lastStatus", ctypes.c_int32),
+        ("compare", StageLatencyStats),
+        ("referenceCopy", StageLatencyStats),
+    ]
+
+
+# Video resolution constants for standard formats
+DEFAULT_WIDTH = 1920  # Full HD/4K width
+DEFAULT_HEIGHT = 1080  # Full HD height
+
+# Device index of the hardware-free mock output built into libdecklink
+# (DECKLINK_MOCK_DEVICE_INDEX). Runs the native frame path at the display
+# mode's frame rate without a DeckLink device.
+MOCK_DEVICE_INDEX = -1000
+
+# HDR metadata constants following industry standards
+DEFAULT_MAX_CLL = 10000.0  # Maximum Content Light Level (cd/m²)
+DEFAULT_MAX_FALL = 400.0  # Maximum Frame Average Light Level (cd/m²)
+DEFAULT_MAX_DISPLAY_MASTERING_LUMINANCE = 1000.0  # Display mastering luminance (cd/m²)
+DEFAULT_MIN_DISPLAY_MASTERING_LUMINANCE = 0.0001  # Minimum display luminance (cd/m²)
+
+
+@dataclass
+class DecklinkSettings:
+    """
+    Comprehensive configuration settings for DeckLink device initialization and operation.
+
+    This dataclass consolidates all settings required for configuring a DeckLink device
+    including device selection, video resolution, pixel format, region of interest,
+    HDR metadata parameters, and color space information. It provides a unified
+    interface for all DeckLink-related configuration.
+
+    Parameters
+    ----------
+    device : int, optional
+        Index of the DeckLink device to use. Default is 0.
+    pixel_format : PixelFormatType | None, optional
+        Pixel format enum, None for auto-selection. Default is None.
+    width : int, optional
+        Frame width in pixels. Default is 1920.
+    height : int, optional
+        Frame height in pixels. Default is 1080.
+    roi_x : int, optional
+        Region of interest X offset. Default is 0.
+    roi_y : int, optional
+        Region of interest Y offset. Default is 0.
+    roi_width : int, optional
+        Region of interest width. Default is 1920.
+    roi_height : int, optional
+        Region of interest height. Default is 1080.
+    no_hdr : bool, optional
+        Whether to disable HDR metadata output. Default is False.
+    eotf : EOTFType, optional
+        Electro-Optical Transfer Function type. Default is PQ (HDR10).
+    max_cll : float, optional
+        Maximum Content Light Level in cd/m². Default is 10000.0.
+    max_fall : float, optional
+        Maximum Frame Average Light Level in cd/m². Default is 400.0.
+    max_display_mastering_luminance : float, optional
+        Maximum display mastering luminance in cd/m². Default is 1000.0.
+    min_display_mastering_luminance : float, optional
+        Minimum display mastering luminance in cd/m². Default is 0.0001.
+    gamut_chromaticities : Gamut_Chromaticities, optional
+        Complete color gamut definition including red, green, blue primaries
+        and white point chromaticity coordinates. Default is Rec.2020.
+
+    Attributes
+    ----------
+    device : int
+        Index of the DeckLink device to use
+    pixel_format : PixelFormatType | None
+        Pixel format enum, None for auto-selection
+    width : int
+        Frame width in pixels
+    height : int
+        Frame height in pixels
+    roi_x : int
+        Region of interest X offset
+    roi_y : int
+        Region of interest Y offset
+    roi_width : int
+        Region of interest width
+    roi_height : int
+        Region of interest height
+    no_hdr : bool
+        Whether to disable HDR metadata output
+    eotf : EOTFType
+        Electro-Optical Transfer Function type
+    max_cll : float
+        Maximum Content Light Level in cd/m²
+    max_fall : float
+        Maximum Frame Average Light Level in cd/m²
+    max_display_mastering_luminance : float
+        Maximum display mastering luminance in cd/m²
+    min_display_mastering_luminance : float
+        Minimum display mastering luminance in cd/m²
+    gamut_chromaticities : Gamut_Chromaticities
+        Complete color gamut definition including red, green, blue primaries
+        and white point chromaticity coordinates
+
+    Examples
+    --------
+    Create settings with defaults:
+
+    >>> settings = DecklinkSettings()
+    >>> print(f"Device: {settings.device}, Resolution: {settings.width}x{settings.height}")
+    Device: 0, Resolution: 1920x1080
+
+    Create settings for specific device with custom HDR:
+
+    >>> settings = DecklinkSettings(
+    ...     device=1,
+    ...     width=3840,
+    ...     height=2160,
+    ...     eotf=EOTFType.HLG,
+    ...     max_cll=4000.0
+    ... )
+    >>> print(f"EOTF: {settings.eotf}, Max CLL: {settings.max_cll}")
+    EOTF: HLG, Max CLL: 4000.0
+
+    Create settings with custom ROI:
+
+    >>> settings = DecklinkSettings(
+    ...     roi_x=100,
+    ...     roi_y=100,
+    ...     roi_width=1720,
+    ...     roi_height=880
+    ... )
+    >>> print(f"ROI: {settings.roi_x},{settings.roi_y} {settings.roi_width}x{settings.roi_height}")
+    ROI: 100,100 1720x880
+
+    Notes
+    -----
+    This class consolidates all DeckLink device configuration into a single
+    interface, eliminating the need for multiple settings classes and conversion
+    functions. It supports complete HDR metadata configuration following
+    industry standards (SMPTE ST 2086, CEA-861.3).
+
+    The default color primaries are set to Rec.2020 (ITU-R BT.2020) which is
+    the standard for Ultra HD and HDR content. The default EOTF is PQ
+    (Perceptual Quantizer) as specified in SMPTE ST 2084 for HDR10.
+
+    See Also
+    --------
+    HDRMetadata : HDR metadata structure for device configuration
+    PixelFormatType : Available pixel format options
+    EOTFType : Electro-Optical Transfer Function types
+    """
+
+    # Device parameters
+    device: int = 0
+    pixel_format: PixelFormatType | None = None
+    width: int = DEFAULT_WIDTH
+    height: int = DEFAULT_HEIGHT
+
+    # ROI parameters
+    roi_x: int = 0
+    roi_y: int = 0
+    roi_width: int = DEFAULT_WIDTH
+    roi_height: int = DEFAULT_HEIGHT
+
+    # HDR metadata settings
+    no_hdr: bool = False
+    eotf: EOTFType = EOTFType.PQ
+    max_cll: float = DEFAULT_MAX_CLL
+    max_fall: float = DEFAULT_MAX_FALL
+    max_display_mastering_luminance: float = DEFAULT_MAX_DISPLAY_MASTERING_LUMINANCE
+    min_display_mastering_luminance: float = DEFAULT_MIN_DISPLAY_MASTERING_LUMINANCE
+
+    # Color space primaries and white point
+    gamut_chromaticities: GamutChromaticities = Gamut_Chromaticities_REC2020
+
+
+def _configure_function_signatures(lib: ctypes.CDLL) -> None:  # noqa: C901
+    """Configure ctypes function signatures for all DeckLink SDK functions.
+
+    Sets up argument types and return types for all C functions in the DeckLink
+    SDK library to ensure proper type safety and memory management when calling
+    from Python.
+
+    Parameters
+    ----------
+    lib : ctypes.CDLL
+        The loaded DeckLink SDK library instance.
+
+    Notes
+    -----
+    This function configures signatures for:
+    - Device enumeration (count, names)
+    - Device management (open, close, start, stop)
+    - Pixel format management
+    - HDR metadata handling
+    - Frame data operations
+    - Scheduled playback
+    - Version information
+    """
+
+    # Device enumeration functions
+    if hasattr(lib, "decklink_get_device_count"):
+        lib.decklink_get_device_count.argtypes = []
+        lib.decklink_get_device_count.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_device_name_by_index"):
+        lib.decklink_get_device_name_by_index.argtypes = [
+            ctypes.c_int,
+            ctypes.c_char_p,
+            ctypes.c_int,
+        ]
+        lib.decklink_get_device_name_by_index.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_device_info"):
+        lib.decklink_get_device_info.argtypes = [
+            ctypes.c_int,
+            ctypes.POINTER(DeckLinkDeviceInfo),
+        ]
+        lib.decklink_get_device_info.restype = ctypes.c_int
+
+    # Device management functions
+    if hasattr(lib, "decklink_open_output_by_index"):
+        lib.decklink_open_output_by_index.argtypes = [ctypes.c_int]
+        lib.decklink_open_output_by_index.restype = ctypes.c_void_p
+
+    if hasattr(lib, "decklink_close"):
+        lib.decklink_close.argtypes = [ctypes.c_void_p]
+        lib.decklink_close.restype = None
+
+    # Output control functions
+    if hasattr(lib, "decklink_start_output"):
+        lib.decklink_start_output.argtypes = [ctypes.c_void_p]
+        lib.decklink_start_output.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_start_output_with_mode"):
+        lib.decklink_start_output_with_mode.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_uint32,
+        ]
+        lib.decklink_start_output_with_mode.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_stop_output"):
+        lib.decklink_stop_output.argtypes = [ctypes.c_void_p]
+        lib.decklink_stop_output.restype = ctypes.c_int
+
+    # Pixel format functions
+    if hasattr(lib, "decklink_get_supported_pixel_format_count"):
+        lib.decklink_get_supported_pixel_format_count.argtypes = [ctypes.c_void_p]
+        lib.decklink_get_supported_pixel_format_count.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_supported_pixel_format_name"):
+        lib.decklink_get_supported_pixel_format_name.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int,
+            ctypes.c_char_p,
+            ctypes.c_int,
+        ]
+        lib.decklink_get_supported_pixel_format_name.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_capabilities"):
+        lib.decklink_get_capabilities.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(DeckLinkCapability),
+            ctypes.c_int,
+        ]
+        lib.decklink_get_capabilities.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_set_pixel_format"):
+        lib.decklink_set_pixel_format.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_uint32,
+        ]
+        lib.decklink_set_pixel_format.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_pixel_format"):
+        lib.decklink_get_pixel_format.argtypes = [ctypes.c_void_p]
+        lib.decklink_get_pixel_format.restype = ctypes.c_uint32
+
+    # HDR metadata functions
+    if hasattr(lib, "decklink_set_hdr_metadata"):
+        lib.decklink_set_hdr_metadata.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(HDRMetadata),
+        ]
+        lib.decklink_set_hdr_metadata.restype = ctypes.c_int
+
+    # Output format switching functions
+    if hasattr(lib, "decklink_prepare_output_format"):
+        lib.decklink_prepare_output_format.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_uint32,
+            ctypes.c_int,
+            ctypes.c_int,
+        ]
+        lib.decklink_prepare_output_format.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_switch_output_format"):
+        lib.decklink_switch_output_format.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_uint32,
+            ctypes.c_uint32,
+            ctypes.POINTER(HDRMetadata),
+            ctypes.POINTER(OutputSwitchReport),
+        ]
+        lib.decklink_switch_output_format.restype = ctypes.c_int
+
+    # RGB to Y'CbCr conversion functions
+    if hasattr(lib, "decklink_set_ycbcr_conversion"):
+        lib.decklink_set_ycbcr_conversion.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+        ]
+        lib.decklink_set_ycbcr_conversion.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_ycbcr_conversion"):
+        lib.decklink_get_ycbcr_conversion.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_int),
+            ctypes.POINTER(ctypes.c_int),
+            ctypes.POINTER(ctypes.c_int),
+        ]
+        lib.decklink_get_ycbcr_conversion.restype = ctypes.c_int
+
+    # Display-correction LUT
+    if hasattr(lib, "decklink_set_color_lut"):
+        lib.decklink_set_color_lut.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_float),
+            ctypes.c_int,
+            ctypes.POINTER(ctypes.c_float),
+            ctypes.c_int,
+        ]
+        lib.decklink_set_color_lut.restype = ctypes.c_int
+
+    # Frame data management functions
+    if hasattr(lib, "decklink_set_frame_data"):
+        lib.decklink_set_frame_data.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_int,
+            ctypes.c_int,
+        ]
+        lib.decklink_set_frame_data.restype = ctypes.c_int
+
+    # Packed-frame cache functions
+    if hasattr(lib, "decklink_set_frame_cache_budget"):
+        lib.decklink_set_frame_cache_budget.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_uint64,
+        ]
+        lib.decklink_set_frame_cache_budget.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_frame_cache_stats"):
+        lib.decklink_get_frame_cache_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(FrameCacheStats),
+        ]
+        lib.decklink_get_frame_cache_stats.restype = ctypes.c_int
+
+    # Latency statistics functions
+    if hasattr(lib, "decklink_get_stats"):
+        lib.decklink_get_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(DeckLinkStats),
+        ]
+        lib.decklink_get_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_reset_stats"):
+        lib.decklink_reset_stats.argtypes = [ctypes.c_void_p]
+        lib.decklink_reset_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_set_solid_color"):
+        lib.decklink_set_solid_color.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.POINTER(ctypes.c_uint16),
+        ]
+        lib.decklink_set_solid_color.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_set_rect_pattern"):
+        lib.decklink_set_rect_pattern.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.POINTER(PatternRect),
+            ctypes.c_int,
+        ]
+        lib.decklink_set_rect_pattern.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_set_generated_pattern"):
+        lib.decklink_set_generated_pattern.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.POINTER(GeneratedPattern),
+        ]
+        lib.decklink_set_generated_pattern.restype = ctypes.c_int
+
+    # Frame management functions
+    if hasattr(lib, "decklink_create_frame_from_data"):
+        lib.decklink_create_frame_from_data.argtypes = [ctypes.c_void_p]
+        lib.decklink_create_frame_from_data.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_create_frame_from_buffer"):
+        lib.decklink_create_frame_from_buffer.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_int,
+            ctypes.c_int,
+        ]
+        lib.decklink_create_frame_from_buffer.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_update_frame_region"):
+        lib.decklink_update_frame_region.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.c_int,
+        ]
+        lib.decklink_update_frame_region.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_begin_frame_write"):
+        lib.decklink_begin_frame_write.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.POINTER(ctypes.c_void_p),
+            ctypes.POINTER(ctypes.c_int),
+        ]
+        lib.decklink_begin_frame_write.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_end_frame_write"):
+        lib.decklink_end_frame_write.argtypes = [ctypes.c_void_p]
+        lib.decklink_end_frame_write.restype = ctypes.c_int
+
+    # Synchronous display function
+    if hasattr(lib, "decklink_display_frame_sync"):
+        lib.decklink_display_frame_sync.argtypes = [ctypes.c_void_p]
+        lib.decklink_display_frame_sync.restype = ctypes.c_int
+
+    # Scheduled playback functions
+    if hasattr(lib, "decklink_schedule_frame_for_output"):
+        lib.decklink_schedule_frame_for_output.argtypes = [ctypes.c_void_p]
+        lib.decklink_schedule_frame_for_output.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_start_scheduled_playback"):
+        lib.decklink_start_scheduled_playback.argtypes = [ctypes.c_void_p]
+        lib.decklink_start_scheduled_playback.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_stop_scheduled_playback"):
+        lib.decklink_stop_scheduled_playback.argtypes = [ctypes.c_void_p]
+        lib.decklink_stop_scheduled_playback.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_buffered_frame_count"):
+        lib.decklink_get_buffered_frame_count.argtypes = [ctypes.c_void_p]
+        lib.decklink_get_buffered_frame_count.restype = ctypes.c_int
+
+    # Frame pipeline functions
+    if hasattr(lib, "decklink_start_frame_pipeline"):
+        lib.decklink_start_frame_pipeline.argtypes = [ctypes.c_void_p]
+        lib.decklink_start_frame_pipeline.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_stop_frame_pipeline"):
+        lib.decklink_stop_frame_pipeline.argtypes = [ctypes.c_void_p]
+        lib.decklink_stop_frame_pipeline.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_submit_frame"):
+        lib.decklink_submit_frame.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_int,
+            ctypes.c_int,
+        ]
+        lib.decklink_submit_frame.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_flush_frame_pipeline"):
+        lib.decklink_flush_frame_pipeline.argtypes = [ctypes.c_void_p]
+        lib.decklink_flush_frame_pipeline.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_frame_pipeline_stats"):
+        lib.decklink_get_frame_pipeline_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(FramePipelineStats),
+        ]
+        lib.decklink_get_frame_pipeline_stats.restype = ctypes.c_int
+
+    # Patch sequence functions
+    if hasattr(lib, "decklink_load_sequence"):
+        lib.decklink_load_sequence.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int,
+            ctypes.c_int,
+            ctypes.POINTER(SequencePatch),
+            ctypes.c_int,
+        ]
+        lib.decklink_load_sequence.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_start_sequence"):
+        lib.decklink_start_sequence.argtypes = [ctypes.c_void_p, ctypes.c_int]
+        lib.decklink_start_sequence.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_stop_sequence"):
+        lib.decklink_stop_sequence.argtypes = [ctypes.c_void_p]
+        lib.decklink_stop_sequence.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_wait_sequence_event"):
+        lib.decklink_wait_sequence_event.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(SequenceEvent),
+            ctypes.c_int,
+        ]
+        lib.decklink_wait_sequence_event.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_sequence_status"):
+        lib.decklink_get_sequence_status.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(SequenceStatus),
+        ]
+        lib.decklink_get_sequence_status.restype = ctypes.c_int
+
+    # Frame completion events
+    if hasattr(lib, "decklink_enable_completion_events"):
+        lib.decklink_enable_completion_events.argtypes = [ctypes.c_void_p]
+        lib.decklink_enable_completion_events.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_disable_completion_events"):
+        lib.decklink_disable_completion_events.argtypes = [ctypes.c_void_p]
+        lib.decklink_disable_completion_events.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_read_completion_events"):
+        lib.decklink_read_completion_events.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(FrameCompletionEvent),
+            ctypes.c_int,
+        ]
+        lib.decklink_read_completion_events.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_completion_status"):
+        lib.decklink_get_completion_status.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(CompletionStatus),
+        ]
+        lib.decklink_get_completion_status.restype = ctypes.c_int
+
+    # Frame telemetry functions
+    if hasattr(lib, "decklink_read_frame_telemetry"):
+        lib.decklink_read_frame_telemetry.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(FrameTelemetrySample),
+            ctypes.c_int,
+        ]
+        lib.decklink_read_frame_telemetry.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_frame_telemetry"):
+        lib.decklink_get_frame_telemetry.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(FrameTelemetryStats),
+        ]
+        lib.decklink_get_frame_telemetry.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_reset_frame_telemetry"):
+        lib.decklink_reset_frame_telemetry.argtypes = [ctypes.c_void_p]
+        lib.decklink_reset_frame_telemetry.restype = ctypes.c_int
+
+    # Loopback verification functions
+    if hasattr(lib, "decklink_start_loopback"):
+        lib.decklink_start_loopback.argtypes = [ctypes.c_void_p, ctypes.c_int]
+        lib.decklink_start_loopback.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_stop_loopback"):
+        lib.decklink_stop_loopback.argtypes = [ctypes.c_void_p]
+        lib.decklink_stop_loopback.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_read_loopback_results"):
+        lib.decklink_read_loopback_results.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(LoopbackResult),
+            ctypes.c_int,
+        ]
+        lib.decklink_read_loopback_results.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_loopback_stats"):
+        lib.decklink_get_loopback_stats.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(LoopbackStats),
+        ]
+        lib.decklink_get_loopback_stats.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_reset_loopback_stats"):
+        lib.decklink_reset_loopback_stats.argtypes = [ctypes.c_void_p]
+        lib.decklink_reset_loopback_stats.restype = ctypes.c_int
+
+    # Output group functions
+    if hasattr(lib, "decklink_group_create"):
+        lib.decklink_group_create.argtypes = []
+        lib.decklink_group_create.restype = ctypes.c_void_p
+
+    if hasattr(lib, "decklink_group_destroy"):
+        lib.decklink_group_destroy.argtypes = [ctypes.c_void_p]
+        lib.decklink_group_destroy.restype = None
+
+    if hasattr(lib, "decklink_group_add_output"):
+        lib.decklink_group_add_output.argtypes = [ctypes.c_void_p, ctypes.c_void_p]
+        lib.decklink_group_add_output.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_group_remove_output"):
+        lib.decklink_group_remove_output.argtypes = [ctypes.c_void_p, ctypes.c_void_p]
+        lib.decklink_group_remove_output.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_group_get_output_count"):
+        lib.decklink_group_get_output_count.argtypes = [ctypes.c_void_p]
+        lib.decklink_group_get_output_count.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_group_display_frame_sync"):
+        lib.decklink_group_display_frame_sync.argtypes = [ctypes.c_void_p]
+        lib.decklink_group_display_frame_sync.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_group_schedule_frame"):
+        lib.decklink_group_schedule_frame.argtypes = [ctypes.c_void_p]
+        lib.decklink_group_schedule_frame.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_group_start_scheduled_playback"):
+        lib.decklink_group_start_scheduled_playback.argtypes = [ctypes.c_void_p]
+        lib.decklink_group_start_scheduled_playback.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_group_stop_scheduled_playback"):
+        lib.decklink_group_stop_scheduled_playback.argtypes = [ctypes.c_void_p]
+        lib.decklink_group_stop_scheduled_playback.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_group_get_pack_count"):
+        lib.decklink_group_get_pack_count.argtypes = [ctypes.c_void_p]
+        lib.decklink_group_get_pack_count.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_group_create_frame_from_buffer"):
+        lib.decklink_group_create_frame_from_buffer.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_uint16),
+            ctypes.c_int,
+            ctypes.c_int,
+        ]
+        lib.decklink_group_create_frame_from_buffer.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_group_get_buffered_frame_counts"):
+        lib.decklink_group_get_buffered_frame_counts.argtypes = [
+            ctypes.c_void_p,
+            ctypes.POINTER(ctypes.c_int),
+            ctypes.c_int,
+        ]
+        lib.decklink_group_get_buffered_frame_counts.restype = ctypes.c_int
+
+    # Frame library functions
+    if hasattr(lib, "decklink_library_writer_create"):
+        lib.decklink_library_writer_create.argtypes = [ctypes.c_char_p]
+        lib.decklink_library_writer_create.restype = ctypes.c_void_p
+
+    if hasattr(lib, "decklink_library_writer_add_frame"):
+        lib.decklink_library_writer_add_frame.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_void_p,
+            ctypes.c_char_p,
+        ]
+        lib.decklink_library_writer_add_frame.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_library_writer_close"):
+        lib.decklink_library_writer_close.argtypes = [ctypes.c_void_p]
+        lib.decklink_library_writer_close.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_library_open"):
+        lib.decklink_library_open.argtypes = [ctypes.c_char_p]
+        lib.decklink_library_open.restype = ctypes.c_void_p
+
+    if hasattr(lib, "decklink_library_close"):
+        lib.decklink_library_close.argtypes = [ctypes.c_void_p]
+        lib.decklink_library_close.restype = None
+
+    if hasattr(lib, "decklink_library_get_frame_count"):
+        lib.decklink_library_get_frame_count.argtypes = [ctypes.c_void_p]
+        lib.decklink_library_get_frame_count.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_library_get_frame_info"):
+        lib.decklink_library_get_frame_info.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_int,
+            ctypes.POINTER(FrameLibraryEntry),
+        ]
+        lib.decklink_library_get_frame_info.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_load_library_frame"):
+        lib.decklink_load_library_frame.argtypes = [
+            ctypes.c_void_p,
+            ctypes.c_void_p,
+            ctypes.c_int,
+        ]
+        lib.decklink_load_library_frame.restype = ctypes.c_int
+
+    # HDR capability detection functions
+    if hasattr(lib, "decklink_device_supports_hdr"):
+        lib.decklink_device_supports_hdr.argtypes = [ctypes.c_void_p]
+        lib.decklink_device_supports_hdr.restype = ctypes.c_bool
+
+    # Packing thread functions
+    if hasattr(lib, "decklink_set_pack_thread_count"):
+        lib.decklink_set_pack_thread_count.argtypes = [ctypes.c_int]
+        lib.decklink_set_pack_thread_count.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_pack_thread_count"):
+        lib.decklink_get_pack_thread_count.argtypes = []
+        lib.decklink_get_pack_thread_count.restype = ctypes.c_int
+
+    # Logging functions
+    if hasattr(lib, "decklink_set_log_level"):
+        lib.decklink_set_log_level.argtypes = [ctypes.c_int]
+        lib.decklink_set_log_level.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_get_log_level"):
+        lib.decklink_get_log_level.argtypes = []
+        lib.decklink_get_log_level.restype = ctypes.c_int
+
+    if hasattr(lib, "decklink_flush_log"):
+        lib.decklink_flush_log.argtypes = []
+        lib.decklink_flush_log.restype = None
+
+    # Version info functions
+    if hasattr(lib, "decklink_get_driver_version"):
+        lib.decklink_get_driver_version.argtypes = []
+        lib.decklink_get_driver_version.restype = ctypes.c_char_p
+
+    if hasattr(lib, "decklink_get_sdk_version"):
+        lib.decklink_get_sdk_version.argtypes = []
+        lib.decklink_get_sdk_version.restype = ctypes.c_char_p
+
+
+def _try_load_decklink_sdk() -> ctypes.CDLL:
+    """Load the DeckLink SDK library and configure function signatures.
+
+    Attempts to load the compiled libdecklink.dylib from the same directory
+    as this Python module, then configures all ctypes function signatures
+    for type safety.
+
+    Returns
+    -------
+    ctypes.CDLL
+        The loaded and configured DeckLink SDK library instance.
+
+    Raises
+    ------
+    FileNotFoundError
+        If libdecklink.dylib cannot be found in the expected location.
+    OSError
+        If the library exists but cannot be loaded (e.g., architecture mismatch,
+        missing dependencies, or permission issues).
+
+    Notes
+    -----
+    The library file must be built from the C++ source in the cpp/ directory
+    and placed in the same directory as this module.
+    """
+    lib_path = Path(__file__).parent.joinpath("libdecklink.dylib")
+    try:
+        # Try to load from the lib directory relative to this script
+        if lib_path.exists() and lib_path.is_file():
+            decklink_lib = ctypes.CDLL(lib_path)
+        else:
+            raise FileNotFoundError(
+                f"Could not find libdecklink.dylib in Python project: {lib_path.absolute()}"
+            )
+    except OSError as error:
+        raise OSError(
+            f"Failed to load DeckLink library from {lib_path.absolute()}"
+        ) from error
+
+    # Configure all function signatures
+    _configure_function_signatures(decklink_lib)
+
+    return decklink_lib
+
+
+DecklinkSDKWrapper: ctypes.CDLL = _try_load_decklink_sdk()
+
+
+def _try_load_native_binding() -> Any | None:
+    """Load the native frame binding if it was built.
+
+    ``_decklink_native`` is built from ``cpp/python_binding.cpp`` by
+    ``make native``. It takes frames through the buffer protocol and makes all the
+    library calls of one frame with the GIL released.
+
+    Returns
+    -------
+    module or None
+        The binding, or None to use ctypes for every call
+    """
+    try:
+        return importlib.import_module("bmd_sg.decklink._decklink_native")
+    except ImportError:
+        return None
+
+
+_native_binding: Any | None = _try_load_native_binding()
+
+
+def _native_frame_call(name: str, handle: Any, frame_data: Any, *args: Any) -> bool:
+    """Run a frame call through the native binding.
+
+    Parameters
+    ----------
+    name : str
+        Function of the binding, which takes the handle, the frame and args
+    handle : Any
+        Device or group handle, None when closed
+    frame_data : array_like
+        Frame data, converted to a C-contiguous ``uint16`` array if needed
+    *args : Any
+        Further arguments of the function
+
+    Returns
+    -------
+    bool
+        False if the binding is not available and the caller has to use
+        ctypes instead
+
+    Raises
+    ------
+    RuntimeError
+        If the handle is closed or a library call fails, with the same
+        messages as the ctypes path
+    ValueError
+        If frame_data does not have shape (height, width, 3)
+    """
+    if _native_binding is None:
+        return False
+    frame_data = np.ascontiguousarray(frame_data, dtype=np.uint16)
+    getattr(_native_binding, name)(handle, frame_data, *args)
+    return True
+
+
+def get_decklink_driver_version() -> str:
+    """
+    Get the DeckLink driver version string.
+
+    Returns
+    -------
+    str
+        The version string of the installed DeckLink driver.
+
+    Examples
+    --------
+    >>> version = get_decklink_driver_version()
+    >>> print(f"Driver version: {version}")
+    Driver version: 12.8.1
+
+    Notes
+    -----
+    Requires DeckLink Desktop Video drivers to be installed.
+    """
+    return DecklinkSDKWrapper.decklink_get_driver_version().decode("utf-8")
+
+
+def get_decklink_sdk_version() -> str:
+    """
+    Get the DeckLink SDK version string.
+
+    Returns
+    -------
+    str
+        The version string of the DeckLink SDK library.
+
+    Examples
+    --------
+    >>> version = get_decklink_sdk_version()
+    >>> print(f"SDK version: {version}")
+    SDK version: 14.4.0
+
+    Notes
+    -----
+    This returns the version of the compiled libdecklink.dylib library.
+    """
+    return DecklinkSDKWrapper.decklink_get_sdk_version().decode("utf-8")
+
+
+def get_pack_thread_count() -> int:
+    """
+    Get the number of threads used to pack each frame.
+
+    Returns
+    -------
+    int
+        Threads used per frame, including the calling thread.
+    """
+    return DecklinkSDKWrapper.decklink_get_pack_thread_count()
+
+
+def set_pack_thread_count(thread_count: int) -> None:
+    """
+    Set the number of threads used to pack each frame.
+
+    Large frames (UHD and up) are split into row bands that are packed in
+    parallel. The threads are shared by every open device.
+
+    Parameters
+    ----------
+    thread_count : int
+        Threads to use per frame, including the calling thread. 1 packs on
+        the calling thread only; 0 uses one thread per CPU core.
+
+    Raises
+    ------
+    ValueError
+        If ``thread_count`` is negative
+    """
+    if thread_count < 0:
+        raise ValueError(f"Thread count must be non-negative, got {thread_count}")
+    res = DecklinkSDKWrapper.decklink_set_pack_thread_count(thread_count)
+    if res != 0:
+        raise RuntimeError(f"Failed to set pack thread count (error {res})")
+
+
+def get_log_level() -> LogLevel:
+    """
+    Get the verbosity of the native library's log output.
+
+    Returns
+    -------
+    LogLevel
+        Most verbose level currently logged
+    """
+    return LogLevel(DecklinkSDKWrapper.decklink_get_log_level())
+
+
+def set_log_level(level: LogLevel | int) -> None:
+    """
+    Set the verbosity of the native library's log output.
+
+    Parameters
+    ----------
+    level : LogLevel or int
+        Most verbose level to log, applied to every open device
+
+    Raises
+    ------
+    ValueError
+        If ``level`` is not a valid log level
+    """
+    level = LogLevel(level)
+    res = DecklinkSDKWrapper.decklink_set_log_level(int(level))
+    if res != 0:
+        raise RuntimeError(f"Failed to set log level (error {res})")
+
+
+def flush_log() -> None:
+    """Wait until every queued native log message has been written to stderr."""
+    DecklinkSDKWrapper.decklink_flush_log()
+
+
+def ndarray_to_bmd_frame_buffer(
+    frame_data: np.ndarray,
+) -> tuple[Any, int, int]:
+    """
+    Convert numpy array to BMD-compatible frame buffer.
+
+    Parameters
+    ----------
+    frame_data : numpy.ndarray
+        Frame data with shape (height, width, channels) or (height, width)
+
+    Returns
+    -------
+    tuple[ctypes.POINTER(ctypes.c_uint16), int, int]
+        Tuple containing (data_ptr, width, height)
+
+    Raises
+    ------
+    ValueError
+        If frame_data is not a valid numpy array or has invalid dimensions
+    """
+    if not isinstance(frame_data, np.ndarray):
+        raise ValueError("frame_data must be a numpy array")
+
+    # Get dimensions
+    if frame_data.ndim == 2:
+        height, width = frame_data.shape
+    elif frame_data.ndim == 3:
+        height, width, _ = frame_data.shape
+    else:
+        raise ValueError("frame_data must be 2D or 3D array")
+
+    # Note: frame_data should already be uint16 and contiguous
+    # These conversions are handled in _prepare_frame() before calling this function
+
+    # Get pointer to data
+    data_ptr = frame_data.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16))
+    return data_ptr, height, width
+
+
+def get_decklink_devices() -> list[str]:
+    """
+    Get list of available DeckLink device names.
+
+    Returns
+    -------
+    list[str]
+        List of device names for all detected DeckLink devices.
+        Returns empty list if no devices are found.
+
+    Examples
+    --------
+    >>> devices = get_decklink_devices()
+    >>> print(f"Found {len(devices)} devices")
+    Found 2 devices
+    >>> for i, device in enumerate(devices):
+    ...     print(f"Device {i}: {device}")
+    Device 0: DeckLink Mini Monitor 4K
+    Device 1: DeckLink Studio 4K
+
+    Notes
+    -----
+    Devices are returned in the order they were detected. The list is cached
+    by the native library and kept current by hot-plug notifications, so
+    calling this repeatedly is cheap. Removing a device shifts the indices of
+    the devices after it down by one.
+    The index corresponds to the device_index parameter used in BMDDeckLink.
+    """
+    count = DecklinkSDKWrapper.decklink_get_device_count()
+    devices = []
+    for i in range(count):
+        name = ctypes.create_string_buffer(256)
+        if DecklinkSDKWrapper.decklink_get_device_name_by_index(i, name, 256) == 0:
+            devices.append(name.value.decode("utf-8"))
+    return devices
+
+
+def get_decklink_device_info(device_index: int) -> dict[str, Any]:
+    """
+    Get the attributes of a DeckLink device without opening it.
+
+    Parameters
+    ----------
+    device_index : int
+        Index of the device, as in get_decklink_devices()
+
+    Returns
+    -------
+    dict[str, Any]
+        Dictionary with keys "name", "model_name", "persistent_id",
+        "topological_id", "supports_playback" and "supports_hdr".
+        The IDs are 0 when the device does not report them.
+
+    Raises
+    ------
+    RuntimeError
+        If no device has this index
+    """
+    info = DeckLinkDeviceInfo()
+    res = DecklinkSDKWrapper.decklink_get_device_info(device_index, ctypes.byref(info))
+    if res != 0:
+        raise RuntimeError(f"Failed to get device info (error {res})")
+    return {
+        "name": info.displayName.decode("utf-8"),
+        "model_name": info.modelName.decode("utf-8"),
+        "persistent_id": info.persistentId,
+        "topological_id": info.topologicalId,
+        "supports_playback": bool(info.supportsPlayback),
+        "supports_hdr": bool(info.supportsHDR),
+    }
+
+
+class FrameCompletionWaiter:
+    """
+    Await frame completions that arrive on a pollable descriptor.
+
+    Registers the descriptor with the running asyncio event loop while any
+    frame is awaited, reads the completions when it becomes readable and
+    resolves the matching waits. No thread blocks and nothing sleeps.
+
+    Parameters
+    ----------
+    fd : int
+        Descriptor that is readable while completions are pending
+    read_events : Callable[[], list[dict[str, int]]]
+        Returns the pending completions, oldest first, each with at least
+        ``frame_number``
+
+    Notes
+    -----
+    All waits must run on one event loop. The most recent completions are
+    remembered, so awaiting a frame that already completed returns at once.
+    """
+
+    _RECENT_EVENTS = 1024
+
+    def __init__(
+        self, fd: int, read_events: Callable[[], list[dict[str, int]]]
+    ) -> None:
+        self._fd = fd
+        self._read_events = read_events
+        self._loop: asyncio.AbstractEventLoop | None = None
+        self._waiters: dict[int, list[asyncio.Future[dict[str, int]]]] = {}
+        self._recent: dict[int, dict[str, int]] = {}
+        self._last_completed = -1
+
+    async def wait(self, frame_number: int) -> dict[str, int]:
+        """
+        Wait until a frame has completed.
+
+        Parameters
+        ----------
+        frame_number : int
+            Number of the scheduled frame
+
+        Returns
+        -------
+        dict[str, int]
+            The frame's completion event
+
+        Raises
+        ------
+        RuntimeError
+            If the completion of the frame was not reported, for example
+            because it was scheduled before the events were enabled, or the
+            waiter was closed meanwhile
+        """
+        if frame_number in self._recent:
+            return self._recent[frame_number]
+        if frame_number <= self._last_completed:
+            raise RuntimeError(f"Completion of frame {frame_number} was not reported")
+
+        loop = asyncio.get_running_loop()
+        if self._loop is None:
+            loop.add_reader(self._fd, self._on_readable)
+            self._loop = loop
+        elif self._loop is not loop:
+            raise RuntimeError("Frame completions are awaited on another event loop")
+        future: asyncio.Future[dict[str, int]] = loop.create_future()
+        self._waiters.setdefault(frame_number, []).append(future)
+        try:
+            return await future
+        finally:
+            waiters = self._waiters.get(frame_number, [])
+            if future in waiters:
+                waiters.remove(future)
+                if not waiters:
+                    del self._waiters[frame_number]
+            if not self._waiters:
+                self._stop_watching()
+
+    def close(self) -> None:
+        """Stop watching the descriptor and fail every pending wait."""
+        self._stop_watching()
+        waiters, self._waiters = self._waiters, {}
+        for futures in waiters.values():
+            for future in futures:
+                if not future.done():
+                    future.set_exception(RuntimeError("Completion events disabled"))
+
+    def _stop_watching(self) -> None:
+        if self._loop is not None:
+            self._loop.remove_reader(self._fd)
+            self._loop = None
+
+    def _on_readable(self) -> None:
+        for event in self._read_events():
+            number = event["frame_number"]
+            self._last_completed = max(self._last_completed, number)
+            self._recent[number] = event
+            if len(self._recent) > self._RECENT_EVENTS:
+                del self._recent[next(iter(self._recent))]
+            for future in self._waiters.get(number, []):
+                if not future.done():
+                    future.set_result(event)
+        # Frames older than the latest completion will not complete any more
+        for number, futures in self._waiters.items():
+            if number < self._last_completed and number not in self._recent:
+                error = RuntimeError(f"Completion of frame {number} was not reported")
+                for future in futures:
+                    if not future.done():
+                        future.set_exception(error)
+
+
+class BMDDeckLink:
+    """
+    RAII wrapper for DeckLink device management.
+
+    This class provides Resource Acquisition Is Initialization (RAII) semantics
+    for DeckLink devices, ensuring proper cleanup when the object is destroyed.
+    The device is opened on initialization and automatically closed on destruction.
+
+    Parameters
+    ----------
+    device_index : int, optional
+        Index of the DeckLink device to open. Default is 0.
+        MOCK_DEVICE_INDEX opens the native mock output instead.
+
+    Attributes
+    ----------
+    handle : ctypes.c_void_p or None
+        Handle to the opened DeckLink device
+    device_index : int
+        Index of the device that was opened
+    _output_started : bool
+        Internal flag tracking output state
+
+    Examples
+    --------
+    Context manager usage (recommended):
+
+    >>> with BMDDeckLink(device_index=0) as device:
+    ...     device.start_playback()
+    ...     # Device automatically closed when exiting the with block
+
+    Basic usage with automatic cleanup:
+
+    >>> device = BMDDeckLink(device_index=0)
+    >>> device.start_playback()
+    >>> # Device automatically closed when object goes out of scope
+
+    Manual cleanup if needed:
+
+    >>> device = BMDDeckLink(device_index=0)
+    >>> device.start_playback()
+    >>> device.close()  # Explicit cleanup
+
+    Raises
+    ------
+    RuntimeError
+        If no DeckLink device is found at the specified index
+
+    Notes
+    -----
+    The device is automatically closed when the object is destroyed via __del__.
+    For guaranteed cleanup timing, use the close() method explicitly.
+    """
+
+    def __init__(self, device_index: int = 0) -> None:
+        self.device_index = device_index
+        self.handle = DecklinkSDKWrapper.decklink_open_output_by_index(device_index)
+        if not self.handle:
+            raise RuntimeError(
+                f"No DeckLink output device found at index {device_index}"
+            )
+        self.started = False
+        self._completion_waiter: FrameCompletionWaiter | None = None
+
+    def __del__(self) -> None:
+        """Destructor - automatically close device on object destruction."""
+        self.close()
+
+    def __enter__(self) -> Self:
+        """
+        Enter the context manager.
+
+        Returns
+        -------
+        Self
+            The BMDDeckLink instance for use in the with statement
+
+        Examples
+        --------
+        >>> with BMDDeckLink(0) as device:
+        ...     device.start_playback()
+        ...     # Device automatically closed when exiting the with block
+        """
+        return self
+
+    def __exit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc_val: BaseException | None,
+        exc_tb: Any | None,
+    ) -> None:
+        """
+        Exit the context manager and close the device.
+
+        Parameters
+        ----------
+        exc_type : type[BaseException] | None
+            Exception type if an exception occurred, None otherwise
+        exc_val : BaseException | None
+            Exception value if an exception occurred, None otherwise
+        exc_tb : Any | None
+            Exception traceback if an exception occurred, None otherwise
+
+        Notes
+        -----
+        The device is automatically closed regardless of whether an exception
+        occurred within the with block.
+        """
+        self.close()
+
+    def close(self) -> None:
+        """
+        Close the device and free resources.
+
+        This method is idempotent - it can be called multiple times safely.
+        After calling close(), the device cannot be used for further operations.
+
+        Notes
+        -----
+        This method is automatically called when the object is destroyed.
+        """
+        if self.handle:
+            if self.started:
+                self.stop_playback()
+            self.disable_completion_events()
+            DecklinkSDKWrapper.decklink_close(self.handle)
+            self.handle = None
+
+    @property
+    def is_open(self) -> bool:
+        """
+        Check if the device is currently open.
+
+        Returns
+        -------
+        bool
+            True if the device is open, False otherwise
+        """
+        return self.handle is not None
+
+    def start_playback(self) -> None:
+        """
+        Start playback output to the DeckLink device.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or if starting playback fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self.started:
+            return
+        res = DecklinkSDKWrapper.decklink_start_output(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to start playback output (error {res})")
+        self.started = True
+
+    def stop_playback(self) -> None:
+        """
+        Stop playback output from the DeckLink device.
+
+        This method is idempotent - it can be called multiple times safely.
+        """
+        if not self.handle or not self.started:
+            return
+        DecklinkSDKWrapper.decklink_stop_output(self.handle)
+        self.started = False
+
+    def get_supported_pixel_formats(self) -> list[PixelFormatType]:
+        """
+        Get list of supported pixel format enum values.
+
+        Returns
+        -------
+        list[PixelFormatType]
+            List of supported pixel format enum values
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+
+        Notes
+        -----
+        If a pixel format string cannot be parsed to a known enum value, a warning
+        is printed asking the user to report the unknown format as a GitHub issue.
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+
+        count = DecklinkSDKWrapper.decklink_get_supported_pixel_format_count(
+            self.handle
+        )
+        formats = []
+        for i in range(count):
+            name = ctypes.create_string_buffer(256)
+            if (
+                DecklinkSDKWrapper.decklink_get_supported_pixel_format_name(
+                    self.handle, i, name, 256
+                )
+                == 0
+            ):
+                format_string = name.value.decode("utf-8")
+                try:
+                    # Try to parse the format string to a PixelFormatType enum
+                    # First try direct parsing, then try extracting format codes from parentheses
+                    try:
+                        pixel_format = PixelFormatType.parse(format_string)
+                    except ValueError as e:
+                        # Try to extract format code from strings like "8Bit ARGB (32)" or "12Bit RGB LE ('R12L')"
+                        # Look for format codes in parentheses, both with and without quotes
+                        match = re.search(r"\((?:'([^']+)'|([^)]+))\)", format_string)
+                        if match:
+                            format_code = match.group(1) or match.group(2)
+                            pixel_format = PixelFormatType.parse(format_code)
+                        else:
+                            raise ValueError(
+                                f"Could not extract format code from: {format_string}"
+                            ) from e
+
+                    formats.append(pixel_format)
+                except ValueError:
+                    # Print warning and ask user to report unknown format
+                    print(
+                        f"⚠️  WARNING: Unknown pixel format detected: '{format_string}'"
+                    )
+                    print(
+                        "📝 Please help improve this project by reporting this unknown format:"
+                    )
+                    print(f"   1. Copy this exact string: '{format_string}'")
+                    print(
+                        "   2. Create a new issue at: https://github.com/OpenLEDEval/bmd-signal-gen/issues"
+                    )
+                    print(
+                        "   3. Include your device model and the unknown format string"
+                    )
+                    print("   This format will be skipped for now.")
+                    print()
+        return formats
+
+    def get_capabilities(self) -> list[dict[str, Any]]:
+        """
+        Get every supported display mode and pixel format pair of the output.
+
+        The matrix is probed in the background when the device is opened and
+        cached on disk per device and driver version, so after the first run
+        this does not query the driver at all.
+
+        Returns
+        -------
+        list[dict[str, Any]]
+            One dict per pair with ``display_mode`` (four-character code),
+            ``pixel_format`` (:class:`PixelFormatType`), ``connections``
+            (:class:`VideoConnection` the pair is supported on),
+            ``default_connection`` (supported on the connection output uses),
+            ``width``, ``height`` and ``frame_rate`` in frames per second.
+            Pairs in pixel formats this package does not know are skipped.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the capabilities could not be probed
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        count = DecklinkSDKWrapper.decklink_get_capabilities(self.handle, None, 0)
+        if count < 0:
+            raise RuntimeError(f"Failed to get capabilities (error {count})")
+        entries = (DeckLinkCapability * count)()
+        count = DecklinkSDKWrapper.decklink_get_capabilities(
+            self.handle, entries, count
+        )
+        if count < 0:
+            raise RuntimeError(f"Failed to get capabilities (error {count})")
+        capabilities = []
+        for entry in entries[: min(count, len(entries))]:
+            try:
+                pixel_format = PixelFormatType.parse(entry.pixelFormat)
+            except ValueError:
+                continue
+            capabilities.append(
+                {
+                    "display_mode": entry.displayMode.to_bytes(4, "big").decode(
+                        "ascii", errors="replace"
+                    ),
+                    "pixel_format": pixel_format,
+                    "connections": VideoConnection(entry.connections),
+                    "default_connection": bool(entry.defaultConnection),
+                    "width": entry.width,
+                    "height": entry.height,
+                    "frame_rate": (
+                        entry.timeScale / entry.frameDuration
+                        if entry.frameDuration
+                        else 0.0
+                    ),
+                }
+            )
+        return capabilities
+
+    @property
+    def supports_hdr(self) -> bool:
+        return DecklinkSDKWrapper.decklink_device_supports_hdr(self.handle)
+
+    @property
+    def pixel_format(self) -> PixelFormatType:
+        """
+        Get the current pixel format as a PixelFormatType enum.
+
+        Returns
+        -------
+        PixelFormatType
+            Current pixel format enum value
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        ValueError
+            If the SDK format code cannot be matched to a known PixelFormatType
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        sdk_format_code = DecklinkSDKWrapper.decklink_get_pixel_format(self.handle)
+        return PixelFormatType.parse(sdk_format_code)
+
+    @pixel_format.setter
+    def pixel_format(self, pixel_format_type: PixelFormatType) -> None:
+        """
+        Set the pixel format using a PixelFormatType enum.
+
+        Parameters
+        ----------
+        pixel_format_type : PixelFormatType
+            The pixel format enum to set
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or setting the format fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_set_pixel_format(
+            self.handle, pixel_format_type.sdk_format_code
+        )
+        if res != 0:
+            raise RuntimeError(
+                f"Failed to set pixel format {pixel_format_type.name} (error {res})"
+            )
+
+    def set_hdr_metadata(self, metadata: HDRMetadata) -> None:
+        """
+        Set complete HDR metadata for all future frames.
+
+        Parameters
+        ----------
+        metadata : HDRMetadata
+            HDR metadata structure with complete HDR parameters
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or setting metadata fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_set_hdr_metadata(
+            self.handle, ctypes.byref(metadata)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to set HDR metadata (error {res})")
+
+    def prepare_output_format(
+        self, pixel_format: PixelFormatType, width: int, height: int
+    ) -> None:
+        """
+        Allocate frames for a pixel format before switching to it.
+
+        The next :meth:`switch_output_format` to this format and frame size
+        then takes these frames instead of allocating new ones.
+
+        Parameters
+        ----------
+        pixel_format : PixelFormatType
+            Pixel format that will be switched to
+        width : int
+            Frame width in pixels
+        height : int
+            Frame height in pixels
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, output is not started, or the
+            allocation fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_prepare_output_format(
+            self.handle, pixel_format.sdk_format_code, width, height
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to prepare output format (error {res})")
+
+    def switch_output_format(
+        self,
+        pixel_format: PixelFormatType,
+        hdr_metadata: HDRMetadata | None = None,
+    ) -> dict[str, int]:
+        """
+        Change the pixel format and HDR metadata while output is running.
+
+        A pixel format on the same SDI link (4:2:2 Y'CbCr to 4:2:2, or RGB to
+        4:4:4) and new metadata are applied to the following frames without
+        touching the link, so the sink does not have to lock again. Going
+        between 4:2:2 and 4:4:4 re-enables output but keeps allocated frames
+        and the frame cache. Frames of the previous format are kept, so
+        alternating between two formats only allocates once. Running loopback
+        verification is restarted in the new format.
+
+        Parameters
+        ----------
+        pixel_format : PixelFormatType
+            New pixel format
+        hdr_metadata : HDRMetadata, optional
+            New HDR metadata. Default keeps the current metadata.
+
+        Returns
+        -------
+        dict[str, int]
+            ``elapsed_ns`` (time spent in the switch), ``relinked`` (1 if
+            output was re-enabled) and ``frames_ready`` (1 if no frames had
+            to be allocated)
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, scheduled playback is active, the
+            format is not supported, re-enabling output fails, or the
+            loopback input does not support the new format (output is
+            switched and loopback verification stopped)
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        report = OutputSwitchReport()
+        res = DecklinkSDKWrapper.decklink_switch_output_format(
+            self.handle,
+            pixel_format.sdk_format_code,
+            0,
+            ctypes.byref(hdr_metadata) if hdr_metadata is not None else None,
+            ctypes.byref(report),
+        )
+        if res != 0:
+            raise RuntimeError(
+                f"Failed to switch to pixel format {pixel_format.name} (error {res})"
+            )
+        return {
+            "elapsed_ns": report.elapsedNs,
+            "relinked": report.relinked,
+            "frames_ready": report.framesReady,
+        }
+
+    @property
+    def ycbcr_conversion(self) -> dict[str, Any]:
+        """
+        RGB to Y'CbCr conversion applied when packing 2vuy, v210 and Ay10.
+
+        Returns
+        -------
+        dict[str, Any]
+            ``matrix`` (YCbCrMatrix), ``full_range`` (bool) and
+            ``chroma_filter`` (ChromaFilter)
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        matrix = ctypes.c_int()
+        full_range = ctypes.c_int()
+        chroma_filter = ctypes.c_int()
+        res = DecklinkSDKWrapper.decklink_get_ycbcr_conversion(
+            self.handle,
+            ctypes.byref(matrix),
+            ctypes.byref(full_range),
+            ctypes.byref(chroma_filter),
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get Y'CbCr conversion (error {res})")
+        return {
+            "matrix": YCbCrMatrix(matrix.value),
+            "full_range": bool(full_range.value),
+            "chroma_filter": ChromaFilter(chroma_filter.value),
+        }
+
+    def set_ycbcr_conversion(
+        self,
+        matrix: YCbCrMatrix | int = YCbCrMatrix.AUTO,
+        full_range: bool = False,
+        chroma_filter: ChromaFilter | int = ChromaFilter.COSITED,
+    ) -> None:
+        """
+        Configure conversion of RGB frames for the 4:2:2 formats.
+
+        Frames are expected as full-range RGB at the output bit depth; the
+        native library converts and subsamples them while packing.
+
+        Parameters
+        ----------
+        matrix : YCbCrMatrix or int, optional
+            Conversion matrix, by default YCbCrMatrix.AUTO
+        full_range : bool, optional
+            Produce full-range instead of narrow-range Y'CbCr, by default
+            False
+        chroma_filter : ChromaFilter or int, optional
+            Horizontal chroma subsampling filter, by default
+            ChromaFilter.COSITED
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or setting the conversion fails
+        ValueError
+            If matrix or chroma_filter is not a valid value
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        matrix = YCbCrMatrix(matrix)
+        chroma_filter = ChromaFilter(chroma_filter)
+        res = DecklinkSDKWrapper.decklink_set_ycbcr_conversion(
+            self.handle, int(matrix), int(full_range), int(chroma_filter)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to set Y'CbCr conversion (error {res})")
+
+    def set_color_lut(
+        self,
+        cube: np.ndarray | None = None,
+        shaper: np.ndarray | None = None,
+    ) -> None:
+        """
+        Apply a display-correction LUT to RGB frames while they are packed.
+
+        Values are normalized to 0-1 at the output bit depth. The shaper is
+        applied first and interpolated linearly, then the cube is
+        interpolated tetrahedrally. The LUT covers images, patterns and
+        region updates; frames given as Y'CbCr and library frames are shown
+        unchanged. Calling with neither removes the LUT.
+
+        Parameters
+        ----------
+        cube : np.ndarray, optional
+            3D LUT of shape (N, N, N, 3) indexed ``[r, g, b]``, N from 2 to
+            129
+        shaper : np.ndarray, optional
+            Per-channel 1D LUT of shape (M, 3) on a uniform input grid, M
+            from 2 to 65536
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, the output is busy with a pipeline or
+            sequence, or the LUT is rejected
+        ValueError
+            If cube or shaper has the wrong shape
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        cube_ptr = shaper_ptr = None
+        cube_size = shaper_size = 0
+        if cube is not None:
+            cube = np.asarray(cube)
+            if cube.ndim != 4 or cube.shape[3] != 3 or len(set(cube.shape[:3])) != 1:
+                raise ValueError("cube must have shape (N, N, N, 3)")
+            cube_size = cube.shape[0]
+            # The native layout has red changing fastest, as in .cube files
+            cube = np.ascontiguousarray(cube.transpose(2, 1, 0, 3), dtype=np.float32)
+            cube_ptr = cube.ctypes.data_as(ctypes.POINTER(ctypes.c_float))
+        if shaper is not None:
+            shaper = np.asarray(shaper)
+            if shaper.ndim != 2 or shaper.shape[1] != 3:
+                raise ValueError("shaper must have shape (M, 3)")
+            shaper_size = shaper.shape[0]
+            shaper = np.ascontiguousarray(shaper, dtype=np.float32)
+            shaper_ptr = shaper.ctypes.data_as(ctypes.POINTER(ctypes.c_float))
+        res = DecklinkSDKWrapper.decklink_set_color_lut(
+            self.handle, shaper_ptr, shaper_size, cube_ptr, cube_size
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to set color LUT (error {res})")
+
+    @property
+    def frame_cache_stats(self) -> dict[str, int]:
+        """
+        Hit, miss and size counters of the packed-frame cache.
+
+        Returns
+        -------
+        dict[str, int]
+            ``hits``, ``misses``, ``evictions``, ``entries``, ``bytes`` and
+            ``budget_bytes``
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stats = FrameCacheStats()
+        res = DecklinkSDKWrapper.decklink_get_frame_cache_stats(
+            self.handle, ctypes.byref(stats)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get frame cache stats (error {res})")
+        return {
+            "hits": stats.hits,
+            "misses": stats.misses,
+            "evictions": stats.evictions,
+            "entries": stats.entries,
+            "bytes": stats.bytes,
+            "budget_bytes": stats.budgetBytes,
+        }
+
+    @property
+    def frame_cache_budget(self) -> int:
+        """
+        Memory budget of the packed-frame cache, in bytes.
+
+        Frames whose source, pixel format, display mode and HDR metadata
+        match an earlier frame are displayed from the cache without packing.
+        Setting 0 (the default) disables the cache.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or setting the budget fails
+        """
+        return self.frame_cache_stats["budget_bytes"]
+
+    @frame_cache_budget.setter
+    def frame_cache_budget(self, budget_bytes: int) -> None:
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if budget_bytes < 0:
+            raise ValueError(f"Cache budget must be non-negative, got {budget_bytes}")
+        res = DecklinkSDKWrapper.decklink_set_frame_cache_budget(
+            self.handle, budget_bytes
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to set frame cache budget (error {res})")
+
+    @property
+    def latency_stats(self) -> dict[str, dict[str, float]]:
+        """
+        Latency of each stage of the native frame path.
+
+        Stages are ``set_frame_data``, ``pack``, ``create_frame``,
+        ``apply_hdr_metadata``, ``display_frame_sync`` and ``schedule_frame``.
+        Percentiles come from bucketed histograms and are accurate to within
+        12.5%.
+
+        Returns
+        -------
+        dict[str, dict[str, float]]
+            Per stage: ``count`` and ``p50_us``, ``p99_us``, ``max_us`` and
+            ``mean_us`` in microseconds
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stats = DeckLinkStats()
+        res = DecklinkSDKWrapper.decklink_get_stats(self.handle, ctypes.byref(stats))
+        if res != 0:
+            raise RuntimeError(f"Failed to get latency stats (error {res})")
+        return {
+            name: _stage_latency_dict(getattr(stats, field))
+            for name, field in _LATENCY_STAGES
+        }
+
+    def reset_latency_stats(self) -> None:
+        """
+        Clear the latency histograms of every stage.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the reset fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_reset_stats(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to reset latency stats (error {res})")
+
+    def read_frame_telemetry(self, max_samples: int = 256) -> list[dict[str, int]]:
+        """
+        Read the oldest pending frame telemetry samples.
+
+        Every frame that is displayed or scheduled leaves a sample with its
+        submit and scanout times on the device's hardware reference clock,
+        which Python and logging do not disturb. The newest 4096 samples are
+        kept until read.
+
+        Parameters
+        ----------
+        max_samples : int, optional
+            Most samples to read. Default is 256.
+
+        Returns
+        -------
+        list[dict[str, int]]
+            ``frame_number`` (-1 for synchronous displays), ``result`` and, in
+            nanoseconds, ``submit_ns``, ``scanout_ns``, ``completion_ns``,
+            ``stream_time_ns``, ``queue_lead_ns``, ``latency_ns``,
+            ``interval_ns`` and ``frame_duration_ns`` of each sample, oldest
+            first; empty if none are pending
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or reading fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        samples = (FrameTelemetrySample * max_samples)()
+        count = DecklinkSDKWrapper.decklink_read_frame_telemetry(
+            self.handle, samples, max_samples
+        )
+        if count < 0:
+            raise RuntimeError(f"Failed to read frame telemetry (error {count})")
+        return [
+            {
+                "frame_number": sample.frameNumber,
+                "submit_ns": sample.submitTimestamp,
+                "scanout_ns": sample.scanoutTimestamp,
+                "completion_ns": sample.completionTimestamp,
+                "stream_time_ns": sample.streamTime,
+                "queue_lead_ns": sample.queueLead,
+                "latency_ns": sample.latency,
+                "interval_ns": sample.interval,
+                "frame_duration_ns": sample.frameDuration,
+                "result": sample.result,
+            }
+            for sample in samples[:count]
+        ]
+
+    @property
+    def frame_telemetry(self) -> dict[str, Any]:
+        """
+        Hardware-timed output latency and frame timing.
+
+        ``submit_to_scanout`` runs from handing a frame to the driver until
+        its scanout starts. ``scanout_jitter`` is how far the interval between
+        the scanouts of consecutive frames deviates from the frame duration;
+        frames after a pause by the caller are not counted.
+
+        Returns
+        -------
+        dict[str, Any]
+            ``displayed_frames``, ``late_frames``, ``dropped_frames``,
+            ``flushed_frames``, ``pending_samples`` and ``samples_dropped``,
+            plus ``submit_to_scanout`` and ``scanout_jitter`` in the form of
+            :attr:`latency_stats` stages
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stats = FrameTelemetryStats()
+        res = DecklinkSDKWrapper.decklink_get_frame_telemetry(
+            self.handle, ctypes.byref(stats)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get frame telemetry (error {res})")
+        return {
+            "displayed_frames": stats.displayedFrames,
+            "late_frames": stats.lateFrames,
+            "dropped_frames": stats.droppedFrames,
+            "flushed_frames": stats.flushedFrames,
+            "pending_samples": stats.pendingSamples,
+            "samples_dropped": stats.samplesDropped,
+            "submit_to_scanout": _stage_latency_dict(stats.submitToScanout),
+            "scanout_jitter": _stage_latency_dict(stats.scanoutJitter),
+        }
+
+    def reset_frame_telemetry(self) -> None:
+        """
+        Clear the frame telemetry samples and summary.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the reset fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_reset_frame_telemetry(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to reset frame telemetry (error {res})")
+
+    def start_loopback(self, input_device_index: int) -> None:
+        """
+        Verify this output continuously against its capture on an input.
+
+        The input of ``input_device_index`` is opened in the output's display
+        mode and pixel format. Every frame displayed or scheduled from now on
+        is kept as a reference, and a background thread matches each captured
+        frame with the frame it was generated from, reporting it as bit-exact
+        or with its largest error per channel. Call again after changing the
+        display mode or pixel format; :meth:`stop_output` stops verification.
+
+        Parameters
+        ----------
+        input_device_index : int
+            Index of the device whose input the output is looped back into;
+            may be this device
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, output is not enabled, the device has
+            no input or the input does not support the output's mode
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_start_loopback(
+            self.handle, input_device_index
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to start loopback verification (error {res})")
+
+    def stop_loopback(self) -> None:
+        """
+        Stop loopback verification; results stay readable.
+
+        This method is idempotent - it can be called multiple times safely.
+        """
+        if self.handle:
+            DecklinkSDKWrapper.decklink_stop_loopback(self.handle)
+
+    def read_loopback_results(self, max_results: int = 256) -> list[dict[str, Any]]:
+        """
+        Read the oldest pending loopback verification results.
+
+        The newest 1024 results are kept until read.
+
+        Parameters
+        ----------
+        max_results : int, optional
+            Most results to read. Default is 256.
+
+        Returns
+        -------
+        list[dict[str, Any]]
+            ``capture_number``, ``reference_number`` (-1 if none),
+            ``status`` as :class:`LoopbackStatus`, ``max_error`` per channel
+            (R, G, B or Y, Cb, Cr), ``mismatched_samples``,
+            ``mismatched_rows``, ``capture_ns`` and ``compare_ns`` of each
+            capture, oldest first; empty if none are pending
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or reading fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        results = (LoopbackResult * max_results)()
+        count = DecklinkSDKWrapper.decklink_read_loopback_results(
+            self.handle, results, max_results
+        )
+        if count < 0:
+            raise RuntimeError(f"Failed to read loopback results (error {count})")
+        return [
+            {
+                "capture_number": result.captureNumber,
+                "reference_number": result.referenceNumber,
+                "status": LoopbackStatus(result.status),
+                "max_error": tuple(result.maxError),
+                "mismatched_samples": result.mismatchedSamples,
+                "mismatched_rows": result.mismatchedRows,
+                "capture_ns": result.captureTimestamp,
+                "compare_ns": result.compareDuration,
+            }
+            for result in results[:count]
+        ]
+
+    @property
+    def loopback_stats(self) -> dict[str, Any]:
+        """
+        Loopback verification counts since it started or was last reset.
+
+        Returns
+        -------
+        dict[str, Any]
+            ``captured_frames``, ``matched_frames``, ``mismatched_frames``,
+            ``uncompared_frames``, ``skipped_frames``, ``pending_results``,
+            ``results_dropped``, the worst ``max_error`` per channel,
+            ``running``, ``last_status`` (None before the first result), plus
+            ``compare`` and ``reference_copy`` in the form of
+            :attr:`latency_stats` stages
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stats = LoopbackStats()
+        res = DecklinkSDKWrapper.decklink_get_loopback_stats(
+            self.handle, ctypes.byref(stats)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get loopback stats (error {res})")
+        return {
+            "captured_frames": stats.capturedFrames,
+            "matched_frames": stats.matchedFrames,
+            "mismatched_frames": stats.mismatchedFrames,
+            "uncompared_frames": stats.uncomparedFrames,
+            "skipped_frames": stats.skippedFrames,
+            "pending_results": stats.pendingResults,
+            "results_dropped": stats.resultsDropped,
+            "max_error": tuple(stats.maxError),
+            "running": bool(stats.running),
+            "last_status": (
+                LoopbackStatus(stats.lastStatus) if stats.lastStatus >= 0 else None
+            ),
+            "compare": _stage_latency_dict(stats.compare),
+            "reference_copy": _stage_latency_dict(stats.referenceCopy),
+        }
+
+    def reset_loopback_stats(self) -> None:
+        """
+        Clear the loopback results and counts.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the reset fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_reset_loopback_stats(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to reset loopback stats (error {res})")
+
+    def _prepare_frame(
+        self,
+        frame_data: np.ndarray,
+        region: tuple[int, int, int, int] | None = None,
+    ) -> None:
+        """
+        Pack frame data into the next output frame.
+
+        The array is packed in place by the native library. It is only
+        copied here if it is not already a C-contiguous ``uint16`` array.
+
+        Parameters
+        ----------
+        frame_data : numpy.ndarray
+            Frame data with shape (height, width, channels) or (height, width)
+        region : tuple of int, optional
+            ``(x, y, width, height)`` of the only area that changed since the
+            previous frame, which is then all that gets repacked
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or any frame operation fails
+        ValueError
+            If frame_data is not a valid numpy array
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+
+        frame_data = np.ascontiguousarray(frame_data, dtype=np.uint16)
+
+        data_ptr, height, width = ndarray_to_bmd_frame_buffer(frame_data)
+        if region is not None:
+            x, y, region_width, region_height = region
+            res = DecklinkSDKWrapper.decklink_update_frame_region(
+                self.handle, data_ptr, width, height, x, y, region_width, region_height
+            )
+        else:
+            res = DecklinkSDKWrapper.decklink_create_frame_from_buffer(
+                self.handle, data_ptr, width, height
+            )
+        if res != 0:
+            raise RuntimeError(f"Failed to create frame (error {res})")
+
+    def _create_frame(self) -> None:
+        """Pack the pending frame data into the next output frame."""
+        res = DecklinkSDKWrapper.decklink_create_frame_from_data(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to create frame (error {res})")
+
+    def _display_created_frame(self) -> None:
+        """Show the frame built by :meth:`_create_frame` synchronously."""
+        res = DecklinkSDKWrapper.decklink_display_frame_sync(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to display frame synchronously (error {res})")
+
+    def display_frame(
+        self,
+        frame_data: np.ndarray,
+        *,
+        region: tuple[int, int, int, int] | None = None,
+    ) -> None:
+        """
+        Display a single frame synchronously.
+
+        Parameters
+        ----------
+        frame_data : numpy.ndarray
+            Frame data with shape (height, width, channels) or (height, width)
+        region : tuple of int, optional
+            ``(x, y, width, height)`` of the only area where frame_data
+            differs from the previous frame. The previous packed frame is then
+            reused and only this rectangle is repacked, which is much cheaper
+            for small patches. Pixels outside it are not read, so they must
+            match the previous frame. Falls back to a full pack when there is
+            no reusable previous frame.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, scheduled playback is active, or any
+            frame operation fails
+        ValueError
+            If frame_data is not a valid numpy array
+
+        Notes
+        -----
+        With the native binding the frame is packed and displayed in one
+        call that releases the GIL, so other threads keep running while
+        this one waits for the hardware.
+        """
+        if not _native_frame_call("display_frame", self.handle, frame_data, region):
+            self._prepare_frame(frame_data, region)
+            self._display_created_frame()
+
+    @contextlib.contextmanager
+    def frame_buffer(
+        self, width: int, height: int, *, schedule: bool = False
+    ) -> Iterator[np.ndarray]:
+        """
+        Write packed pixels directly into an output frame.
+
+        Yields a writable ``uint8`` view of shape ``(height, row_bytes)`` over
+        the mapped buffer of a pooled frame, laid out in the current pixel
+        format (for example big-endian words for r210). Nothing is packed or
+        copied by the wrapper. When the block exits normally the frame is
+        displayed, or queued if ``schedule`` is true.
+
+        Parameters
+        ----------
+        width : int
+            Frame width in pixels
+        height : int
+            Frame height in pixels
+        schedule : bool, optional
+            Queue the frame for scheduled playback instead of displaying it
+            synchronously. Default is False.
+
+        Yields
+        ------
+        numpy.ndarray
+            View over the frame buffer, valid only inside the ``with`` block
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or any frame operation fails
+
+        Examples
+        --------
+        >>> with device.frame_buffer(1920, 1080) as buffer:
+        ...     buffer[:] = packed_r210_rows
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        data = ctypes.c_void_p()
+        row_bytes = ctypes.c_int()
+        res = DecklinkSDKWrapper.decklink_begin_frame_write(
+            self.handle, width, height, ctypes.byref(data), ctypes.byref(row_bytes)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to map frame buffer (error {res})")
+
+        size = row_bytes.value * height
+        buffer = (ctypes.c_uint8 * size).from_address(data.value)
+        view = np.frombuffer(buffer, dtype=np.uint8).reshape(height, row_bytes.value)
+        try:
+            yield view
+        finally:
+            # Drop the view before the mapping goes away
+            del view, buffer
+            res = DecklinkSDKWrapper.decklink_end_frame_write(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to finish frame buffer (error {res})")
+
+        if schedule:
+            res = DecklinkSDKWrapper.decklink_schedule_frame_for_output(self.handle)
+            if res != 0:
+                raise RuntimeError(f"Failed to schedule frame (error {res})")
+        else:
+            self._display_created_frame()
+
+    def display_library_frame(
+        self, library: "BMDFrameLibrary", frame: int | str, *, schedule: bool = False
+    ) -> None:
+        """
+        Display a pre-packed frame from a frame library.
+
+        The packed pixels are copied from the mapped file into an output
+        frame, with no generation or packing. The HDR metadata stored with
+        the frame becomes the device's metadata.
+
+        Parameters
+        ----------
+        library : BMDFrameLibrary
+            Open frame library
+        frame : int or str
+            Index or name of the frame
+        schedule : bool, optional
+            Queue the frame for scheduled playback instead of displaying it
+            synchronously. Default is False.
+
+        Raises
+        ------
+        RuntimeError
+            If the device or library is not open, the frame was packed in
+            another pixel format than the current one, or any frame
+            operation fails
+        KeyError
+            If no frame has the given name
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if not library.handle:
+            raise RuntimeError("Frame library not open")
+        index = library.index(frame) if isinstance(frame, str) else frame
+        res = DecklinkSDKWrapper.decklink_load_library_frame(
+            self.handle, library.handle, index
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to load library frame {frame} (error {res})")
+
+        if schedule:
+            res = DecklinkSDKWrapper.decklink_schedule_frame_for_output(self.handle)
+            if res != 0:
+                raise RuntimeError(f"Failed to schedule frame (error {res})")
+        else:
+            self._display_created_frame()
+
+    def display_solid_color(self, color: Any, width: int, height: int) -> None:
+        """
+        Display a frame of one color without uploading a full image.
+
+        The color is packed once per row layout in the native library, so no
+        width x height x 3 array is built or copied.
+
+        Parameters
+        ----------
+        color : ArrayLike
+            RGB color with shape (3,), in the bit depth of the pixel format
+        width : int
+            Frame width in pixels
+        height : int
+            Frame height in pixels
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or any frame operation fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        rgb = (ctypes.c_uint16 * 3)(*(int(v) for v in np.asarray(color).reshape(3)))
+        res = DecklinkSDKWrapper.decklink_set_solid_color(
+            self.handle, width, height, rgb
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to set solid color (error {res})")
+        self._create_frame()
+        self._display_created_frame()
+
+    def display_rect_pattern(
+        self,
+        width: int,
+        height: int,
+        rects: list[tuple[int, int, int, int, Any]],
+        background: Any = (0, 0, 0),
+    ) -> None:
+        """
+        Display a pattern of flat or checkerboard rectangles.
+
+        Each distinct row of the pattern is packed once in the native library
+        and copied to the other rows that match it, so no full image is
+        uploaded.
+
+        Parameters
+        ----------
+        width : int
+            Frame width in pixels
+        height : int
+            Frame height in pixels
+        rects : list of tuple
+            ``(x, y, width, height, colors)`` rectangles drawn in order over
+            the background, as returned by ``PatternGenerator.generate_rects``.
+            See :class:`PatternRect` for the color layout.
+        background : ArrayLike, optional
+            RGB color outside every rectangle. Default is black.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or any frame operation fails
+
+        Examples
+        --------
+        >>> generator = PatternGenerator(bit_depth=12, width=3840, height=2160)
+        >>> rects = generator.generate_rects([[4095, 4095, 4095], [0, 0, 0]])
+        >>> device.display_rect_pattern(3840, 2160, rects)
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        rgb = (ctypes.c_uint16 * 3)(*(int(v) for v in np.asarray(background).reshape(3)))
+        rect_array = (PatternRect * max(len(rects), 1))(
+            *(PatternRect(*rect) for rect in rects)
+        )
+        res = DecklinkSDKWrapper.decklink_set_rect_pattern(
+            self.handle, width, height, rgb, rect_array, len(rects)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to set rect pattern (error {res})")
+        self._create_frame()
+        self._display_created_frame()
+
+    def _display_generated_pattern(
+        self, width: int, height: int, pattern: GeneratedPattern
+    ) -> None:
+        """Pack a generated pattern natively and show it synchronously."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_set_generated_pattern(
+            self.handle, width, height, ctypes.byref(pattern)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to set generated pattern (error {res})")
+        self._create_frame()
+        self._display_created_frame()
+
+    def display_ramp(
+        self,
+        width: int,
+        height: int,
+        start: Any,
+        end: Any,
+        *,
+        vertical: bool = False,
+        steps: int = 0,
+    ) -> None:
+        """
+        Display a ramp or stepped gradient computed in the native library.
+
+        Rows are computed while they are packed, so no image is built or
+        uploaded. A continuous ramp as wide as the number of codes of a 10- or
+        12-bit format shows every code once.
+
+        Parameters
+        ----------
+        width : int
+            Frame width in pixels
+        height : int
+            Frame height in pixels
+        start : ArrayLike
+            RGB color at the left (or top) edge, in the bit depth of the
+            pixel format
+        end : ArrayLike
+            RGB color at the right (or bottom) edge
+        vertical : bool, optional
+            Run the ramp from top to bottom instead of left to right
+        steps : int, optional
+            Number of flat steps from ``start`` to ``end``; 0 or 1 for a
+            continuous ramp
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or any frame operation fails
+
+        Examples
+        --------
+        >>> device.display_ramp(4096, 2160, (0, 0, 0), (4095, 4095, 4095))
+        >>> device.display_ramp(3840, 2160, (0, 0, 0), (1023, 0, 0), steps=16)
+        """
+        pattern = GeneratedPattern(
+            GeneratedPattern.VERTICAL_RAMP
+            if vertical
+            else GeneratedPattern.HORIZONTAL_RAMP,
+            steps,
+        )
+        pattern.start_color[:] = [int(v) for v in np.asarray(start).reshape(3)]
+        pattern.end_color[:] = [int(v) for v in np.asarray(end).reshape(3)]
+        self._display_generated_pattern(width, height, pattern)
+
+    def display_zone_plate(
+        self,
+        width: int,
+        height: int,
+        low: Any,
+        high: Any,
+        frequency: float = 1.0,
+    ) -> None:
+        """
+        Display a circular zone plate computed in the native library.
+
+        Parameters
+        ----------
+        width : int
+            Frame width in pixels
+        height : int
+            Frame height in pixels
+        low : ArrayLike
+            RGB color of the troughs, in the bit depth of the pixel format
+        high : ArrayLike
+            RGB color of the crests, including the center
+        frequency : float, optional
+            Spatial frequency scale. At 1 the rings reach the Nyquist limit at
+            the left and right edges. Default is 1.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or any frame operation fails
+        """
+        pattern = GeneratedPattern(GeneratedPattern.ZONE_PLATE, 0)
+        pattern.start_color[:] = [int(v) for v in np.asarray(low).reshape(3)]
+        pattern.end_color[:] = [int(v) for v in np.asarray(high).reshape(3)]
+        pattern.frequency = frequency
+        self._display_generated_pattern(width, height, pattern)
+
+    def schedule_frame(self, frame_data: np.ndarray) -> None:
+        """
+        Queue a frame for scheduled playback.
+
+        Each frame is shown for one frame period, directly after the
+        previously queued frame. Frames queued before
+        :meth:`start_scheduled_playback` preroll the output ring.
+
+        Parameters
+        ----------
+        frame_data : numpy.ndarray
+            Frame data with shape (height, width, channels) or (height, width)
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or any frame operation fails
+        ValueError
+            If frame_data is not a valid numpy array
+
+        Examples
+        --------
+        Preroll two frames, then alternate at the full output rate:
+
+        >>> device.schedule_frame(white)
+        >>> device.schedule_frame(black)
+        >>> device.start_scheduled_playback()
+        >>> for _ in range(100):
+        ...     device.schedule_frame(white)
+        ...     device.schedule_frame(black)
+        >>> device.stop_scheduled_playback()
+
+        Notes
+        -----
+        Blocks while every pooled frame is queued on the hardware, which
+        paces the caller to the output frame rate.
+        """
+        if _native_frame_call("schedule_frame", self.handle, frame_data):
+            return
+        self._prepare_frame(frame_data)
+
+        res = DecklinkSDKWrapper.decklink_schedule_frame_for_output(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to schedule frame (error {res})")
+
+    def start_scheduled_playback(self) -> None:
+        """
+        Start scheduled playback of queued frames.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or starting playback fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_start_scheduled_playback(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to start scheduled playback (error {res})")
+
+    def stop_scheduled_playback(self) -> None:
+        """
+        Stop scheduled playback and return to synchronous display.
+
+        This method is idempotent - it can be called multiple times safely.
+        """
+        if not self.handle:
+            return
+        DecklinkSDKWrapper.decklink_stop_scheduled_playback(self.handle)
+
+    @property
+    def buffered_frame_count(self) -> int:
+        """
+        Get the number of frames queued on the hardware.
+
+        Returns
+        -------
+        int
+            Frames scheduled but not yet output
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the query fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        count = DecklinkSDKWrapper.decklink_get_buffered_frame_count(self.handle)
+        if count < 0:
+            raise RuntimeError(f"Failed to query buffered frames (error {count})")
+        return count
+
+    def start_frame_pipeline(self) -> None:
+        """
+        Pack and display frames on library threads.
+
+        Afterwards :meth:`submit_frame` queues frames, and the native library
+        packs each one while the previous one is being displayed. Other frame
+        calls and pixel format, display mode, HDR and Y'CbCr changes fail
+        until :meth:`stop_frame_pipeline`.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, output is not started or scheduled
+            playback is active
+
+        Examples
+        --------
+        >>> device.start_frame_pipeline()
+        >>> for frame in frames:
+        ...     device.submit_frame(frame)
+        >>> device.flush_frame_pipeline()
+        >>> device.stop_frame_pipeline()
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_start_frame_pipeline(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to start frame pipeline (error {res})")
+
+    def stop_frame_pipeline(self) -> None:
+        """
+        Stop the frame pipeline, dropping frames not yet displayed.
+
+        This method is idempotent - it can be called multiple times safely.
+        """
+        if not self.handle:
+            return
+        DecklinkSDKWrapper.decklink_stop_frame_pipeline(self.handle)
+
+    def submit_frame(self, frame_data: np.ndarray) -> None:
+        """
+        Queue a frame for the frame pipeline.
+
+        The frame is copied, so the array may be reused right away.
+
+        Parameters
+        ----------
+        frame_data : numpy.ndarray
+            Frame data with shape (height, width, channels) or (height, width),
+            the same size for every frame since the pipeline started
+
+        Raises
+        ------
+        RuntimeError
+            If the pipeline is not running, the frame size changed or no
+            slot freed up in time
+
+        Notes
+        -----
+        Blocks while both source slots are queued, which paces the caller to
+        the output frame rate.
+        """
+        if _native_frame_call("submit_frame", self.handle, frame_data):
+            return
+        if not self.handle:
+            raise RuntimeError("Device not open")
+
+        frame_data = np.ascontiguousarray(frame_data, dtype=np.uint16)
+
+        data_ptr, height, width = ndarray_to_bmd_frame_buffer(frame_data)
+        res = DecklinkSDKWrapper.decklink_submit_frame(
+            self.handle, data_ptr, width, height
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to submit frame (error {res})")
+
+    def flush_frame_pipeline(self) -> None:
+        """
+        Wait until every submitted frame has been displayed.
+
+        Raises
+        ------
+        RuntimeError
+            If the pipeline is not running or does not drain in time
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_flush_frame_pipeline(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to flush frame pipeline (error {res})")
+
+    @property
+    def frame_pipeline_stats(self) -> dict[str, int]:
+        """
+        Counters and queue depths of the running frame pipeline.
+
+        Returns
+        -------
+        dict[str, int]
+            ``submitted``, ``displayed``, ``failed``, ``producer_stalls``,
+            ``source_depth``, ``frame_depth``, ``capacity`` and
+            ``last_error``
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the pipeline is not running
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stats = FramePipelineStats()
+        res = DecklinkSDKWrapper.decklink_get_frame_pipeline_stats(
+            self.handle, ctypes.byref(stats)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get frame pipeline stats (error {res})")
+        return {
+            "submitted": stats.submitted,
+            "displayed": stats.displayed,
+            "failed": stats.failed,
+            "producer_stalls": stats.producerStalls,
+            "source_depth": stats.sourceDepth,
+            "frame_depth": stats.frameDepth,
+            "capacity": stats.capacity,
+            "last_error": stats.lastError,
+        }
+
+    def load_sequence(
+        self, width: int, height: int, patches: list[tuple[Any, int]]
+    ) -> None:
+        """
+        Upload a list of patches for :meth:`start_sequence`.
+
+        Parameters
+        ----------
+        width : int
+            Frame width in pixels
+        height : int
+            Frame height in pixels
+        patches : list of tuple
+            ``(content, dwell_frames)`` pairs. ``content`` is an RGB color
+            with shape (3,) for a solid patch or an image with shape
+            (height, width, 3). ``dwell_frames`` is how many frames the patch
+            stays on screen.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, a patch is invalid or a sequence is
+            playing
+
+        Notes
+        -----
+        Images are copied by the native library, and nothing is packed until
+        the sequence plays, so the pixel format and settings at
+        :meth:`start_sequence` apply.
+
+        Examples
+        --------
+        >>> patches = [([v, v, v], 30) for v in range(0, 4096, 256)]
+        >>> device.load_sequence(3840, 2160, patches)
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+
+        patch_array = (SequencePatch * max(len(patches), 1))()
+        images = []
+        for patch, (content, dwell_frames) in zip(patch_array, patches):
+            content = np.asarray(content)
+            if content.ndim == 1:
+                patch.rgb[:] = [int(v) for v in content.reshape(3)]
+            else:
+                image = np.ascontiguousarray(content, dtype=np.uint16)
+                if image.shape != (height, width, 3):
+                    raise RuntimeError(
+                        f"Patch image shape {image.shape} does not match "
+                        f"{(height, width, 3)}"
+                    )
+                # Kept alive until the native library has copied it
+                images.append(image)
+                patch.image = image.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16))
+            patch.dwellFrames = int(dwell_frames)
+
+        res = DecklinkSDKWrapper.decklink_load_sequence(
+            self.handle, width, height, patch_array, len(patches)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to load sequence (error {res})")
+
+    def start_sequence(self, loop: bool = False) -> None:
+        """
+        Play the uploaded sequence on scheduled frame timing.
+
+        The native library packs each patch once and keeps the hardware queue
+        filled on its own, so no Python code runs per patch. Use
+        :meth:`wait_sequence_event` to follow the patches as they complete.
+        Other frame calls and format, mode, HDR or Y'CbCr changes fail until
+        the last patch has completed or :meth:`stop_sequence` is called.
+
+        Parameters
+        ----------
+        loop : bool, optional
+            Start over with the first patch after the last one. Default is
+            False.
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, no sequence is loaded or scheduled
+            playback is already active
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        res = DecklinkSDKWrapper.decklink_start_sequence(self.handle, int(loop))
+        if res != 0:
+            raise RuntimeError(f"Failed to start sequence (error {res})")
+
+    def stop_sequence(self) -> None:
+        """
+        Stop the sequence and scheduled playback.
+
+        This method is idempotent - it can be called multiple times safely.
+        """
+        if not self.handle:
+            return
+        DecklinkSDKWrapper.decklink_stop_sequence(self.handle)
+
+    def wait_sequence_event(self, timeout: float = 1.0) -> dict[str, int] | None:
+        """
+        Wait for the next patch of the playing sequence to complete.
+
+        Parameters
+        ----------
+        timeout : float, optional
+            Seconds to wait. Default is 1.0.
+
+        Returns
+        -------
+        dict[str, int] or None
+            ``patch_index``, ``pass``, ``start_time``, ``end_time``,
+            ``time_scale``, ``completion_timestamp_ns`` and ``result`` of the
+            oldest unread event, or None on timeout or once the sequence has
+            ended and every event was read
+
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
 
-    Returns
-    -------
-    str
-        The version string of the installed DeckLink driver.
+        Examples
+        --------
+        >>> device.start_sequence()
+        >>> while (event := device.wait_sequence_event()) is not None:
+        ...     meter.read(event["patch_index"])
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        event = SequenceEvent()
+        res = DecklinkSDKWrapper.decklink_wait_sequence_event(
+            self.handle, ctypes.byref(event), int(timeout * 1000)
+        )
+        if res != 0:
+            return None
+        return {
+            "patch_index": event.patchIndex,
+            "pass": event.pass_,
+            "start_time": event.startTime,
+            "end_time": event.endTime,
+            "time_scale": event.timeScale,
+            "completion_timestamp_ns": event.completionTimestamp,
+            "result": event.result,
+        }
 
-    Examples
-    --------
-    >>> version = get_decklink_driver_version()
-    >>> print(f"Driver version: {version}")
-    Driver version: 12.8.1
+    @property
+    def sequence_status(self) -> dict[str, int]:
+        """
+        Playback state of the uploaded sequence.
 
-    Notes
-    -----
-    Requires DeckLink Desktop Video drivers to be installed.
-    """
-    return DecklinkSDKWrapper.decklink_get_driver_version().decode("utf-8")
+        Returns
+        -------
+        dict[str, int]
+            ``running``, ``patch_count``, ``completed_patches``,
+            ``queued_frames``, ``late_frames``, ``dropped_frames``,
+            ``events_dropped`` and ``last_error``
 
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        status = SequenceStatus()
+        res = DecklinkSDKWrapper.decklink_get_sequence_status(
+            self.handle, ctypes.byref(status)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get sequence status (error {res})")
+        return {
+            "running": status.running,
+            "patch_count": status.patchCount,
+            "completed_patches": status.completedPatches,
+            "queued_frames": status.queuedFrames,
+            "late_frames": status.lateFrames,
+            "dropped_frames": status.droppedFrames,
+            "events_dropped": status.eventsDropped,
+            "last_error": status.lastError,
+        }
+
+    def enable_completion_events(self) -> int:
+        """
+        Report completions of scheduled frames on a pollable descriptor.
 
-def get_decklink_sdk_version() -> str:
-    """
-    Get the DeckLink SDK version string.
+        Every frame scheduled afterwards, by :meth:`schedule_frame`, a group
+        or a patch sequence, produces one event once it has been shown and
+        replaced on screen. The descriptor is readable while events are
+        pending, so an event loop can watch it; :meth:`wait_frame_completed`
+        does this for asyncio.
 
-    Returns
-    -------
-    str
-        The version string of the DeckLink SDK library.
+        Returns
+        -------
+        int
+            The descriptor, owned by the library and valid until
+            :meth:`disable_completion_events` or :meth:`close`
 
-    Examples
-    --------
-    >>> version = get_decklink_sdk_version()
-    >>> print(f"SDK version: {version}")
-    SDK version: 14.4.0
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or the descriptor cannot be created
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        fd = DecklinkSDKWrapper.decklink_enable_completion_events(self.handle)
+        if fd < 0:
+            raise RuntimeError(f"Failed to enable completion events (error {fd})")
+        if self._completion_waiter is None:
+            self._completion_waiter = FrameCompletionWaiter(
+                fd, self.read_completion_events
+            )
+        return fd
 
-    Notes
-    -----
-    This returns the version of the compiled libdecklink.dylib library.
-    """
-    return DecklinkSDKWrapper.decklink_get_sdk_version().decode("utf-8")
+    def disable_completion_events(self) -> None:
+        """
+        Close the completion descriptor, failing any pending wait.
 
+        This method is idempotent - it can be called multiple times safely.
+        """
+        if self._completion_waiter is not None:
+            self._completion_waiter.close()
+            self._completion_waiter = None
+        if self.handle:
+            DecklinkSDKWrapper.decklink_disable_completion_events(self.handle)
 
-def ndarray_to_bmd_frame_buffer(
-    frame_data: np.ndarray,
-) -> tuple[Any, int, int]:
-    """
-    Convert numpy array to BMD-compatible frame buffer.
+    def read_completion_events(self, max_events: int = 64) -> list[dict[str, int]]:
+        """
+        Read pending frame completions without waiting.
 
-    Parameters
-    ----------
-    frame_data : numpy.ndarray
-        Frame data with shape (height, width, channels) or (height, width)
+        Parameters
+        ----------
+        max_events : int, optional
+            Most events to read. Default is 64.
 
-    Returns
-    -------
-    tuple[ctypes.POINTER(ctypes.c_uint16), int, int]
-        Tuple containing (data_ptr, width, height)
+        Returns
+        -------
+        list[dict[str, int]]
+            ``frame_number``, ``stream_time``, ``time_scale``,
+            ``completion_timestamp_ns`` and ``result`` of each event, oldest
+            first; empty if none are pending
 
-    Raises
-    ------
-    ValueError
-        If frame_data is not a valid numpy array or has invalid dimensions
-    """
-    if not isinstance(frame_data, np.ndarray):
-        raise ValueError("frame_data must be a numpy array")
+        Raises
+        ------
+        RuntimeError
+            If the device is not open or reading fails
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        events = (FrameCompletionEvent * max_events)()
+        count = DecklinkSDKWrapper.decklink_read_completion_events(
+            self.handle, events, max_events
+        )
+        if count < 0:
+            raise RuntimeError(f"Failed to read completion events (error {count})")
+        return [
+            {
+                "frame_number": event.frameNumber,
+                "stream_time": event.streamTime,
+                "time_scale": event.timeScale,
+                "completion_timestamp_ns": event.completionTimestamp,
+                "result": event.result,
+            }
+            for event in events[:count]
+        ]
 
-    # Get dimensions
-    if frame_data.ndim == 2:
-        height, width = frame_data.shape
-    elif frame_data.ndim == 3:
-        height, width, _ = frame_data.shape
-    else:
-        raise ValueError("frame_data must be 2D or 3D array")
+    @property
+    def completion_status(self) -> dict[str, int]:
+        """
+        State of the frame completion events.
 
-    # Note: frame_data should already be uint16 and contiguous
-    # These conversions are handled in display_frame() before calling this function
+        Returns
+        -------
+        dict[str, int]
+            ``enabled``, ``scheduled_frames``, ``pending_events`` and
+            ``events_dropped``
 
-    # Get pointer to data
-    data_ptr = frame_data.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16))
-    return data_ptr, height, width
+        Raises
+        ------
+        RuntimeError
+            If the device is not open
+        """
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        status = CompletionStatus()
+        res = DecklinkSDKWrapper.decklink_get_completion_status(
+            self.handle, ctypes.byref(status)
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to get completion status (error {res})")
+        return {
+            "enabled": status.enabled,
+            "scheduled_frames": status.scheduledFrames,
+            "pending_events": status.pendingEvents,
+            "events_dropped": status.eventsDropped,
+        }
+
+    async def wait_frame_completed(
+        self, frame_number: int | None = None
+    ) -> dict[str, int]:
+        """
+        Wait on the running event loop until a scheduled frame completed.
 
+        Enables completion events if needed. A frame completes once it has
+        been on screen for its frame period and was replaced, so awaiting
+        the last frame of a patch waits out its dwell without sleeping.
 
-def get_decklink_devices() -> list[str]:
-    """
-    Get list of available DeckLink device names.
+        Parameters
+        ----------
+        frame_number : int, optional
+            Number of the frame, by default the frame scheduled last
 
-    Returns
-    -------
-    list[str]
-        List of device names for all detected DeckLink devices.
-        Returns empty list if no devices are found.
+        Returns
+        -------
+        dict[str, int]
+            The completion event, as returned by
+            :meth:`read_completion_events`; ``result`` tells whether it was
+            displayed on time, late, dropped or flushed
 
-    Examples
-    --------
-    >>> devices = get_decklink_devices()
-    >>> print(f"Found {len(devices)} devices")
-    Found 2 devices
-    >>> for i, device in enumerate(devices):
-    ...     print(f"Device {i}: {device}")
-    Device 0: DeckLink Mini Monitor 4K
-    Device 1: DeckLink Studio 4K
+        Raises
+        ------
+        RuntimeError
+            If the device is not open, nothing was scheduled, or the frame's
+            completion was not reported
 
-    Notes
-    -----
-    Devices are returned in the order they are detected by the system.
-    The index corresponds to the device_index parameter used in BMDDeckLink.
-    """
-    count = DecklinkSDKWrapper.decklink_get_device_count()
-    devices = []
-    for i in range(count):
-        name = ctypes.create_string_buffer(256)
-        if DecklinkSDKWrapper.decklink_get_device_name_by_index(i, name, 256) == 0:
-            devices.append(name.value.decode("utf-8"))
-    return devices
+        Examples
+        --------
+        >>> device.enable_completion_events()
+        >>> device.start_scheduled_playback()
+        >>> device.schedule_frame(patch)
+        >>> event = await device.wait_frame_completed()
+        """
+        self.enable_completion_events()
+        assert self._completion_waiter is not None
+        if frame_number is None:
+            frame_number = self.completion_status["scheduled_frames"] - 1
+            if frame_number < 0:
+                raise RuntimeError("No frame has been scheduled")
+        return await self._completion_waiter.wait(frame_number)
 
 
-class BMDDeckLink:
+class BMDDeckLinkGroup:
     """
-    RAII wrapper for DeckLink device management.
+    Several open DeckLink outputs driven in lockstep.
 
-    This class provides Resource Acquisition Is Initialization (RAII) semantics
-    for DeckLink devices, ensuring proper cleanup when the object is destroyed.
-    The device is opened on initialization and automatically closed on destruction.
+    Each image is packed once per distinct pixel format among the outputs
+    and the packed frame is copied to the others, so driving N outputs of
+    one format costs a single pack. Synchronous display runs on every output
+    at once, and scheduled frames are queued at the same stream time on
+    every output. When the hardware supports DeckLink playback groups the
+    outputs also start scheduled playback on the same hardware frame.
 
     Parameters
     ----------
-    device_index : int, optional
-        Index of the DeckLink device to open. Default is 0.
+    devices : list[BMDDeckLink]
+        Open devices with output started, in any pixel format. Scheduled
+        playback needs the same frame rate on every device.
 
     Attributes
     ----------
     handle : ctypes.c_void_p or None
-        Handle to the opened DeckLink device
-    device_index : int
-        Index of the device that was opened
-    _output_started : bool
-        Internal flag tracking output state
-
-    Examples
-    --------
-    Context manager usage (recommended):
-
-    >>> with BMDDeckLink(device_index=0) as device:
-    ...     device.start_playback()
-    ...     # Device automatically closed when exiting the with block
-
-    Basic usage with automatic cleanup:
-
-    >>> device = BMDDeckLink(device_index=0)
-    >>> device.start_playback()
-    >>> # Device automatically closed when object goes out of scope
-
-    Manual cleanup if needed:
-
-    >>> device = BMDDeckLink(device_index=0)
-    >>> device.start_playback()
-    >>> device.close()  # Explicit cleanup
+        Handle to the native output group
+    devices : list[BMDDeckLink]
+        Member devices, in the order given
 
     Raises
     ------
     RuntimeError
-        If no DeckLink device is found at the specified index
+        If a device is not open or already belongs to another group
+
+    Examples
+    --------
+    >>> with BMDDeckLink(0) as monitor, BMDDeckLink(1) as display:
+    ...     monitor.start_playback()
+    ...     display.start_playback()
+    ...     with BMDDeckLinkGroup([monitor, display]) as group:
+    ...         group.display_frame(image)
 
     Notes
     -----
-    The device is automatically closed when the object is destroyed via __del__.
-    For guaranteed cleanup timing, use the close() method explicitly.
+    The devices stay open when the group is closed. A device that is closed
+    first simply leaves the group.
     """
 
-    def __init__(self, device_index: int = 0) -> None:
-        self.device_index = device_index
-        self.handle = DecklinkSDKWrapper.decklink_open_output_by_index(device_index)
+    def __init__(self, devices: list[BMDDeckLink]) -> None:
+        self.devices = list(devices)
+        self.handle = DecklinkSDKWrapper.decklink_group_create()
         if not self.handle:
-            raise RuntimeError(
-                f"No DeckLink output device found at index {device_index}"
+            raise RuntimeError("Failed to create output group")
+        for device in self.devices:
+            if not device.handle:
+                self.close()
+                raise RuntimeError("Device not open")
+            res = DecklinkSDKWrapper.decklink_group_add_output(
+                self.handle, device.handle
             )
-        self.started = False
+            if res != 0:
+                self.close()
+                raise RuntimeError(f"Failed to add device to group (error {res})")
 
     def __del__(self) -> None:
-        """Destructor - automatically close device on object destruction."""
+        """Destructor - automatically release the group."""
         self.close()
 
     def __enter__(self) -> Self:
-        """
-        Enter the context manager.
-
-        Returns
-        -------
-        Self
-            The BMDDeckLink instance for use in the with statement
-
-        Examples
-        --------
-        >>> with BMDDeckLink(0) as device:
-        ...     device.start_playback()
-        ...     # Device automatically closed when exiting the with block
-        """
+        """Enter the context manager."""
         return self
 
     def __exit__(
@@ -1110,264 +4525,337 @@ class BMDDeckLink:
         exc_val: BaseException | None,
         exc_tb: Any | None,
     ) -> None:
-        """
-        Exit the context manager and close the device.
-
-        Parameters
-        ----------
-        exc_type : type[BaseException] | None
-            Exception type if an exception occurred, None otherwise
-        exc_val : BaseException | None
-            Exception value if an exception occurred, None otherwise
-        exc_tb : Any | None
-            Exception traceback if an exception occurred, None otherwise
-
-        Notes
-        -----
-        The device is automatically closed regardless of whether an exception
-        occurred within the with block.
-        """
+        """Exit the context manager and release the group."""
         self.close()
 
     def close(self) -> None:
         """
-        Close the device and free resources.
+        Release the group, leaving its devices open.
 
         This method is idempotent - it can be called multiple times safely.
-        After calling close(), the device cannot be used for further operations.
+        """
+        if self.handle:
+            DecklinkSDKWrapper.decklink_group_destroy(self.handle)
+            self.handle = None
+
+    def _prepare_frame(self, frame_data: np.ndarray) -> None:
+        """Pack frame data into the next output frame of every device."""
+        if not self.handle:
+            raise RuntimeError("Group not open")
+
+        frame_data = np.ascontiguousarray(frame_data, dtype=np.uint16)
+
+        data_ptr, height, width = ndarray_to_bmd_frame_buffer(frame_data)
+        res = DecklinkSDKWrapper.decklink_group_create_frame_from_buffer(
+            self.handle, data_ptr, width, height
+        )
+        if res != 0:
+            raise RuntimeError(f"Failed to create group frame (error {res})")
+
+    def display_frame(self, frame_data: np.ndarray) -> None:
+        """
+        Display one frame on every device synchronously.
+
+        Parameters
+        ----------
+        frame_data : numpy.ndarray
+            Frame data with shape (height, width, channels) or (height, width)
 
-        Notes
-        -----
-        This method is automatically called when the object is destroyed.
+        Raises
+        ------
+        RuntimeError
+            If the group is closed, scheduled playback is active, or any
+            frame operation fails
         """
-        if self.handle:
-            if self.started:
-                self.stop_playback()
-            DecklinkSDKWrapper.decklink_close(self.handle)
-            self.handle = None
+        if _native_frame_call("group_display_frame", self.handle, frame_data):
+            return
+        self._prepare_frame(frame_data)
+        res = DecklinkSDKWrapper.decklink_group_display_frame_sync(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to display group frame (error {res})")
 
-    @property
-    def is_open(self) -> bool:
+    def schedule_frame(self, frame_data: np.ndarray) -> None:
         """
-        Check if the device is currently open.
+        Queue one frame on every device at the same stream time.
 
-        Returns
-        -------
-        bool
-            True if the device is open, False otherwise
+        Parameters
+        ----------
+        frame_data : numpy.ndarray
+            Frame data with shape (height, width, channels) or (height, width)
+
+        Raises
+        ------
+        RuntimeError
+            If the group is closed, the devices run different frame rates,
+            or any frame operation fails
         """
-        return self.handle is not None
+        if _native_frame_call("group_schedule_frame", self.handle, frame_data):
+            return
+        self._prepare_frame(frame_data)
+        res = DecklinkSDKWrapper.decklink_group_schedule_frame(self.handle)
+        if res != 0:
+            raise RuntimeError(f"Failed to schedule group frame (error {res})")
 
-    def start_playback(self) -> None:
+    def start_scheduled_playback(self) -> None:
         """
-        Start playback output to the DeckLink device.
+        Start scheduled playback on every device together.
 
         Raises
         ------
         RuntimeError
-            If the device is not open or if starting playback fails
+            If the group is closed or starting playback fails
         """
         if not self.handle:
-            raise RuntimeError("Device not open")
-        if self.started:
-            return
-        res = DecklinkSDKWrapper.decklink_start_output(self.handle)
+            raise RuntimeError("Group not open")
+        res = DecklinkSDKWrapper.decklink_group_start_scheduled_playback(self.handle)
         if res != 0:
-            raise RuntimeError(f"Failed to start playback output (error {res})")
-        self.started = True
+            raise RuntimeError(f"Failed to start group playback (error {res})")
 
-    def stop_playback(self) -> None:
+    def stop_scheduled_playback(self) -> None:
         """
-        Stop playback output from the DeckLink device.
+        Stop scheduled playback on every device.
 
         This method is idempotent - it can be called multiple times safely.
         """
-        if not self.handle or not self.started:
+        if not self.handle:
             return
-        DecklinkSDKWrapper.decklink_stop_output(self.handle)
-        self.started = False
+        DecklinkSDKWrapper.decklink_group_stop_scheduled_playback(self.handle)
 
-    def get_supported_pixel_formats(self) -> list[PixelFormatType]:
+    @property
+    def pack_count(self) -> int:
         """
-        Get list of supported pixel format enum values.
+        Get how many frames the last group frame actually packed.
 
         Returns
         -------
-        list[PixelFormatType]
-            List of supported pixel format enum values
+        int
+            Number of distinct pixel formats packed; the other devices
+            received copies
+        """
+        if not self.handle:
+            raise RuntimeError("Group not open")
+        return DecklinkSDKWrapper.decklink_group_get_pack_count(self.handle)
+
+    @property
+    def buffered_frame_counts(self) -> list[int]:
+        """
+        Get the number of frames queued on each device.
+
+        Returns
+        -------
+        list[int]
+            Frames scheduled but not yet output, one per device in group order
 
         Raises
         ------
         RuntimeError
-            If the device is not open
-
-        Notes
-        -----
-        If a pixel format string cannot be parsed to a known enum value, a warning
-        is printed asking the user to report the unknown format as a GitHub issue.
+            If the group is closed or the query fails
         """
         if not self.handle:
-            raise RuntimeError("Device not open")
+            raise RuntimeError("Group not open")
+        capacity = len(self.devices)
+        counts = (ctypes.c_int * max(capacity, 1))()
+        res = DecklinkSDKWrapper.decklink_group_get_buffered_frame_counts(
+            self.handle, counts, capacity
+        )
+        if res < 0:
+            raise RuntimeError(f"Failed to query buffered frames (error {res})")
+        return list(counts[: min(res, capacity)])
 
-        count = DecklinkSDKWrapper.decklink_get_supported_pixel_format_count(
-            self.handle
+
+class BMDFrameLibraryWriter:
+    """
+    Writes frames packed by a device into a frame library file.
+
+    Each :meth:`add_frame` stores the device's current packed frame, as left
+    by ``display_frame`` or ``display_solid_color``, together with its pixel
+    format, layout and HDR metadata. The file is complete once the writer is
+    closed; a writer that is dropped without closing leaves no file.
+
+    Parameters
+    ----------
+    path : str or os.PathLike
+        File to create, replacing an existing one
+
+    Raises
+    ------
+    RuntimeError
+        If the file cannot be created
+
+    Examples
+    --------
+    >>> with BMDFrameLibraryWriter("patches.bmdflib") as writer:
+    ...     for name, image in patches.items():
+    ...         device.display_frame(image)
+    ...         writer.add_frame(device, name)
+    """
+
+    def __init__(self, path: str | os.PathLike[str]) -> None:
+        self.path = os.fspath(path)
+        self.handle = DecklinkSDKWrapper.decklink_library_writer_create(
+            self.path.encode("utf-8")
         )
-        formats = []
-        for i in range(count):
-            name = ctypes.create_string_buffer(256)
-            if (
-                DecklinkSDKWrapper.decklink_get_supported_pixel_format_name(
-                    self.handle, i, name, 256
-                )
-                == 0
-            ):
-                format_string = name.value.decode("utf-8")
-                try:
-                    # Try to parse the format string to a PixelFormatType enum
-                    # First try direct parsing, then try extracting format codes from parentheses
-                    try:
-                        pixel_format = PixelFormatType.parse(format_string)
-                    except ValueError as e:
-                        # Try to extract format code from strings like "8Bit ARGB (32)" or "12Bit RGB LE ('R12L')"
-                        # Look for format codes in parentheses, both with and without quotes
-                        match = re.search(r"\((?:'([^']+)'|([^)]+))\)", format_string)
-                        if match:
-                            format_code = match.group(1) or match.group(2)
-                            pixel_format = PixelFormatType.parse(format_code)
-                        else:
-                            raise ValueError(
-                                f"Could not extract format code from: {format_string}"
-                            ) from e
+        if not self.handle:
+            raise RuntimeError(f"Failed to create frame library {self.path}")
 
-                    formats.append(pixel_format)
-                except ValueError:
-                    # Print warning and ask user to report unknown format
-                    print(
-                        f"⚠️  WARNING: Unknown pixel format detected: '{format_string}'"
-                    )
-                    print(
-                        "📝 Please help improve this project by reporting this unknown format:"
-                    )
-                    print(f"   1. Copy this exact string: '{format_string}'")
-                    print(
-                        "   2. Create a new issue at: https://github.com/OpenLEDEval/bmd-signal-gen/issues"
-                    )
-                    print(
-                        "   3. Include your device model and the unknown format string"
-                    )
-                    print("   This format will be skipped for now.")
-                    print()
-        return formats
+    def __enter__(self) -> Self:
+        """Enter the context manager."""
+        return self
 
-    @property
-    def supports_hdr(self) -> bool:
-        return DecklinkSDKWrapper.decklink_device_supports_hdr(self.handle)
+    def __exit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc_val: BaseException | None,
+        exc_tb: Any | None,
+    ) -> None:
+        """Exit the context manager and finish the file."""
+        self.close()
 
-    @property
-    def pixel_format(self) -> PixelFormatType:
+    def add_frame(self, device: BMDDeckLink, name: str = "") -> int:
         """
-        Get the current pixel format as a PixelFormatType enum.
+        Append the device's current packed frame.
+
+        Parameters
+        ----------
+        device : BMDDeckLink
+            Device with output started and a frame created
+        name : str, optional
+            Label to find the frame by, up to 63 bytes
 
         Returns
         -------
-        PixelFormatType
-            Current pixel format enum value
+        int
+            Index of the frame in the library
 
         Raises
         ------
         RuntimeError
-            If the device is not open
-        ValueError
-            If the SDK format code cannot be matched to a known PixelFormatType
+            If the writer or device is closed, the device has no frame, or
+            writing fails
         """
         if not self.handle:
+            raise RuntimeError("Frame library writer closed")
+        if not device.handle:
             raise RuntimeError("Device not open")
-        sdk_format_code = DecklinkSDKWrapper.decklink_get_pixel_format(self.handle)
-        return PixelFormatType.parse(sdk_format_code)
+        res = DecklinkSDKWrapper.decklink_library_writer_add_frame(
+            self.handle, device.handle, name.encode("utf-8")
+        )
+        if res < 0:
+            raise RuntimeError(f"Failed to add frame to library (error {res})")
+        return res
 
-    @pixel_format.setter
-    def pixel_format(self, pixel_format_type: PixelFormatType) -> None:
+    def close(self) -> None:
         """
-        Set the pixel format using a PixelFormatType enum.
+        Write the index and close the file.
 
-        Parameters
-        ----------
-        pixel_format_type : PixelFormatType
-            The pixel format enum to set
+        This method is idempotent - it can be called multiple times safely.
 
         Raises
         ------
         RuntimeError
-            If the device is not open or setting the format fails
+            If finishing the file fails; the file is then removed
         """
         if not self.handle:
-            raise RuntimeError("Device not open")
-        res = DecklinkSDKWrapper.decklink_set_pixel_format(
-            self.handle, pixel_format_type.sdk_format_code
-        )
+            return
+        res = DecklinkSDKWrapper.decklink_library_writer_close(self.handle)
+        self.handle = None
         if res != 0:
             raise RuntimeError(
-                f"Failed to set pixel format {pixel_format_type.name} (error {res})"
+                f"Failed to write frame library {self.path} (error {res})"
             )
 
-    def set_hdr_metadata(self, metadata: HDRMetadata) -> None:
-        """
-        Set complete HDR metadata for all future frames.
 
-        Parameters
-        ----------
-        metadata : HDRMetadata
-            HDR metadata structure with complete HDR parameters
+class BMDFrameLibrary:
+    """
+    Frame library file mapped for display with no packing.
 
-        Raises
-        ------
-        RuntimeError
-            If the device is not open or setting metadata fails
-        """
-        if not self.handle:
-            raise RuntimeError("Device not open")
-        res = DecklinkSDKWrapper.decklink_set_hdr_metadata(
-            self.handle, ctypes.byref(metadata)
+    The file is mapped into memory rather than read, so opening it is
+    immediate and frames are paged in from disk as they are displayed with
+    :meth:`BMDDeckLink.display_library_frame`.
+
+    Parameters
+    ----------
+    path : str or os.PathLike
+        Library written by :class:`BMDFrameLibraryWriter`
+
+    Attributes
+    ----------
+    handle : ctypes.c_void_p or None
+        Handle to the native library mapping
+    frames : list[dict[str, Any]]
+        ``name``, ``pixel_format`` (SDK code), ``width``, ``height``,
+        ``row_bytes`` and ``eotf`` of every frame, by index
+
+    Raises
+    ------
+    RuntimeError
+        If the file cannot be opened or is not a frame library of this
+        version
+    """
+
+    def __init__(self, path: str | os.PathLike[str]) -> None:
+        self.path = os.fspath(path)
+        self.handle = DecklinkSDKWrapper.decklink_library_open(
+            self.path.encode("utf-8")
         )
-        if res != 0:
-            raise RuntimeError(f"Failed to set HDR metadata (error {res})")
+        if not self.handle:
+            raise RuntimeError(f"Failed to open frame library {self.path}")
+        self.frames: list[dict[str, Any]] = []
+        count = DecklinkSDKWrapper.decklink_library_get_frame_count(self.handle)
+        for index in range(count):
+            entry = FrameLibraryEntry()
+            DecklinkSDKWrapper.decklink_library_get_frame_info(
+                self.handle, index, ctypes.byref(entry)
+            )
+            self.frames.append(
+                {
+                    "name": entry.name.decode("utf-8", errors="replace"),
+                    "pixel_format": entry.pixelFormat,
+                    "width": entry.width,
+                    "height": entry.height,
+                    "row_bytes": entry.rowBytes,
+                    "eotf": entry.eotf,
+                }
+            )
+        self._names = {frame["name"]: i for i, frame in enumerate(self.frames)}
 
-    def display_frame(self, frame_data: np.ndarray) -> None:
-        """
-        Display a single frame synchronously.
+    def __del__(self) -> None:
+        """Destructor - automatically unmap the file."""
+        self.close()
 
-        Parameters
-        ----------
-        frame_data : numpy.ndarray
-            Frame data with shape (height, width, channels) or (height, width)
+    def __enter__(self) -> Self:
+        """Enter the context manager."""
+        return self
+
+    def __exit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc_val: BaseException | None,
+        exc_tb: Any | None,
+    ) -> None:
+        """Exit the context manager and unmap the file."""
+        self.close()
+
+    def __len__(self) -> int:
+        return len(self.frames)
+
+    def index(self, name: str) -> int:
+        """
+        Index of the first frame with the given name.
 
         Raises
         ------
-        RuntimeError
-            If the device is not open or any frame operation fails
-        ValueError
-            If frame_data is not a valid numpy array
+        KeyError
+            If no frame has that name
         """
-        if not self.handle:
-            raise RuntimeError("Device not open")
-
-        frame_data = np.astype(frame_data, np.uint16, copy=True)
-        frame_data = np.ascontiguousarray(frame_data)
+        return self._names[name]
 
-        # Set frame data
-        data_ptr, height, width = ndarray_to_bmd_frame_buffer(frame_data)
-        res = DecklinkSDKWrapper.decklink_set_frame_data(
-            self.handle, data_ptr, width, height
-        )
-        if res != 0:
-            raise RuntimeError(f"Failed to set frame data (error {res})")
-
-        # Create frame
-        res = DecklinkSDKWrapper.decklink_create_frame_from_data(self.handle)
-        if res != 0:
-            raise RuntimeError(f"Failed to create frame (error {res})")
+    def close(self) -> None:
+        """
+        Unmap the file.
 
-        # Display frame synchronously
-        res = DecklinkSDKWrapper.decklink_display_frame_sync(self.handle)
-        if res != 0:
-            raise RuntimeError(f"Failed to display frame synchronously (error {res})")
+        This method is idempotent - it can be called multiple times safely.
+        """
+        if getattr(self, "handle", None):
+            DecklinkSDKWrapper.decklink_library_close(self.handle)
+            self.handle = None
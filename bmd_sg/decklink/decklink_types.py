@@ -33,6 +33,10 @@ class DecklinkSDKProtocol(Protocol):
         """Get device name by index."""
         ...
 
+    def decklink_get_device_info(self, index: int, info: Any) -> int:
+        """Get cached device attributes by index."""
+        ...
+
     # Device management functions
     def decklink_open_output_by_index(self, index: int) -> ctypes.c_void_p | None:
         """Open output device by index."""
@@ -72,6 +76,12 @@ class DecklinkSDKProtocol(Protocol):
         """Get supported pixel format name by index."""
         ...
 
+    def decklink_get_capabilities(
+        self, handle: ctypes.c_void_p, entries: Any, capacity: int
+    ) -> int:
+        """Get the supported display mode and pixel format pairs, returning how many."""
+        ...
+
     def decklink_set_pixel_format(
         self, handle: ctypes.c_void_p, format_index: int
     ) -> int:
@@ -87,6 +97,53 @@ class DecklinkSDKProtocol(Protocol):
         """Set complete HDR metadata."""
         ...
 
+    # Output format switching functions
+    def decklink_prepare_output_format(
+        self, handle: ctypes.c_void_p, pixel_format_code: int, width: int, height: int
+    ) -> int:
+        """Allocate frames for a pixel format ahead of a switch."""
+        ...
+
+    def decklink_switch_output_format(
+        self,
+        handle: ctypes.c_void_p,
+        pixel_format_code: int,
+        display_mode_code: int,
+        metadata: Any,
+        report: Any,
+    ) -> int:
+        """Switch pixel format, display mode and metadata without a restart."""
+        ...
+
+    # RGB to Y'CbCr conversion functions
+    def decklink_set_ycbcr_conversion(
+        self,
+        handle: ctypes.c_void_p,
+        matrix: int,
+        full_range: int,
+        chroma_filter: int,
+    ) -> int:
+        """Set RGB to Y'CbCr conversion for the 4:2:2 formats."""
+        ...
+
+    def decklink_get_ycbcr_conversion(
+        self, handle: ctypes.c_void_p, matrix: Any, full_range: Any, chroma_filter: Any
+    ) -> int:
+        """Get RGB to Y'CbCr conversion for the 4:2:2 formats."""
+        ...
+
+    # Display-correction LUT
+    def decklink_set_color_lut(
+        self,
+        handle: ctypes.c_void_p,
+        shaper: Any,
+        shaper_size: int,
+        cube: Any,
+        cube_size: int,
+    ) -> int:
+        """Set or clear the 1D shaper and 3D cube applied while packing."""
+        ...
+
     def decklink_device_supports_hdr(self, handle: ctypes.c_void_p) -> bool:
         """Check if device supports HDR metadata."""
         ...
@@ -102,11 +159,89 @@ class DecklinkSDKProtocol(Protocol):
         """Set frame data."""
         ...
 
+    def decklink_set_frame_cache_budget(
+        self, handle: ctypes.c_void_p, budget_bytes: int
+    ) -> int:
+        """Set packed-frame cache budget in bytes."""
+        ...
+
+    def decklink_get_frame_cache_stats(self, handle: ctypes.c_void_p, stats: Any) -> int:
+        """Get packed-frame cache counters."""
+        ...
+
+    # Latency statistics functions
+    def decklink_get_stats(self, handle: ctypes.c_void_p, stats: Any) -> int:
+        """Get per-stage latency histograms."""
+        ...
+
+    def decklink_reset_stats(self, handle: ctypes.c_void_p) -> int:
+        """Clear per-stage latency histograms."""
+        ...
+
+    def decklink_set_solid_color(
+        self, handle: ctypes.c_void_p, width: int, height: int, rgb: Any
+    ) -> int:
+        """Set a solid color as the pending frame."""
+        ...
+
+    def decklink_set_rect_pattern(
+        self,
+        handle: ctypes.c_void_p,
+        width: int,
+        height: int,
+        background_rgb: Any,
+        rects: Any,
+        rect_count: int,
+    ) -> int:
+        """Set a rectangle pattern as the pending frame."""
+        ...
+
+    def decklink_set_generated_pattern(
+        self, handle: ctypes.c_void_p, width: int, height: int, pattern: Any
+    ) -> int:
+        """Set a ramp or zone plate as the pending frame."""
+        ...
+
     # Frame management functions
     def decklink_create_frame_from_data(self, handle: ctypes.c_void_p) -> int:
         """Create frame from pending data."""
         ...
 
+    def decklink_create_frame_from_buffer(
+        self, handle: ctypes.c_void_p, data: Any, width: int, height: int
+    ) -> int:
+        """Pack a caller-owned image straight into the next frame."""
+        ...
+
+    def decklink_update_frame_region(
+        self,
+        handle: ctypes.c_void_p,
+        data: Any,
+        width: int,
+        height: int,
+        x: int,
+        y: int,
+        region_width: int,
+        region_height: int,
+    ) -> int:
+        """Repack only a changed rectangle on top of the previous frame."""
+        ...
+
+    def decklink_begin_frame_write(
+        self,
+        handle: ctypes.c_void_p,
+        width: int,
+        height: int,
+        data: Any,
+        row_bytes: Any,
+    ) -> int:
+        """Map a pooled frame buffer for direct writing."""
+        ...
+
+    def decklink_end_frame_write(self, handle: ctypes.c_void_p) -> int:
+        """Unmap the frame buffer and make it the current frame."""
+        ...
+
     def decklink_schedule_frame_for_output(self, handle: ctypes.c_void_p) -> int:
         """Schedule frame for output."""
         ...
@@ -115,6 +250,250 @@ class DecklinkSDKProtocol(Protocol):
         """Start scheduled playback."""
         ...
 
+    def decklink_stop_scheduled_playback(self, handle: ctypes.c_void_p) -> int:
+        """Stop scheduled playback."""
+        ...
+
+    def decklink_get_buffered_frame_count(self, handle: ctypes.c_void_p) -> int:
+        """Get number of frames queued for scheduled output."""
+        ...
+
+    # Frame pipeline functions
+    def decklink_start_frame_pipeline(self, handle: ctypes.c_void_p) -> int:
+        """Start packing and displaying frames on library threads."""
+        ...
+
+    def decklink_stop_frame_pipeline(self, handle: ctypes.c_void_p) -> int:
+        """Stop the frame pipeline."""
+        ...
+
+    def decklink_submit_frame(
+        self, handle: ctypes.c_void_p, data: Any, width: int, height: int
+    ) -> int:
+        """Queue a copy of an image for the frame pipeline."""
+        ...
+
+    def decklink_flush_frame_pipeline(self, handle: ctypes.c_void_p) -> int:
+        """Wait until every submitted frame was displayed."""
+        ...
+
+    def decklink_get_frame_pipeline_stats(
+        self, handle: ctypes.c_void_p, stats: Any
+    ) -> int:
+        """Get frame pipeline counters and queue depths."""
+        ...
+
+    # Patch sequence functions
+    def decklink_load_sequence(
+        self,
+        handle: ctypes.c_void_p,
+        width: int,
+        height: int,
+        patches: Any,
+        patch_count: int,
+    ) -> int:
+        """Upload solid color and image patches with dwell times."""
+        ...
+
+    def decklink_start_sequence(self, handle: ctypes.c_void_p, loop: int) -> int:
+        """Play the uploaded patches on scheduled frame timing."""
+        ...
+
+    def decklink_stop_sequence(self, handle: ctypes.c_void_p) -> int:
+        """Stop the sequence and scheduled playback."""
+        ...
+
+    def decklink_wait_sequence_event(
+        self, handle: ctypes.c_void_p, event: Any, timeout_ms: int
+    ) -> int:
+        """Wait for the next completed patch."""
+        ...
+
+    def decklink_get_sequence_status(
+        self, handle: ctypes.c_void_p, status: Any
+    ) -> int:
+        """Get the playback state of the sequence."""
+        ...
+
+    # Frame completion events
+    def decklink_enable_completion_events(self, handle: ctypes.c_void_p) -> int:
+        """Open the completion descriptor and return it."""
+        ...
+
+    def decklink_disable_completion_events(self, handle: ctypes.c_void_p) -> int:
+        """Close the completion descriptor."""
+        ...
+
+    def decklink_read_completion_events(
+        self, handle: ctypes.c_void_p, events: Any, capacity: int
+    ) -> int:
+        """Read pending frame completions, returning how many."""
+        ...
+
+    def decklink_get_completion_status(
+        self, handle: ctypes.c_void_p, status: Any
+    ) -> int:
+        """Get the state of the frame completion events."""
+        ...
+
+    # Frame telemetry
+    def decklink_read_frame_telemetry(
+        self, handle: ctypes.c_void_p, samples: Any, capacity: int
+    ) -> int:
+        """Read pending frame telemetry samples, returning how many."""
+        ...
+
+    def decklink_get_frame_telemetry(self, handle: ctypes.c_void_p, stats: Any) -> int:
+        """Get the latency, jitter and frame counts of the output."""
+        ...
+
+    def decklink_reset_frame_telemetry(self, handle: ctypes.c_void_p) -> int:
+        """Clear the frame telemetry."""
+        ...
+
+    # Loopback verification
+    def decklink_start_loopback(
+        self, handle: ctypes.c_void_p, input_device_index: int
+    ) -> int:
+        """Verify the output against its capture on another device's input."""
+        ...
+
+    def decklink_stop_loopback(self, handle: ctypes.c_void_p) -> int:
+        """Stop loopback verification."""
+        ...
+
+    def decklink_read_loopback_results(
+        self, handle: ctypes.c_void_p, results: Any, capacity: int
+    ) -> int:
+        """Read pending loopback results, returning how many."""
+        ...
+
+    def decklink_get_loopback_stats(self, handle: ctypes.c_void_p, stats: Any) -> int:
+        """Get the match, mismatch and error summary of loopback verification."""
+        ...
+
+    def decklink_reset_loopback_stats(self, handle: ctypes.c_void_p) -> int:
+        """Clear the loopback results and counts."""
+        ...
+
+    # Output group functions
+    def decklink_group_create(self) -> ctypes.c_void_p | None:
+        """Create an empty output group."""
+        ...
+
+    def decklink_group_destroy(self, group: ctypes.c_void_p) -> None:
+        """Destroy an output group, leaving its outputs open."""
+        ...
+
+    def decklink_group_add_output(
+        self, group: ctypes.c_void_p, handle: ctypes.c_void_p
+    ) -> int:
+        """Add an open output to a group."""
+        ...
+
+    def decklink_group_remove_output(
+        self, group: ctypes.c_void_p, handle: ctypes.c_void_p
+    ) -> int:
+        """Remove an output from a group."""
+        ...
+
+    def decklink_group_get_output_count(self, group: ctypes.c_void_p) -> int:
+        """Get number of outputs in a group."""
+        ...
+
+    def decklink_group_create_frame_from_buffer(
+        self, group: ctypes.c_void_p, data: Any, width: int, height: int
+    ) -> int:
+        """Pack one image into the next frame of every group output."""
+        ...
+
+    def decklink_group_get_pack_count(self, group: ctypes.c_void_p) -> int:
+        """Get number of frames packed for the last group frame."""
+        ...
+
+    def decklink_group_display_frame_sync(self, group: ctypes.c_void_p) -> int:
+        """Display the current frame on every group output."""
+        ...
+
+    def decklink_group_schedule_frame(self, group: ctypes.c_void_p) -> int:
+        """Queue the current frame on every group output."""
+        ...
+
+    def decklink_group_start_scheduled_playback(self, group: ctypes.c_void_p) -> int:
+        """Start scheduled playback on every group output."""
+        ...
+
+    def decklink_group_stop_scheduled_playback(self, group: ctypes.c_void_p) -> int:
+        """Stop scheduled playback on every group output."""
+        ...
+
+    def decklink_group_get_buffered_frame_counts(
+        self, group: ctypes.c_void_p, counts: Any, max_count: int
+    ) -> int:
+        """Get the queue depth of every group output."""
+        ...
+
+    # Frame library functions
+    def decklink_library_writer_create(self, path: bytes) -> ctypes.c_void_p | None:
+        """Create a frame library file for writing."""
+        ...
+
+    def decklink_library_writer_add_frame(
+        self, writer: ctypes.c_void_p, handle: ctypes.c_void_p, name: bytes
+    ) -> int:
+        """Append an output's current packed frame to the library."""
+        ...
+
+    def decklink_library_writer_close(self, writer: ctypes.c_void_p) -> int:
+        """Write the index, close the file and free the writer."""
+        ...
+
+    def decklink_library_open(self, path: bytes) -> ctypes.c_void_p | None:
+        """Map a frame library file."""
+        ...
+
+    def decklink_library_close(self, library: ctypes.c_void_p) -> None:
+        """Unmap a frame library."""
+        ...
+
+    def decklink_library_get_frame_count(self, library: ctypes.c_void_p) -> int:
+        """Get the number of frames in a library."""
+        ...
+
+    def decklink_library_get_frame_info(
+        self, library: ctypes.c_void_p, index: int, info: Any
+    ) -> int:
+        """Get the index entry of one library frame."""
+        ...
+
+    def decklink_load_library_frame(
+        self, handle: ctypes.c_void_p, library: ctypes.c_void_p, index: int
+    ) -> int:
+        """Copy a library frame into the output's next frame."""
+        ...
+
+    # Packing thread functions
+    def decklink_set_pack_thread_count(self, thread_count: int) -> int:
+        """Set number of threads used to pack each frame."""
+        ...
+
+    def decklink_get_pack_thread_count(self) -> int:
+        """Get number of threads used to pack each frame."""
+        ...
+
+    # Logging functions
+    def decklink_set_log_level(self, level: int) -> int:
+        """Set the most verbose native log level."""
+        ...
+
+    def decklink_get_log_level(self) -> int:
+        """Get the most verbose native log level."""
+        ...
+
+    def decklink_flush_log(self) -> None:
+        """Wait for queued native log messages to be written."""
+        ...
+
     # Version info functions
     def decklink_get_driver_version(self) -> bytes:
         """Get driver version string."""
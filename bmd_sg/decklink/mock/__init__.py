@@ -24,9 +24,18 @@ Development workflow:
 
 from bmd_sg.decklink.mock.mock_decklink import (
     MockBMDDeckLink,
+    MockBMDDeckLinkGroup,
+    MockBMDFrameLibrary,
+    MockBMDFrameLibraryWriter,
+    mock_get_decklink_device_info,
     mock_get_decklink_devices,
     mock_get_decklink_driver_version,
+    mock_flush_log,
     mock_get_decklink_sdk_version,
+    mock_get_log_level,
+    mock_get_pack_thread_count,
+    mock_set_log_level,
+    mock_set_pack_thread_count,
     patch_decklink_module,
     reset_mock_state,
     set_available_devices,
@@ -36,9 +45,18 @@ from bmd_sg.decklink.mock.mock_decklink import (
 
 __all__ = [
     "MockBMDDeckLink",
+    "MockBMDDeckLinkGroup",
+    "MockBMDFrameLibrary",
+    "MockBMDFrameLibraryWriter",
+    "mock_get_decklink_device_info",
     "mock_get_decklink_devices",
     "mock_get_decklink_driver_version",
+    "mock_flush_log",
     "mock_get_decklink_sdk_version",
+    "mock_get_log_level",
+    "mock_get_pack_thread_count",
+    "mock_set_log_level",
+    "mock_set_pack_thread_count",
     "patch_decklink_module",
     "reset_mock_state",
     "set_available_devices",
@@ -6,14 +6,22 @@ and related module functions to enable development and testing without physical
 """
 
 import contextlib
-from typing import Any, ClassVar
+import os
+from collections.abc import Iterator
+from typing import Any, ClassVar, Self
 from unittest.mock import MagicMock, patch
 
 import numpy as np
 
 from bmd_sg.decklink.bmd_decklink import (
+    MOCK_DEVICE_INDEX,
+    ChromaFilter,
+    FrameCompletionWaiter,
     HDRMetadata,
+    LogLevel,
     PixelFormatType,
+    VideoConnection,
+    YCbCrMatrix,
 )
 
 # Global mock configuration state
@@ -29,8 +37,36 @@ _mock_config = {
     "hdr_support": True,
     "driver_version": "12.8.1",
     "sdk_version": "14.4.0",
+    "pack_thread_count": 1,
+    "log_level": 3,
 }
 
+# Frame libraries written by MockBMDFrameLibraryWriter, by path
+_mock_libraries: dict[str, list[dict[str, Any]]] = {}
+
+
+# Bytes per row of each packed format, as reported by RowBytesForPixelFormat
+_ROW_BYTES = {
+    PixelFormatType.FORMAT_8BIT_YUV: lambda w: w * 2,
+    PixelFormatType.FORMAT_10BIT_YUV: lambda w: ((w + 47) // 48) * 128,
+    PixelFormatType.FORMAT_10BIT_RGB: lambda w: ((w + 63) // 64) * 256,
+    PixelFormatType.FORMAT_12BIT_RGB: lambda w: ((w + 7) // 8) * 36,
+    PixelFormatType.FORMAT_12BIT_RGBLE: lambda w: ((w + 7) // 8) * 36,
+    PixelFormatType.FORMAT_10BIT_RGBXLE: lambda w: ((w + 63) // 64) * 256,
+    PixelFormatType.FORMAT_10BIT_RGBX: lambda w: ((w + 63) // 64) * 256,
+}
+
+# Pixel formats sent over the 4:2:2 Y'CbCr link; the rest use 4:4:4 RGB
+_YCBCR_FORMATS = {
+    PixelFormatType.FORMAT_8BIT_YUV,
+    PixelFormatType.FORMAT_10BIT_YUV,
+    PixelFormatType.FORMAT_10BIT_YUVA,
+}
+
+
+def _is_444(pixel_format: PixelFormatType) -> bool:
+    return pixel_format not in _YCBCR_FORMATS
+
 
 class MockBMDDeckLink:
     """
@@ -85,21 +121,43 @@ class MockBMDDeckLink:
 
     def __init__(self, device_index: int = 0) -> None:
         # Check if device exists in mock configuration
-        if device_index >= len(_mock_config["available_devices"]):
+        if device_index == MOCK_DEVICE_INDEX:
+            self.device_name = "DeckLink Mock Output"
+        elif 0 <= device_index < len(_mock_config["available_devices"]):
+            self.device_name = _mock_config["available_devices"][device_index]
+        else:
             raise RuntimeError(
                 f"No DeckLink output device found at index {device_index}"
             )
 
         self.device_index = device_index
-        self.device_name = _mock_config["available_devices"][device_index]
         self.handle = MagicMock()  # Always non-None when device is "open"
         self.started = False
+        self._scheduled_playback = False
+        self._frame_pipeline = False
+        self._pipeline_submitted = 0
+        self._sequence_dwell: list[int] = []
+        self._sequence_loop = False
+        self._sequence_running = False
+        self._sequence_completed = 0
+        self._sequence_time = 0
+        self._scheduled_frames = 0
+        self._completion_pipe: tuple[int, int] | None = None
+        self._completion_events: list[dict[str, int]] = []
+        self._completion_waiter: FrameCompletionWaiter | None = None
 
         # Internal state
         self._pixel_format = _mock_config["supported_formats"][0]
+        self._prepared_format: PixelFormatType | None = None
         self._hdr_metadata: HDRMetadata | None = None
         self._frame_history: list[np.ndarray] = []
         self._max_frame_history = 10
+        self._frame_cache_budget = 0
+        self._ycbcr_conversion: dict[str, Any] = {
+            "matrix": YCbCrMatrix.AUTO,
+            "full_range": False,
+            "chroma_filter": ChromaFilter.COSITED,
+        }
 
         # Method call tracking
         self._method_calls: dict[str, list[dict[str, Any]]] = {
@@ -107,7 +165,32 @@ class MockBMDDeckLink:
             "stop_playback": [],
             "set_pixel_format": [],
             "set_hdr_metadata": [],
+            "prepare_output_format": [],
+            "switch_output_format": [],
+            "set_ycbcr_conversion": [],
+            "set_color_lut": [],
             "display_frame": [],
+            "display_solid_color": [],
+            "display_rect_pattern": [],
+            "display_ramp": [],
+            "display_zone_plate": [],
+            "display_library_frame": [],
+            "schedule_frame": [],
+            "frame_buffer": [],
+            "start_scheduled_playback": [],
+            "stop_scheduled_playback": [],
+            "reset_latency_stats": [],
+            "reset_frame_telemetry": [],
+            "start_loopback": [],
+            "stop_loopback": [],
+            "reset_loopback_stats": [],
+            "start_frame_pipeline": [],
+            "stop_frame_pipeline": [],
+            "submit_frame": [],
+            "load_sequence": [],
+            "enable_completion_events": [],
+            "start_sequence": [],
+            "stop_sequence": [],
             "close": [],
         }
 
@@ -138,6 +221,7 @@ class MockBMDDeckLink:
             self._method_calls["close"].append({})
             if self.started:
                 self.stop_playback()
+            self.disable_completion_events()
             self.handle = None
             # Remove from instances list
             if self in MockBMDDeckLink._instances:
@@ -172,6 +256,23 @@ class MockBMDDeckLink:
             raise RuntimeError("Device not open")
         return _mock_config["supported_formats"].copy()
 
+    def get_capabilities(self) -> list[dict[str, Any]]:
+        """Mock capabilities: every supported format in 1080p30 on the default connection."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return [
+            {
+                "display_mode": "Hp30",
+                "pixel_format": pixel_format,
+                "connections": VideoConnection(0),
+                "default_connection": True,
+                "width": 1920,
+                "height": 1080,
+                "frame_rate": 30.0,
+            }
+            for pixel_format in _mock_config["supported_formats"]
+        ]
+
     @property
     def supports_hdr(self) -> bool:
         """Check if the device supports HDR."""
@@ -210,8 +311,109 @@ class MockBMDDeckLink:
         self._method_calls["set_hdr_metadata"].append({"metadata": metadata})
         self._hdr_metadata = metadata
 
-    def display_frame(self, frame_data: np.ndarray) -> None:
-        """Display a single frame synchronously."""
+    def prepare_output_format(
+        self, pixel_format: PixelFormatType, width: int, height: int
+    ) -> None:
+        """Record the format that frames were prepared for."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if not self.started:
+            raise RuntimeError("Failed to prepare output format (error -1)")
+        self._method_calls["prepare_output_format"].append(
+            {"format": pixel_format, "width": width, "height": height}
+        )
+        self._prepared_format = pixel_format
+
+    def switch_output_format(
+        self,
+        pixel_format: PixelFormatType,
+        hdr_metadata: HDRMetadata | None = None,
+    ) -> dict[str, int]:
+        """Switch format and metadata, reporting a relink across 4:2:2/4:4:4."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._scheduled_playback:
+            raise RuntimeError(
+                f"Failed to switch to pixel format {pixel_format.name} (error -2)"
+            )
+        if pixel_format not in _mock_config["supported_formats"]:
+            raise RuntimeError(
+                f"Failed to switch to pixel format {pixel_format.name} (error -1)"
+            )
+        relinked = self.started and _is_444(pixel_format) != _is_444(
+            self._pixel_format
+        )
+        frames_ready = pixel_format in (self._pixel_format, self._prepared_format)
+        self._method_calls["switch_output_format"].append(
+            {"format": pixel_format, "metadata": hdr_metadata}
+        )
+        self._prepared_format = self._pixel_format
+        self._pixel_format = pixel_format
+        if hdr_metadata is not None:
+            self._hdr_metadata = hdr_metadata
+        return {
+            "elapsed_ns": 0,
+            "relinked": int(relinked),
+            "frames_ready": int(frames_ready),
+        }
+
+    @property
+    def ycbcr_conversion(self) -> dict[str, Any]:
+        """Get the RGB to Y'CbCr conversion for the 4:2:2 formats."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return dict(self._ycbcr_conversion)
+
+    def set_ycbcr_conversion(
+        self,
+        matrix: YCbCrMatrix | int = YCbCrMatrix.AUTO,
+        full_range: bool = False,
+        chroma_filter: ChromaFilter | int = ChromaFilter.COSITED,
+    ) -> None:
+        """Set the RGB to Y'CbCr conversion for the 4:2:2 formats."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        conversion = {
+            "matrix": YCbCrMatrix(matrix),
+            "full_range": bool(full_range),
+            "chroma_filter": ChromaFilter(chroma_filter),
+        }
+        self._method_calls["set_ycbcr_conversion"].append(dict(conversion))
+        self._ycbcr_conversion = conversion
+
+    def set_color_lut(
+        self,
+        cube: np.ndarray | None = None,
+        shaper: np.ndarray | None = None,
+    ) -> None:
+        """Record a display-correction LUT; frames are recorded unchanged."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._frame_pipeline:
+            raise RuntimeError("Failed to set color LUT (error -10)")
+        if self._sequence_running:
+            raise RuntimeError("Failed to set color LUT (error -11)")
+        cube_size = shaper_size = 0
+        if cube is not None:
+            cube = np.asarray(cube)
+            if cube.ndim != 4 or cube.shape[3] != 3 or len(set(cube.shape[:3])) != 1:
+                raise ValueError("cube must have shape (N, N, N, 3)")
+            cube_size = cube.shape[0]
+        if shaper is not None:
+            shaper = np.asarray(shaper)
+            if shaper.ndim != 2 or shaper.shape[1] != 3:
+                raise ValueError("shaper must have shape (M, 3)")
+            shaper_size = shaper.shape[0]
+        if (cube is not None and not 2 <= cube_size <= 129) or (
+            shaper is not None and not 2 <= shaper_size <= 65536
+        ):
+            raise RuntimeError("Failed to set color LUT (error -1)")
+        self._method_calls["set_color_lut"].append(
+            {"cube_size": cube_size, "shaper_size": shaper_size}
+        )
+
+    def _record_frame(self, method_name: str, frame_data: np.ndarray) -> None:
+        """Validate frame data and record it in the frame history."""
         if not self.handle:
             raise RuntimeError("Device not open")
 
@@ -229,10 +431,525 @@ class MockBMDDeckLink:
             self._frame_history.pop(0)
 
         # Track method call
-        self._method_calls["display_frame"].append(
+        self._method_calls[method_name].append(
             {"shape": frame_data.shape, "dtype": frame_data.dtype}
         )
 
+    def display_frame(
+        self,
+        frame_data: np.ndarray,
+        *,
+        region: tuple[int, int, int, int] | None = None,
+    ) -> None:
+        """Display a single frame synchronously."""
+        if self._scheduled_playback:
+            raise RuntimeError("Failed to display frame synchronously (error -2)")
+        self._record_frame("display_frame", frame_data)
+        if region is not None:
+            self._method_calls["display_frame"][-1]["region"] = tuple(region)
+
+    @contextlib.contextmanager
+    def frame_buffer(
+        self, width: int, height: int, *, schedule: bool = False
+    ) -> Iterator[np.ndarray]:
+        """Yield a zeroed packed buffer and record it once written."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._scheduled_playback and not schedule:
+            raise RuntimeError("Failed to display frame synchronously (error -2)")
+        row_bytes = _ROW_BYTES.get(self._pixel_format, lambda w: w * 4)(width)
+        buffer = np.zeros((height, row_bytes), dtype=np.uint8)
+        yield buffer
+        self._method_calls["frame_buffer"].append(
+            {"shape": buffer.shape, "schedule": schedule}
+        )
+        if schedule:
+            self._scheduled_playback = True
+
+    def display_solid_color(self, color: Any, width: int, height: int) -> None:
+        """Display a solid color frame, rendered in numpy for the history."""
+        if self._scheduled_playback:
+            raise RuntimeError("Failed to display frame synchronously (error -2)")
+        frame = np.empty((height, width, 3), dtype=np.uint16)
+        frame[:] = np.asarray(color, dtype=np.uint16).reshape(3)
+        self._record_frame("display_solid_color", frame)
+
+    def display_rect_pattern(
+        self,
+        width: int,
+        height: int,
+        rects: list[tuple[int, int, int, int, Any]],
+        background: Any = (0, 0, 0),
+    ) -> None:
+        """Display a rectangle pattern, rendered in numpy for the history."""
+        if self._scheduled_playback:
+            raise RuntimeError("Failed to display frame synchronously (error -2)")
+        frame = np.empty((height, width, 3), dtype=np.uint16)
+        frame[:] = np.asarray(background, dtype=np.uint16).reshape(3)
+        for x, y, rect_width, rect_height, colors in rects:
+            cells = np.broadcast_to(np.asarray(colors, dtype=np.uint16), (4, 3))
+            x0, y0 = max(x, 0), max(y, 0)
+            x1, y1 = min(x + rect_width, width), min(y + rect_height, height)
+            for cell, color in enumerate(cells):
+                # Cell order matches PatternRect: row parity, then column parity
+                row_start = y0 + ((y0 - y + cell) & 1)
+                col_start = x0 + ((x0 - x + (cell >> 1)) & 1)
+                frame[row_start:y1:2, col_start:x1:2] = color
+        self._record_frame("display_rect_pattern", frame)
+
+    def display_ramp(
+        self,
+        width: int,
+        height: int,
+        start: Any,
+        end: Any,
+        *,
+        vertical: bool = False,
+        steps: int = 0,
+    ) -> None:
+        """Display a ramp, rendered in numpy for the history."""
+        if self._scheduled_playback:
+            raise RuntimeError("Failed to display frame synchronously (error -2)")
+        if steps < 0:
+            raise RuntimeError("Failed to set generated pattern (error -1)")
+        count = height if vertical else width
+        index = np.arange(count)
+        if steps >= 2:
+            position = (index * steps // count) / (steps - 1)
+        else:
+            position = index / max(count - 1, 1)
+        start_rgb = np.asarray(start, dtype=np.float64).reshape(3)
+        end_rgb = np.asarray(end, dtype=np.float64).reshape(3)
+        line = (start_rgb + (end_rgb - start_rgb) * position[:, None] + 0.5).astype(
+            np.uint16
+        )
+        shape = (height, width, 3)
+        frame = np.broadcast_to(
+            line[:, None, :] if vertical else line[None, :, :], shape
+        ).copy()
+        self._record_frame("display_ramp", frame)
+
+    def display_zone_plate(
+        self,
+        width: int,
+        height: int,
+        low: Any,
+        high: Any,
+        frequency: float = 1.0,
+    ) -> None:
+        """Display a zone plate, rendered in numpy for the history."""
+        if self._scheduled_playback:
+            raise RuntimeError("Failed to display frame synchronously (error -2)")
+        if not np.isfinite(frequency) or frequency < 0:
+            raise RuntimeError("Failed to set generated pattern (error -1)")
+        dx = np.arange(width) + 0.5 - width / 2
+        dy = np.arange(height) + 0.5 - height / 2
+        phase = np.pi * frequency / width * (dy[:, None] ** 2 + dx[None, :] ** 2)
+        level = 0.5 + 0.5 * np.cos(phase)
+        low_rgb = np.asarray(low, dtype=np.float64).reshape(3)
+        high_rgb = np.asarray(high, dtype=np.float64).reshape(3)
+        frame = (low_rgb + (high_rgb - low_rgb) * level[..., None] + 0.5).astype(
+            np.uint16
+        )
+        self._record_frame("display_zone_plate", frame)
+
+    def display_library_frame(
+        self,
+        library: "MockBMDFrameLibrary",
+        frame: int | str,
+        *,
+        schedule: bool = False,
+    ) -> None:
+        """Display the image that was current when the frame was added."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if not library.handle:
+            raise RuntimeError("Frame library not open")
+        index = library.index(frame) if isinstance(frame, str) else frame
+        if not 0 <= index < len(library.frames):
+            raise RuntimeError(f"Failed to load library frame {frame} (error -2)")
+        entry = library.frames[index]
+        if entry["pixel_format"] != self._pixel_format.sdk_format_code:
+            raise RuntimeError(f"Failed to load library frame {frame} (error -8)")
+        if self._scheduled_playback and not schedule:
+            raise RuntimeError("Failed to display frame synchronously (error -2)")
+        self._record_frame("display_library_frame", library._images[index])
+
+    def schedule_frame(self, frame_data: np.ndarray) -> None:
+        """Queue a frame for scheduled playback."""
+        self._record_frame("schedule_frame", frame_data)
+        self._scheduled_playback = True
+        # Mock frames complete on time as soon as they are queued
+        frame_number = self._scheduled_frames
+        self._scheduled_frames += 1
+        if self._completion_pipe is not None:
+            if not self._completion_events:
+                os.write(self._completion_pipe[1], b"\x01")
+            self._completion_events.append(
+                {
+                    "frame_number": frame_number,
+                    "stream_time": frame_number * self._SEQUENCE_FRAME_DURATION,
+                    "time_scale": self._SEQUENCE_TIME_SCALE,
+                    "completion_timestamp_ns": 0,
+                    "result": 0,
+                }
+            )
+
+    def start_scheduled_playback(self) -> None:
+        """Start scheduled playback of queued frames."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self._method_calls["start_scheduled_playback"].append({})
+        self._scheduled_playback = True
+
+    def stop_scheduled_playback(self) -> None:
+        """Stop scheduled playback and return to synchronous display."""
+        if not self.handle:
+            return
+        self._method_calls["stop_scheduled_playback"].append({})
+        self._scheduled_playback = False
+
+    @property
+    def buffered_frame_count(self) -> int:
+        """Mock devices output frames instantly, so nothing stays queued."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return 0
+
+    def start_frame_pipeline(self) -> None:
+        """Start the frame pipeline."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self._method_calls["start_frame_pipeline"].append({})
+        self._frame_pipeline = True
+        self._pipeline_submitted = 0
+
+    def stop_frame_pipeline(self) -> None:
+        """Stop the frame pipeline."""
+        if not self.handle:
+            return
+        self._method_calls["stop_frame_pipeline"].append({})
+        self._frame_pipeline = False
+
+    def submit_frame(self, frame_data: np.ndarray) -> None:
+        """Mock pipelines display each frame as soon as it is submitted."""
+        if not self._frame_pipeline:
+            raise RuntimeError("Failed to submit frame (error -1)")
+        self._record_frame("submit_frame", frame_data)
+        self._pipeline_submitted += 1
+
+    def flush_frame_pipeline(self) -> None:
+        """Nothing is ever queued in a mock pipeline."""
+        if not self._frame_pipeline:
+            raise RuntimeError("Failed to flush frame pipeline (error -1)")
+
+    @property
+    def frame_pipeline_stats(self) -> dict[str, int]:
+        """Every submitted frame counts as displayed."""
+        if not self._frame_pipeline:
+            raise RuntimeError("Failed to get frame pipeline stats (error -1)")
+        return {
+            "submitted": self._pipeline_submitted,
+            "displayed": self._pipeline_submitted,
+            "failed": 0,
+            "producer_stalls": 0,
+            "source_depth": 0,
+            "frame_depth": 0,
+            "capacity": 2,
+            "last_error": 0,
+        }
+
+    # Mock sequences run on a 60 fps clock, one frame being 1000 ticks
+    _SEQUENCE_TIME_SCALE = 60000
+    _SEQUENCE_FRAME_DURATION = 1000
+
+    def load_sequence(
+        self, width: int, height: int, patches: list[tuple[Any, int]]
+    ) -> None:
+        """Validate and store the dwell times of a patch list."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._sequence_running:
+            raise RuntimeError("Failed to load sequence (error -11)")
+        if not patches or any(int(dwell) <= 0 for _, dwell in patches):
+            raise RuntimeError("Failed to load sequence (error -1)")
+        for content, _ in patches:
+            content = np.asarray(content)
+            if content.ndim != 1 and content.shape != (height, width, 3):
+                raise RuntimeError(
+                    f"Patch image shape {content.shape} does not match "
+                    f"{(height, width, 3)}"
+                )
+        self._sequence_dwell = [int(dwell) for _, dwell in patches]
+        self._method_calls["load_sequence"].append(
+            {"width": width, "height": height, "patch_count": len(patches)}
+        )
+
+    def start_sequence(self, loop: bool = False) -> None:
+        """Start generating patch events."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if not self._sequence_dwell:
+            raise RuntimeError("Failed to start sequence (error -2)")
+        self._method_calls["start_sequence"].append({"loop": loop})
+        self._sequence_loop = loop
+        self._sequence_running = True
+        self._sequence_completed = 0
+        self._sequence_time = 0
+
+    def stop_sequence(self) -> None:
+        """Stop generating patch events."""
+        if not self.handle:
+            return
+        self._method_calls["stop_sequence"].append({})
+        self._sequence_running = False
+
+    def wait_sequence_event(self, timeout: float = 1.0) -> dict[str, int] | None:
+        """Mock patches complete as soon as their event is read."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if not self._sequence_running:
+            return None
+        patch_count = len(self._sequence_dwell)
+        index = self._sequence_completed % patch_count
+        start = self._sequence_time
+        self._sequence_time += (
+            self._sequence_dwell[index] * self._SEQUENCE_FRAME_DURATION
+        )
+        event = {
+            "patch_index": index,
+            "pass": self._sequence_completed // patch_count,
+            "start_time": start,
+            "end_time": self._sequence_time,
+            "time_scale": self._SEQUENCE_TIME_SCALE,
+            "completion_timestamp_ns": 0,
+            "result": 0,
+        }
+        self._sequence_completed += 1
+        if not self._sequence_loop and self._sequence_completed == patch_count:
+            self._sequence_running = False
+        return event
+
+    @property
+    def sequence_status(self) -> dict[str, int]:
+        """Playback state of the mock sequence."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return {
+            "running": int(self._sequence_running),
+            "patch_count": len(self._sequence_dwell),
+            "completed_patches": self._sequence_completed,
+            "queued_frames": 0,
+            "late_frames": 0,
+            "dropped_frames": 0,
+            "events_dropped": 0,
+            "last_error": 0,
+        }
+
+    def enable_completion_events(self) -> int:
+        """Report mock frame completions on a real pipe."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if self._completion_pipe is None:
+            read_fd, write_fd = os.pipe()
+            os.set_blocking(read_fd, False)
+            self._completion_pipe = (read_fd, write_fd)
+            self._completion_waiter = FrameCompletionWaiter(
+                read_fd, self.read_completion_events
+            )
+            self._method_calls["enable_completion_events"].append({})
+        return self._completion_pipe[0]
+
+    def disable_completion_events(self) -> None:
+        """Close the mock completion pipe."""
+        if self._completion_waiter is not None:
+            self._completion_waiter.close()
+            self._completion_waiter = None
+        if self._completion_pipe is not None:
+            for fd in self._completion_pipe:
+                os.close(fd)
+            self._completion_pipe = None
+        self._completion_events = []
+
+    def read_completion_events(self, max_events: int = 64) -> list[dict[str, int]]:
+        """Read pending mock frame completions."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        events = self._completion_events[:max_events]
+        del self._completion_events[:max_events]
+        if not self._completion_events and self._completion_pipe is not None:
+            with contextlib.suppress(BlockingIOError):
+                os.read(self._completion_pipe[0], 16)
+        return events
+
+    @property
+    def completion_status(self) -> dict[str, int]:
+        """State of the mock frame completion events."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return {
+            "enabled": int(self._completion_pipe is not None),
+            "scheduled_frames": self._scheduled_frames,
+            "pending_events": len(self._completion_events),
+            "events_dropped": 0,
+        }
+
+    async def wait_frame_completed(
+        self, frame_number: int | None = None
+    ) -> dict[str, int]:
+        """Wait for a mock frame completion on the running event loop."""
+        self.enable_completion_events()
+        assert self._completion_waiter is not None
+        if frame_number is None:
+            frame_number = self._scheduled_frames - 1
+            if frame_number < 0:
+                raise RuntimeError("No frame has been scheduled")
+        return await self._completion_waiter.wait(frame_number)
+
+    @property
+    def frame_cache_stats(self) -> dict[str, int]:
+        """Mock devices do not cache, so only the budget is reported."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return {
+            "hits": 0,
+            "misses": 0,
+            "evictions": 0,
+            "entries": 0,
+            "bytes": 0,
+            "budget_bytes": self._frame_cache_budget,
+        }
+
+    @property
+    def frame_cache_budget(self) -> int:
+        """Memory budget of the packed-frame cache, in bytes."""
+        return self.frame_cache_stats["budget_bytes"]
+
+    @frame_cache_budget.setter
+    def frame_cache_budget(self, budget_bytes: int) -> None:
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        if budget_bytes < 0:
+            raise ValueError(f"Cache budget must be non-negative, got {budget_bytes}")
+        self._frame_cache_budget = budget_bytes
+
+    @property
+    def latency_stats(self) -> dict[str, dict[str, float]]:
+        """Mock devices have no native frame path, so every stage is empty."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        stages = (
+            "set_frame_data",
+            "pack",
+            "create_frame",
+            "apply_hdr_metadata",
+            "display_frame_sync",
+            "schedule_frame",
+        )
+        return {
+            stage: {
+                "count": 0,
+                "p50_us": 0.0,
+                "p99_us": 0.0,
+                "max_us": 0.0,
+                "mean_us": 0.0,
+            }
+            for stage in stages
+        }
+
+    def reset_latency_stats(self) -> None:
+        """Mock devices record no latency, so there is nothing to clear."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self._method_calls["reset_latency_stats"].append({})
+
+    def read_frame_telemetry(self, max_samples: int = 256) -> list[dict[str, int]]:
+        """Mock devices have no hardware clock, so no samples are recorded."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return []
+
+    @property
+    def frame_telemetry(self) -> dict[str, Any]:
+        """Mock devices have no hardware clock, so the summary is empty."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        empty = {
+            "count": 0,
+            "p50_us": 0.0,
+            "p99_us": 0.0,
+            "max_us": 0.0,
+            "mean_us": 0.0,
+        }
+        return {
+            "displayed_frames": 0,
+            "late_frames": 0,
+            "dropped_frames": 0,
+            "flushed_frames": 0,
+            "pending_samples": 0,
+            "samples_dropped": 0,
+            "submit_to_scanout": dict(empty),
+            "scanout_jitter": dict(empty),
+        }
+
+    def reset_frame_telemetry(self) -> None:
+        """Mock devices record no telemetry, so there is nothing to clear."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self._method_calls["reset_frame_telemetry"].append({})
+
+    def start_loopback(self, input_device_index: int) -> None:
+        """Mock devices have no input to capture the output with."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self._method_calls["start_loopback"].append(
+            {"input_device_index": input_device_index}
+        )
+        raise RuntimeError("Failed to start loopback verification (error -2)")
+
+    def stop_loopback(self) -> None:
+        """Mock stop loopback verification."""
+        self._method_calls["stop_loopback"].append({})
+
+    def read_loopback_results(self, max_results: int = 256) -> list[dict[str, Any]]:
+        """Mock devices capture nothing, so no results are recorded."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        return []
+
+    @property
+    def loopback_stats(self) -> dict[str, Any]:
+        """Mock devices capture nothing, so the summary is empty."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        empty = {
+            "count": 0,
+            "p50_us": 0.0,
+            "p99_us": 0.0,
+            "max_us": 0.0,
+            "mean_us": 0.0,
+        }
+        return {
+            "captured_frames": 0,
+            "matched_frames": 0,
+            "mismatched_frames": 0,
+            "uncompared_frames": 0,
+            "skipped_frames": 0,
+            "pending_results": 0,
+            "results_dropped": 0,
+            "max_error": (0, 0, 0),
+            "running": False,
+            "last_status": None,
+            "compare": dict(empty),
+            "reference_copy": dict(empty),
+        }
+
+    def reset_loopback_stats(self) -> None:
+        """Mock devices record no loopback results, so there is nothing to clear."""
+        if not self.handle:
+            raise RuntimeError("Device not open")
+        self._method_calls["reset_loopback_stats"].append({})
+
     # Additional mock-specific methods for testing and verification
 
     def get_method_calls(
@@ -270,6 +987,182 @@ class MockBMDDeckLink:
         self._frame_history = []
 
 
+class MockBMDDeckLinkGroup:
+    """
+    Mock implementation of BMDDeckLinkGroup.
+
+    Forwards every frame to each member mock device, so their frame history
+    and method calls record the group's output.
+
+    Parameters
+    ----------
+    devices : list[MockBMDDeckLink]
+        Open mock devices
+    """
+
+    def __init__(self, devices: list[MockBMDDeckLink]) -> None:
+        for device in devices:
+            if not device.handle:
+                raise RuntimeError("Device not open")
+        self.devices = list(devices)
+        self.handle = MagicMock()
+
+    def __enter__(self) -> "MockBMDDeckLinkGroup":
+        """Enter the context manager."""
+        return self
+
+    def __exit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc_val: BaseException | None,
+        exc_tb: Any | None,
+    ) -> None:
+        """Exit the context manager and release the group."""
+        self.close()
+
+    def close(self) -> None:
+        """Release the group, leaving its devices open."""
+        self.handle = None
+
+    def _open_devices(self) -> list[MockBMDDeckLink]:
+        if not self.handle:
+            raise RuntimeError("Group not open")
+        return [device for device in self.devices if device.handle]
+
+    def display_frame(self, frame_data: np.ndarray) -> None:
+        """Display one frame on every device."""
+        for device in self._open_devices():
+            device.display_frame(frame_data)
+
+    def schedule_frame(self, frame_data: np.ndarray) -> None:
+        """Queue one frame on every device."""
+        for device in self._open_devices():
+            device.schedule_frame(frame_data)
+
+    def start_scheduled_playback(self) -> None:
+        """Start scheduled playback on every device."""
+        for device in self._open_devices():
+            device.start_scheduled_playback()
+
+    def stop_scheduled_playback(self) -> None:
+        """Stop scheduled playback on every device."""
+        if not self.handle:
+            return
+        for device in self._open_devices():
+            device.stop_scheduled_playback()
+
+    @property
+    def pack_count(self) -> int:
+        """Distinct pixel formats among the open devices."""
+        return len({device.pixel_format for device in self._open_devices()})
+
+    @property
+    def buffered_frame_counts(self) -> list[int]:
+        """Queue depth of every open device."""
+        return [device.buffered_frame_count for device in self._open_devices()]
+
+
+class MockBMDFrameLibraryWriter:
+    """
+    Mock implementation of BMDFrameLibraryWriter.
+
+    Frames are kept in memory under the path, with the image each device
+    last displayed standing in for its packed frame.
+    """
+
+    def __init__(self, path: str | os.PathLike[str]) -> None:
+        self.path = os.fspath(path)
+        self.handle = MagicMock()
+        self._frames: list[dict[str, Any]] = []
+
+    def __enter__(self) -> Self:
+        """Enter the context manager."""
+        return self
+
+    def __exit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc_val: BaseException | None,
+        exc_tb: Any | None,
+    ) -> None:
+        """Exit the context manager and finish the library."""
+        self.close()
+
+    def add_frame(self, device: MockBMDDeckLink, name: str = "") -> int:
+        """Store the device's last displayed image."""
+        if not self.handle:
+            raise RuntimeError("Frame library writer closed")
+        if not device.handle:
+            raise RuntimeError("Device not open")
+        if not device._frame_history:
+            raise RuntimeError("Failed to add frame to library (error -2)")
+        image = device._frame_history[-1]
+        height, width = image.shape[:2]
+        metadata = device._hdr_metadata
+        self._frames.append(
+            {
+                "name": name.encode("utf-8")[:63].decode("utf-8", errors="ignore"),
+                "pixel_format": device.pixel_format.sdk_format_code,
+                "width": width,
+                "height": height,
+                "row_bytes": _ROW_BYTES.get(device.pixel_format, lambda w: w * 4)(
+                    width
+                ),
+                "eotf": metadata.EOTF if metadata is not None else 0,
+                "image": image.copy(),
+            }
+        )
+        return len(self._frames) - 1
+
+    def close(self) -> None:
+        """Publish the frames under the path."""
+        if not self.handle:
+            return
+        _mock_libraries[self.path] = self._frames
+        self.handle = None
+
+
+class MockBMDFrameLibrary:
+    """Mock implementation of BMDFrameLibrary, reading what the mock writer kept."""
+
+    def __init__(self, path: str | os.PathLike[str]) -> None:
+        self.path = os.fspath(path)
+        if self.path not in _mock_libraries:
+            raise RuntimeError(f"Failed to open frame library {self.path}")
+        stored = _mock_libraries[self.path]
+        self.handle = MagicMock()
+        self.frames = [
+            {key: value for key, value in frame.items() if key != "image"}
+            for frame in stored
+        ]
+        self._images = [frame["image"] for frame in stored]
+        self._names = {frame["name"]: i for i, frame in enumerate(self.frames)}
+
+    def __enter__(self) -> Self:
+        """Enter the context manager."""
+        return self
+
+    def __exit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc_val: BaseException | None,
+        exc_tb: Any | None,
+    ) -> None:
+        """Exit the context manager and close the library."""
+        self.close()
+
+    def __len__(self) -> int:
+        return len(self.frames)
+
+    def index(self, name: str) -> int:
+        """Index of the first frame with the given name."""
+        return self._names[name]
+
+    def close(self) -> None:
+        """Close the library."""
+        self.handle = None
+
+
 # Mock module-level functions
 
 
@@ -278,6 +1171,25 @@ def mock_get_decklink_devices() -> list[str]:
     return _mock_config["available_devices"].copy()
 
 
+def mock_get_decklink_device_info(device_index: int) -> dict[str, Any]:
+    """Mock implementation of get_decklink_device_info."""
+    if device_index == MOCK_DEVICE_INDEX:
+        name, supports_hdr = "DeckLink Mock Output", False
+    elif 0 <= device_index < len(_mock_config["available_devices"]):
+        name = _mock_config["available_devices"][device_index]
+        supports_hdr = _mock_config["hdr_support"]
+    else:
+        raise RuntimeError("Failed to get device info (error -1)")
+    return {
+        "name": name,
+        "model_name": name,
+        "persistent_id": 0,
+        "topological_id": 0,
+        "supports_playback": True,
+        "supports_hdr": supports_hdr,
+    }
+
+
 def mock_get_decklink_driver_version() -> str:
     """Mock implementation of get_decklink_driver_version."""
     return _mock_config["driver_version"]
@@ -288,6 +1200,32 @@ def mock_get_decklink_sdk_version() -> str:
     return _mock_config["sdk_version"]
 
 
+def mock_get_pack_thread_count() -> int:
+    """Mock implementation of get_pack_thread_count."""
+    return _mock_config["pack_thread_count"]
+
+
+def mock_set_pack_thread_count(thread_count: int) -> None:
+    """Mock implementation of set_pack_thread_count."""
+    if thread_count < 0:
+        raise ValueError(f"Thread count must be non-negative, got {thread_count}")
+    _mock_config["pack_thread_count"] = thread_count or 1
+
+
+def mock_get_log_level() -> LogLevel:
+    """Mock implementation of get_log_level."""
+    return LogLevel(_mock_config["log_level"])
+
+
+def mock_set_log_level(level: LogLevel | int) -> None:
+    """Mock implementation of set_log_level."""
+    _mock_config["log_level"] = int(LogLevel(level))
+
+
+def mock_flush_log() -> None:
+    """Mock implementation of flush_log; mock devices never log."""
+
+
 # Configuration functions
 
 
@@ -347,8 +1285,11 @@ def reset_mock_state() -> None:
             "hdr_support": True,
             "driver_version": "12.8.1",
             "sdk_version": "14.4.0",
+            "pack_thread_count": 1,
+            "log_level": 3,
         }
     )
+    _mock_libraries.clear()
 
 
 # Patching utilities
@@ -370,10 +1311,20 @@ def patch_decklink_module():
     """
     patches = [
         patch("bmd_sg.decklink.bmd_decklink.BMDDeckLink", MockBMDDeckLink),
+        patch("bmd_sg.decklink.bmd_decklink.BMDDeckLinkGroup", MockBMDDeckLinkGroup),
+        patch("bmd_sg.decklink.bmd_decklink.BMDFrameLibrary", MockBMDFrameLibrary),
+        patch(
+            "bmd_sg.decklink.bmd_decklink.BMDFrameLibraryWriter",
+            MockBMDFrameLibraryWriter,
+        ),
         patch(
             "bmd_sg.decklink.bmd_decklink.get_decklink_devices",
             mock_get_decklink_devices,
         ),
+        patch(
+            "bmd_sg.decklink.bmd_decklink.get_decklink_device_info",
+            mock_get_decklink_device_info,
+        ),
         patch(
             "bmd_sg.decklink.bmd_decklink.get_decklink_driver_version",
             mock_get_decklink_driver_version,
@@ -382,8 +1333,26 @@ def patch_decklink_module():
             "bmd_sg.decklink.bmd_decklink.get_decklink_sdk_version",
             mock_get_decklink_sdk_version,
         ),
+        patch(
+            "bmd_sg.decklink.bmd_decklink.get_pack_thread_count",
+            mock_get_pack_thread_count,
+        ),
+        patch(
+            "bmd_sg.decklink.bmd_decklink.set_pack_thread_count",
+            mock_set_pack_thread_count,
+        ),
+        patch(
+            "bmd_sg.decklink.bmd_decklink.get_log_level",
+            mock_get_log_level,
+        ),
+        patch(
+            "bmd_sg.decklink.bmd_decklink.set_log_level",
+            mock_set_log_level,
+        ),
+        patch("bmd_sg.decklink.bmd_decklink.flush_log", mock_flush_log),
         # Also patch the SDK wrapper to prevent real library loading
         patch("bmd_sg.decklink.bmd_decklink.DecklinkSDKWrapper", MagicMock()),
+        patch("bmd_sg.decklink.bmd_decklink._native_binding", None),
     ]
 
     with contextlib.ExitStack() as stack:
@@ -250,6 +250,58 @@ class PatternGenerator:
 
         return o_image.astype(np.uint16)
 
+    def _expand_colors(self, colors: ArrayLike) -> np.ndarray:
+        """Expand 1-4 colors to the four checkerboard cell colors.
+
+        Parameters
+        ----------
+        colors : ArrayLike
+            Color array with shape (3,) or (1, 3) to (4, 3). See :meth:`generate`
+            for the expansion rules.
+
+        Returns
+        -------
+        np.ndarray
+            Array of 4 RGB colors with shape (4, 3).
+
+        Raises
+        ------
+        RuntimeError
+            If colors array has invalid shape.
+        """
+        colors = np.asarray(colors)
+
+        # Handle single color input: reshape (3,) to (1, 3)
+        if colors.shape == (3,):
+            colors = colors.reshape((1, 3))
+
+        # Validate input shape: must be 2D with 1-4 rows and exactly 3 columns
+        if (
+            colors.ndim != 2
+            or colors.shape[0] < 1
+            or colors.shape[0] > 4
+            or colors.shape[1] != 3
+        ):
+            raise RuntimeError(
+                "Colors must have shape (1,3) to (4,3), or single color shape (3,)"
+            )
+
+        num_colors = colors.shape[0]
+
+        # Expand colors to 4-color checkerboard pattern
+        if num_colors == 1:
+            # Single color: use same color for all four squares
+            colors = np.broadcast_to(colors, (4, 3))
+        elif num_colors == 2:
+            # Two colors: tile to create checkerboard of two colors
+            colors = colors[(0, 1, 1, 0), :]
+        elif num_colors == 3:
+            # Three colors: map to [color1, color2, color1, color3]
+            # This creates a pattern where color1 appears in top-left and bottom-right
+            colors = colors[(0, 1, 2, 0), :]
+
+        return np.asarray(colors)
+
     def generate(self, colors: ArrayLike) -> np.ndarray:
         """Generate a checkerboard pattern with the specified colors.
 
@@ -294,38 +346,61 @@ class PatternGenerator:
         >>> colors = [[255, 0, 0], [0, 255, 0], [0, 0, 255], [255, 255, 255]]
         >>> pattern = generator.generate(colors)
         """
-        colors = np.asarray(colors)
+        return self._draw_checkerboard_pattern(self._expand_colors(colors))
 
-        # Handle single color input: reshape (3,) to (1, 3)
-        if colors.shape == (3,):
-            colors = colors.reshape((1, 3))
+    def generate_rects(
+        self, colors: ArrayLike
+    ) -> list[tuple[int, int, int, int, np.ndarray]]:
+        """Describe the pattern as rectangles instead of a full image.
 
-        # Validate input shape: must be 2D with 1-4 rows and exactly 3 columns
-        if (
-            colors.ndim != 2
-            or colors.shape[0] < 1
-            or colors.shape[0] > 4
-            or colors.shape[1] != 3
-        ):
-            raise RuntimeError(
-                "Colors must have shape (1,3) to (4,3), or single color shape (3,)"
-            )
+        Returns the same pattern as :meth:`generate`, as a list of
+        ``(x, y, width, height, cell_colors)`` rectangles drawn over a black
+        background. ``cell_colors`` has shape (4, 3) and follows the
+        checkerboard cell order of :meth:`generate`. This form can be packed
+        natively without building a width x height x 3 array, see
+        ``BMDDeckLink.display_rect_pattern``.
 
-        num_colors = colors.shape[0]
+        Parameters
+        ----------
+        colors : ArrayLike
+            Color array, as accepted by :meth:`generate`.
 
-        # Expand colors to 4-color checkerboard pattern
-        if num_colors == 1:
-            # Single color: use same color for all four squares
-            colors = np.broadcast_to(colors, (4, 3))
-        elif num_colors == 2:
-            # Two colors: tile to create checkerboard of two colors
-            colors = colors[(0, 1, 1, 0), :]
-        elif num_colors == 3:
-            # Three colors: map to [color1, color2, color1, color3]
-            # This creates a pattern where color1 appears in top-left and bottom-right
-            colors = colors[(0, 1, 2, 0), :]
+        Returns
+        -------
+        list[tuple[int, int, int, int, np.ndarray]]
+            Rectangles in drawing order. Empty if the ROI lies outside the
+            image.
 
-        return self._draw_checkerboard_pattern(colors)
+        Raises
+        ------
+        RuntimeError
+            If colors array has invalid shape.
+        ColorRangeError
+            If color values exceed bit depth limits.
+
+        Examples
+        --------
+        >>> generator = PatternGenerator(bit_depth=8, width=100, height=100)
+        >>> generator.generate_rects([255, 0, 0])[0][:4]
+        (0, 0, 100, 100)
+        """
+        colors = self._expand_colors(colors).astype(np.uint16)
+        if not _validate_color(colors, self.bit_depth):
+            raise ColorRangeError(f"Bit depth: {self.bit_depth:d}")
+
+        roi_y_end = min(self.roi.y2, self.height)
+        roi_x_end = min(self.roi.x2, self.width)
+        if roi_x_end <= self.roi.x or roi_y_end <= self.roi.y:
+            return []
+        return [
+            (
+                self.roi.x,
+                self.roi.y,
+                roi_x_end - self.roi.x,
+                roi_y_end - self.roi.y,
+                colors,
+            )
+        ]
 
 
 # Default pattern generator for common 1080p 12-bit use case
@@ -0,0 +1,266 @@
+#include "capability_matrix.h"
+#include "logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <sys/stat.h>
+
+static const char kMagic[8] = {'B', 'M', 'D', 'C', 'A', 'P', 'S', '\0'};
+
+// Cache file layout, in host byte order: the header, then entryCount
+// DeckLinkCapability records
+struct CapabilityFileHeader
+{
+    char magic[8]; // "BMDCAPS\0"
+    uint32_t version;
+    uint32_t entrySize; // sizeof(DeckLinkCapability)
+    uint64_t entryCount;
+    int64_t deviceId;
+    char driverVersion[32]; // NUL terminated
+};
+
+static_assert(sizeof(DeckLinkCapability) == 40, "DeckLinkCapability is part of the file format");
+static_assert(sizeof(CapabilityFileHeader) == 64, "CapabilityFileHeader is part of the file format");
+
+// Every connection a device can report in BMDDeckLinkVideoOutputConnections
+static const BMDVideoConnection kConnections[] = {
+    bmdVideoConnectionSDI,       bmdVideoConnectionHDMI,      bmdVideoConnectionOpticalSDI,
+    bmdVideoConnectionComponent, bmdVideoConnectionComposite, bmdVideoConnectionSVideo,
+};
+
+const std::vector<BMDPixelFormat>& CapabilityMatrix::probedPixelFormats() {
+    static const std::vector<BMDPixelFormat> formats = [] {
+        std::vector<BMDPixelFormat> list = {
+            bmdFormat8BitYUV,     // '2vuy' 4:2:2 Representation
+            bmdFormat10BitYUV,    // 'v210' 4:2:2 Representation
+            bmdFormat10BitYUVA,   // 'Ay10' 4:2:2 raw
+            bmdFormat8BitARGB,    // 32     4:4:4:4 raw
+            bmdFormat8BitBGRA,    // 'BGRA' 4:4:4:x raw
+            bmdFormat10BitRGB,    // 'r210' 4:4:4 raw
+            bmdFormat12BitRGB,    // 'R12B' Big-endian RGB 12-bit per component
+            bmdFormat12BitRGBLE,  // 'R12L' Little-endian RGB 12-bit per component
+            bmdFormat10BitRGBXLE, // 'R10l' Three 10-bit components in a 32-bit little-endian word
+            bmdFormat10BitRGBX,   // 'R10b' Three 10-bit components in a 32-bit big-endian word
+        };
+        std::sort(list.begin(), list.end());
+        return list;
+    }();
+    return formats;
+}
+
+static bool probe(IDeckLinkOutput* output, BMDVideoConnection connection, BMDDisplayMode displayMode,
+                  BMDPixelFormat pixelFormat) {
+    BMDDisplayMode actualMode;
+    bool supported = false;
+    return output->DoesSupportVideoMode(connection, displayMode, pixelFormat, bmdNoVideoOutputConversion,
+                                        bmdSupportedVideoModeDefault, &actualMode, &supported) == S_OK &&
+           supported;
+}
+
+bool CapabilityMatrix::build(IDeckLinkOutput* output, int64_t connections) {
+    m_entries.clear();
+    IDeckLinkDisplayModeIterator* iterator = nullptr;
+    if (!output || output->GetDisplayModeIterator(&iterator) != S_OK || !iterator) return false;
+
+    IDeckLinkDisplayMode* mode = nullptr;
+    while (iterator->Next(&mode) == S_OK && mode) {
+        DeckLinkCapability entry = {};
+        entry.displayMode = static_cast<uint32_t>(mode->GetDisplayMode());
+        entry.width = static_cast<int32_t>(mode->GetWidth());
+        entry.height = static_cast<int32_t>(mode->GetHeight());
+        BMDTimeValue frameDuration = 0;
+        BMDTimeScale timeScale = 0;
+        if (mode->GetFrameRate(&frameDuration, &timeScale) == S_OK) {
+            entry.frameDuration = frameDuration;
+            entry.timeScale = timeScale;
+        }
+        mode->Release();
+        mode = nullptr;
+
+        for (BMDPixelFormat format : probedPixelFormats()) {
+            BMDDisplayMode displayMode = static_cast<BMDDisplayMode>(entry.displayMode);
+            entry.pixelFormat = static_cast<uint32_t>(format);
+            entry.defaultConnection = probe(output, bmdVideoConnectionUnspecified, displayMode, format) ? 1 : 0;
+            entry.connections = 0;
+            for (BMDVideoConnection connection : kConnections) {
+                if ((connections & connection) && probe(output, connection, displayMode, format)) {
+                    entry.connections |= static_cast<uint32_t>(connection);
+                }
+            }
+            if (entry.defaultConnection || entry.connections) {
+                m_entries.push_back(entry);
+            }
+        }
+    }
+    iterator->Release();
+    return true;
+}
+
+bool CapabilityMatrix::load(const std::string& path, int64_t deviceId, const std::string& driverVersion) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    CapabilityFileHeader header;
+    std::vector<DeckLinkCapability> entries;
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+              std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 && header.version == kFileVersion &&
+              header.entrySize == sizeof(DeckLinkCapability) && header.deviceId == deviceId &&
+              header.driverVersion[sizeof(header.driverVersion) - 1] == '\0' &&
+              driverVersion == header.driverVersion && header.entryCount <= 1u << 20;
+    if (ok) {
+        entries.resize(header.entryCount);
+        ok = std::fread(entries.data(), sizeof(DeckLinkCapability), entries.size(), file) == entries.size();
+    }
+    std::fclose(file);
+    if (!ok) return false;
+    m_entries = std::move(entries);
+    return true;
+}
+
+// Written to a temporary file first and renamed over the old one, so a
+// reader in another process never sees a partial matrix
+bool CapabilityMatrix::save(const std::string& path, int64_t deviceId, const std::string& driverVersion) const {
+    if (driverVersion.size() >= sizeof(CapabilityFileHeader::driverVersion)) return false;
+    CapabilityFileHeader header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFileVersion;
+    header.entrySize = sizeof(DeckLinkCapability);
+    header.entryCount = m_entries.size();
+    header.deviceId = deviceId;
+    std::memcpy(header.driverVersion, driverVersion.c_str(), driverVersion.size());
+
+    std::string temporary = path + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(m_entries.data(), sizeof(DeckLinkCapability), m_entries.size(), file) ==
+                  m_entries.size();
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool CapabilityMatrix::supports(BMDDisplayMode displayMode, BMDPixelFormat pixelFormat) const {
+    for (const auto& entry : m_entries) {
+        if (entry.displayMode == static_cast<uint32_t>(displayMode) &&
+            entry.pixelFormat == static_cast<uint32_t>(pixelFormat)) {
+            return entry.defaultConnection != 0;
+        }
+    }
+    return false;
+}
+
+std::vector<BMDPixelFormat> CapabilityMatrix::pixelFormats(BMDDisplayMode displayMode) const {
+    std::vector<BMDPixelFormat> formats;
+    for (const auto& entry : m_entries) {
+        if (entry.displayMode == static_cast<uint32_t>(displayMode) && entry.defaultConnection) {
+            formats.push_back(static_cast<BMDPixelFormat>(entry.pixelFormat));
+        }
+    }
+    return formats;
+}
+
+// ~/Library/Caches/bmd-signal-gen, created on first use. Empty if HOME is
+// not set or the directory cannot be created.
+static std::string cache_directory() {
+    const char* home = std::getenv("HOME");
+    if (!home || !*home) return "";
+    std::string directory = std::string(home) + "/Library/Caches/bmd-signal-gen";
+    if (mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) return "";
+    return directory;
+}
+
+static std::string cache_path(const std::string& directory, int64_t deviceId) {
+    char name[48];
+    std::snprintf(name, sizeof(name), "/capabilities-%016llx.bin",
+                  static_cast<unsigned long long>(static_cast<uint64_t>(deviceId)));
+    return directory + name;
+}
+
+static int64_t output_connections(IDeckLink* device) {
+    int64_t connections = 0;
+    IDeckLinkProfileAttributes* attributes = nullptr;
+    if (device && device->QueryInterface(IID_IDeckLinkProfileAttributes, (void**)&attributes) == S_OK &&
+        attributes) {
+        if (attributes->GetInt(BMDDeckLinkVideoOutputConnections, &connections) != S_OK) {
+            connections = 0;
+        }
+        attributes->Release();
+    }
+    return connections;
+}
+
+// Runs on the probing thread, which holds its own references to both
+// interfaces
+static std::shared_ptr<const CapabilityMatrix> probe_device(IDeckLink* device, IDeckLinkOutput* output,
+                                                            int64_t deviceId, const std::string& driverVersion) {
+    auto matrix = std::make_shared<CapabilityMatrix>();
+    std::string directory = deviceId != 0 ? cache_directory() : "";
+    std::string path = directory.empty() ? "" : cache_path(directory, deviceId);
+    bool loaded = !path.empty() && matrix->load(path, deviceId, driverVersion);
+
+    if (!loaded) {
+        auto start = std::chrono::steady_clock::now();
+        bool built = matrix->build(output, output_connections(device));
+        auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        if (!built) {
+            LOG_WARNING("[Capabilities] Could not list display modes, support is probed per call");
+            matrix.reset();
+        } else {
+            LOG_INFO("[Capabilities] Probed " << matrix->entries().size() << " supported mode and format pairs in "
+                     << elapsedUs << " us");
+            if (!path.empty() && !matrix->save(path, deviceId, driverVersion)) {
+                LOG_WARNING("[Capabilities] Could not write " << path);
+            }
+        }
+    } else {
+        LOG_DEBUG("[Capabilities] Loaded " << matrix->entries().size() << " mode and format pairs from " << path);
+    }
+
+    output->Release();
+    if (device) {
+        device->Release();
+    }
+    return matrix;
+}
+
+CapabilityFuture device_capabilities(IDeckLink* device, IDeckLinkOutput* output, int64_t deviceId,
+                                     const std::string& driverVersion) {
+    // Futures of devices with an ID live for the whole process; the last
+    // one left at exit waits for its probe to finish. A failed probe is
+    // dropped once finished, so the next call probes again.
+    static std::mutex mutex;
+    static std::map<int64_t, CapabilityFuture> devices;
+
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if (deviceId != 0) {
+        lock.lock();
+        auto found = devices.find(deviceId);
+        if (found != devices.end()) {
+            bool failed = found->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+                          !found->second.get();
+            if (!failed) return found->second;
+            devices.erase(found);
+        }
+    }
+
+    output->AddRef();
+    if (device) {
+        device->AddRef();
+    }
+    CapabilityFuture future =
+        std::async(std::launch::async, probe_device, device, output, deviceId, driverVersion).share();
+    if (deviceId != 0) {
+        devices.emplace(deviceId, future);
+    }
+    return future;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "DeckLinkAPI.h"
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One supported display mode and pixel format pair, as returned by
+// decklink_get_capabilities()
+struct DeckLinkCapability
+{
+    uint32_t displayMode;      // BMDDisplayMode
+    uint32_t pixelFormat;      // BMDPixelFormat
+    uint32_t connections;      // BMDVideoConnection bits the pair is supported on
+    int32_t defaultConnection; // 1 if supported with bmdVideoConnectionUnspecified, as output uses it
+    int32_t width;
+    int32_t height;
+    int64_t frameDuration;
+    int64_t timeScale;
+};
+
+// Display mode x pixel format x connection support of one output, probed
+// once with DoesSupportVideoMode. Only pairs supported on at least one
+// connection are kept, mode by mode in the order of the display mode
+// iterator and formats in code order within a mode.
+class CapabilityMatrix
+{
+public:
+    // Version of the cache file layout; older files are probed again
+    static constexpr uint32_t kFileVersion = 1;
+
+    // Probes every display mode of output against every pixel format
+    // pack_pixel_format() writes, with the default connection and each bit
+    // of connections (BMDDeckLinkVideoOutputConnections). Returns false if
+    // the display modes could not be listed.
+    bool build(IDeckLinkOutput *output, int64_t connections);
+    // Both return false on any failure; a file written by another driver
+    // version, device or layout is not loaded
+    bool load(const std::string &path, int64_t deviceId, const std::string &driverVersion);
+    bool save(const std::string &path, int64_t deviceId, const std::string &driverVersion) const;
+
+    // Support with the default connection
+    bool supports(BMDDisplayMode displayMode, BMDPixelFormat pixelFormat) const;
+    std::vector<BMDPixelFormat> pixelFormats(BMDDisplayMode displayMode) const;
+    const std::vector<DeckLinkCapability> &entries() const { return m_entries; }
+
+    // Pixel formats every mode is probed with, in code order
+    static const std::vector<BMDPixelFormat> &probedPixelFormats();
+
+private:
+    std::vector<DeckLinkCapability> m_entries;
+};
+
+using CapabilityFuture = std::shared_future<std::shared_ptr<const CapabilityMatrix>>;
+
+// Starts building the matrix of an opened output on a background thread and
+// returns right away. Devices are shared by deviceId (persistent or
+// topological ID, 0 if neither is known) for the whole process and persisted
+// in the user's cache directory, keyed by device ID and driver version, so
+// later opens and later runs read the matrix instead of probing the driver.
+// Outputs without an ID are probed every time. The future holds nullptr if
+// probing failed; failures are neither shared nor persisted, so the next
+// call for the device probes again.
+CapabilityFuture device_capabilities(IDeckLink *device, IDeckLinkOutput *output, int64_t deviceId,
+                                     const std::string &driverVersion);
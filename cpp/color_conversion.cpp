@@ -0,0 +1,132 @@
+#include "color_conversion.h"
+#include <algorithm>
+#include <cmath>
+
+/*
+ * RGB to Y'CbCr conversion
+ * 
+ * With luma weights Kr, Kg, Kb and E' = RGB / (2^n - 1):
+ * 
+ *   Y  = (Kr R' + Kg G' + Kb B') * yScale + yOffset
+ *   Cb = (B' - Y') / (2 (1 - Kb)) * cScale + 2^(n-1)
+ *   Cr = (R' - Y') / (2 (1 - Kr)) * cScale + 2^(n-1)
+ * 
+ * Narrow range uses yScale = 219 * 2^(n-8), yOffset = 16 * 2^(n-8) and
+ * cScale = 224 * 2^(n-8); full range scales both to 2^n - 1.
+ * 
+ * The weights become Q16 integers. Green absorbs the rounding so whites map
+ * to exactly the nominal peak and greys to exactly zero chroma.
+ */
+
+static constexpr int kFractionBits = 16;
+
+static void luma_weights(YCbCrMatrix matrix, double& kr, double& kb) {
+    switch (matrix) {
+        case YCbCrMatrix::Rec601:
+            kr = 0.299;
+            kb = 0.114;
+            break;
+        case YCbCrMatrix::Rec2020:
+            kr = 0.2627;
+            kb = 0.0593;
+            break;
+        default:
+            kr = 0.2126;
+            kb = 0.0722;
+            break;
+    }
+}
+
+static int32_t to_fixed(double value) {
+    return static_cast<int32_t>(std::lround(value * (1 << kFractionBits)));
+}
+
+YCbCrCoefficients make_ycbcr_coefficients(YCbCrMatrix matrix, bool fullRange,
+                                          ChromaFilter chromaFilter, int bitDepth) {
+    double kr, kb;
+    luma_weights(matrix, kr, kb);
+    double maxIn = static_cast<double>((1 << bitDepth) - 1);
+    double step = static_cast<double>(1 << (bitDepth - 8));
+    double yScale = (fullRange ? maxIn : 219.0 * step) / maxIn;
+    double cScale = (fullRange ? maxIn : 224.0 * step) / maxIn;
+    double yOffset = fullRange ? 0.0 : 16.0 * step;
+    
+    YCbCrCoefficients c;
+    c.y[0] = to_fixed(kr * yScale);
+    c.y[2] = to_fixed(kb * yScale);
+    c.y[1] = to_fixed(yScale) - c.y[0] - c.y[2];
+    
+    c.cb[0] = to_fixed(-kr / (2.0 * (1.0 - kb)) * cScale);
+    c.cb[2] = to_fixed(0.5 * cScale);
+    c.cb[1] = -c.cb[0] - c.cb[2];
+    
+    c.cr[0] = to_fixed(0.5 * cScale);
+    c.cr[2] = to_fixed(-kb / (2.0 * (1.0 - kr)) * cScale);
+    c.cr[1] = -c.cr[0] - c.cr[2];
+    
+    c.yOffset = to_fixed(yOffset) + (1 << (kFractionBits - 1));
+    // Chroma is filtered at 4x weight, hence the two extra fraction bits
+    c.cOffset = ((1 << (bitDepth - 1)) << (kFractionBits + 2)) + (1 << (kFractionBits + 1));
+    c.maxValue = (1 << bitDepth) - 1;
+    c.chromaFilter = chromaFilter;
+    return c;
+}
+
+static inline uint16_t clamp_output(int32_t value, int32_t maxValue) {
+    return static_cast<uint16_t>(std::clamp(value, 0, maxValue));
+}
+
+void convert_rgb_row_to_ycbcr(const uint16_t* rgb, uint16_t* ycbcr, int width,
+                              const YCbCrCoefficients& c) {
+    const int32_t maxIn = c.maxValue;
+    auto component = [maxIn](const uint16_t* pixel, int i) {
+        return std::min<int32_t>(pixel[i], maxIn);
+    };
+    
+    // Chroma of the odd pixel before the current pair, for the triangle filter
+    int32_t previousCb = 0, previousCr = 0;
+    for (int x = 0; x < width; x += 2) {
+        const uint16_t* p0 = rgb + x * 3;
+        const uint16_t* p1 = x + 1 < width ? p0 + 3 : p0;
+        int32_t r0 = component(p0, 0), g0 = component(p0, 1), b0 = component(p0, 2);
+        int32_t r1 = component(p1, 0), g1 = component(p1, 1), b1 = component(p1, 2);
+        
+        int32_t cb0 = c.cb[0] * r0 + c.cb[1] * g0 + c.cb[2] * b0;
+        int32_t cr0 = c.cr[0] * r0 + c.cr[1] * g0 + c.cr[2] * b0;
+        int32_t cb1 = c.cb[0] * r1 + c.cb[1] * g1 + c.cb[2] * b1;
+        int32_t cr1 = c.cr[0] * r1 + c.cr[1] * g1 + c.cr[2] * b1;
+        if (x == 0) {
+            previousCb = cb0;
+            previousCr = cr0;
+        }
+        
+        // Weighted to a total of 4 for every filter
+        int32_t cb, cr;
+        switch (c.chromaFilter) {
+            case ChromaFilter::Average:
+                cb = 2 * (cb0 + cb1);
+                cr = 2 * (cr0 + cr1);
+                break;
+            case ChromaFilter::Triangle:
+                cb = previousCb + 2 * cb0 + cb1;
+                cr = previousCr + 2 * cr0 + cr1;
+                break;
+            default:
+                cb = 4 * cb0;
+                cr = 4 * cr0;
+                break;
+        }
+        previousCb = cb1;
+        previousCr = cr1;
+        
+        uint16_t* out = ycbcr + x * 3;
+        out[0] = clamp_output((c.y[0] * r0 + c.y[1] * g0 + c.y[2] * b0 + c.yOffset) >> kFractionBits, c.maxValue);
+        out[1] = clamp_output((cb + c.cOffset) >> (kFractionBits + 2), c.maxValue);
+        out[2] = clamp_output((cr + c.cOffset) >> (kFractionBits + 2), c.maxValue);
+        if (x + 1 < width) {
+            out[3] = clamp_output((c.y[0] * r1 + c.y[1] * g1 + c.y[2] * b1 + c.yOffset) >> kFractionBits, c.maxValue);
+            out[4] = out[1];
+            out[5] = out[2];
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+// Y'CbCr matrix applied to RGB sources of the 4:2:2 formats (C API values)
+enum class YCbCrMatrix : int32_t
+{
+    Auto = 0,    // chosen from the HDR metadata and frame size
+    Rec601 = 1,
+    Rec709 = 2,
+    Rec2020 = 3, // non-constant luminance
+    None = 4,    // source is already Y'CbCr, pack it unchanged
+};
+
+// How the chroma of a pixel pair is derived from its two pixels
+enum class ChromaFilter : int32_t
+{
+    CoSited = 0,  // even pixel only
+    Average = 1,  // mean of the pair
+    Triangle = 2, // [1 2 1] / 4 centred on the even pixel
+};
+
+struct YCbCrConversion
+{
+    YCbCrMatrix matrix;
+    bool fullRange;
+    ChromaFilter chromaFilter;
+};
+
+// Fixed-point (Q16) RGB to Y'CbCr coefficients for one bit depth
+struct YCbCrCoefficients
+{
+    int32_t y[3];
+    int32_t cb[3];
+    int32_t cr[3];
+    int32_t yOffset;   // Q16, including rounding
+    int32_t cOffset;   // Q18, including rounding
+    int32_t maxValue;
+    ChromaFilter chromaFilter;
+};
+
+// matrix must be Rec601, Rec709 or Rec2020. Source RGB is full range at the
+// same bit depth as the output.
+YCbCrCoefficients make_ycbcr_coefficients(YCbCrMatrix matrix, bool fullRange,
+                                          ChromaFilter chromaFilter, int bitDepth);
+
+// Converts one row of interleaved RGB into interleaved Y'CbCr. Every pixel
+// gets its luma, and both pixels of a pair get the pair's filtered chroma,
+// which the 4:2:2 packers read from the even pixel.
+void convert_rgb_row_to_ycbcr(const uint16_t* rgb, uint16_t* ycbcr, int width,
+                              const YCbCrCoefficients& coefficients);
@@ -0,0 +1,186 @@
+#include "color_lut.h"
+#include "frame_cache.h"
+#include "pixel_packing_simd.h"
+#include "logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/*
+ * Tetrahedral interpolation
+ *
+ * A source pixel falls into the cube cell whose lower corner is V0 at
+ * fractions (fr, fg, fb). Sorting the fractions into hi >= mid >= lo picks
+ * one of the six tetrahedra of the cell:
+ *
+ *   out = V0 * (1 - hi) + V1 * (hi - mid) + V2 * (mid - lo) + V3 * lo
+ *
+ * V1 is V0 one step along the axis of hi, V2 one step along the axes of hi
+ * and mid, and V3 the opposite corner. When fractions are equal the weight
+ * between them is zero, so which of the tied axes is taken does not matter.
+ * The kernels select the axes and compute the sum in exactly this order.
+ */
+
+static const int kDepthMaxValues[3] = {255, 1023, 4095};
+
+ColorLut::ColorLut()
+    : m_cubeSize(0)
+    , m_depths{}
+    , m_hash(0)
+{
+}
+
+static bool all_finite(const float* values, size_t count) {
+    return std::all_of(values, values + count, [](float value) { return std::isfinite(value); });
+}
+
+// Linear interpolation of one shaper channel at input 0-1
+static double shape(const float* shaper, int shaperSize, int channel, double input) {
+    double position = input * (shaperSize - 1);
+    int index = std::min(static_cast<int>(position), shaperSize - 2);
+    double fraction = position - index;
+    return shaper[index * 3 + channel] * (1.0 - fraction) + shaper[(index + 1) * 3 + channel] * fraction;
+}
+
+/**
+ * @brief Replaces the LUT and bakes its per-code tables
+ *
+ * @return int Returns 0 on success, -1 for invalid arguments, in which case
+ *         the LUT is left unchanged
+ */
+int ColorLut::build(const float* shaper, int shaperSize, const float* cube, int cubeSize) {
+    if (!shaper && !cube) return -1;
+    if (shaper && (shaperSize < 2 || shaperSize > kMaxShaperSize ||
+                   !all_finite(shaper, static_cast<size_t>(shaperSize) * 3))) {
+        LOG_ERROR("[ColorLut] Shaper needs 2 to " << kMaxShaperSize << " finite entries");
+        return -1;
+    }
+    const size_t vertexCount = cube ? static_cast<size_t>(cubeSize) * cubeSize * cubeSize : 0;
+    if (cube && (cubeSize < 2 || cubeSize > kMaxCubeSize || !all_finite(cube, vertexCount * 3))) {
+        LOG_ERROR("[ColorLut] Cube needs a size of 2 to " << kMaxCubeSize << " and finite entries");
+        return -1;
+    }
+
+    m_cubeSize = cube ? cubeSize : 0;
+    m_vertices.assign(vertexCount * 4, 0.0f);
+    for (size_t i = 0; i < vertexCount; i++) {
+        std::memcpy(&m_vertices[i * 4], &cube[i * 3], 3 * sizeof(float));
+    }
+
+    const int32_t stride[3] = {1, m_cubeSize, m_cubeSize * m_cubeSize};
+    for (int d = 0; d < 3; d++) {
+        DepthTables& tables = m_depths[d];
+        const int maxValue = kDepthMaxValues[d];
+        const size_t codes = static_cast<size_t>(maxValue) + 1;
+        tables.maxValue = maxValue;
+        tables.direct.assign(cube ? 0 : codes * 3, 0);
+        tables.cell.assign(cube ? codes * 3 : 0, 0);
+        tables.fraction.assign(cube ? codes * 3 : 0, 0.0f);
+
+        for (int c = 0; c < 3; c++) {
+            for (size_t code = 0; code < codes; code++) {
+                double value = static_cast<double>(code) / maxValue;
+                if (shaper) {
+                    value = shape(shaper, shaperSize, c, value);
+                }
+                value = std::clamp(value, 0.0, 1.0);
+                if (!cube) {
+                    tables.direct[c * codes + code] = static_cast<uint16_t>(value * maxValue + 0.5);
+                    continue;
+                }
+                // The top code lands on the far side of the last cell
+                double position = value * (m_cubeSize - 1);
+                int index = std::min(static_cast<int>(position), m_cubeSize - 2);
+                tables.cell[c * codes + code] = index * stride[c];
+                tables.fraction[c * codes + code] = static_cast<float>(position - index);
+            }
+        }
+
+        LutCubeTables& view = tables.cube;
+        for (int c = 0; c < 3; c++) {
+            view.cell[c] = cube ? tables.cell.data() + c * codes : nullptr;
+            view.fraction[c] = cube ? tables.fraction.data() + c * codes : nullptr;
+            view.stride[c] = stride[c];
+        }
+        view.vertices = cube ? m_vertices.data() : nullptr;
+        view.maxValue = maxValue;
+    }
+
+    const int32_t sizes[2] = {shaper ? shaperSize : 0, m_cubeSize};
+    uint64_t hash = hash_frame_bytes(sizes, sizeof(sizes));
+    if (shaper) {
+        hash = hash_frame_bytes(shaper, static_cast<size_t>(shaperSize) * 3 * sizeof(float), hash);
+    }
+    if (cube) {
+        hash = hash_frame_bytes(cube, vertexCount * 3 * sizeof(float), hash);
+    }
+    // 0 stands for no LUT in the packing settings
+    m_hash = hash ? hash : 1;
+    LOG_INFO("[ColorLut] Built " << (shaper ? shaperSize : 0) << "-entry shaper, "
+             << m_cubeSize << "^3 cube");
+    return 0;
+}
+
+const ColorLut::DepthTables* ColorLut::tablesFor(int maxValue) const {
+    for (const DepthTables& tables : m_depths) {
+        if (tables.maxValue == maxValue) return &tables;
+    }
+    return nullptr;
+}
+
+void ColorLut::applyRow(const uint16_t* src, uint16_t* dest, int width, int maxValue) const {
+    const DepthTables* tables = tablesFor(maxValue);
+    if (!tables) {
+        std::memcpy(dest, src, static_cast<size_t>(width) * 3 * sizeof(uint16_t));
+        return;
+    }
+    if (m_cubeSize) {
+        // Vector kernel maps whole blocks, the scalar loop the rest
+        LutCubeRowKernel kernel = simd_row_kernels().lutCubeRow;
+        int x = kernel ? kernel(dest, src, width, tables->cube) : 0;
+        apply_lut_cube_row(dest + x * 3, src + x * 3, width - x, tables->cube);
+        return;
+    }
+
+    const size_t codes = static_cast<size_t>(maxValue) + 1;
+    const uint16_t* direct = tables->direct.data();
+    for (int i = 0; i < width * 3; i += 3) {
+        dest[i + 0] = direct[std::min<int>(src[i + 0], maxValue)];
+        dest[i + 1] = direct[codes + std::min<int>(src[i + 1], maxValue)];
+        dest[i + 2] = direct[2 * codes + std::min<int>(src[i + 2], maxValue)];
+    }
+}
+
+void apply_lut_cube_row(uint16_t* out, const uint16_t* src, int width, const LutCubeTables& tables) {
+    const float scale = static_cast<float>(tables.maxValue);
+    const int32_t allSteps = tables.stride[0] + tables.stride[1] + tables.stride[2];
+    for (int x = 0; x < width; x++, src += 3, out += 3) {
+        int r = std::min<int>(src[0], tables.maxValue);
+        int g = std::min<int>(src[1], tables.maxValue);
+        int b = std::min<int>(src[2], tables.maxValue);
+        float fr = tables.fraction[0][r];
+        float fg = tables.fraction[1][g];
+        float fb = tables.fraction[2][b];
+        int32_t base = tables.cell[0][r] + tables.cell[1][g] + tables.cell[2][b];
+
+        float hi = std::max(std::max(fr, fg), fb);
+        float lo = std::min(std::min(fr, fg), fb);
+        float mid = std::max(std::min(fr, fg), std::min(std::max(fr, fg), fb));
+        int32_t hiStep = (fr >= fg && fr >= fb) ? tables.stride[0] : (fg >= fb) ? tables.stride[1] : tables.stride[2];
+        int32_t loStep = (fr <= fg && fr <= fb) ? tables.stride[0] : (fg <= fb) ? tables.stride[1] : tables.stride[2];
+        const float w0 = 1.0f - hi;
+        const float w1 = hi - mid;
+        const float w2 = mid - lo;
+        const float w3 = lo;
+
+        const float* v0 = tables.vertices + static_cast<size_t>(base) * 4;
+        const float* v1 = tables.vertices + static_cast<size_t>(base + hiStep) * 4;
+        const float* v2 = tables.vertices + static_cast<size_t>(base + allSteps - loStep) * 4;
+        const float* v3 = tables.vertices + static_cast<size_t>(base + allSteps) * 4;
+        for (int c = 0; c < 3; c++) {
+            float value = ((v0[c] * w0 + v1[c] * w1) + v2[c] * w2) + v3[c] * w3;
+            value = std::min(std::max(value, 0.0f), 1.0f);
+            out[c] = static_cast<uint16_t>(value * scale + 0.5f);
+        }
+    }
+}
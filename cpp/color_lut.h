@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Tables of a 3D LUT for sources of one bit depth, laid out for the row
+// kernels. Codes above maxValue are looked up as maxValue.
+struct LutCubeTables
+{
+    const int32_t *cell[3];   // per code and channel: lower cell corner times stride
+    const float *fraction[3]; // per code and channel: position inside the cell, 0 to 1
+    const float *vertices;    // cubeSize^3 vertices of 4 floats (R, G, B, unused)
+    int32_t stride[3];        // vertex step in R, G and B: 1, N and N * N
+    int32_t maxValue;
+};
+
+// Display-correction LUT applied to RGB sources while they are packed: an
+// optional per-channel 1D shaper followed by an optional 3D cube, both on
+// values normalized to 0-1. The shaper is interpolated linearly and the cube
+// tetrahedrally.
+//
+// Sources are integer codes of 8, 10 or 12 bits, so build() bakes the shaper
+// and the cube coordinates into per-code tables for each depth. Applying the
+// LUT is then one lookup per channel plus the interpolation of one
+// tetrahedron, and with no cube only the lookup. The result is rounded back
+// to the bit depth of the source.
+class ColorLut
+{
+public:
+    static constexpr int kMaxShaperSize = 65536;
+    static constexpr int kMaxCubeSize = 129;
+
+    ColorLut();
+
+    ColorLut(const ColorLut &) = delete;
+    ColorLut &operator=(const ColorLut &) = delete;
+
+    // shaper holds shaperSize RGB triples on a uniform input grid, cube holds
+    // cubeSize^3 RGB triples with red changing fastest, then green, as in
+    // .cube files. Either may be null, not both. Returns 0 on success, -1
+    // for invalid sizes or values that are not finite.
+    int build(const float *shaper, int shaperSize, const float *cube, int cubeSize);
+
+    // Changes whenever the contents change; part of the frame cache key
+    uint64_t hash() const { return m_hash; }
+
+    // Maps one row of interleaved RGB with components of up to maxValue
+    // (255, 1023 or 4095) to dest, clamped to maxValue
+    void applyRow(const uint16_t *src, uint16_t *dest, int width, int maxValue) const;
+
+private:
+    // Per-code tables of one bit depth
+    struct DepthTables
+    {
+        int maxValue;
+        std::vector<uint16_t> direct; // shaper only: output code, 3 * (maxValue + 1)
+        std::vector<int32_t> cell;
+        std::vector<float> fraction;
+        LutCubeTables cube;
+    };
+
+    const DepthTables *tablesFor(int maxValue) const;
+
+    int m_cubeSize;
+    std::vector<float> m_vertices;
+    DepthTables m_depths[3];
+    uint64_t m_hash;
+};
+
+// Scalar form of the cube row kernels in pixel_packing_simd.cpp, which must
+// match it bit for bit
+void apply_lut_cube_row(uint16_t *out, const uint16_t *src, int width, const LutCubeTables &tables);
@@ -0,0 +1,136 @@
+#include "completion_events.h"
+#include "logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+CompletionEvents::CompletionEvents()
+    : m_readFd(-1)
+    , m_writeFd(-1)
+    , m_scheduledFrames(0)
+    , m_eventsDropped(0)
+{
+}
+
+CompletionEvents::~CompletionEvents() {
+    disable();
+}
+
+int CompletionEvents::enable() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_readFd >= 0) return m_readFd;
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        LOG_ERROR("[CompletionEvents] Cannot create the notification pipe (errno " << errno << ")");
+        return -1;
+    }
+    for (int fd : fds) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    m_readFd = fds[0];
+    m_writeFd = fds[1];
+    m_eventsDropped = 0;
+    LOG_INFO("[CompletionEvents] Reporting frame completions on descriptor " << m_readFd);
+    return m_readFd;
+}
+
+void CompletionEvents::disable() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    closePipeLocked();
+}
+
+void CompletionEvents::closePipeLocked() {
+    if (m_readFd >= 0) {
+        ::close(m_readFd);
+        ::close(m_writeFd);
+    }
+    m_readFd = -1;
+    m_writeFd = -1;
+    m_scheduled.clear();
+    m_events.clear();
+}
+
+uint64_t CompletionEvents::frameScheduled(IDeckLinkVideoFrame* frame, BMDTimeValue streamTime,
+                                          BMDTimeScale timeScale) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t frameNumber = m_scheduledFrames++;
+    if (m_readFd < 0) return frameNumber;
+    m_scheduled.push_back({frame, frameNumber, streamTime, timeScale});
+    if (m_scheduled.size() > kMaxScheduled) {
+        m_scheduled.pop_front();
+    }
+    return frameNumber;
+}
+
+void CompletionEvents::scheduleFailed(IDeckLinkVideoFrame* frame) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_scheduled.rbegin(), m_scheduled.rend(),
+                           [frame](const ScheduledFrame& scheduled) { return scheduled.frame == frame; });
+    if (it != m_scheduled.rend()) {
+        m_scheduled.erase(std::next(it).base());
+    }
+    // Schedules come from one thread at a time, so the refused frame holds
+    // the latest number
+    m_scheduledFrames--;
+}
+
+void CompletionEvents::frameCompleted(IDeckLinkVideoFrame* frame, BMDOutputFrameCompletionResult result,
+                                      BMDTimeValue completionTimestamp) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_readFd < 0) return;
+    // Completions arrive in queue order, so the oldest showing of the frame
+    // is the one that completed
+    auto it = std::find_if(m_scheduled.begin(), m_scheduled.end(),
+                           [frame](const ScheduledFrame& scheduled) { return scheduled.frame == frame; });
+    if (it == m_scheduled.end()) return;
+
+    FrameCompletionEvent event;
+    event.frameNumber = it->frameNumber;
+    event.streamTime = it->streamTime;
+    event.timeScale = it->timeScale;
+    event.completionTimestamp = completionTimestamp;
+    event.result = static_cast<int32_t>(result);
+    event.reserved = 0;
+    m_scheduled.erase(it);
+
+    bool wasEmpty = m_events.empty();
+    m_events.push_back(event);
+    if (m_events.size() > kMaxEvents) {
+        m_events.pop_front();
+        m_eventsDropped++;
+    }
+    if (wasEmpty) {
+        const char byte = 1;
+        // Cannot fill up: at most one byte is ever in the pipe
+        (void)::write(m_writeFd, &byte, 1);
+    }
+}
+
+int CompletionEvents::read(FrameCompletionEvent* events, int capacity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    int count = 0;
+    while (count < capacity && !m_events.empty()) {
+        events[count++] = m_events.front();
+        m_events.pop_front();
+    }
+    if (m_events.empty() && m_readFd >= 0) {
+        char bytes[16];
+        while (::read(m_readFd, bytes, sizeof(bytes)) > 0) {
+        }
+    }
+    return count;
+}
+
+CompletionStatus CompletionEvents::status() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CompletionStatus status;
+    status.scheduledFrames = m_scheduledFrames;
+    status.pendingEvents = m_events.size();
+    status.eventsDropped = m_eventsDropped;
+    status.enabled = m_readFd >= 0 ? 1 : 0;
+    status.reserved = 0;
+    return status;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "DeckLinkAPI.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+// Reported by decklink_read_completion_events() for every scheduled frame
+// that completed while completion events were enabled
+struct FrameCompletionEvent
+{
+    uint64_t frameNumber;        // position among every frame the output scheduled, from 0
+    int64_t streamTime;          // stream time the frame was scheduled at
+    int64_t timeScale;           // units of streamTime per second
+    int64_t completionTimestamp; // hardware reference time in ns, 0 if unavailable
+    int32_t result;              // BMDOutputFrameCompletionResult
+    int32_t reserved;
+};
+
+// Counters reported by decklink_get_completion_status()
+struct CompletionStatus
+{
+    uint64_t scheduledFrames; // frames scheduled so far; the last one is number scheduledFrames - 1
+    uint64_t pendingEvents;   // completed and not read yet
+    uint64_t eventsDropped;   // events lost because nobody read them in time
+    int32_t enabled;          // 1 while the descriptor is open
+    int32_t reserved;
+};
+
+// Frame completions from ScheduledFrameCompleted, queued for a reader that
+// polls a file descriptor instead of blocking a thread per wait.
+//
+// The descriptor is the read end of a non-blocking pipe, which kqueue,
+// epoll and select all accept, so an event loop such as asyncio can watch it
+// directly. It is readable exactly while unread events are queued: the
+// first event written to an empty queue writes one byte, and read() drains
+// the pipe when it empties the queue.
+class CompletionEvents
+{
+public:
+    CompletionEvents();
+    ~CompletionEvents();
+
+    CompletionEvents(const CompletionEvents &) = delete;
+    CompletionEvents &operator=(const CompletionEvents &) = delete;
+
+    // Returns the descriptor, the same one while enabled, or -1 if no pipe
+    // could be created. Only frames scheduled from now on are reported.
+    int enable();
+    // Closes the descriptor, which the caller must have stopped watching,
+    // and drops unread events
+    void disable();
+
+    // Scheduling side, called before the frame is handed to the driver so
+    // its completion always finds it: numbers the frame and, while enabled,
+    // remembers it for its completion. Returns the frame's number.
+    uint64_t frameScheduled(IDeckLinkVideoFrame *frame, BMDTimeValue streamTime, BMDTimeScale timeScale);
+    // Takes back the latest frameScheduled() of a frame the driver refused
+    void scheduleFailed(IDeckLinkVideoFrame *frame);
+    // Driver's completion thread
+    void frameCompleted(IDeckLinkVideoFrame *frame, BMDOutputFrameCompletionResult result,
+                        BMDTimeValue completionTimestamp);
+
+    // Moves up to capacity of the oldest events to events and returns how
+    // many, 0 if none are pending
+    int read(FrameCompletionEvent *events, int capacity);
+    CompletionStatus status() const;
+
+private:
+    static constexpr size_t kMaxEvents = 1024;
+    // Far more than any frame pool; only exceeded if completions stop coming
+    static constexpr size_t kMaxScheduled = 1024;
+
+    struct ScheduledFrame
+    {
+        IDeckLinkVideoFrame *frame;
+        uint64_t frameNumber;
+        BMDTimeValue streamTime;
+        BMDTimeScale timeScale;
+    };
+
+    void closePipeLocked();
+
+    mutable std::mutex m_mutex;
+    int m_readFd;
+    int m_writeFd;
+    uint64_t m_scheduledFrames;
+    uint64_t m_eventsDropped;
+    // In the order they were scheduled; a frame queued several times is
+    // listed once per showing and completes oldest first
+    std::deque<ScheduledFrame> m_scheduled;
+    std::deque<FrameCompletionEvent> m_events;
+};
@@ -1,10 +1,16 @@
 #include "decklink_wrapper.h"
 #include "pixel_packing.h"
-#include <iostream>
+#include "output_callback.h"
+#include "output_group.h"
+#include "mock_output.h"
+#include "device_registry.h"
+#include "frame_library.h"
+#include "worker_pool.h"
+#include "logger.h"
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include "DeckLinkAPIVersion.h"
-#include <CoreFoundation/CoreFoundation.h>
 
 // Helper function to convert a 32-bit integer to 4-character ASCII code
 std::string fourCharCode(int value) {
@@ -20,6 +26,48 @@ std::string fourCharCode(int value) {
     return std::string(chars);
 }
 
+// Frames kept per output: one on screen, one being filled, one spare so a new
+// patch never has to wait for the previous frame to be recycled.
+static const size_t kFramePoolSize = 3;
+
+// Scheduled playback keeps a short ring of frames queued ahead of scanout on
+// top of the frames needed for synchronous display.
+static const size_t kScheduledPrerollFrames = 3;
+static const size_t kScheduledFramePoolSize = kFramePoolSize + kScheduledPrerollFrames;
+
+// The frame pipeline also holds a frame being displayed and the packed
+// frames waiting for it, on top of the synchronous frames
+static const size_t kPipelineFramePoolSize = kFramePoolSize + 2;
+
+// A patch sequence keeps the preroll ring queued on top of the frame on screen
+static const size_t kSequenceQueuedFrames = kScheduledPrerollFrames + 1;
+
+// Units of the frame completion timestamps in sequence events
+static const BMDTimeScale kNanosecondTimeScale = 1000000000;
+
+// How long the frame pipeline may take to display what was submitted
+static const std::chrono::milliseconds kPipelineFlushTimeout(5000);
+
+// How long createFrame() waits for the hardware to hand a frame back while
+// scheduled playback has the whole ring queued.
+static const std::chrono::milliseconds kFrameAcquireTimeout(1000);
+
+// RGB formats go out as 4:4:4 SDI; everything else uses the 4:2:2 link
+static bool is_444_format(BMDPixelFormat pixelFormat) {
+    switch (pixelFormat) {
+        case bmdFormat10BitRGB:
+        case bmdFormat12BitRGB:
+        case bmdFormat12BitRGBLE:
+        case bmdFormat10BitRGBXLE:
+        case bmdFormat10BitRGBX:
+        case bmdFormat8BitARGB:
+        case bmdFormat8BitBGRA:
+            return true;
+        default:
+            return false;
+    }
+}
+
 // DeckLinkSignalGen Implementation
 DeckLinkSignalGen::DeckLinkSignalGen() 
     : m_device(nullptr)
@@ -31,8 +79,40 @@ DeckLinkSignalGen::DeckLinkSignalGen()
     , m_height(1080)
     , m_outputEnabled(false)
     , m_pixelFormat(bmdFormat12BitRGBLE)
-    , m_displayMode(bmdModeHD1080p30)
+    , m_hdrMetadataGeneration(1)
+    , m_ycbcrConversion{YCbCrMatrix::Auto, false, ChromaFilter::CoSited}
+    , m_capabilityDeviceId(0)
     , m_formatsCached(false)
+    , m_pendingIsPattern(false)
+    , m_patternGenerated(false)
+    , m_patternBackground{0, 0, 0}
+    , m_generatedPattern{}
+    , m_displayedFrame(nullptr)
+    , m_writeFrame(nullptr)
+    , m_writeBuffer(nullptr)
+    , m_outputCallback(nullptr)
+    , m_scheduledMode(false)
+    , m_scheduledPlaybackRunning(false)
+    , m_frameDuration(0)
+    , m_timeScale(0)
+    , m_nextStreamTime(0)
+    , m_lateFrames(0)
+    , m_droppedFrames(0)
+    , m_outputGroup(nullptr)
+    , m_pipelineMode(false)
+    , m_pipelineOnScreen(nullptr)
+    , m_pipelineWidth(0)
+    , m_pipelineHeight(0)
+    , m_regionBase(nullptr)
+    , m_regionBaseSettings(0)
+    , m_sequence(
+          [this](const uint16_t* image, const uint16_t* rgb, IDeckLinkMutableVideoFrame** frame) {
+              return packSequencePatch(image, rgb, frame);
+          },
+          [this](IDeckLinkMutableVideoFrame* frame, BMDTimeValue streamTime) {
+              return scheduleSequenceFrame(frame, streamTime);
+          },
+          [this](IDeckLinkVideoFrame* frame) { recycleFrame(frame); })
 {
     // Initialize HDR metadata with default Rec2020 values (matching Python defaults)
     m_hdrMetadata.EOTF = 2; // PQ
@@ -51,12 +131,19 @@ DeckLinkSignalGen::DeckLinkSignalGen()
 }
 
 DeckLinkSignalGen::~DeckLinkSignalGen() {
+    if (m_outputGroup) {
+        m_outputGroup->remove(this);
+    }
     if (m_outputEnabled) {
         stopOutput();
     }
-    if (m_frame) {
-        m_frame->Release();
-        m_frame = nullptr;
+    releaseFrames();
+    m_framePool.clear();
+    m_standbyPool.clear();
+    m_frameCache.clear();
+    if (m_outputCallback) {
+        m_outputCallback->Release();
+        m_outputCallback = nullptr;
     }
     if (m_output) {
         m_output->Release();
@@ -82,13 +169,13 @@ void DeckLinkSignalGen::logFrameInfo(const char* context) {
         uint16_t rowBytes = m_frame->GetRowBytes();
         BMDPixelFormat format = m_frame->GetPixelFormat();
         
-        std::cerr << "[DeckLink] Frame info " << context << ":" << std::endl;
-        std::cerr << "  Width: " << std::dec << width << ", Height: " << std::dec << height << std::endl;
-        std::cerr << "  RowBytes: " << std::dec << rowBytes << std::endl;
-        std::cerr << "  PixelFormat: " << fourCharCode(static_cast<int>(format)) << std::endl;
-        std::cerr << "  Flags: 0x" << std::hex << flags << std::dec << std::endl;
+        LOG_DEBUG("[DeckLink] Frame info " << context << ":");
+        LOG_DEBUG("  Width: " << std::dec << width << ", Height: " << std::dec << height);
+        LOG_DEBUG("  RowBytes: " << std::dec << rowBytes);
+        LOG_DEBUG("  PixelFormat: " << fourCharCode(static_cast<int>(format)));
+        LOG_DEBUG("  Flags: 0x" << std::hex << flags << std::dec);
     } else {
-        std::cerr << "[DeckLink] No frame available for logging" << std::endl;
+        LOG_DEBUG("[DeckLink] No frame available for logging");
     }
 }
 
@@ -112,224 +199,1780 @@ int DeckLinkSignalGen::startOutput(BMDDisplayMode displayMode) {
     if (!m_output) return -1;
     if (m_outputEnabled) return 0;
     
+    int err = enableVideoOutput(m_pixelFormat, m_displayMode);
+    if (err)
+        return err;
+    m_outputEnabled = true;
+    
+    LOG_INFO("[DeckLink] Video output enabled successfully with display mode " 
+             << fourCharCode(static_cast<int>(m_displayMode)));
+    
+    // Completion callback and frame timing are needed for scheduled playback
+    if (!m_outputCallback) {
+        m_outputCallback = new OutputCallback(this);
+    }
+    if (m_output->SetScheduledFrameCompletionCallback(m_outputCallback) != S_OK) {
+        LOG_WARNING("[DeckLink] Warning: Failed to install scheduled frame completion callback");
+    }
+    updateFrameTiming();
+    
+    // Preallocate frames so the first patch does not pay for CreateVideoFrame
+    if (ensureFramePool() != 0) {
+        LOG_WARNING("[DeckLink] Warning: Frame pool preallocation failed, will retry on first frame");
+    }
+    
+    return 0;
+}
+
+// Configures the SDI link for the pixel format and enables video output.
+// Returns 0 on success, -1 if EnableVideoOutput failed, -2 if the SDI
+// configuration failed.
+int DeckLinkSignalGen::enableVideoOutput(BMDPixelFormat pixelFormat, BMDDisplayMode displayMode) {
     // CRITICAL: Configure SDI output mode BEFORE enabling video output (following SignalGenHDR)
     if (m_configuration) {
-        bool output444;
-        
-        // Determine if this is an RGB format requiring 4:4:4 output
-        switch (m_pixelFormat) {
-            case bmdFormat10BitRGB:
-            case bmdFormat12BitRGB:
-            case bmdFormat12BitRGBLE:
-            case bmdFormat10BitRGBXLE:
-            case bmdFormat10BitRGBX:
-            case bmdFormat8BitARGB:
-            case bmdFormat8BitBGRA:
-                output444 = true;
-                break;
-            default:
-                // YUV formats and others use 4:2:2
-                output444 = false;
-                break;
-        }
+        bool output444 = is_444_format(pixelFormat);
         
-        std::cerr << "[DeckLink] Pre-EnableOutput: Setting SDI to " << (output444 ? "4:4:4" : "4:2:2") 
-                  << " for pixel format " << fourCharCode(static_cast<int>(m_pixelFormat)) << std::endl;
+        LOG_INFO("[DeckLink] Pre-EnableOutput: Setting SDI to " << (output444 ? "4:4:4" : "4:2:2") 
+                 << " for pixel format " << fourCharCode(static_cast<int>(pixelFormat)));
         
         HRESULT configResult = m_configuration->SetFlag(bmdDeckLinkConfig444SDIVideoOutput, output444);
         // Note: SetFlag may return E_NOTIMPL for devices without SDI output (like Intensity Pro 4K)
         if (configResult != S_OK && configResult != E_NOTIMPL) {
-            std::cerr << "[DeckLink] CRITICAL: Failed to set SDI output mode before EnableVideoOutput. HRESULT: 0x" 
-                      << std::hex << configResult << std::dec << std::endl;
+            LOG_ERROR("[DeckLink] CRITICAL: Failed to set SDI output mode before EnableVideoOutput. HRESULT: 0x" 
+                      << std::hex << configResult << std::dec);
             return -2;
         }
     } else {
-        std::cerr << "[DeckLink] Warning: No configuration interface available for pre-EnableOutput SDI setup" << std::endl;
+        LOG_WARNING("[DeckLink] Warning: No configuration interface available for pre-EnableOutput SDI setup");
     }
     
-    // Enable video output with current display mode
-    HRESULT enableResult = m_output->EnableVideoOutput(m_displayMode, bmdVideoOutputFlagDefault);
+    HRESULT enableResult = m_output->EnableVideoOutput(displayMode, bmdVideoOutputFlagDefault);
     if (enableResult != S_OK) {
-        std::cerr << "[DeckLink] EnableVideoOutput failed for mode " << fourCharCode(static_cast<int>(m_displayMode)) 
-                  << ". HRESULT: 0x" << std::hex << enableResult << std::dec << std::endl;
+        LOG_ERROR("[DeckLink] EnableVideoOutput failed for mode " << fourCharCode(static_cast<int>(displayMode)) 
+                  << ". HRESULT: 0x" << std::hex << enableResult << std::dec);
         return -1;
     }
-    m_outputEnabled = true;
-    
-    std::cerr << "[DeckLink] Video output enabled successfully with display mode " 
-              << fourCharCode(static_cast<int>(m_displayMode)) << std::endl;
-    
     return 0;
 }
 
 int DeckLinkSignalGen::stopOutput() {
     if (!m_outputEnabled) return 0;
     
+    stopPipeline();
+    if (m_scheduledMode) {
+        stopScheduledPlayback();
+    }
+    m_output->SetScheduledFrameCompletionCallback(nullptr);
     m_output->DisableVideoOutput();
     m_outputEnabled = false;
+    m_loopback.stop();
+    m_sequence.dropQueuedFrames();
+    
+    // Nothing is on screen any more, so every pooled frame can be returned
+    releaseFrames();
+    m_framePool.clear();
+    m_standbyPool.clear();
+    m_frameCache.clear();
     
     return 0;
 }
 
-int DeckLinkSignalGen::createFrame() {
-    if (!m_output || !m_outputEnabled) return -1;
-    if (m_pendingFrameData.empty()) {
-        std::cerr << "[DeckLink] No pending frame data available" << std::endl;
-        return -2;
+/**
+ * @brief Makes sure the frame pool matches the current output configuration
+ * 
+ * The pool is keyed on width, height, rowBytes and pixel format. When any of
+ * them changed since the last call, frames still borrowed from the old pool
+ * are dropped and the pool trades places with the standby pool: if that was
+ * prepared for the new geometry, by prepareOutputFormat() or as the pool of
+ * an earlier configuration, no frames are allocated. The old frames stay
+ * behind as the standby, so switching back and forth is also free.
+ * 
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Output interface not available
+ *         - -3: RowBytesForPixelFormat failed
+ *         - -4: Frame allocation failed
+ */
+int DeckLinkSignalGen::ensureFramePool() {
+    if (!m_output) return -1;
+    
+    FrameGeometry geometry;
+    if (frameGeometry(geometry) != 0) return -3;
+    size_t poolSize = m_scheduledMode ? kScheduledFramePoolSize
+                    : m_pipelineMode ? kPipelineFramePoolSize : kFramePoolSize;
+    if (m_framePool.matches(geometry)) {
+        // Same geometry: grows in place if scheduled playback needs more frames
+        return m_framePool.allocate(m_output, geometry, poolSize) == 0 ? 0 : -4;
     }
     
+    releaseFrames();
+    m_framePool.swap(m_standbyPool);
+    if (m_scheduledMode) {
+        // Scheduled frames of the old pool may still be in flight
+        m_standbyPool.clear();
+    }
+    if (m_framePool.allocate(m_output, geometry, poolSize) != 0) return -4;
+    return 0;
+}
+
+// Geometry of frames for the current size and pixel format
+int DeckLinkSignalGen::frameGeometry(FrameGeometry& geometry) const {
+    return frameGeometry(m_pixelFormat, m_width, m_height, geometry);
+}
+
+int DeckLinkSignalGen::frameGeometry(BMDPixelFormat pixelFormat, int width, int height,
+                                     FrameGeometry& geometry) const {
     int32_t rowBytes = 0;
-    HRESULT result = m_output->RowBytesForPixelFormat(m_pixelFormat, m_width, &rowBytes);
+    HRESULT result = m_output->RowBytesForPixelFormat(pixelFormat, width, &rowBytes);
     if (result != S_OK) {
-        std::cerr << "[DeckLink] RowBytesForPixelFormat failed. HRESULT: 0x"
-                  << std::hex << result << std::dec << std::endl;
+        LOG_ERROR("[DeckLink] RowBytesForPixelFormat failed. HRESULT: 0x"
+                  << std::hex << result << std::dec);
         return -3;
     }
+    geometry = {width, height, rowBytes, pixelFormat};
+    return 0;
+}
+
+// Cache the frame duration of the current display mode for ScheduleVideoFrame
+int DeckLinkSignalGen::updateFrameTiming() {
+    if (!m_output) return -1;
     
-    result = m_output->CreateVideoFrame(
-        m_width, m_height, rowBytes,
-        m_pixelFormat,
-        bmdFrameFlagDefault,
-        &m_frame);
-    if (!m_frame) {
-        std::cerr << "[DeckLink] CreateVideoFrame failed" << std::endl;
+    IDeckLinkDisplayMode* mode = nullptr;
+    if (m_output->GetDisplayMode(m_displayMode, &mode) != S_OK || !mode) {
+        LOG_ERROR("[DeckLink] GetDisplayMode failed for mode " << fourCharCode(static_cast<int>(m_displayMode)));
+        m_frameDuration = 0;
+        m_timeScale = 0;
+        return -1;
+    }
+    HRESULT result = mode->GetFrameRate(&m_frameDuration, &m_timeScale);
+    mode->Release();
+    return result == S_OK ? 0 : -1;
+}
+
+// Forget the borrowed frames; the pool still owns them
+void DeckLinkSignalGen::releaseFrames() {
+    if (m_writeFrame) {
+        m_writeBuffer->EndAccess(bmdBufferAccessWrite);
+        m_writeBuffer->Release();
+        recycleFrame(m_writeFrame);
+        m_writeBuffer = nullptr;
+        m_writeFrame = nullptr;
+    }
+    if (m_frame && m_frame != m_displayedFrame) {
+        recycleFrame(m_frame);
+    }
+    if (m_displayedFrame) {
+        recycleFrame(m_displayedFrame);
+    }
+    m_frame = nullptr;
+    m_displayedFrame = nullptr;
+    m_regionBase = nullptr;
+}
+
+int DeckLinkSignalGen::createFrame() {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (int busy = outputBusy("createFrame")) return busy;
+    ScopedLatency timer(m_latency.createFrame);
+    if (m_pendingFrameData.empty() && !m_pendingIsPattern) {
+        LOG_ERROR("[DeckLink] No pending frame data available");
+        return -2;
+    }
+    return packFrame(m_pendingIsPattern ? nullptr : m_pendingFrameData.data());
+}
+
+/**
+ * @brief Packs a caller-owned RGB image straight into the next output frame
+ * 
+ * Unlike setFrameData() followed by createFrame(), the source is read in
+ * place during this call and never copied. Pending frame data is dropped, so
+ * a later createFrame() needs new data.
+ * 
+ * @param data Interleaved RGB image, width * height * 3 values
+ * @param width Image width in pixels
+ * @param height Image height in pixels
+ * @return int Same codes as createFrame(), with -2 for invalid image arguments
+ */
+int DeckLinkSignalGen::createFrameFromBuffer(const uint16_t* data, int width, int height) {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (int busy = outputBusy("createFrameFromBuffer")) return busy;
+    if (!data || width <= 0 || height <= 0) return -2;
+    ScopedLatency timer(m_latency.createFrame);
+    
+    m_width = width;
+    m_height = height;
+    m_pendingFrameData.clear();
+    m_pendingIsPattern = false;
+    return packFrame(data);
+}
+
+/**
+ * @brief Builds the next frame from the previous one plus a changed rectangle
+ * 
+ * For patches that only change part of the frame, such as a window on a
+ * fixed background. The previous packed frame is copied into a pooled frame
+ * and only the packing groups the rectangle touches are repacked from the
+ * new image (see pack_pixel_region()), so the cost follows the size of the
+ * rectangle rather than the output resolution. The caller promises that the
+ * image differs from the previous one only inside the rectangle.
+ * 
+ * When there is no previous frame to start from, because it was written
+ * directly, handed to scheduled playback, or packed with another size or
+ * different settings, the whole image is packed as createFrameFromBuffer()
+ * would.
+ * 
+ * @param data Interleaved RGB image, width * height * 3 values
+ * @param x Left edge of the changed rectangle
+ * @param y Top edge of the changed rectangle
+ * @param regionWidth Width of the changed rectangle, clipped to the frame
+ * @param regionHeight Height of the changed rectangle, clipped to the frame
+ * @return int Same codes as createFrameFromBuffer()
+ */
+int DeckLinkSignalGen::updateFrameRegion(const uint16_t* data, int width, int height,
+                                         int x, int y, int regionWidth, int regionHeight) {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (int busy = outputBusy("updateFrameRegion")) return busy;
+    if (!data || width <= 0 || height <= 0) return -2;
+    
+    IDeckLinkMutableVideoFrame* base = nullptr;
+    if (m_regionBase && (m_regionBase == m_frame || m_regionBase == m_displayedFrame) &&
+        width == m_width && height == m_height && m_regionBaseSettings == packSettingsHash()) {
+        base = m_regionBase;
+    }
+    if (!base) {
+        return createFrameFromBuffer(data, width, height);
+    }
+    ScopedLatency timer(m_latency.createFrame);
+    m_pendingFrameData.clear();
+    m_pendingIsPattern = false;
+    
+    IDeckLinkMutableVideoFrame* frame = nullptr;
+    IDeckLinkVideoBuffer* videoBuffer = nullptr;
+    void* frameData = nullptr;
+    int err = mapOutputFrame(nullptr, &frame, &videoBuffer, &frameData);
+    if (err)
+        return err;
+    
+    IDeckLinkVideoBuffer* baseBuffer = nullptr;
+    void* baseData = nullptr;
+    err = -5;
+    if (base->QueryInterface(IID_IDeckLinkVideoBuffer, (void**)&baseBuffer) == S_OK) {
+        if (baseBuffer->StartAccess(bmdBufferAccessRead) == S_OK) {
+            if (baseBuffer->GetBytes(&baseData) == S_OK) {
+                std::memcpy(frameData, baseData, static_cast<size_t>(base->GetRowBytes()) * m_height);
+                err = 0;
+            }
+            baseBuffer->EndAccess(bmdBufferAccessRead);
+        }
+        baseBuffer->Release();
+    }
+    if (err == 0) {
+        ScopedLatency packTimer(m_latency.pack);
+        YCbCrConversion conversion = resolvedYCbCrConversion();
+        err = pack_pixel_region(frameData, m_pixelFormat, data, m_width, m_height,
+                                static_cast<int32_t>(frame->GetRowBytes()),
+                                x, y, regionWidth, regionHeight, &conversion, m_colorLut.get());
+    }
+    
+    videoBuffer->EndAccess(bmdBufferAccessWrite);
+    videoBuffer->Release();
+    if (err) {
+        discardFrame(frame);
+        return err;
+    }
+    
+    // A frame that was filled but never displayed can go back now
+    if (m_frame && m_frame != m_displayedFrame) {
+        recycleFrame(m_frame);
+    }
+    m_frame = frame;
+    m_regionBase = frame;
+    updateHDRMetadata();
+    return 0;
+}
+
+// Packs the image at srcData, or the pending pattern when srcData is null.
+// With the frame cache enabled, a repeat of an earlier frame is reused as is.
+int DeckLinkSignalGen::packFrame(const uint16_t* srcData) {
+    // A frame that was filled but never displayed can be reused right away
+    if (m_frame && m_frame != m_displayedFrame) {
+        recycleFrame(m_frame);
+    }
+    m_frame = nullptr;
+    
+    FrameCacheKey cacheKey = {0, 0};
+    bool useCache = m_frameCache.enabled() && !m_writeFrame;
+    if (useCache) {
+        cacheKey = frameCacheKey(srcData);
+        IDeckLinkMutableVideoFrame* cached = m_frameCache.lookup(cacheKey);
+        if (cached) {
+            // The on-screen reference already counts as a use of this frame
+            if (cached == m_displayedFrame) {
+                m_frameCache.release(cached);
+            }
+            m_frame = cached;
+            m_regionBase = cached;
+            m_regionBaseSettings = packSettingsHash();
+            return 0;
+        }
+    }
+    
+    IDeckLinkMutableVideoFrame* frame = nullptr;
+    IDeckLinkVideoBuffer* videoBuffer = nullptr;
+    void* frameData = nullptr;
+    int err = mapOutputFrame(useCache ? &cacheKey : nullptr, &frame, &videoBuffer, &frameData);
+    if (err)
+        return err;
+    int32_t rowBytes = static_cast<int32_t>(frame->GetRowBytes());
+    
+    // Use pixel packing system to convert raw RGB data to the target format
+    {
+        ScopedLatency timer(m_latency.pack);
+        YCbCrConversion conversion = resolvedYCbCrConversion();
+        if (srcData) {
+            err = pack_pixel_format(
+                        frameData,
+                        m_pixelFormat,
+                        srcData,
+                        m_width, m_height,
+                        rowBytes,
+                        &conversion,
+                        m_colorLut.get());
+        } else if (m_patternGenerated) {
+            err = pack_generated_pattern(
+                        frameData,
+                        m_pixelFormat,
+                        m_generatedPattern,
+                        m_width, m_height,
+                        rowBytes,
+                        &conversion,
+                        m_colorLut.get());
+        } else {
+            err = pack_rect_pattern(
+                        frameData,
+                        m_pixelFormat,
+                        m_patternBackground,
+                        m_patternRects.data(), static_cast<int>(m_patternRects.size()),
+                        m_width, m_height,
+                        rowBytes,
+                        &conversion,
+                        m_colorLut.get());
+        }
+    }
+    
+    videoBuffer->EndAccess(bmdBufferAccessWrite);
+    videoBuffer->Release();
+    if (err) {
+        discardFrame(frame);
+        return err;
+    }
+    m_frame = frame;
+    m_regionBase = frame;
+    m_regionBaseSettings = packSettingsHash();
+    updateHDRMetadata();
+    
+    // Frame created successfully
+    return 0;
+}
+
+// Hashes every setting that affects the packed frame or its metadata
+uint64_t DeckLinkSignalGen::packSettingsHash() const {
+    YCbCrConversion conversion = resolvedYCbCrConversion();
+    const uint64_t settings[] = {
+        static_cast<uint64_t>(m_pixelFormat),
+        static_cast<uint64_t>(m_displayMode),
+        static_cast<uint64_t>(m_width),
+        static_cast<uint64_t>(m_height),
+        static_cast<uint64_t>(conversion.matrix),
+        static_cast<uint64_t>(conversion.fullRange),
+        static_cast<uint64_t>(conversion.chromaFilter),
+        m_colorLut ? m_colorLut->hash() : 0,
+    };
+    return hash_frame_bytes(&m_hdrMetadata, sizeof(m_hdrMetadata), hash_frame_bytes(settings, sizeof(settings)));
+}
+
+// Hashes the pending source and every setting that affects the packed frame
+FrameCacheKey DeckLinkSignalGen::frameCacheKey(const uint16_t* srcData) const {
+    const uint64_t sourceKind = srcData ? 0u : m_patternGenerated ? 2u : 1u;
+    FrameCacheKey key;
+    key.settingsHash = hash_frame_bytes(&sourceKind, sizeof(sourceKind), packSettingsHash());
+    if (srcData) {
+        key.contentHash = hash_frame_bytes(srcData, static_cast<size_t>(m_width) * m_height * 3 * sizeof(uint16_t));
+    } else if (m_patternGenerated) {
+        // Field by field, so padding never reaches the hash
+        const GeneratedPattern& pattern = m_generatedPattern;
+        uint64_t fields[5] = {
+            static_cast<uint64_t>(pattern.kind),
+            static_cast<uint64_t>(pattern.steps),
+            0,
+            0,
+            0,
+        };
+        for (int c = 0; c < 3; c++) {
+            fields[2] |= static_cast<uint64_t>(pattern.startColor[c]) << (16 * c);
+            fields[3] |= static_cast<uint64_t>(pattern.endColor[c]) << (16 * c);
+        }
+        std::memcpy(&fields[4], &pattern.frequency, sizeof(pattern.frequency));
+        key.contentHash = hash_frame_bytes(fields, sizeof(fields));
+    } else {
+        key.contentHash = hash_frame_bytes(m_patternRects.data(), m_patternRects.size() * sizeof(PatternRect),
+                                           hash_frame_bytes(m_patternBackground, sizeof(m_patternBackground)));
+    }
+    return key;
+}
+
+// Returns one use of a frame to whichever of the cache or the pool owns it,
+// once the loopback verifier no longer needs its contents
+void DeckLinkSignalGen::recycleFrame(IDeckLinkVideoFrame* frame) {
+    if (!frame) return;
+    m_loopback.frameReleased(frame);
+    if (!m_frameCache.release(frame)) {
+        m_framePool.release(frame);
+    }
+}
+
+// Like recycleFrame(), but a cache entry is dropped since its frame is not valid
+void DeckLinkSignalGen::discardFrame(IDeckLinkVideoFrame* frame) {
+    m_frameCache.discard(frame);
+    m_framePool.release(frame);
+}
+
+/**
+ * @brief Takes a frame to fill and maps its buffer for writing
+ * 
+ * The frame is a new frame cache entry for cacheKey when one is given and
+ * fits in the budget, and a frame borrowed from the pool otherwise. On
+ * success the caller owns the frame and the started buffer access, and must
+ * end the access and release the buffer. On failure nothing is left
+ * borrowed.
+ * 
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1, -3, -4: See ensureFramePool()
+ *         - -4: No free frame available in the pool
+ *         - -5: QueryInterface for IDeckLinkVideoBuffer failed
+ *         - -6: StartAccess failed
+ *         - -7: GetBytes failed
+ *         - -9: A frame is still open for direct writing
+ */
+int DeckLinkSignalGen::mapOutputFrame(const FrameCacheKey* cacheKey, IDeckLinkMutableVideoFrame** frame,
+                                      IDeckLinkVideoBuffer** buffer, void** frameData) {
+    if (m_writeFrame) {
+        LOG_ERROR("[DeckLink] A frame is still open for writing, call endFrameWrite() first");
+        return -9;
+    }
+    
+    int err = ensureFramePool();
+    if (err)
+        return err;
+    
+    IDeckLinkMutableVideoFrame* borrowed = nullptr;
+    if (cacheKey) {
+        FrameGeometry geometry;
+        if (frameGeometry(geometry) == 0) {
+            borrowed = m_frameCache.insert(m_output, *cacheKey, geometry);
+        }
+    }
+    if (!borrowed) {
+        // Only blocks while scheduled playback holds every pooled frame
+        borrowed = m_framePool.acquire(kFrameAcquireTimeout);
+    }
+    if (!borrowed) {
+        LOG_ERROR("[DeckLink] No free frame available in pool");
         return -4;
     }
     
     // Get frame buffer for writing
     IDeckLinkVideoBuffer* videoBuffer = nullptr;
-    if (m_frame->QueryInterface(IID_IDeckLinkVideoBuffer, (void**)&videoBuffer) != S_OK) {
-        std::cerr << "[DeckLink] QueryInterface for IDeckLinkVideoBuffer failed" << std::endl;
+    if (borrowed->QueryInterface(IID_IDeckLinkVideoBuffer, (void**)&videoBuffer) != S_OK) {
+        LOG_ERROR("[DeckLink] QueryInterface for IDeckLinkVideoBuffer failed");
+        discardFrame(borrowed);
         return -5;
     }
     
     if (videoBuffer->StartAccess(bmdBufferAccessWrite) != S_OK) {
-        std::cerr << "[DeckLink] StartAccess failed" << std::endl;
+        LOG_ERROR("[DeckLink] StartAccess failed");
         videoBuffer->Release();
+        discardFrame(borrowed);
         return -6;
     }
     
-    void* frameData = nullptr;
-    if (videoBuffer->GetBytes(&frameData) != S_OK) {
-        std::cerr << "[DeckLink] GetBytes failed" << std::endl;
+    void* bytes = nullptr;
+    if (videoBuffer->GetBytes(&bytes) != S_OK) {
+        LOG_ERROR("[DeckLink] GetBytes failed");
         videoBuffer->EndAccess(bmdBufferAccessWrite);
         videoBuffer->Release();
+        discardFrame(borrowed);
         return -7;
     }
     
-    // Use pixel packing system to convert raw RGB data to the target format
-    const uint16_t* srcData = m_pendingFrameData.data();
-    
-    // Pack the data according to the pixel format
-    int err = pack_pixel_format(
-                frameData,
-                m_pixelFormat,
-                srcData,
-                m_width, m_height,
-                rowBytes);
+    *frame = borrowed;
+    *buffer = videoBuffer;
+    *frameData = bytes;
+    return 0;
+}
+
+/**
+ * @brief Hands the caller a pooled frame buffer to fill with packed pixels
+ * 
+ * The buffer holds `height` rows of `rowBytes` bytes in the current pixel
+ * format, written directly with no packing or copy by the wrapper. It stays
+ * mapped until endFrameWrite(), which makes it the current frame for
+ * displayFrameSync() or scheduleFrame().
+ * 
+ * @param width Frame width in pixels
+ * @param height Frame height in pixels
+ * @param data Receives the start of the mapped frame buffer
+ * @param rowBytes Receives the bytes per row, including padding
+ * @return int Same codes as mapOutputFrame(), plus -2 for invalid arguments
+ */
+int DeckLinkSignalGen::beginFrameWrite(int width, int height, void** data, int32_t* rowBytes) {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (int busy = outputBusy("beginFrameWrite")) return busy;
+    if (!data || !rowBytes || width <= 0 || height <= 0) return -2;
     
-    videoBuffer->EndAccess(bmdBufferAccessWrite);
-    videoBuffer->Release();
+    m_width = width;
+    m_height = height;
+    IDeckLinkMutableVideoFrame* frame = nullptr;
+    IDeckLinkVideoBuffer* videoBuffer = nullptr;
+    void* frameData = nullptr;
+    int err = mapOutputFrame(nullptr, &frame, &videoBuffer, &frameData);
     if (err)
         return err;
+    
+    m_writeFrame = frame;
+    m_writeBuffer = videoBuffer;
+    *data = frameData;
+    *rowBytes = static_cast<int32_t>(frame->GetRowBytes());
+    return 0;
+}
 
-    // Apply EOTF metadata if set
-    if (m_hdrMetadata.EOTF >= 0) { // Changed from m_eotfType to m_hdrMetadata.EOTF
-        applyHDRMetadata(); // Changed from applyEOTFMetadata to applyHDRMetadata
-    }
+/**
+ * @brief Unmaps the frame opened by beginFrameWrite() and makes it current
+ * 
+ * @return int Returns 0 on success, -1 if no frame is open for writing
+ */
+int DeckLinkSignalGen::endFrameWrite() {
+    if (!m_writeFrame) return -1;
     
-    // Frame created successfully
+    m_writeBuffer->EndAccess(bmdBufferAccessWrite);
+    m_writeBuffer->Release();
+    m_writeBuffer = nullptr;
+    
+    if (m_frame && m_frame != m_displayedFrame) {
+        recycleFrame(m_frame);
+    }
+    m_frame = m_writeFrame;
+    m_writeFrame = nullptr;
+    // Written by the caller, so not a base for updateFrameRegion()
+    m_regionBase = nullptr;
+    updateHDRMetadata();
     return 0;
 }
 
 
 int DeckLinkSignalGen::displayFrameSync() {
+    if (int busy = outputBusy("displayFrameSync")) return busy;
     if (!m_output || !m_frame) return -1;
+    if (m_scheduledMode) {
+        LOG_ERROR("[DeckLink] DisplayVideoFrameSync is not available during scheduled playback");
+        return -2;
+    }
     
-    HRESULT result = m_output->DisplayVideoFrameSync(m_frame);
+    HRESULT result = displayVideoFrameSync(m_frame);
     if (result != S_OK) {
-        std::cerr << "[DeckLink] DisplayVideoFrameSync failed. HRESULT: 0x" << std::hex << result << std::dec << std::endl;
+        LOG_ERROR("[DeckLink] DisplayVideoFrameSync failed. HRESULT: 0x" << std::hex << result << std::dec);
         return -1;
     }
     
+    // The previous frame has been replaced on screen and can be recycled
+    if (m_displayedFrame && m_displayedFrame != m_frame) {
+        recycleFrame(m_displayedFrame);
+    }
+    m_displayedFrame = m_frame;
+    
     // Frame displayed successfully
     return 0;
 }
 
-int DeckLinkSignalGen::setPixelFormat(BMDPixelFormat pixelFormat) {
-    if (!m_output) return -1;
-    
-    if (!m_formatsCached) {
-        cacheSupportedFormats();
+/**
+ * @brief Queues the current frame for scheduled playback
+ * 
+ * The frame built by createFrame() is handed to ScheduleVideoFrame one frame
+ * duration after the previously queued frame. Ownership passes to the
+ * hardware until ScheduledFrameCompleted returns it to the pool, so the
+ * caller can immediately build the next frame. Frames may be queued before
+ * startScheduledPlayback() to preroll the ring.
+ * 
+ * If the caller fell behind scanout, the frame is moved to the next frame
+ * boundary after the current stream time instead of being queued late.
+ * 
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Output not enabled
+ *         - -2: No frame created
+ *         - -3: Frame timing for the display mode is unknown
+ *         - -4: ScheduleVideoFrame failed
+ * 
+ * @see startScheduledPlayback(), getBufferedFrameCount()
+ */
+int DeckLinkSignalGen::scheduleFrame() {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (int busy = outputBusy("scheduleFrame")) return busy;
+    if (!m_frame) {
+        LOG_ERROR("[DeckLink] No frame available to schedule");
+        return -2;
     }
     
-    // Check if the format is supported by this device
-    bool isSupported = false;
-    for (const auto& supportedFormat : m_supportedFormats) {
-        if (supportedFormat == pixelFormat) {
-            isSupported = true;
-            break;
-        }
-    }
+    BMDTimeValue streamTime = 0;
+    BMDTimeValue frameDuration = 0;
+    BMDTimeScale timeScale = 0;
+    int err = nextStreamTime(streamTime, frameDuration, timeScale);
+    if (err)
+        return err;
+    return scheduleFrameAt(streamTime);
+}
+
+/**
+ * @brief Stream time the next scheduleFrame() would queue its frame at
+ * 
+ * One frame duration after the previously queued frame, or the next frame
+ * boundary after the current stream time if the caller fell behind scanout.
+ * 
+ * @param streamTime Receives the stream time, in timeScale units
+ * @param frameDuration Receives the frame duration of the display mode
+ * @param timeScale Receives the time scale of the display mode
+ * @return int Returns 0 on success, -1 if output is not enabled, -3 if the
+ *         frame timing for the display mode is unknown
+ */
+int DeckLinkSignalGen::nextStreamTime(BMDTimeValue& streamTime, BMDTimeValue& frameDuration,
+                                      BMDTimeScale& timeScale) {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (m_frameDuration <= 0 && updateFrameTiming() != 0) return -3;
     
-    if (!isSupported) {
-        std::cerr << "[DeckLink] Pixel format " << fourCharCode(static_cast<int>(pixelFormat)) 
-                  << " is not supported by this device" << std::endl;
-        return -1;
+    if (m_scheduledPlaybackRunning) {
+        BMDTimeValue currentTime = 0;
+        double playbackSpeed = 0.0;
+        if (m_output->GetScheduledStreamTime(m_timeScale, &currentTime, &playbackSpeed) == S_OK &&
+            m_nextStreamTime <= currentTime) {
+            m_nextStreamTime = (currentTime / m_frameDuration + 1) * m_frameDuration;
+        }
     }
-    
-    m_pixelFormat = pixelFormat;
-    std::cerr << "[DeckLink] Set pixel format to " << fourCharCode(static_cast<int>(m_pixelFormat)) << std::endl;
-    std::cerr << "[DeckLink] Note: SDI output mode will be configured when startOutput() is called" << std::endl;
-    
+    streamTime = m_nextStreamTime;
+    frameDuration = m_frameDuration;
+    timeScale = m_timeScale;
     return 0;
 }
 
-BMDPixelFormat DeckLinkSignalGen::getPixelFormat() const {
-    return m_pixelFormat;
-}
-
-int DeckLinkSignalGen::setDisplayMode(BMDDisplayMode displayMode) {
-    if (!m_output) return -1;
+/**
+ * @brief Queues the current frame at a given stream time
+ * 
+ * Like scheduleFrame(), with the stream time chosen by the caller, such as an
+ * OutputGroup keeping several outputs on the same frame. The next
+ * scheduleFrame() follows one frame duration later.
+ * 
+ * @param streamTime Display time in the display mode's time scale
+ * @return int Same codes as scheduleFrame()
+ */
+int DeckLinkSignalGen::scheduleFrameAt(BMDTimeValue streamTime) {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (int busy = outputBusy("scheduleFrameAt")) return busy;
+    if (!m_frame) {
+        LOG_ERROR("[DeckLink] No frame available to schedule");
+        return -2;
+    }
+    if (m_frameDuration <= 0 && updateFrameTiming() != 0) return -3;
+    ScopedLatency timer(m_latency.scheduleFrame);
     
-    // Validate that the display mode is supported
-    BMDDisplayMode actualMode;
-    bool supported;
-    
-    HRESULT result = m_output->DoesSupportVideoMode(bmdVideoConnectionUnspecified,
-                                                   displayMode,
-                                                   m_pixelFormat,
-                                                   bmdNoVideoOutputConversion,
-                                                   bmdSupportedVideoModeDefault,
-                                                   &actualMode,
-                                                   &supported);
-    
-    if (result != S_OK || !supported) {
-        std::cerr << "[DeckLink] Display mode " << fourCharCode(static_cast<int>(displayMode)) 
-                  << " is not supported with current pixel format " << fourCharCode(static_cast<int>(m_pixelFormat)) << std::endl;
-        return -1;
+    if (!m_scheduledMode) {
+        m_scheduledMode = true;
+        ensureFramePool();
     }
     
-    m_displayMode = displayMode;
-    std::cerr << "[DeckLink] Set display mode to " << fourCharCode(static_cast<int>(m_displayMode)) << std::endl;
+    HRESULT result = queueScheduledFrame(m_frame, streamTime);
+    if (result != S_OK) {
+        LOG_ERROR("[DeckLink] ScheduleVideoFrame failed. HRESULT: 0x" << std::hex << result << std::dec);
+        return -4;
+    }
+    m_nextStreamTime = streamTime + m_frameDuration;
     
+    // The hardware owns the frame until ScheduledFrameCompleted. If it was
+    // also the synchronously displayed frame, that use passes to the hardware.
+    if (m_frame == m_displayedFrame) {
+        m_displayedFrame = nullptr;
+    }
+    m_frame = nullptr;
     return 0;
 }
 
-BMDDisplayMode DeckLinkSignalGen::getDisplayMode() const {
-    return m_displayMode;
+int DeckLinkSignalGen::startScheduledPlayback() {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (int busy = outputBusy("startScheduledPlayback")) return busy;
+    return beginScheduledPlayback();
 }
 
-int DeckLinkSignalGen::setHDRMetadata(const HDRMetadata& metadata) {
-    m_hdrMetadata = metadata;
+// Starts playback of the frames queued so far, also for startSequence()
+int DeckLinkSignalGen::beginScheduledPlayback() {
+    if (m_scheduledPlaybackRunning) return 0;
+    if (m_frameDuration <= 0 && updateFrameTiming() != 0) return -3;
     
-    // HDR metadata set successfully (debug output reduced)
+    m_scheduledMode = true;
+    m_lateFrames = 0;
+    m_droppedFrames = 0;
+    
+    // In a playback group (setPlaybackGroup()) starting any member starts
+    // them all, so the others find playback already running
+    bool running = false;
+    if (m_output->IsScheduledPlaybackRunning(&running) != S_OK || !running) {
+        HRESULT result = m_output->StartScheduledPlayback(0, m_timeScale, 1.0);
+        if (result != S_OK) {
+            LOG_ERROR("[DeckLink] StartScheduledPlayback failed. HRESULT: 0x" << std::hex << result << std::dec);
+            return -2;
+        }
+    }
+    m_scheduledPlaybackRunning = true;
     
+    // Scheduled frames replace whatever DisplayVideoFrameSync left on screen
+    if (m_displayedFrame) {
+        recycleFrame(m_displayedFrame);
+        m_displayedFrame = nullptr;
+    }
     return 0;
 }
 
-int DeckLinkSignalGen::setFrameData(const uint16_t* data, int width, int height) {
+int DeckLinkSignalGen::stopScheduledPlayback() {
+    if (!m_output) return -1;
+    // A playing sequence stops feeding first, so nothing is queued after the flush
+    m_sequence.stop();
+    if (!m_scheduledMode) return 0;
+    
+    if (m_scheduledPlaybackRunning) {
+        // Frames still queued come back through ScheduledFrameCompleted as flushed
+        m_output->StopScheduledPlayback(0, nullptr, 0);
+        m_scheduledPlaybackRunning = false;
+        LOG_INFO("[DeckLink] Scheduled playback stopped. Late frames: " << m_lateFrames
+                 << ", dropped frames: " << m_droppedFrames);
+    }
+    m_scheduledMode = false;
+    m_nextStreamTime = 0;
+    return 0;
+}
+
+int DeckLinkSignalGen::getBufferedFrameCount() {
+    if (!m_output || !m_outputEnabled) return -1;
+    
+    uint32_t count = 0;
+    if (m_output->GetBufferedVideoFrameCount(&count) != S_OK) return -1;
+    return static_cast<int>(count);
+}
+
+// Called on the driver's completion thread
+void DeckLinkSignalGen::onScheduledFrameCompleted(IDeckLinkVideoFrame* frame, BMDOutputFrameCompletionResult result) {
+    switch (result) {
+        case bmdOutputFrameDisplayedLate:
+            m_lateFrames++;
+            break;
+        case bmdOutputFrameDropped:
+            m_droppedFrames++;
+            break;
+        default:
+            break;
+    }
+    
+    // Patch frames go back through the sequence, which knows how often each
+    // one was queued
+    BMDTimeValue completionTimestamp = 0;
+    if (m_output->GetFrameCompletionReferenceTimestamp(frame, kNanosecondTimeScale, &completionTimestamp) != S_OK) {
+        completionTimestamp = 0;
+    }
+    m_completions.frameCompleted(frame, result, completionTimestamp);
+    m_telemetry.frameCompleted(frame, result, completionTimestamp);
+    if (!m_sequence.frameCompleted(frame, result, completionTimestamp)) {
+        recycleFrame(frame);
+    }
+}
+
+/**
+ * @brief Starts library threads that pack and display submitted frames
+ * 
+ * After this, submitFrame() queues images instead of the caller packing and
+ * displaying them itself: a pack thread fills pooled frames while a display
+ * thread shows them with DisplayVideoFrameSync, so the pack of one frame
+ * overlaps the display of the previous one. The current frame stays on
+ * screen until the first submitted frame replaces it. Until stopPipeline(),
+ * calls that build or display frames or change how they are packed return
+ * DECKLINK_ERROR_PIPELINE_RUNNING.
+ * 
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Output not enabled
+ *         - -2: Scheduled playback is active
+ *         - -9: A frame is still open for direct writing
+ */
+int DeckLinkSignalGen::startPipeline() {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (m_pipeline) return 0;
+    if (m_scheduledMode) {
+        LOG_ERROR("[DeckLink] The frame pipeline is not available during scheduled playback");
+        return -2;
+    }
+    if (m_writeFrame) {
+        LOG_ERROR("[DeckLink] A frame is still open for writing, call endFrameWrite() first");
+        return -9;
+    }
+    
+    // The display thread takes over the displayed frame. Pending data is
+    // dropped since pipelined frames may change the frame size.
+    if (m_frame && m_frame != m_displayedFrame) {
+        recycleFrame(m_frame);
+    }
+    m_frame = nullptr;
+    m_pipelineOnScreen = m_displayedFrame;
+    m_displayedFrame = nullptr;
+    m_pendingFrameData.clear();
+    m_pendingIsPattern = false;
+    m_pipelineWidth = 0;
+    m_pipelineHeight = 0;
+    
+    m_pipelineMode = true;
+    m_pipeline = std::make_unique<FramePipeline>(
+        [this](const uint16_t* data, int width, int height, IDeckLinkMutableVideoFrame** frame) {
+            return packPipelineFrame(data, width, height, frame);
+        },
+        [this](IDeckLinkMutableVideoFrame* frame) { return displayPipelineFrame(frame); },
+        [this](IDeckLinkMutableVideoFrame* frame) { recycleFrame(frame); });
+    LOG_INFO("[DeckLink] Frame pipeline started");
+    return 0;
+}
+
+// Frames still queued are dropped; the last displayed frame stays on screen
+int DeckLinkSignalGen::stopPipeline() {
+    if (!m_pipeline) return 0;
+    
+    m_pipeline->stop();
+    FramePipelineStats stats = m_pipeline->stats();
+    m_pipeline.reset();
+    m_pipelineMode = false;
+    m_displayedFrame = m_pipelineOnScreen;
+    m_pipelineOnScreen = nullptr;
+    LOG_INFO("[DeckLink] Frame pipeline stopped. Displayed: " << stats.displayed
+             << ", failed: " << stats.failed << ", producer stalls: " << stats.producerStalls);
+    return 0;
+}
+
+/**
+ * @brief Queues a copy of an RGB image for the frame pipeline
+ * 
+ * Blocks while both queued source slots are full, which paces the caller to
+ * the display rate. Every frame must have the size of the first one
+ * submitted since startPipeline().
+ * 
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Pipeline not running
+ *         - -2: Invalid image arguments or a different frame size
+ *         - -3: No slot freed up within the frame acquire timeout
+ */
+int DeckLinkSignalGen::submitFrame(const uint16_t* data, int width, int height) {
+    if (!m_pipeline) return -1;
+    if (!data || width <= 0 || height <= 0) return -2;
+    if (m_pipelineWidth == 0) {
+        m_pipelineWidth = width;
+        m_pipelineHeight = height;
+    } else if (width != m_pipelineWidth || height != m_pipelineHeight) {
+        LOG_ERROR("[DeckLink] Pipelined frames must stay " << m_pipelineWidth << "x" << m_pipelineHeight
+                  << ", stop the pipeline to change size");
+        return -2;
+    }
+    return m_pipeline->submit(data, width, height, kFrameAcquireTimeout);
+}
+
+// Returns 0 once every submitted frame was displayed or failed, -1 if the
+// pipeline is not running, -3 on timeout
+int DeckLinkSignalGen::flushPipeline() {
+    if (!m_pipeline) return -1;
+    return m_pipeline->flush(kPipelineFlushTimeout);
+}
+
+int DeckLinkSignalGen::getPipelineStats(FramePipelineStats& stats) const {
+    if (!m_pipeline) return -1;
+    stats = m_pipeline->stats();
+    return 0;
+}
+
+// Error code for calls that would disturb a running frame pipeline or patch
+// sequence, 0 when neither runs
+int DeckLinkSignalGen::outputBusy(const char* call) const {
+    if (m_pipeline) {
+        LOG_ERROR("[DeckLink] " << call << " is not available while the frame pipeline runs");
+        return DECKLINK_ERROR_PIPELINE_RUNNING;
+    }
+    if (m_sequence.running()) {
+        LOG_ERROR("[DeckLink] " << call << " is not available while a patch sequence plays");
+        return DECKLINK_ERROR_SEQUENCE_RUNNING;
+    }
+    return 0;
+}
+
+// Pack thread of the frame pipeline. m_frame is only used in passing, so the
+// packed frame leaves with one use owned by the pipeline.
+int DeckLinkSignalGen::packPipelineFrame(const uint16_t* data, int width, int height,
+                                         IDeckLinkMutableVideoFrame** frame) {
+    ScopedLatency timer(m_latency.createFrame);
+    m_width = width;
+    m_height = height;
+    int err = packFrame(data);
+    if (err)
+        return err;
+    *frame = m_frame;
+    m_frame = nullptr;
+    return 0;
+}
+
+// Display thread of the frame pipeline; owns the frame from here on
+int DeckLinkSignalGen::displayPipelineFrame(IDeckLinkMutableVideoFrame* frame) {
+    HRESULT result = displayVideoFrameSync(frame);
+    if (result != S_OK) {
+        LOG_ERROR("[DeckLink] DisplayVideoFrameSync failed. HRESULT: 0x" << std::hex << result << std::dec);
+        recycleFrame(frame);
+        return -1;
+    }
+    
+    // Every queued frame holds its own use, even a cached frame shown twice
+    recycleFrame(m_pipelineOnScreen);
+    m_pipelineOnScreen = frame;
+    return 0;
+}
+
+/**
+ * @brief Uploads a patch sequence for startSequence()
+ * 
+ * Every patch is a solid color or a width x height RGB image, shown for its
+ * dwell time in frames. Images are copied; nothing is packed until the
+ * sequence plays, so the current pixel format and settings apply then.
+ * 
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Invalid size, empty list or a patch without dwell time
+ *         - DECKLINK_ERROR_SEQUENCE_RUNNING: The loaded sequence is playing
+ */
+int DeckLinkSignalGen::loadSequence(int width, int height, const SequencePatch* patches, int count) {
+    if (m_sequence.running()) {
+        LOG_ERROR("[DeckLink] Stop the playing patch sequence before loading another");
+        return DECKLINK_ERROR_SEQUENCE_RUNNING;
+    }
+    int err = m_sequence.load(width, height, patches, count);
+    if (err == 0) {
+        LOG_INFO("[DeckLink] Loaded a sequence of " << count << " patches at " << width << "x" << height);
+    }
+    return err;
+}
+
+/**
+ * @brief Plays the loaded patch sequence on scheduled frame timing
+ * 
+ * The first frames are packed and queued before playback starts. From then
+ * on a library thread keeps the hardware queue topped up, packing each patch
+ * once and queueing it for every frame of its dwell time, so the caller only
+ * has to collect events with waitSequenceEvent(). Until the last patch has
+ * completed or stopSequence(), calls that build or display frames or change
+ * how they are packed return DECKLINK_ERROR_SEQUENCE_RUNNING. The last patch
+ * stays on screen until stopSequence().
+ * 
+ * @param loop Start over with the first patch after the last one
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Output not enabled
+ *         - -2: No sequence loaded
+ *         - -3: Scheduled playback is already active
+ *         - -4: Frame timing for the display mode is unknown
+ *         - -9: A frame is still open for direct writing
+ *         - Other codes: See packFrame() and scheduleFrame()
+ */
+int DeckLinkSignalGen::startSequence(bool loop) {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (int busy = outputBusy("startSequence")) return busy;
+    if (m_sequence.empty()) {
+        LOG_ERROR("[DeckLink] No patch sequence loaded");
+        return -2;
+    }
+    if (m_scheduledMode) {
+        LOG_ERROR("[DeckLink] Stop scheduled playback before starting a patch sequence");
+        return -3;
+    }
+    if (m_writeFrame) {
+        LOG_ERROR("[DeckLink] A frame is still open for writing, call endFrameWrite() first");
+        return -9;
+    }
+    if (m_frameDuration <= 0 && updateFrameTiming() != 0) return -4;
+    
+    m_width = m_sequence.width();
+    m_height = m_sequence.height();
+    m_scheduledMode = true;
+    m_nextStreamTime = 0;
+    int err = ensureFramePool();
+    if (err) {
+        m_scheduledMode = false;
+        return err;
+    }
+    
+    // Like startPipeline(), pending data is dropped. The displayed frame
+    // stays on screen until playback replaces it.
+    if (m_frame && m_frame != m_displayedFrame) {
+        recycleFrame(m_frame);
+    }
+    m_frame = nullptr;
+    IDeckLinkMutableVideoFrame* onScreen = m_displayedFrame;
+    m_displayedFrame = nullptr;
+    m_pendingFrameData.clear();
+    m_pendingIsPattern = false;
+    
+    err = m_sequence.start(loop, m_nextStreamTime, m_frameDuration, m_timeScale, kSequenceQueuedFrames);
+    if (err == 0) {
+        err = beginScheduledPlayback();
+    }
+    if (err) {
+        stopScheduledPlayback();
+        m_displayedFrame = onScreen;
+        return err;
+    }
+    recycleFrame(onScreen);
+    LOG_INFO("[DeckLink] Patch sequence started" << (loop ? ", looping" : ""));
+    return 0;
+}
+
+// Stops the sequence along with scheduled playback; queued frames are flushed
+int DeckLinkSignalGen::stopSequence() {
+    if (!m_output) return -1;
+    SequenceStatus status = m_sequence.status();
+    int err = stopScheduledPlayback();
+    LOG_INFO("[DeckLink] Patch sequence stopped. Completed patches: " << status.completedPatches
+             << ", late frames: " << status.lateFrames << ", dropped frames: " << status.droppedFrames);
+    return err;
+}
+
+// Returns 0 with the oldest patch event, -1 once the sequence ended and
+// every event was read, -3 if none arrived within timeoutMs
+int DeckLinkSignalGen::waitSequenceEvent(SequenceEvent& event, int timeoutMs) {
+    return m_sequence.waitEvent(event, std::chrono::milliseconds(std::max(timeoutMs, 0)));
+}
+
+SequenceStatus DeckLinkSignalGen::getSequenceStatus() const {
+    return m_sequence.status();
+}
+
+/**
+ * @brief Reports completions of scheduled frames on a pollable descriptor
+ * 
+ * The descriptor is readable while completion events are waiting, so an
+ * event loop can watch it and call readCompletionEvents() instead of a
+ * thread blocking on the output. Every frame scheduled afterwards, by
+ * scheduleFrame(), an output group or a patch sequence, is reported once it
+ * completes, with its number, stream time and completion result.
+ * 
+ * @return int Returns the descriptor, which stays owned by the library, or
+ *         -1 if it cannot be created
+ */
+int DeckLinkSignalGen::enableCompletionEvents() {
+    return m_completions.enable();
+}
+
+// The caller must have stopped watching the descriptor
+void DeckLinkSignalGen::disableCompletionEvents() {
+    m_completions.disable();
+}
+
+int DeckLinkSignalGen::readCompletionEvents(FrameCompletionEvent* events, int capacity) {
+    return m_completions.read(events, capacity);
+}
+
+CompletionStatus DeckLinkSignalGen::getCompletionStatus() const {
+    return m_completions.status();
+}
+
+/**
+ * @brief Moves the oldest frame telemetry samples to the caller
+ * 
+ * Every frame that is displayed synchronously or scheduled leaves a sample
+ * with its submit and scanout times on the hardware reference clock, which
+ * is free of the host's scheduling noise. The newest
+ * FrameTelemetry::kCapacity samples are kept until read.
+ * 
+ * @return int Returns the number of samples written, 0 if none are pending
+ */
+int DeckLinkSignalGen::readFrameTelemetry(FrameTelemetrySample* samples, int capacity) {
+    return m_telemetry.read(samples, capacity);
+}
+
+FrameTelemetryStats DeckLinkSignalGen::getFrameTelemetry() const {
+    return m_telemetry.stats();
+}
+
+void DeckLinkSignalGen::resetFrameTelemetry() {
+    m_telemetry.reset();
+}
+
+/**
+ * @brief Starts checking this output against its capture on another input
+ * 
+ * The input of device inputDeviceIndex is opened in the output's display
+ * mode and pixel format, so the signal looped back arrives in the layout it
+ * was packed in. From now on every frame displayed or scheduled is kept as
+ * a reference until the capture of it comes back, and each capture is
+ * reported as bit-exact or with its per-channel maximum error (see
+ * LoopbackVerifier). switchOutputFormat() restarts the input in the new
+ * display mode and pixel format.
+ * 
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Output not enabled
+ *         - -2: No such device, or it has no input (the mock output has none)
+ *         - -3: The input does not support the output's display mode and pixel format
+ *         - -4: The input could not be started
+ */
+int DeckLinkSignalGen::startLoopback(int inputDeviceIndex) {
+    if (!m_output || !m_outputEnabled) return -1;
+    
+    IDeckLink* device = DeviceRegistry::instance().device(inputDeviceIndex);
+    if (!device) return -2;
+    IDeckLinkInput* input = nullptr;
+    HRESULT result = device->QueryInterface(IID_IDeckLinkInput, (void**)&input);
+    device->Release();
+    if (result != S_OK) {
+        LOG_ERROR("[DeckLink] Device " << inputDeviceIndex << " has no input to verify the loopback with");
+        return -2;
+    }
+    
+    int started = m_loopback.start(input, m_displayMode, m_pixelFormat);
+    input->Release();
+    if (started != 0) return started == -1 ? -3 : -4;
+    return 0;
+}
+
+int DeckLinkSignalGen::stopLoopback() {
+    m_loopback.stop();
+    return 0;
+}
+
+int DeckLinkSignalGen::readLoopbackResults(LoopbackResult* results, int capacity) {
+    return m_loopback.read(results, capacity);
+}
+
+LoopbackStats DeckLinkSignalGen::getLoopbackStats() const {
+    return m_loopback.stats();
+}
+
+void DeckLinkSignalGen::resetLoopbackStats() {
+    m_loopback.reset();
+}
+
+// Current time of the hardware reference clock in ns, 0 if unavailable
+int64_t DeckLinkSignalGen::hardwareTimeNs() const {
+    BMDTimeValue hardwareTime = 0;
+    BMDTimeValue timeInFrame = 0;
+    BMDTimeValue ticksPerFrame = 0;
+    if (m_output->GetHardwareReferenceClock(kNanosecondTimeScale, &hardwareTime, &timeInFrame, &ticksPerFrame) !=
+        S_OK) {
+        return 0;
+    }
+    return hardwareTime;
+}
+
+// Stream time of the display mode's time scale in ns
+int64_t DeckLinkSignalGen::toNanoseconds(BMDTimeValue time) const {
+    if (m_timeScale <= 0) return 0;
+    // Split so hours of stream time cannot overflow
+    return time / m_timeScale * kNanosecondTimeScale + time % m_timeScale * kNanosecondTimeScale / m_timeScale;
+}
+
+// DisplayVideoFrameSync with its wait timed and the frame's hardware submit
+// and scanout times recorded
+HRESULT DeckLinkSignalGen::displayVideoFrameSync(IDeckLinkVideoFrame* frame) {
+    int64_t submitTimestamp = hardwareTimeNs();
+    HRESULT result;
+    {
+        ScopedLatency timer(m_latency.displayFrameSync);
+        result = m_output->DisplayVideoFrameSync(frame);
+    }
+    if (result == S_OK) {
+        m_telemetry.frameDisplayed(submitTimestamp, hardwareTimeNs(), toNanoseconds(m_frameDuration));
+        m_loopback.frameOutput(frame);
+    }
+    return result;
+}
+
+// ScheduleVideoFrame for one frame duration at streamTime. The frame is
+// registered for its completion event and telemetry first, so a completion
+// always finds it, and taken back if the driver refuses it. Once queued it
+// becomes a loopback reference.
+HRESULT DeckLinkSignalGen::queueScheduledFrame(IDeckLinkVideoFrame* frame, BMDTimeValue streamTime) {
+    int64_t submitTimestamp = hardwareTimeNs();
+    int64_t queueLead = 0;
+    BMDTimeValue currentTime = 0;
+    double playbackSpeed = 0.0;
+    if (m_output->GetScheduledStreamTime(m_timeScale, &currentTime, &playbackSpeed) == S_OK && playbackSpeed > 0.0) {
+        queueLead = toNanoseconds(streamTime - currentTime);
+    }
+    uint64_t frameNumber = m_completions.frameScheduled(frame, streamTime, m_timeScale);
+    m_telemetry.frameScheduled(frame, frameNumber, submitTimestamp, toNanoseconds(streamTime), queueLead,
+                               toNanoseconds(m_frameDuration));
+
+    HRESULT result = m_output->ScheduleVideoFrame(frame, streamTime, m_frameDuration, m_timeScale);
+    if (result != S_OK) {
+        m_completions.scheduleFailed(frame);
+        m_telemetry.scheduleFailed(frame);
+    } else {
+        m_loopback.frameOutput(frame);
+    }
+    return result;
+}
+
+// Feeder thread of a patch sequence. Like packPipelineFrame(), the packed
+// frame leaves with one use owned by the sequence.
+int DeckLinkSignalGen::packSequencePatch(const uint16_t* image, const uint16_t rgb[3],
+                                         IDeckLinkMutableVideoFrame** frame) {
+    ScopedLatency timer(m_latency.createFrame);
+    int err;
+    if (image) {
+        err = packFrame(image);
+    } else {
+        std::copy(rgb, rgb + 3, m_patternBackground);
+        m_patternRects.clear();
+        m_patternGenerated = false;
+        err = packFrame(nullptr);
+    }
+    if (err)
+        return err;
+    *frame = m_frame;
+    m_frame = nullptr;
+    return 0;
+}
+
+// Feeder thread of a patch sequence: one frame duration of a packed patch
+int DeckLinkSignalGen::scheduleSequenceFrame(IDeckLinkMutableVideoFrame* frame, BMDTimeValue streamTime) {
+    ScopedLatency timer(m_latency.scheduleFrame);
+    HRESULT result = queueScheduledFrame(frame, streamTime);
+    if (result != S_OK) {
+        LOG_ERROR("[DeckLink] ScheduleVideoFrame failed. HRESULT: 0x" << std::hex << result << std::dec);
+        return -4;
+    }
+    return 0;
+}
+
+/**
+ * @brief Appends the current packed frame to a frame library file
+ * 
+ * The frame is stored with its pixel format, layout and the HDR metadata it
+ * would be shown with, so loadLibraryFrame() can put it back on screen
+ * without the source image or any packing.
+ * 
+ * @param name Label stored with the frame, truncated to 63 characters; may be null
+ * @return int Returns the frame's index in the library on success, negative
+ *         values on failure:
+ *         - -1: Output not enabled
+ *         - -2: No current frame
+ *         - -5, -6, -7: The frame cannot be mapped for reading
+ *         - Other codes: See FrameLibraryWriter::addFrame()
+ */
+int DeckLinkSignalGen::saveFrameToLibrary(FrameLibraryWriter& writer, const char* name) {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (int busy = outputBusy("saveFrameToLibrary")) return busy;
+    if (!m_frame) return -2;
+    
+    FrameLibraryEntry entry = {};
+    entry.pixelFormat = static_cast<uint32_t>(m_frame->GetPixelFormat());
+    entry.width = static_cast<int32_t>(m_frame->GetWidth());
+    entry.height = static_cast<int32_t>(m_frame->GetHeight());
+    entry.rowBytes = static_cast<int32_t>(m_frame->GetRowBytes());
+    entry.eotf = m_hdrMetadata.EOTF;
+    const Gamut_Chromaticities& primaries = m_hdrMetadata.referencePrimaries;
+    double chromaticities[8] = {primaries.RedX, primaries.RedY, primaries.GreenX, primaries.GreenY,
+                                primaries.BlueX, primaries.BlueY, primaries.WhiteX, primaries.WhiteY};
+    std::memcpy(entry.primaries, chromaticities, sizeof(chromaticities));
+    entry.maxDisplayMasteringLuminance = m_hdrMetadata.maxDisplayMasteringLuminance;
+    entry.minDisplayMasteringLuminance = m_hdrMetadata.minDisplayMasteringLuminance;
+    entry.maxCLL = m_hdrMetadata.maxCLL;
+    entry.maxFALL = m_hdrMetadata.maxFALL;
+    if (name) {
+        std::strncpy(entry.name, name, sizeof(entry.name) - 1);
+    }
+    
+    IDeckLinkVideoBuffer* videoBuffer = nullptr;
+    if (m_frame->QueryInterface(IID_IDeckLinkVideoBuffer, (void**)&videoBuffer) != S_OK) return -5;
+    int result = -6;
+    if (videoBuffer->StartAccess(bmdBufferAccessRead) == S_OK) {
+        void* frameData = nullptr;
+        result = videoBuffer->GetBytes(&frameData) == S_OK ? writer.addFrame(entry, frameData) : -7;
+        videoBuffer->EndAccess(bmdBufferAccessRead);
+    }
+    videoBuffer->Release();
+    return result;
+}
+
+/**
+ * @brief Makes a frame from a frame library the next frame
+ * 
+ * The packed payload is copied straight from the mapped file into a pooled
+ * frame, which is all a library frame costs: nothing is converted or
+ * packed, and pages the system has not read ahead yet come in from disk
+ * during the copy. The HDR metadata stored with the frame becomes this
+ * output's metadata, as if set with setHDRMetadata(). The frame is then
+ * shown with displayFrameSync() or scheduleFrame() like any other.
+ * 
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Output not enabled
+ *         - -2: Index out of range
+ *         - -8: The frame was packed in another pixel format than the current one
+ *         - Other codes: See mapOutputFrame()
+ */
+int DeckLinkSignalGen::loadLibraryFrame(const FrameLibrary& library, int index) {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (int busy = outputBusy("loadLibraryFrame")) return busy;
+    const FrameLibraryEntry* entry = library.entry(index);
+    if (!entry) return -2;
+    if (entry->pixelFormat != static_cast<uint32_t>(m_pixelFormat)) {
+        LOG_ERROR("[DeckLink] Library frame " << index << " is packed as "
+                  << fourCharCode(static_cast<int>(entry->pixelFormat)) << ", output is "
+                  << fourCharCode(static_cast<int>(m_pixelFormat)));
+        return -8;
+    }
+    ScopedLatency timer(m_latency.createFrame);
+    
+    if (m_frame && m_frame != m_displayedFrame) {
+        recycleFrame(m_frame);
+    }
+    m_frame = nullptr;
+    m_width = entry->width;
+    m_height = entry->height;
+    m_pendingFrameData.clear();
+    m_pendingIsPattern = false;
+    
+    HDRMetadata metadata;
+    metadata.EOTF = entry->eotf;
+    Gamut_Chromaticities& primaries = metadata.referencePrimaries;
+    primaries.RedX = entry->primaries[0];
+    primaries.RedY = entry->primaries[1];
+    primaries.GreenX = entry->primaries[2];
+    primaries.GreenY = entry->primaries[3];
+    primaries.BlueX = entry->primaries[4];
+    primaries.BlueY = entry->primaries[5];
+    primaries.WhiteX = entry->primaries[6];
+    primaries.WhiteY = entry->primaries[7];
+    metadata.maxDisplayMasteringLuminance = entry->maxDisplayMasteringLuminance;
+    metadata.minDisplayMasteringLuminance = entry->minDisplayMasteringLuminance;
+    metadata.maxCLL = entry->maxCLL;
+    metadata.maxFALL = entry->maxFALL;
+    setHDRMetadata(metadata);
+    
+    IDeckLinkMutableVideoFrame* frame = nullptr;
+    IDeckLinkVideoBuffer* videoBuffer = nullptr;
+    void* frameData = nullptr;
+    int err = mapOutputFrame(nullptr, &frame, &videoBuffer, &frameData);
+    if (err)
+        return err;
+    
+    // Row layouts only differ if the driver changed its row alignment since
+    // the library was written
+    const uint8_t* payload = library.payload(index);
+    size_t rowBytes = static_cast<size_t>(frame->GetRowBytes());
+    if (rowBytes == static_cast<size_t>(entry->rowBytes)) {
+        std::memcpy(frameData, payload, rowBytes * m_height);
+    } else {
+        size_t copyBytes = std::min(rowBytes, static_cast<size_t>(entry->rowBytes));
+        uint8_t* dest = static_cast<uint8_t*>(frameData);
+        for (int y = 0; y < m_height; y++) {
+            std::memcpy(dest + y * rowBytes, payload + static_cast<size_t>(y) * entry->rowBytes, copyBytes);
+        }
+    }
+    
+    videoBuffer->EndAccess(bmdBufferAccessWrite);
+    videoBuffer->Release();
+    m_frame = frame;
+    m_regionBase = nullptr;
+    updateHDRMetadata();
+    return 0;
+}
+
+// True when frames packed by other are byte for byte what this output would
+// pack from the same source, so OutputGroup can copy instead of packing
+bool DeckLinkSignalGen::sharesPackedFrames(const DeckLinkSignalGen& other) const {
+    if (m_pixelFormat != other.m_pixelFormat) return false;
+    YCbCrConversion ours = resolvedYCbCrConversion(other.m_height);
+    YCbCrConversion theirs = other.resolvedYCbCrConversion();
+    uint64_t ourLut = m_colorLut ? m_colorLut->hash() : 0;
+    uint64_t theirLut = other.m_colorLut ? other.m_colorLut->hash() : 0;
+    return ours.matrix == theirs.matrix && ours.fullRange == theirs.fullRange &&
+           ours.chromaFilter == theirs.chromaFilter && ourLut == theirLut;
+}
+
+/**
+ * @brief Makes a copy of another output's current frame the next frame
+ * 
+ * Used by OutputGroup to fan one packed frame out to outputs that share its
+ * pixel format (see sharesPackedFrames()). The packed bytes are copied into
+ * a pooled frame of this output, which keeps its own HDR metadata.
+ * 
+ * @param source Output whose current frame is copied
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Output not enabled
+ *         - -2: The source has no frame, or its layout differs from this output's
+ *         - Other codes: See mapOutputFrame()
+ */
+int DeckLinkSignalGen::copyFrameFrom(const DeckLinkSignalGen& source) {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (int busy = outputBusy("copyFrameFrom")) return busy;
+    IDeckLinkMutableVideoFrame* sourceFrame = source.m_frame;
+    if (!sourceFrame || sourceFrame->GetPixelFormat() != m_pixelFormat) return -2;
+    ScopedLatency timer(m_latency.createFrame);
+    
+    if (m_frame && m_frame != m_displayedFrame) {
+        recycleFrame(m_frame);
+    }
+    m_frame = nullptr;
+    m_width = static_cast<int>(sourceFrame->GetWidth());
+    m_height = static_cast<int>(sourceFrame->GetHeight());
+    m_pendingFrameData.clear();
+    m_pendingIsPattern = false;
+    
+    IDeckLinkMutableVideoFrame* frame = nullptr;
+    IDeckLinkVideoBuffer* videoBuffer = nullptr;
+    void* frameData = nullptr;
+    int err = mapOutputFrame(nullptr, &frame, &videoBuffer, &frameData);
+    if (err)
+        return err;
+    
+    size_t frameBytes = static_cast<size_t>(sourceFrame->GetRowBytes()) * m_height;
+    IDeckLinkVideoBuffer* sourceBuffer = nullptr;
+    void* sourceData = nullptr;
+    err = -2;
+    if (frame->GetRowBytes() == sourceFrame->GetRowBytes() &&
+        sourceFrame->QueryInterface(IID_IDeckLinkVideoBuffer, (void**)&sourceBuffer) == S_OK) {
+        if (sourceBuffer->StartAccess(bmdBufferAccessRead) == S_OK) {
+            if (sourceBuffer->GetBytes(&sourceData) == S_OK) {
+                std::memcpy(frameData, sourceData, frameBytes);
+                err = 0;
+            }
+            sourceBuffer->EndAccess(bmdBufferAccessRead);
+        }
+        sourceBuffer->Release();
+    }
+    
+    videoBuffer->EndAccess(bmdBufferAccessWrite);
+    videoBuffer->Release();
+    if (err) {
+        discardFrame(frame);
+        return err;
+    }
+    m_frame = frame;
+    m_regionBase = nullptr;
+    updateHDRMetadata();
+    return 0;
+}
+
+/**
+ * @brief Joins a DeckLink playback group, or leaves it with groupId 0
+ * 
+ * Outputs in the same playback group start scheduled playback together on
+ * the same hardware frame.
+ * 
+ * @return int Returns 0 on success, -1 if the device does not support
+ *         playback groups, -2 if the configuration could not be set
+ */
+int DeckLinkSignalGen::setPlaybackGroup(int64_t groupId) {
+    if (!m_device || !m_configuration) return -1;
+    
+    IDeckLinkProfileAttributes* attributes = nullptr;
+    if (m_device->QueryInterface(IID_IDeckLinkProfileAttributes, (void**)&attributes) != S_OK || !attributes) {
+        return -1;
+    }
+    bool supported = false;
+    HRESULT result = attributes->GetFlag(BMDDeckLinkSupportsSynchronizeToPlaybackGroup, &supported);
+    attributes->Release();
+    if (result != S_OK || !supported) return -1;
+    
+    if (m_configuration->SetInt(bmdDeckLinkConfigPlaybackGroup, groupId) != S_OK) {
+        LOG_WARNING("[DeckLink] Could not set playback group " << groupId);
+        return -2;
+    }
+    return 0;
+}
+
+int DeckLinkSignalGen::setPixelFormat(BMDPixelFormat pixelFormat) {
+    if (!m_output) return -1;
+    if (int busy = outputBusy("setPixelFormat")) return busy;
+    
+    if (!m_formatsCached) {
+        cacheSupportedFormats();
+    }
+    
+    // Check if the format is supported by this device
+    bool isSupported = false;
+    for (const auto& supportedFormat : m_supportedFormats) {
+        if (supportedFormat == pixelFormat) {
+            isSupported = true;
+            break;
+        }
+    }
+    
+    if (!isSupported) {
+        LOG_ERROR("[DeckLink] Pixel format " << fourCharCode(static_cast<int>(pixelFormat)) 
+                  << " is not supported by this device");
+        return -1;
+    }
+    
+    m_pixelFormat = pixelFormat;
+    LOG_INFO("[DeckLink] Set pixel format to " << fourCharCode(static_cast<int>(m_pixelFormat)));
+    LOG_DEBUG("[DeckLink] Note: SDI output mode will be configured when startOutput() is called");
+    
+    if (m_outputEnabled) {
+        ensureFramePool();
+    }
+    
+    return 0;
+}
+
+BMDPixelFormat DeckLinkSignalGen::getPixelFormat() const {
+    return m_pixelFormat;
+}
+
+int DeckLinkSignalGen::setDisplayMode(BMDDisplayMode displayMode) {
+    if (!m_output) return -1;
+    if (int busy = outputBusy("setDisplayMode")) return busy;
+    
+    // Validate that the display mode is supported
+    if (!supportsVideoMode(displayMode, m_pixelFormat)) {
+        LOG_ERROR("[DeckLink] Display mode " << fourCharCode(static_cast<int>(displayMode)) 
+                  << " is not supported with current pixel format " << fourCharCode(static_cast<int>(m_pixelFormat)));
+        return -1;
+    }
+    
+    if (displayMode != m_displayMode) {
+        m_formatsCached = false;
+    }
+    m_displayMode = displayMode;
+    LOG_INFO("[DeckLink] Set display mode to " << fourCharCode(static_cast<int>(m_displayMode)));
+    
+    if (m_outputEnabled) {
+        ensureFramePool();
+    }
+    
+    return 0;
+}
+
+BMDDisplayMode DeckLinkSignalGen::getDisplayMode() const {
+    return m_displayMode;
+}
+
+/**
+ * @brief Allocates frames for a configuration ahead of switching to it
+ * 
+ * The frames go into the standby pool, which the next switch to this pixel
+ * format and frame size takes over instead of allocating, so the switch does
+ * not pay for CreateVideoFrame. Frames of the previous standby configuration
+ * are released.
+ * 
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Output not enabled or invalid size
+ *         - -3: RowBytesForPixelFormat failed
+ *         - -4: Frame allocation failed
+ */
+int DeckLinkSignalGen::prepareOutputFormat(BMDPixelFormat pixelFormat, int width, int height) {
+    if (!m_output || !m_outputEnabled) return -1;
+    if (int busy = outputBusy("prepareOutputFormat")) return busy;
+    if (width <= 0 || height <= 0) return -1;
+    
+    FrameGeometry geometry;
+    if (frameGeometry(pixelFormat, width, height, geometry) != 0) return -3;
+    if (m_framePool.matches(geometry)) return 0;
+    size_t poolSize = m_pipelineMode ? kPipelineFramePoolSize : kFramePoolSize;
+    if (m_standbyPool.allocate(m_output, geometry, poolSize) != 0) return -4;
+    LOG_INFO("[DeckLink] Prepared frames for " << fourCharCode(static_cast<int>(pixelFormat))
+             << " at " << width << "x" << height);
+    return 0;
+}
+
+/**
+ * @brief Changes pixel format, display mode and HDR metadata in one step
+ * 
+ * Only what actually changed is touched. A new pixel format that keeps the
+ * SDI link (4:2:2 Y'CbCr to 4:2:2, or RGB to 4:4:4) and new metadata just
+ * change how the following frames are packed and stamped, so output stays
+ * enabled and the sink keeps its lock. A new display mode, or going between
+ * the 4:2:2 and 4:4:4 links, disables and re-enables video output with the
+ * new SDI configuration, but keeps the frame pools, the frame cache and the
+ * cached format list. Frames prepared with prepareOutputFormat(), or left
+ * from an earlier configuration, are reused in both cases.
+ * 
+ * A running loopback verifier is restarted in the new display mode and
+ * pixel format, so captures keep matching the packed frames.
+ * 
+ * Not available during scheduled playback.
+ * 
+ * @param displayMode New display mode, 0 to keep the current one
+ * @param metadata New HDR metadata, or nullptr to keep the current values
+ * @param report Filled with what the switch did and how long it took, may be nullptr
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Output interface not available or combination not supported
+ *         - -2: Scheduled playback is active
+ *         - -3: Video output could not be enabled with the new configuration;
+ *               the previous one is restored when possible
+ *         - -4: Output switched, but the loopback input does not support the
+ *               new configuration and was stopped
+ */
+int DeckLinkSignalGen::switchOutputFormat(BMDPixelFormat pixelFormat, BMDDisplayMode displayMode,
+                                          const HDRMetadata* metadata, OutputSwitchReport* report) {
+    if (!m_output) return -1;
+    if (int busy = outputBusy("switchOutputFormat")) return busy;
+    if (m_scheduledMode) {
+        LOG_ERROR("[DeckLink] Stop scheduled playback before switching the output format");
+        return -2;
+    }
+    auto start = std::chrono::steady_clock::now();
+    if (displayMode == 0) {
+        displayMode = m_displayMode;
+    }
+    
+    if (!supportsVideoMode(displayMode, pixelFormat)) {
+        LOG_ERROR("[DeckLink] Pixel format " << fourCharCode(static_cast<int>(pixelFormat))
+                  << " is not supported with display mode " << fourCharCode(static_cast<int>(displayMode)));
+        return -1;
+    }
+    
+    bool relink = m_outputEnabled &&
+                  (displayMode != m_displayMode || is_444_format(pixelFormat) != is_444_format(m_pixelFormat));
+    bool framesReady = false;
+    FrameGeometry geometry;
+    if (frameGeometry(pixelFormat, m_width, m_height, geometry) == 0) {
+        framesReady = m_framePool.matches(geometry) || m_standbyPool.matches(geometry);
+    }
+    
+    if (metadata && std::memcmp(metadata, &m_hdrMetadata, sizeof(HDRMetadata)) != 0) {
+        m_hdrMetadata = *metadata;
+        m_hdrMetadataGeneration++;
+    }
+    
+    if (relink) {
+        // Nothing is on screen while output is disabled
+        releaseFrames();
+        m_output->DisableVideoOutput();
+        m_outputEnabled = false;
+        if (enableVideoOutput(pixelFormat, displayMode) != 0) {
+            if (enableVideoOutput(m_pixelFormat, m_displayMode) == 0) {
+                m_outputEnabled = true;
+            }
+            return -3;
+        }
+        m_outputEnabled = true;
+    }
+    
+    bool formatChanged = displayMode != m_displayMode || pixelFormat != m_pixelFormat;
+    if (displayMode != m_displayMode) {
+        m_formatsCached = false;
+    }
+    m_pixelFormat = pixelFormat;
+    m_displayMode = displayMode;
+    if (m_outputEnabled) {
+        updateFrameTiming();
+        ensureFramePool();
+    }
+    
+    int loopbackError = 0;
+    if (formatChanged && m_loopback.running() && m_loopback.restart(m_displayMode, m_pixelFormat) != 0) {
+        LOG_ERROR("[DeckLink] Loopback verification stopped, the input could not follow the format switch");
+        loopbackError = -4;
+    }
+    
+    uint64_t elapsedNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    LOG_INFO("[DeckLink] Switched to " << fourCharCode(static_cast<int>(m_pixelFormat)) << " in "
+             << fourCharCode(static_cast<int>(m_displayMode)) << (relink ? " with" : " without")
+             << " re-enabling output, " << elapsedNs / 1000 << " us");
+    if (report) {
+        report->elapsedNs = elapsedNs;
+        report->relinked = relink ? 1 : 0;
+        report->framesReady = framesReady ? 1 : 0;
+    }
+    return loopbackError;
+}
+
+int DeckLinkSignalGen::setHDRMetadata(const HDRMetadata& metadata) {
+    if (int busy = outputBusy("setHDRMetadata")) return busy;
+    // Setting the same values again keeps every stamped frame valid
+    if (std::memcmp(&metadata, &m_hdrMetadata, sizeof(HDRMetadata)) != 0) {
+        m_hdrMetadata = metadata;
+        m_hdrMetadataGeneration++;
+    }
+    return 0;
+}
+
+/**
+ * @brief Selects how RGB frames are converted for the Y'CbCr pixel formats
+ * 
+ * Applies to 2vuy, v210 and Ay10; RGB formats ignore it. With
+ * YCbCrMatrix::Auto the matrix follows the colorspace each frame is tagged
+ * with: Rec.2020 while HDR metadata is applied (EOTF >= 0), otherwise
+ * Rec.601 for SD frame sizes and Rec.709 above. YCbCrMatrix::None packs the
+ * source as Y'CbCr triples unchanged.
+ * 
+ * @param matrix Conversion matrix
+ * @param fullRange true for full-range output, false for narrow (video) range
+ * @param chromaFilter Filter used to subsample chroma to 4:2:2
+ * @return int Returns 0 on success, -1 for an unknown matrix or filter
+ */
+int DeckLinkSignalGen::setYCbCrConversion(YCbCrMatrix matrix, bool fullRange, ChromaFilter chromaFilter) {
+    if (int busy = outputBusy("setYCbCrConversion")) return busy;
+    if (matrix < YCbCrMatrix::Auto || matrix > YCbCrMatrix::None) return -1;
+    if (chromaFilter < ChromaFilter::CoSited || chromaFilter > ChromaFilter::Triangle) return -1;
+    m_ycbcrConversion = {matrix, fullRange, chromaFilter};
+    return 0;
+}
+
+YCbCrConversion DeckLinkSignalGen::getYCbCrConversion() const {
+    return m_ycbcrConversion;
+}
+
+/**
+ * @brief Sets the display-correction LUT applied to every packed frame
+ * 
+ * The LUT maps RGB sources right before they are packed (see ColorLut), in
+ * the same pass and on the same row bands, so no corrected copy of the image
+ * is made. This covers images, patterns and region updates alike, and 4:2:2
+ * output converted from RGB. Frames that are already packed, such as
+ * library frames, are not changed.
+ * 
+ * @param shaper shaperSize RGB triples of a 1D shaper, or null
+ * @param shaperSize Entries of the shaper
+ * @param cube cubeSize^3 RGB triples of a 3D cube with red changing fastest, or null
+ * @param cubeSize Points per axis of the cube
+ * @return int Returns 0 on success, -1 for an invalid shaper or cube.
+ *         Passing neither removes the LUT.
+ */
+int DeckLinkSignalGen::setColorLut(const float* shaper, int shaperSize, const float* cube, int cubeSize) {
+    if (int busy = outputBusy("setColorLut")) return busy;
+    if (!shaper && !cube) {
+        m_colorLut.reset();
+        return 0;
+    }
+    auto lut = std::make_unique<ColorLut>();
+    if (int err = lut->build(shaper, shaperSize, cube, cubeSize)) return err;
+    m_colorLut = std::move(lut);
+    return 0;
+}
+
+// The configured conversion with an Auto matrix replaced by the actual one
+YCbCrConversion DeckLinkSignalGen::resolvedYCbCrConversion() const {
+    return resolvedYCbCrConversion(m_height);
+}
+
+// As above for a frame of the given height
+YCbCrConversion DeckLinkSignalGen::resolvedYCbCrConversion(int height) const {
+    YCbCrConversion conversion = m_ycbcrConversion;
+    if (conversion.matrix == YCbCrMatrix::Auto) {
+        if (m_hdrMetadata.EOTF >= 0) {
+            // applyHDRMetadata() tags these frames as Rec.2020
+            conversion.matrix = YCbCrMatrix::Rec2020;
+        } else {
+            conversion.matrix = height <= 576 ? YCbCrMatrix::Rec601 : YCbCrMatrix::Rec709;
+        }
+    }
+    return conversion;
+}
+
+int DeckLinkSignalGen::setFrameData(const uint16_t* data, int width, int height) {
     if (!data || width <= 0 || height <= 0) return -1;
+    if (int busy = outputBusy("setFrameData")) return busy;
+    ScopedLatency timer(m_latency.setFrameData);
     // Update dimensions if they changed
     if (width != m_width || height != m_height) {
         m_width = width;
@@ -338,118 +1981,230 @@ int DeckLinkSignalGen::setFrameData(const uint16_t* data, int width, int height)
     // Store the frame data
     size_t dataSize = width * height * 3; // 3 channels (R, G, B) per pixel
     m_pendingFrameData.assign(data, data + dataSize);
+    m_pendingIsPattern = false;
     return 0;
 }
 
-int DeckLinkSignalGen::getDeviceCount() {
-    IDeckLinkIterator* iterator = CreateDeckLinkIteratorInstance();
-    if (!iterator) return 0;
+void DeckLinkSignalGen::setFrameCacheBudget(size_t bytes) {
+    m_frameCache.setBudget(bytes);
+}
+
+FrameCacheStats DeckLinkSignalGen::getFrameCacheStats() const {
+    return m_frameCache.stats();
+}
+
+DeckLinkStats DeckLinkSignalGen::getStats() const {
+    return m_latency.snapshot();
+}
+
+void DeckLinkSignalGen::resetStats() {
+    m_latency.reset();
+}
+
+int DeckLinkSignalGen::setSolidColor(int width, int height, const uint16_t rgb[3]) {
+    return setRectPattern(width, height, rgb, nullptr, 0);
+}
+
+/**
+ * @brief Sets the next frame to a pattern of colored rectangles
+ * 
+ * Replaces any pending image data. Only the rectangle list is kept;
+ * createFrame() packs it straight into the output frame, so no
+ * width x height source image is built or copied.
+ * 
+ * @param width Frame width in pixels
+ * @param height Frame height in pixels
+ * @param background RGB color of pixels outside every rectangle
+ * @param rects Rectangles drawn in order over the background
+ * @param rectCount Number of rectangles (may be 0 for a solid frame)
+ * @return int Returns 0 on success, -1 for invalid arguments
+ */
+int DeckLinkSignalGen::setRectPattern(int width, int height, const uint16_t background[3],
+                                      const PatternRect* rects, int rectCount) {
+    if (!background || width <= 0 || height <= 0 || rectCount < 0) return -1;
+    if (rectCount > 0 && !rects) return -1;
+    if (int busy = outputBusy("setRectPattern")) return busy;
     
-    int count = 0;
-    IDeckLink* device = nullptr;
-    while (iterator->Next(&device) == S_OK) {
-        count++;
-        device->Release();
+    m_width = width;
+    m_height = height;
+    std::copy(background, background + 3, m_patternBackground);
+    m_patternRects.assign(rects, rects + rectCount);
+    m_pendingIsPattern = true;
+    m_patternGenerated = false;
+    // Drop the image but keep its storage for the next setFrameData()
+    m_pendingFrameData.clear();
+    return 0;
+}
+
+/**
+ * @brief Sets the next frame to a ramp, stepped gradient or zone plate
+ * 
+ * Like setRectPattern(), only the description is kept: createFrame()
+ * computes the rows while packing them (see pack_generated_pattern()), so no
+ * source image exists at any point.
+ * 
+ * @param width Frame width in pixels
+ * @param height Frame height in pixels
+ * @param pattern Kind, colors and shape of the pattern
+ * @return int Returns 0 on success, -1 for invalid arguments
+ */
+int DeckLinkSignalGen::setGeneratedPattern(int width, int height, const GeneratedPattern& pattern) {
+    if (width <= 0 || height <= 0 || pattern.steps < 0) return -1;
+    if (pattern.kind < static_cast<int32_t>(GeneratedPatternKind::HorizontalRamp) ||
+        pattern.kind > static_cast<int32_t>(GeneratedPatternKind::ZonePlate)) {
+        return -1;
     }
-    iterator->Release();
+    if (!std::isfinite(pattern.frequency) || pattern.frequency < 0) return -1;
+    if (int busy = outputBusy("setGeneratedPattern")) return busy;
     
-    return count;
+    m_width = width;
+    m_height = height;
+    m_generatedPattern = pattern;
+    m_pendingIsPattern = true;
+    m_patternGenerated = true;
+    m_pendingFrameData.clear();
+    return 0;
+}
+
+// Served from the device registry, which is filled once and then kept
+// current by hot-plug notifications
+int DeckLinkSignalGen::getDeviceCount() {
+    return DeviceRegistry::instance().count();
 }
 
 std::string DeckLinkSignalGen::getDeviceName(int deviceIndex) {
-    IDeckLinkIterator* iterator = CreateDeckLinkIteratorInstance();
-    if (!iterator) return "";
-    
-    IDeckLink* device = nullptr;
-    int current = 0;
-    std::string deviceName;
-    
-    while (iterator->Next(&device) == S_OK) {
-        if (current == deviceIndex) {
-            CFStringRef nameRef = nullptr;
-            if (device->GetDisplayName(&nameRef) == S_OK && nameRef) {
-                char nameBuffer[256];
-                CFStringGetCString(nameRef, nameBuffer, sizeof(nameBuffer), kCFStringEncodingUTF8);
-                deviceName = nameBuffer;
-                CFRelease(nameRef);
-            }
-            device->Release();
-            break;
-        }
-        device->Release();
-        current++;
+    if (deviceIndex == DECKLINK_MOCK_DEVICE_INDEX) return MockDeckLinkOutput::deviceName();
+    return DeviceRegistry::instance().displayName(deviceIndex);
+}
+
+/**
+ * @brief Starts probing the capability matrix of the output in the background
+ * 
+ * Called on open, so the matrix is usually ready, or read from the cache
+ * file, by the time a format or mode is first checked.
+ * 
+ * @param deviceId Persistent or topological ID the matrix is shared and
+ *        cached under, 0 to probe without caching
+ */
+void DeckLinkSignalGen::startCapabilityProbe(int64_t deviceId) {
+    if (!m_output) return;
+    if (m_capabilities.valid()) {
+        // A probe that failed is started again; a running or good one is kept
+        bool failed = m_capabilities.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+                      !m_capabilities.get();
+        if (!failed) return;
+        m_capabilities = CapabilityFuture();
     }
-    iterator->Release();
-    
-    return deviceName;
+    m_capabilityDeviceId = deviceId;
+    m_capabilities = device_capabilities(m_device, m_output, deviceId, decklink_get_driver_version());
+}
+
+// Waits for the probe to finish, probing again if the last one failed.
+// Returns nullptr if it failed.
+const CapabilityMatrix* DeckLinkSignalGen::capabilities() {
+    startCapabilityProbe(m_capabilityDeviceId);
+    if (!m_capabilities.valid()) return nullptr;
+    return m_capabilities.get().get();
+}
+
+// Support with the default connection, from the matrix or, if probing
+// failed, straight from the driver
+bool DeckLinkSignalGen::supportsVideoMode(BMDDisplayMode displayMode, BMDPixelFormat pixelFormat) {
+    if (const CapabilityMatrix* matrix = capabilities()) {
+        return matrix->supports(displayMode, pixelFormat);
+    }
+    BMDDisplayMode actualMode;
+    bool supported = false;
+    return m_output && m_output->DoesSupportVideoMode(bmdVideoConnectionUnspecified, displayMode, pixelFormat,
+                                                      bmdNoVideoOutputConversion, bmdSupportedVideoModeDefault,
+                                                      &actualMode, &supported) == S_OK && supported;
+}
+
+/**
+ * @brief Copies the supported display mode and pixel format pairs
+ * 
+ * @return int Number of pairs, which may exceed capacity, or -1 if the
+ *         matrix could not be probed
+ */
+int DeckLinkSignalGen::getCapabilities(DeckLinkCapability* entries, int capacity) {
+    const CapabilityMatrix* matrix = capabilities();
+    if (!matrix) return -1;
+    const auto& all = matrix->entries();
+    if (entries && capacity > 0) {
+        size_t count = std::min(all.size(), static_cast<size_t>(capacity));
+        std::copy(all.begin(), all.begin() + count, entries);
+    }
+    return static_cast<int>(all.size());
 }
 
 void DeckLinkSignalGen::cacheSupportedFormats() {
     if (!m_output || m_formatsCached) return;
     
-    std::set<BMDPixelFormat> uniqueFormats;
-    
-    // Test common pixel formats
-    BMDPixelFormat supportedFormats[] = {
-        bmdFormat8BitYUV,       // '2vuy' 4:2:2 Representation
-        bmdFormat10BitYUV,      // 'v210' 4:2:2 Representation
-        bmdFormat10BitYUVA,     // 'Ay10' 4:2:2 raw
-        
-        bmdFormat8BitARGB,      // 32     4:4:4:4 raw
-        bmdFormat8BitBGRA,      // 'BGRA' 4:4:4:x raw
+    if (const CapabilityMatrix* matrix = capabilities()) {
+        m_supportedFormats = matrix->pixelFormats(m_displayMode);
+    } else {
+        m_supportedFormats.clear();
+        for (BMDPixelFormat format : CapabilityMatrix::probedPixelFormats()) {
+            if (supportsVideoMode(m_displayMode, format)) {
+                m_supportedFormats.push_back(format);
+            }
+        }
+    }
+    m_formatsCached = true;
+}
 
-        bmdFormat10BitRGB,      // 'r210' 4:4:4 raw
-        bmdFormat12BitRGB,      // 'R12B' Big-endian RGB 12-bit per component with full range (0-4095). Packed as 12-bit per component
-        bmdFormat12BitRGBLE,    // 'R12L' Little-endian RGB 12-bit per component with full range (0-4095). Packed as 12-bit per component.
-        
-        bmdFormat10BitRGBXLE,   // 'R10l' 4:4:4 raw Three 10-bit unsigned components are packed into one 32-bit little-endian word.
-        bmdFormat10BitRGBX,     // 'R10b' 4:4:4 raw Three 10-bit unsigned components are packed into one 32-bit big-endian word.
-    };
+/**
+ * @brief Stamps the current frame with the HDR metadata if it is out of date
+ * 
+ * Metadata set on a pooled or cached frame stays with it across reuse, so
+ * applyHDRMetadata() only runs for frames that have not been stamped with
+ * the current generation yet: new frames, and every frame once after
+ * setHDRMetadata() changes the values. Nothing is applied while EOTF is
+ * negative.
+ * 
+ * @return int Same as applyHDRMetadata()
+ */
+int DeckLinkSignalGen::updateHDRMetadata() {
+    if (!m_frame || m_hdrMetadata.EOTF < 0) return 0;
     
-    for (int i = 0; i < sizeof(supportedFormats)/sizeof(supportedFormats[0]); i++) {
-        BMDPixelFormat format = supportedFormats[i];
-        BMDDisplayMode actualMode;
-        bool supported;
-        
-        if (m_output->DoesSupportVideoMode(bmdVideoConnectionUnspecified, 
-                                          m_displayMode, 
-                                          format, 
-                                          bmdNoVideoOutputConversion, 
-                                          bmdSupportedVideoModeDefault, 
-                                          &actualMode, 
-                                          &supported) == S_OK && supported) {
-            uniqueFormats.insert(format);
-        }
+    uint64_t stamp = 0;
+    if (!m_frameCache.metadataStamp(m_frame, stamp)) {
+        m_framePool.metadataStamp(m_frame, stamp);
     }
+    if (stamp == m_hdrMetadataGeneration) return 0;
     
-    m_supportedFormats.assign(uniqueFormats.begin(), uniqueFormats.end());
-    m_formatsCached = true;
+    int err = applyHDRMetadata();
+    if (!m_frameCache.setMetadataStamp(m_frame, m_hdrMetadataGeneration)) {
+        m_framePool.setMetadataStamp(m_frame, m_hdrMetadataGeneration);
+    }
+    return err;
 }
 
 int DeckLinkSignalGen::applyHDRMetadata() {
     if (!m_frame) return 0;
+    ScopedLatency timer(m_latency.applyHDRMetadata);
     
     // Get the metadata extensions interface
     IDeckLinkVideoFrameMutableMetadataExtensions* metadataExt = nullptr;
     HRESULT result = m_frame->QueryInterface(IID_IDeckLinkVideoFrameMutableMetadataExtensions, (void**)&metadataExt);
     if (result != S_OK || !metadataExt) {
-        std::cerr << "[DeckLink] Warning: Could not get metadata extensions interface (HRESULT: 0x" 
-                  << std::hex << result << std::dec << "). HDR metadata will not be applied." << std::endl;
+        LOG_WARNING("[DeckLink] Warning: Could not get metadata extensions interface (HRESULT: 0x" 
+                    << std::hex << result << std::dec << "). HDR metadata will not be applied.");
         return 0; // Don't fail the frame creation, just skip metadata
     }
     
     // Set colorspace metadata (Rec2020 for HDR)
     result = metadataExt->SetInt(bmdDeckLinkFrameMetadataColorspace, bmdColorspaceRec2020);
     if (result != S_OK) {
-        std::cerr << "[DeckLink] Warning: Failed to set colorspace metadata (HRESULT: 0x" 
-                  << std::hex << result << std::dec << ")" << std::endl;
+        LOG_WARNING("[DeckLink] Warning: Failed to set colorspace metadata (HRESULT: 0x" 
+                    << std::hex << result << std::dec << ")");
     }
     
     // Set EOTF metadata
     result = metadataExt->SetInt(bmdDeckLinkFrameMetadataHDRElectroOpticalTransferFunc, m_hdrMetadata.EOTF);
     if (result != S_OK) {
-        std::cerr << "[DeckLink] Warning: Failed to set EOTF metadata (HRESULT: 0x" 
-                  << std::hex << result << std::dec << ")" << std::endl;
+        LOG_WARNING("[DeckLink] Warning: Failed to set EOTF metadata (HRESULT: 0x" 
+                    << std::hex << result << std::dec << ")");
     }
     
     // Only apply full HDR metadata for PQ (EOTF = 2)
@@ -484,13 +2239,122 @@ int DeckLinkSignalGen::applyHDRMetadata() {
     return 0;
 }
 
-// Thin C wrapper implementation
-extern "C" {
+// Thin C wrapper implementation
+extern "C" {
+
+int decklink_set_frame_data(DeckLinkHandle handle, const uint16_t* data, int width, int height) {
+    if (!handle || !data) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->setFrameData(data, width, height);
+}
+
+int decklink_create_frame_from_buffer(DeckLinkHandle handle, const uint16_t* data, int width, int height) {
+    if (!handle || !data) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->createFrameFromBuffer(data, width, height);
+}
+
+int decklink_prepare_output_format(DeckLinkHandle handle, uint32_t pixel_format_code, int width, int height) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->prepareOutputFormat(static_cast<BMDPixelFormat>(pixel_format_code), width, height);
+}
+
+int decklink_switch_output_format(DeckLinkHandle handle, uint32_t pixel_format_code, uint32_t display_mode_code,
+                                  const HDRMetadata* metadata, OutputSwitchReport* report) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->switchOutputFormat(static_cast<BMDPixelFormat>(pixel_format_code),
+                                         static_cast<BMDDisplayMode>(display_mode_code), metadata, report);
+}
+
+int decklink_update_frame_region(DeckLinkHandle handle, const uint16_t* data, int width, int height,
+                                 int x, int y, int region_width, int region_height) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->updateFrameRegion(data, width, height, x, y, region_width, region_height);
+}
+
+int decklink_begin_frame_write(DeckLinkHandle handle, int width, int height, void** data, int* row_bytes) {
+    if (!handle || !data || !row_bytes) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    int32_t rowBytes = 0;
+    int err = signalGen->beginFrameWrite(width, height, data, &rowBytes);
+    *row_bytes = rowBytes;
+    return err;
+}
+
+int decklink_end_frame_write(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->endFrameWrite();
+}
+
+/**
+ * @brief Sets the memory budget of the packed-frame cache
+ * 
+ * Repeated frames with the same content and output settings are then shown
+ * without packing again. The budget counts frame buffer bytes; 0 disables
+ * the cache, which is the default.
+ * 
+ * @return int Returns 0 on success, -1 for an invalid handle
+ */
+int decklink_set_frame_cache_budget(DeckLinkHandle handle, uint64_t budget_bytes) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    signalGen->setFrameCacheBudget(static_cast<size_t>(budget_bytes));
+    return 0;
+}
+
+int decklink_get_frame_cache_stats(DeckLinkHandle handle, FrameCacheStats* stats) {
+    if (!handle || !stats) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    *stats = signalGen->getFrameCacheStats();
+    return 0;
+}
 
-int decklink_set_frame_data(DeckLinkHandle handle, const uint16_t* data, int width, int height) {
-    if (!handle || !data) return -1;
+/**
+ * @brief Reads the per-stage latency histograms
+ * 
+ * Each stage reports its sample count, p50, p99, maximum and total time in
+ * nanoseconds, measured with a monotonic clock since the device was opened
+ * or since the last decklink_reset_stats(). Percentiles are bucketed and
+ * accurate to within 12.5%. Safe to call while frames are being produced.
+ * 
+ * @return int Returns 0 on success, -1 for an invalid handle or null stats
+ */
+int decklink_get_stats(DeckLinkHandle handle, DeckLinkStats* stats) {
+    if (!handle || !stats) return -1;
     auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
-    return signalGen->setFrameData(data, width, height);
+    *stats = signalGen->getStats();
+    return 0;
+}
+
+int decklink_reset_stats(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    signalGen->resetStats();
+    return 0;
+}
+
+int decklink_set_solid_color(DeckLinkHandle handle, int width, int height, const uint16_t* rgb) {
+    if (!handle || !rgb) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->setSolidColor(width, height, rgb);
+}
+
+int decklink_set_rect_pattern(DeckLinkHandle handle, int width, int height, const uint16_t* background_rgb,
+                              const PatternRect* rects, int rect_count) {
+    if (!handle || !background_rgb) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->setRectPattern(width, height, background_rgb, rects, rect_count);
+}
+
+int decklink_set_generated_pattern(DeckLinkHandle handle, int width, int height,
+                                   const GeneratedPattern* pattern) {
+    if (!handle || !pattern) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->setGeneratedPattern(width, height, *pattern);
 }
 
 int decklink_get_device_count() {
@@ -511,47 +2375,64 @@ int decklink_get_device_name_by_index(int index, char* name, int name_size) {
 DeckLinkHandle decklink_open_output_by_index(int index) {
     DeckLinkSignalGen* signalGen = new DeckLinkSignalGen();
     
-    // Open the device
-    IDeckLinkIterator* iterator = CreateDeckLinkIteratorInstance();
-    if (!iterator) {
+    // The mock output has no device or configuration interface, so HDR
+    // support reports false and SDI setup is skipped
+    if (index == DECKLINK_MOCK_DEVICE_INDEX) {
+        signalGen->m_output = new MockDeckLinkOutput();
+        signalGen->startCapabilityProbe(0);
+        LOG_INFO("[DeckLink] Opened " << MockDeckLinkOutput::deviceName());
+        return signalGen;
+    }
+    
+    IDeckLink* device = DeviceRegistry::instance().device(index);
+    if (!device) {
         delete signalGen;
         return nullptr;
     }
     
-    IDeckLink* device = nullptr;
-    int current = 0;
-    while (iterator->Next(&device) == S_OK) {
-        if (current == index) {
-            IDeckLinkOutput* output = nullptr;
-            IDeckLinkConfiguration* configuration = nullptr;
-            
-            if (device->QueryInterface(IID_IDeckLinkOutput, (void**)&output) == S_OK) {
-                // Also get the configuration interface for SDI output control
-                if (device->QueryInterface(IID_IDeckLinkConfiguration, (void**)&configuration) == S_OK) {
-                    signalGen->m_device = device;
-                    signalGen->m_output = output;
-                    signalGen->m_configuration = configuration;
-                    iterator->Release();
-                    return signalGen;
-                } else {
-                    std::cerr << "[DeckLink] Warning: Could not get configuration interface for device " << index << std::endl;
-                    // Still proceed without configuration interface
-                    signalGen->m_device = device;
-                    signalGen->m_output = output;
-                    signalGen->m_configuration = nullptr;
-                    iterator->Release();
-                    return signalGen;
-                }
-            }
-            device->Release();
-            break;
-        }
+    IDeckLinkOutput* output = nullptr;
+    if (device->QueryInterface(IID_IDeckLinkOutput, (void**)&output) != S_OK) {
         device->Release();
-        current++;
+        delete signalGen;
+        return nullptr;
+    }
+    
+    // Also get the configuration interface for SDI output control
+    IDeckLinkConfiguration* configuration = nullptr;
+    if (device->QueryInterface(IID_IDeckLinkConfiguration, (void**)&configuration) != S_OK) {
+        LOG_WARNING("[DeckLink] Warning: Could not get configuration interface for device " << index);
+        // Still proceed without configuration interface
+        configuration = nullptr;
+    }
+    signalGen->m_device = device;
+    signalGen->m_output = output;
+    signalGen->m_configuration = configuration;
+    
+    DeckLinkDeviceInfo info = {};
+    DeviceRegistry::instance().info(index, info);
+    signalGen->startCapabilityProbe(info.persistentId != 0 ? info.persistentId : info.topologicalId);
+    return signalGen;
+}
+
+/**
+ * @brief Reads the cached attributes of a device
+ * 
+ * Comes from the device registry, so it does not touch the driver. Indices
+ * match decklink_get_device_name_by_index() and decklink_open_output_by_index(),
+ * and DECKLINK_MOCK_DEVICE_INDEX describes the mock output.
+ * 
+ * @return int Returns 0 on success, -1 for a null info or an index out of range
+ */
+int decklink_get_device_info(int index, DeckLinkDeviceInfo* info) {
+    if (!info) return -1;
+    if (index == DECKLINK_MOCK_DEVICE_INDEX) {
+        *info = {};
+        strncpy(info->displayName, MockDeckLinkOutput::deviceName(), sizeof(info->displayName) - 1);
+        strncpy(info->modelName, MockDeckLinkOutput::deviceName(), sizeof(info->modelName) - 1);
+        info->supportsPlayback = 1;
+        return 0;
     }
-    iterator->Release();
-    delete signalGen;
-    return nullptr;
+    return DeviceRegistry::instance().info(index, *info) ? 0 : -1;
 }
 
 void decklink_close(DeckLinkHandle handle) {
@@ -585,6 +2466,324 @@ int decklink_create_frame_from_data(DeckLinkHandle handle) {
     return signalGen->createFrame();
 }
 
+int decklink_schedule_frame_for_output(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->scheduleFrame();
+}
+
+int decklink_start_scheduled_playback(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->startScheduledPlayback();
+}
+
+int decklink_stop_scheduled_playback(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->stopScheduledPlayback();
+}
+
+int decklink_get_buffered_frame_count(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->getBufferedFrameCount();
+}
+
+int decklink_start_frame_pipeline(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->startPipeline();
+}
+
+int decklink_stop_frame_pipeline(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->stopPipeline();
+}
+
+int decklink_submit_frame(DeckLinkHandle handle, const uint16_t* data, int width, int height) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->submitFrame(data, width, height);
+}
+
+int decklink_flush_frame_pipeline(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->flushPipeline();
+}
+
+int decklink_get_frame_pipeline_stats(DeckLinkHandle handle, FramePipelineStats* stats) {
+    if (!handle || !stats) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->getPipelineStats(*stats);
+}
+
+int decklink_load_sequence(DeckLinkHandle handle, int width, int height, const SequencePatch* patches,
+                           int patch_count) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->loadSequence(width, height, patches, patch_count);
+}
+
+int decklink_start_sequence(DeckLinkHandle handle, int loop) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->startSequence(loop != 0);
+}
+
+int decklink_stop_sequence(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->stopSequence();
+}
+
+int decklink_wait_sequence_event(DeckLinkHandle handle, SequenceEvent* event, int timeout_ms) {
+    if (!handle || !event) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->waitSequenceEvent(*event, timeout_ms);
+}
+
+int decklink_get_sequence_status(DeckLinkHandle handle, SequenceStatus* status) {
+    if (!handle || !status) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    *status = signalGen->getSequenceStatus();
+    return 0;
+}
+
+int decklink_enable_completion_events(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->enableCompletionEvents();
+}
+
+int decklink_disable_completion_events(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    signalGen->disableCompletionEvents();
+    return 0;
+}
+
+// Returns the number of events read, 0 if none were pending
+int decklink_read_completion_events(DeckLinkHandle handle, FrameCompletionEvent* events, int capacity) {
+    if (!handle || !events || capacity <= 0) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->readCompletionEvents(events, capacity);
+}
+
+int decklink_get_completion_status(DeckLinkHandle handle, CompletionStatus* status) {
+    if (!handle || !status) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    *status = signalGen->getCompletionStatus();
+    return 0;
+}
+
+/**
+ * @brief Reads the oldest frame telemetry samples
+ * 
+ * @return int Returns the number of samples written to samples, 0 if none
+ *         are pending, -1 for an invalid handle, buffer or capacity
+ */
+int decklink_read_frame_telemetry(DeckLinkHandle handle, FrameTelemetrySample* samples, int capacity) {
+    if (!handle || !samples || capacity <= 0) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->readFrameTelemetry(samples, capacity);
+}
+
+/**
+ * @brief Gets the submit-to-scanout latency, scanout jitter and frame
+ * counts recorded since the device was opened or last reset
+ * 
+ * @return int Returns 0 on success, -1 for an invalid handle or null stats
+ */
+int decklink_get_frame_telemetry(DeckLinkHandle handle, FrameTelemetryStats* stats) {
+    if (!handle || !stats) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    *stats = signalGen->getFrameTelemetry();
+    return 0;
+}
+
+int decklink_reset_frame_telemetry(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    signalGen->resetFrameTelemetry();
+    return 0;
+}
+
+int decklink_start_loopback(DeckLinkHandle handle, int input_device_index) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->startLoopback(input_device_index);
+}
+
+int decklink_stop_loopback(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->stopLoopback();
+}
+
+/**
+ * @brief Reads the oldest loopback verification results
+ * 
+ * @return int Returns the number of results written, 0 if none are
+ *         pending, -1 for an invalid handle, buffer or capacity
+ */
+int decklink_read_loopback_results(DeckLinkHandle handle, LoopbackResult* results, int capacity) {
+    if (!handle || !results || capacity <= 0) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->readLoopbackResults(results, capacity);
+}
+
+int decklink_get_loopback_stats(DeckLinkHandle handle, LoopbackStats* stats) {
+    if (!handle || !stats) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    *stats = signalGen->getLoopbackStats();
+    return 0;
+}
+
+int decklink_reset_loopback_stats(DeckLinkHandle handle) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    signalGen->resetLoopbackStats();
+    return 0;
+}
+
+DeckLinkGroupHandle decklink_group_create() {
+    return new OutputGroup();
+}
+
+// Members stay open; only the group is freed
+void decklink_group_destroy(DeckLinkGroupHandle group) {
+    delete static_cast<OutputGroup*>(group);
+}
+
+/**
+ * @brief Adds an open output to a group
+ * 
+ * The output leaves the group when it is closed, or when the group is
+ * destroyed. Outputs can be added in any pixel format and display mode;
+ * scheduled playback needs the same frame rate on every member.
+ * 
+ * @return int Returns 0 on success, -1 for a null handle, -2 if the output
+ *         already belongs to a group
+ */
+int decklink_group_add_output(DeckLinkGroupHandle group, DeckLinkHandle handle) {
+    if (!group || !handle) return -1;
+    return static_cast<OutputGroup*>(group)->add(static_cast<DeckLinkSignalGen*>(handle));
+}
+
+int decklink_group_remove_output(DeckLinkGroupHandle group, DeckLinkHandle handle) {
+    if (!group || !handle) return -1;
+    return static_cast<OutputGroup*>(group)->remove(static_cast<DeckLinkSignalGen*>(handle));
+}
+
+int decklink_group_get_output_count(DeckLinkGroupHandle group) {
+    if (!group) return -1;
+    return static_cast<OutputGroup*>(group)->count();
+}
+
+int decklink_group_create_frame_from_buffer(DeckLinkGroupHandle group, const uint16_t* data, int width, int height) {
+    if (!group) return -1;
+    if (!data || width <= 0 || height <= 0) return -2;
+    return static_cast<OutputGroup*>(group)->createFrameFromBuffer(data, width, height);
+}
+
+// Frames actually packed by the last decklink_group_create_frame_from_buffer()
+int decklink_group_get_pack_count(DeckLinkGroupHandle group) {
+    if (!group) return -1;
+    return static_cast<OutputGroup*>(group)->packCount();
+}
+
+int decklink_group_display_frame_sync(DeckLinkGroupHandle group) {
+    if (!group) return -1;
+    return static_cast<OutputGroup*>(group)->displayFrameSync();
+}
+
+int decklink_group_schedule_frame(DeckLinkGroupHandle group) {
+    if (!group) return -1;
+    return static_cast<OutputGroup*>(group)->scheduleFrame();
+}
+
+int decklink_group_start_scheduled_playback(DeckLinkGroupHandle group) {
+    if (!group) return -1;
+    return static_cast<OutputGroup*>(group)->startScheduledPlayback();
+}
+
+int decklink_group_stop_scheduled_playback(DeckLinkGroupHandle group) {
+    if (!group) return -1;
+    return static_cast<OutputGroup*>(group)->stopScheduledPlayback();
+}
+
+/**
+ * @brief Reads the hardware queue depth of every member
+ * 
+ * @param counts Receives one buffered frame count per member, in the order
+ *        they were added
+ * @param max_count Capacity of counts
+ * @return int Number of members on success, or a negative error code
+ */
+int decklink_group_get_buffered_frame_counts(DeckLinkGroupHandle group, int* counts, int max_count) {
+    if (!group || (!counts && max_count > 0)) return -1;
+    return static_cast<OutputGroup*>(group)->getBufferedFrameCounts(counts, max_count);
+}
+
+DeckLinkLibraryWriterHandle decklink_library_writer_create(const char* path) {
+    auto* writer = new FrameLibraryWriter();
+    if (writer->open(path) != 0) {
+        delete writer;
+        return nullptr;
+    }
+    return writer;
+}
+
+int decklink_library_writer_add_frame(DeckLinkLibraryWriterHandle writer, DeckLinkHandle handle, const char* name) {
+    if (!writer || !handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->saveFrameToLibrary(*static_cast<FrameLibraryWriter*>(writer), name);
+}
+
+// Finishes the file and frees the writer, also when finishing fails
+int decklink_library_writer_close(DeckLinkLibraryWriterHandle writer) {
+    if (!writer) return -1;
+    auto* libraryWriter = static_cast<FrameLibraryWriter*>(writer);
+    int result = libraryWriter->finish();
+    delete libraryWriter;
+    return result;
+}
+
+DeckLinkLibraryHandle decklink_library_open(const char* path) {
+    auto* library = new FrameLibrary();
+    if (library->open(path) != 0) {
+        delete library;
+        return nullptr;
+    }
+    return library;
+}
+
+void decklink_library_close(DeckLinkLibraryHandle library) {
+    delete static_cast<FrameLibrary*>(library);
+}
+
+int decklink_library_get_frame_count(DeckLinkLibraryHandle library) {
+    if (!library) return -1;
+    return static_cast<FrameLibrary*>(library)->frameCount();
+}
+
+int decklink_library_get_frame_info(DeckLinkLibraryHandle library, int index, FrameLibraryEntry* info) {
+    if (!library || !info) return -1;
+    const FrameLibraryEntry* entry = static_cast<FrameLibrary*>(library)->entry(index);
+    if (!entry) return -2;
+    *info = *entry;
+    return 0;
+}
+
+int decklink_load_library_frame(DeckLinkHandle handle, DeckLinkLibraryHandle library, int index) {
+    if (!handle || !library) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->loadLibraryFrame(*static_cast<FrameLibrary*>(library), index);
+}
+
 
 uint32_t decklink_get_pixel_format(DeckLinkHandle handle) {
     if (!handle) return 0;
@@ -639,6 +2838,21 @@ int decklink_get_supported_pixel_format_name(DeckLinkHandle handle, int index, c
     return 0;
 }
 
+/**
+ * @brief Reads the whole capability matrix of the output
+ * 
+ * Waits for the background probe started on open if it is still running.
+ * Pass a null entries pointer to get just the count.
+ * 
+ * @return int Number of supported display mode and pixel format pairs,
+ *         which may exceed capacity, or -1 on failure
+ */
+int decklink_get_capabilities(DeckLinkHandle handle, DeckLinkCapability* entries, int capacity) {
+    if (!handle || capacity < 0) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->getCapabilities(entries, capacity);
+}
+
 // Version info
 const char* decklink_get_driver_version() {
     static std::string version;
@@ -668,6 +2882,50 @@ const char* decklink_get_sdk_version() {
     return sdk_version.c_str();
 }
 
+/**
+ * @brief Sets how many threads pack each frame
+ * 
+ * The packing threads are shared by every open device. A count of 1 packs on
+ * the calling thread only; 0 selects one thread per hardware core.
+ * 
+ * @return int Returns 0 on success, -1 for a negative thread count
+ */
+int decklink_set_pack_thread_count(int thread_count) {
+    if (thread_count < 0) return -1;
+    WorkerPool::instance().setThreadCount(thread_count);
+    LOG_INFO("[DeckLink] Pack thread count set to " << WorkerPool::instance().threadCount());
+    return 0;
+}
+
+int decklink_get_pack_thread_count() {
+    return WorkerPool::instance().threadCount();
+}
+
+/**
+ * @brief Sets the most verbose level the library logs at
+ * 
+ * Messages are written to stderr by a background thread, so logging never
+ * blocks frame output. The default is info. Debug messages, which include
+ * per-frame packing details, only exist in builds without NDEBUG.
+ * 
+ * @param level 0 = none, 1 = error, 2 = warning, 3 = info, 4 = debug
+ * @return int Returns 0 on success, -1 for a level outside 0-4
+ */
+int decklink_set_log_level(int level) {
+    if (level < static_cast<int>(LogLevel::None) || level > static_cast<int>(LogLevel::Debug)) return -1;
+    Logger::setLevel(static_cast<LogLevel>(level));
+    return 0;
+}
+
+int decklink_get_log_level() {
+    return static_cast<int>(Logger::level());
+}
+
+// Waits until every queued log message has been written to stderr
+void decklink_flush_log() {
+    Logger::instance().flush();
+}
+
 // Add new C wrapper function for complete HDR metadata
 int decklink_set_hdr_metadata(DeckLinkHandle handle, const HDRMetadata* metadata) {
     if (!handle || !metadata) return -1;
@@ -675,6 +2933,30 @@ int decklink_set_hdr_metadata(DeckLinkHandle handle, const HDRMetadata* metadata
     return signalGen->setHDRMetadata(*metadata);
 }
 
+int decklink_set_ycbcr_conversion(DeckLinkHandle handle, int matrix, int full_range, int chroma_filter) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->setYCbCrConversion(static_cast<YCbCrMatrix>(matrix), full_range != 0,
+                                         static_cast<ChromaFilter>(chroma_filter));
+}
+
+int decklink_set_color_lut(DeckLinkHandle handle, const float* shaper, int shaper_size, const float* cube,
+                           int cube_size) {
+    if (!handle) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    return signalGen->setColorLut(shaper, shaper_size, cube, cube_size);
+}
+
+int decklink_get_ycbcr_conversion(DeckLinkHandle handle, int* matrix, int* full_range, int* chroma_filter) {
+    if (!handle || !matrix || !full_range || !chroma_filter) return -1;
+    auto* signalGen = static_cast<DeckLinkSignalGen*>(handle);
+    YCbCrConversion conversion = signalGen->getYCbCrConversion();
+    *matrix = static_cast<int>(conversion.matrix);
+    *full_range = conversion.fullRange ? 1 : 0;
+    *chroma_filter = static_cast<int>(conversion.chromaFilter);
+    return 0;
+}
+
 // HDR capability detection
 bool decklink_device_supports_hdr(DeckLinkHandle handle) {
     if (!handle) return false;
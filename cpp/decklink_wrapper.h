@@ -1,6 +1,19 @@
 #pragma once
 
 #include "DeckLinkAPI.h"
+#include "capability_matrix.h"
+#include "completion_events.h"
+#include "device_registry.h"
+#include "frame_cache.h"
+#include "frame_library.h"
+#include "frame_pipeline.h"
+#include "frame_pool.h"
+#include "frame_telemetry.h"
+#include "latency_stats.h"
+#include "loopback_verifier.h"
+#include "patch_sequence.h"
+#include "pixel_packing.h"
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -8,6 +21,9 @@
 
 // Handle type for C API
 typedef void *DeckLinkHandle;
+typedef void *DeckLinkGroupHandle;
+typedef void *DeckLinkLibraryHandle;
+typedef void *DeckLinkLibraryWriterHandle;
 
 // Wrapper definitions for versioned symbols
 extern "C"
@@ -21,12 +37,24 @@ extern "C"
 #define CreateDeckLinkDiscoveryInstance CreateDeckLinkDiscoveryInstance_0003
 #define CreateDeckLinkAPIInformationInstance CreateDeckLinkAPIInformationInstance_0001
 
+class OutputCallback;
+class OutputGroup;
+
 // Error codes
 #define DECKLINK_SUCCESS 0
 #define DECKLINK_ERROR_NO_DEVICE -1
 #define DECKLINK_ERROR_INIT_FAILED -2
 #define DECKLINK_ERROR_OUTPUT_FAILED -3
 #define DECKLINK_ERROR_FRAME_FAILED -4
+// The frame pipeline owns the frames and settings until it is stopped
+#define DECKLINK_ERROR_PIPELINE_RUNNING -10
+// A patch sequence is playing and owns the frames and settings until it
+// finishes or is stopped
+#define DECKLINK_ERROR_SEQUENCE_RUNNING -11
+
+// Device index that opens the hardware-free mock output (mock_output.h)
+// instead of a DeckLink device. Not counted by decklink_get_device_count().
+#define DECKLINK_MOCK_DEVICE_INDEX -1000
 
 // Complete HDR metadata structure (matching SignalGenHDR sample)
 struct Gamut_Chromaticities
@@ -51,6 +79,14 @@ struct HDRMetadata
     double maxFALL;
 };
 
+// What decklink_switch_output_format() did
+struct OutputSwitchReport
+{
+    uint64_t elapsedNs;  // time spent in the switch
+    int32_t relinked;    // 1 if video output was disabled and re-enabled
+    int32_t framesReady; // 1 if frames for the new format were already allocated
+};
+
 // C++ Implementation Class
 class DeckLinkSignalGen
 {
@@ -65,8 +101,54 @@ public:
 
     // Frame management
     int createFrame();
+    int createFrameFromBuffer(const uint16_t *data, int width, int height);
+    int updateFrameRegion(const uint16_t *data, int width, int height,
+                          int x, int y, int regionWidth, int regionHeight);
+    int beginFrameWrite(int width, int height, void **data, int32_t *rowBytes);
+    int endFrameWrite();
     int displayFrameSync();
 
+    // Scheduled playback
+    int scheduleFrame();
+    int startScheduledPlayback();
+    int stopScheduledPlayback();
+    int getBufferedFrameCount();
+    int nextStreamTime(BMDTimeValue &streamTime, BMDTimeValue &frameDuration, BMDTimeScale &timeScale);
+    int scheduleFrameAt(BMDTimeValue streamTime);
+    void onScheduledFrameCompleted(IDeckLinkVideoFrame *frame, BMDOutputFrameCompletionResult result);
+
+    // Pipelined display (frame_pipeline.h)
+    int startPipeline();
+    int stopPipeline();
+    int submitFrame(const uint16_t *data, int width, int height);
+    int flushPipeline();
+    int getPipelineStats(FramePipelineStats &stats) const;
+
+    // Patch sequences played on scheduled frame timing (patch_sequence.h)
+    int loadSequence(int width, int height, const SequencePatch *patches, int count);
+    int startSequence(bool loop);
+    int stopSequence();
+    int waitSequenceEvent(SequenceEvent &event, int timeoutMs);
+    SequenceStatus getSequenceStatus() const;
+
+    // Scheduled frame completions on a pollable descriptor (completion_events.h)
+    int enableCompletionEvents();
+    void disableCompletionEvents();
+    int readCompletionEvents(FrameCompletionEvent *events, int capacity);
+    CompletionStatus getCompletionStatus() const;
+
+    // Hardware timing of frames reaching the output (frame_telemetry.h)
+    int readFrameTelemetry(FrameTelemetrySample *samples, int capacity);
+    FrameTelemetryStats getFrameTelemetry() const;
+    void resetFrameTelemetry();
+
+    // Verification of the output looped back into an input (loopback_verifier.h)
+    int startLoopback(int inputDeviceIndex);
+    int stopLoopback();
+    int readLoopbackResults(LoopbackResult *results, int capacity);
+    LoopbackStats getLoopbackStats() const;
+    void resetLoopbackStats();
+
     // Pixel format management
     int setPixelFormat(BMDPixelFormat pixelFormat);
     BMDPixelFormat getPixelFormat() const;
@@ -74,14 +156,49 @@ public:
     // Display mode management
     int setDisplayMode(BMDDisplayMode displayMode);
     BMDDisplayMode getDisplayMode() const;
+
+    // Switching between configurations without a full output restart
+    int prepareOutputFormat(BMDPixelFormat pixelFormat, int width, int height);
+    int switchOutputFormat(BMDPixelFormat pixelFormat, BMDDisplayMode displayMode,
+                           const HDRMetadata *metadata, OutputSwitchReport *report);
     
     // Complete HDR metadata management
     int setHDRMetadata(const HDRMetadata &metadata);
 
+    // RGB to Y'CbCr conversion for the 4:2:2 formats
+    int setYCbCrConversion(YCbCrMatrix matrix, bool fullRange, ChromaFilter chromaFilter);
+    YCbCrConversion getYCbCrConversion() const;
+
+    // Display-correction LUT for RGB sources
+    int setColorLut(const float *shaper, int shaperSize, const float *cube, int cubeSize);
+
     // Frame data management
     int setFrameData(const uint16_t *data, int width, int height);
-
-    // Device enumeration (static)
+    int setSolidColor(int width, int height, const uint16_t rgb[3]);
+    int setRectPattern(int width, int height, const uint16_t background[3],
+                       const PatternRect *rects, int rectCount);
+    int setGeneratedPattern(int width, int height, const GeneratedPattern &pattern);
+
+    // Packed-frame cache
+    void setFrameCacheBudget(size_t bytes);
+    FrameCacheStats getFrameCacheStats() const;
+
+    // Per-stage latency
+    DeckLinkStats getStats() const;
+    void resetStats();
+
+    // Output groups (output_group.h)
+    bool sharesPackedFrames(const DeckLinkSignalGen &other) const;
+    int copyFrameFrom(const DeckLinkSignalGen &source);
+    int setPlaybackGroup(int64_t groupId);
+    OutputGroup *outputGroup() const { return m_outputGroup; }
+    void setOutputGroup(OutputGroup *group) { m_outputGroup = group; }
+
+    // Pre-packed frame library files (frame_library.h)
+    int saveFrameToLibrary(FrameLibraryWriter &writer, const char *name);
+    int loadLibraryFrame(const FrameLibrary &library, int index);
+
+    // Device enumeration (static, from the device registry)
     static int getDeviceCount();
     static std::string getDeviceName(int deviceIndex);
 
@@ -89,6 +206,10 @@ public:
     void cacheSupportedFormats();
     std::vector<BMDPixelFormat> &getSupportedFormats() { return m_supportedFormats; }
 
+    // Display mode x pixel format x connection support (capability_matrix.h)
+    void startCapabilityProbe(int64_t deviceId);
+    int getCapabilities(DeckLinkCapability *entries, int capacity);
+
     // Core DeckLink objects (made public for C wrapper access)
     IDeckLink* m_device;
     IDeckLinkOutput* m_output;
@@ -102,21 +223,120 @@ private:
     int m_height;
     bool m_outputEnabled;
     BMDPixelFormat m_pixelFormat;
-    BMDDisplayMode m_displayMode;
 
-    // Complete HDR metadata
+    // Complete HDR metadata. The generation goes up whenever it changes;
+    // pooled and cached frames remember the generation they were stamped with.
     HDRMetadata m_hdrMetadata;
-
-    // Cached supported formats
+    uint64_t m_hdrMetadataGeneration;
+    // Matrix may be Auto, resolved per frame by resolvedYCbCrConversion()
+    YCbCrConversion m_ycbcrConversion;
+    // Display-correction LUT applied while packing, null when none is set
+    std::unique_ptr<ColorLut> m_colorLut;
+
+    // Capability matrix, probed in the background from open, and the
+    // formats supported in m_displayMode, refreshed when the mode changes
+    CapabilityFuture m_capabilities;
+    int64_t m_capabilityDeviceId; // as passed to startCapabilityProbe()
     std::vector<BMDPixelFormat> m_supportedFormats;
     bool m_formatsCached;
 
-    // Pending frame data
+    // Pending frame data: either a full RGB image or, when m_pendingIsPattern
+    // is set, a pattern packed without a source frame: m_generatedPattern if
+    // m_patternGenerated is set, a background color plus rectangles otherwise
     std::vector<uint16_t> m_pendingFrameData;
+    bool m_pendingIsPattern;
+    bool m_patternGenerated;
+    uint16_t m_patternBackground[3];
+    std::vector<PatternRect> m_patternRects;
+    GeneratedPattern m_generatedPattern;
+
+    // Preallocated output frames. m_frame is borrowed from the pool while it is
+    // being filled; m_displayedFrame is the frame currently on screen.
+    FramePool m_framePool;
+    IDeckLinkMutableVideoFrame* m_displayedFrame;
+    // Frames of another geometry, kept for the next switch to it
+    FramePool m_standbyPool;
+
+    // Packed frames kept for repeated patches. Frames handed out from the
+    // cache are returned through recycleFrame() like pooled frames.
+    FrameCache m_frameCache;
+    StageLatencyHistograms m_latency;
+
+    // Frame lent to the caller between beginFrameWrite() and endFrameWrite(),
+    // with its buffer mapped for writing
+    IDeckLinkMutableVideoFrame* m_writeFrame;
+    IDeckLinkVideoBuffer* m_writeBuffer;
+
+    // Scheduled playback state. Frames handed to ScheduleVideoFrame stay
+    // borrowed from the pool until ScheduledFrameCompleted returns them.
+    OutputCallback* m_outputCallback;
+    bool m_scheduledMode;
+    bool m_scheduledPlaybackRunning;
+    BMDTimeValue m_frameDuration;
+    BMDTimeScale m_timeScale;
+    BMDTimeValue m_nextStreamTime;
+    std::atomic<uint64_t> m_lateFrames;
+    std::atomic<uint64_t> m_droppedFrames;
+    // Completions of every scheduled frame, for a reader polling its descriptor
+    CompletionEvents m_completions;
+    // Hardware submit and scanout times of every displayed frame
+    FrameTelemetry m_telemetry;
+    // Captures of this output from an input, compared with what was output
+    LoopbackVerifier m_loopback;
+
+    // Group this output belongs to, if any; it is removed when closed
+    OutputGroup* m_outputGroup;
+
+    // Pipelined display. While m_pipeline runs, its pack thread fills
+    // m_frame and its display thread owns m_pipelineOnScreen instead of
+    // m_displayedFrame. Frames keep the size of the first one submitted.
+    std::unique_ptr<FramePipeline> m_pipeline;
+    bool m_pipelineMode;
+    IDeckLinkMutableVideoFrame* m_pipelineOnScreen;
+    int m_pipelineWidth;
+    int m_pipelineHeight;
+
+    // Last frame known to hold a full pack of its source, and the settings
+    // it was packed with, which updateFrameRegion() copies and patches.
+    // Only used while it is still m_frame or m_displayedFrame.
+    IDeckLinkMutableVideoFrame* m_regionBase;
+    uint64_t m_regionBaseSettings;
+
+    // Uploaded patch sequence. While it plays, its feeder thread fills
+    // m_frame and every scheduled frame belongs to it.
+    PatchSequence m_sequence;
 
     // Private helper methods
+    int updateFrameTiming();
+    int ensureFramePool();
+    int packFrame(const uint16_t *srcData);
+    int enableVideoOutput(BMDPixelFormat pixelFormat, BMDDisplayMode displayMode);
+    int frameGeometry(FrameGeometry &geometry) const;
+    int frameGeometry(BMDPixelFormat pixelFormat, int width, int height, FrameGeometry &geometry) const;
+    int mapOutputFrame(const FrameCacheKey *cacheKey, IDeckLinkMutableVideoFrame **frame,
+                       IDeckLinkVideoBuffer **buffer, void **frameData);
+    uint64_t packSettingsHash() const;
+    FrameCacheKey frameCacheKey(const uint16_t *srcData) const;
+    YCbCrConversion resolvedYCbCrConversion() const;
+    YCbCrConversion resolvedYCbCrConversion(int height) const;
+    void recycleFrame(IDeckLinkVideoFrame *frame);
+    void discardFrame(IDeckLinkVideoFrame *frame);
+    void releaseFrames();
+    int updateHDRMetadata();
     int applyHDRMetadata();
     void logFrameInfo(const char *context);
+    int64_t hardwareTimeNs() const;
+    int64_t toNanoseconds(BMDTimeValue time) const;
+    HRESULT displayVideoFrameSync(IDeckLinkVideoFrame *frame);
+    HRESULT queueScheduledFrame(IDeckLinkVideoFrame *frame, BMDTimeValue streamTime);
+    int outputBusy(const char *call) const;
+    const CapabilityMatrix *capabilities();
+    bool supportsVideoMode(BMDDisplayMode displayMode, BMDPixelFormat pixelFormat);
+    int beginScheduledPlayback();
+    int packPipelineFrame(const uint16_t *data, int width, int height, IDeckLinkMutableVideoFrame **frame);
+    int displayPipelineFrame(IDeckLinkMutableVideoFrame *frame);
+    int packSequencePatch(const uint16_t *image, const uint16_t rgb[3], IDeckLinkMutableVideoFrame **frame);
+    int scheduleSequenceFrame(IDeckLinkMutableVideoFrame *frame, BMDTimeValue streamTime);
 };
 
 // Thin C wrapper for ctypes compatibility
@@ -128,6 +348,7 @@ extern "C"
     // Device enumeration
     int decklink_get_device_count();
     int decklink_get_device_name_by_index(int index, char *name, int name_size);
+    int decklink_get_device_info(int index, DeckLinkDeviceInfo *info);
 
     // Device management
     DeckLinkHandle decklink_open_output_by_index(int index);
@@ -140,18 +361,137 @@ extern "C"
 
     // Frame management
     int decklink_create_frame_from_data(DeckLinkHandle handle);
+    // Zero-copy: pack straight from the caller's image, or write packed
+    // pixels directly into a pooled frame between begin and end
+    int decklink_create_frame_from_buffer(DeckLinkHandle handle, const uint16_t *data, int width, int height);
+    // Format switching without tearing the output down
+    int decklink_prepare_output_format(DeckLinkHandle handle, uint32_t pixel_format_code, int width, int height);
+    int decklink_switch_output_format(DeckLinkHandle handle, uint32_t pixel_format_code, uint32_t display_mode_code,
+                                      const HDRMetadata *metadata, OutputSwitchReport *report);
+
+    // Dirty rectangle: repack only the groups a changed rectangle touches,
+    // starting from a copy of the previous frame
+    int decklink_update_frame_region(DeckLinkHandle handle, const uint16_t *data, int width, int height,
+                                     int x, int y, int region_width, int region_height);
+    int decklink_begin_frame_write(DeckLinkHandle handle, int width, int height, void **data, int *row_bytes);
+    int decklink_end_frame_write(DeckLinkHandle handle);
+
+    // Scheduled playback
+    int decklink_schedule_frame_for_output(DeckLinkHandle handle);
+    int decklink_start_scheduled_playback(DeckLinkHandle handle);
+    int decklink_stop_scheduled_playback(DeckLinkHandle handle);
+    int decklink_get_buffered_frame_count(DeckLinkHandle handle);
+
+    // Pipelined display: submitted images are packed and displayed by library
+    // threads, so packing the next frame overlaps the display of this one
+    int decklink_start_frame_pipeline(DeckLinkHandle handle);
+    int decklink_stop_frame_pipeline(DeckLinkHandle handle);
+    int decklink_submit_frame(DeckLinkHandle handle, const uint16_t *data, int width, int height);
+    int decklink_flush_frame_pipeline(DeckLinkHandle handle);
+    int decklink_get_frame_pipeline_stats(DeckLinkHandle handle, FramePipelineStats *stats);
+
+    // Patch sequences: upload a list of solid colors or images with dwell
+    // times, then the library packs and plays them on scheduled frame timing
+    // and reports each finished patch as an event
+    int decklink_load_sequence(DeckLinkHandle handle, int width, int height, const SequencePatch *patches,
+                               int patch_count);
+    int decklink_start_sequence(DeckLinkHandle handle, int loop);
+    int decklink_stop_sequence(DeckLinkHandle handle);
+    int decklink_wait_sequence_event(DeckLinkHandle handle, SequenceEvent *event, int timeout_ms);
+    int decklink_get_sequence_status(DeckLinkHandle handle, SequenceStatus *status);
+
+    // Completion events: a descriptor that is readable while completions of
+    // scheduled frames are waiting, so an event loop can await a frame
+    // leaving the screen without a blocked thread. The descriptor belongs to
+    // the library and stays valid until disabled or the device is closed.
+    int decklink_enable_completion_events(DeckLinkHandle handle);
+    int decklink_disable_completion_events(DeckLinkHandle handle);
+    int decklink_read_completion_events(DeckLinkHandle handle, FrameCompletionEvent *events, int capacity);
+    int decklink_get_completion_status(DeckLinkHandle handle, CompletionStatus *status);
+
+    // Frame telemetry: hardware reference timestamps of every frame handed to
+    // the output and of its scanout, kept in a ring buffer of the newest
+    // samples, with a summary of latency, jitter and late or dropped frames
+    int decklink_read_frame_telemetry(DeckLinkHandle handle, FrameTelemetrySample *samples, int capacity);
+    int decklink_get_frame_telemetry(DeckLinkHandle handle, FrameTelemetryStats *stats);
+    int decklink_reset_frame_telemetry(DeckLinkHandle handle);
+
+    // Loopback verification: the output captured back through the input of
+    // a device index, each capture matched on a background thread with the
+    // frame it was generated from and reported as bit-exact or with its
+    // per-channel maximum error
+    int decklink_start_loopback(DeckLinkHandle handle, int input_device_index);
+    int decklink_stop_loopback(DeckLinkHandle handle);
+    int decklink_read_loopback_results(DeckLinkHandle handle, LoopbackResult *results, int capacity);
+    int decklink_get_loopback_stats(DeckLinkHandle handle, LoopbackStats *stats);
+    int decklink_reset_loopback_stats(DeckLinkHandle handle);
+
+    // Output groups: open outputs driven in lockstep, with each source packed
+    // once per distinct pixel format (output_group.h)
+    DeckLinkGroupHandle decklink_group_create();
+    void decklink_group_destroy(DeckLinkGroupHandle group);
+    int decklink_group_add_output(DeckLinkGroupHandle group, DeckLinkHandle handle);
+    int decklink_group_remove_output(DeckLinkGroupHandle group, DeckLinkHandle handle);
+    int decklink_group_get_output_count(DeckLinkGroupHandle group);
+    int decklink_group_create_frame_from_buffer(DeckLinkGroupHandle group, const uint16_t *data, int width, int height);
+    int decklink_group_get_pack_count(DeckLinkGroupHandle group);
+    int decklink_group_display_frame_sync(DeckLinkGroupHandle group);
+    int decklink_group_schedule_frame(DeckLinkGroupHandle group);
+    int decklink_group_start_scheduled_playback(DeckLinkGroupHandle group);
+    int decklink_group_stop_scheduled_playback(DeckLinkGroupHandle group);
+    int decklink_group_get_buffered_frame_counts(DeckLinkGroupHandle group, int *counts, int max_count);
+
+    // Frame libraries: files of packed frames written from an output's
+    // current frame and mapped back for display without packing
+    // (frame_library.h). Create and open return null on failure.
+    DeckLinkLibraryWriterHandle decklink_library_writer_create(const char *path);
+    int decklink_library_writer_add_frame(DeckLinkLibraryWriterHandle writer, DeckLinkHandle handle,
+                                          const char *name);
+    int decklink_library_writer_close(DeckLinkLibraryWriterHandle writer);
+    DeckLinkLibraryHandle decklink_library_open(const char *path);
+    void decklink_library_close(DeckLinkLibraryHandle library);
+    int decklink_library_get_frame_count(DeckLinkLibraryHandle library);
+    int decklink_library_get_frame_info(DeckLinkLibraryHandle library, int index, FrameLibraryEntry *info);
+    int decklink_load_library_frame(DeckLinkHandle handle, DeckLinkLibraryHandle library, int index);
 
     // Pixel format management
     int decklink_get_supported_pixel_format_count(DeckLinkHandle handle);
     int decklink_get_supported_pixel_format_name(DeckLinkHandle handle, int index, char *name, int name_size);
+    // Every supported display mode and pixel format pair in one call: copies
+    // up to capacity and returns how many there are
+    int decklink_get_capabilities(DeckLinkHandle handle, DeckLinkCapability *entries, int capacity);
     int decklink_set_pixel_format(DeckLinkHandle handle, uint32_t pixel_format_code);
     uint32_t decklink_get_pixel_format(DeckLinkHandle handle);
 
     // Complete HDR metadata control
     int decklink_set_hdr_metadata(DeckLinkHandle handle, const HDRMetadata *metadata);
 
+    // RGB to Y'CbCr conversion for 2vuy/v210/Ay10 (matrix 0 = auto, 4 = none)
+    int decklink_set_ycbcr_conversion(DeckLinkHandle handle, int matrix, int full_range, int chroma_filter);
+    int decklink_get_ycbcr_conversion(DeckLinkHandle handle, int *matrix, int *full_range, int *chroma_filter);
+
+    // Display-correction LUT applied while packing: shaper_size RGB triples of
+    // a 1D shaper and/or cube_size^3 RGB triples of a 3D cube (red fastest),
+    // normalized to 0-1. Passing neither removes the LUT.
+    int decklink_set_color_lut(DeckLinkHandle handle, const float *shaper, int shaper_size, const float *cube,
+                               int cube_size);
+
     // Frame data management
     int decklink_set_frame_data(DeckLinkHandle handle, const uint16_t *data, int width, int height);
+    // Packed-frame cache (budget in bytes, 0 = disabled)
+    int decklink_set_frame_cache_budget(DeckLinkHandle handle, uint64_t budget_bytes);
+    int decklink_get_frame_cache_stats(DeckLinkHandle handle, FrameCacheStats *stats);
+
+    // Per-stage latency histograms (nanoseconds)
+    int decklink_get_stats(DeckLinkHandle handle, DeckLinkStats *stats);
+    int decklink_reset_stats(DeckLinkHandle handle);
+
+    int decklink_set_solid_color(DeckLinkHandle handle, int width, int height, const uint16_t *rgb);
+    int decklink_set_rect_pattern(DeckLinkHandle handle, int width, int height, const uint16_t *background_rgb,
+                                  const PatternRect *rects, int rect_count);
+    // Ramp or zone plate computed while packing, see GeneratedPattern
+    int decklink_set_generated_pattern(DeckLinkHandle handle, int width, int height,
+                                       const GeneratedPattern *pattern);
 
     // Synchronous display
     int decklink_display_frame_sync(DeckLinkHandle handle);
@@ -159,6 +499,15 @@ extern "C"
     // HDR capability detection
     bool decklink_device_supports_hdr(DeckLinkHandle handle);
 
+    // Packing threads, shared by every open device (0 = one per core)
+    int decklink_set_pack_thread_count(int thread_count);
+    int decklink_get_pack_thread_count();
+
+    // Library logging: 0 = none, 1 = error, 2 = warning, 3 = info, 4 = debug
+    int decklink_set_log_level(int level);
+    int decklink_get_log_level();
+    void decklink_flush_log();
+
 // Display mode management
 uint32_t decklink_get_display_mode(DeckLinkHandle handle);
 int decklink_set_display_mode(DeckLinkHandle handle, uint32_t display_mode_code);
@@ -0,0 +1,195 @@
+#include "device_registry.h"
+#include "decklink_wrapper.h"
+#include "logger.h"
+#include <cstring>
+#include <CoreFoundation/CoreFoundation.h>
+
+static void copy_cf_string(CFStringRef string, char* buffer, size_t size) {
+    buffer[0] = '\0';
+    if (!string) return;
+    if (!CFStringGetCString(string, buffer, size, kCFStringEncodingUTF8)) {
+        buffer[0] = '\0';
+    }
+    CFRelease(string);
+}
+
+DeviceRegistry& DeviceRegistry::instance() {
+    static DeviceRegistry registry;
+    return registry;
+}
+
+/**
+ * @brief Lists the devices present now, then subscribes to hot-plug events
+ *
+ * The iterator pass makes the list complete as soon as the constructor
+ * returns; discovery then reports the same devices again, and addDevice()
+ * swaps its objects into the existing entries so that removals, which
+ * discovery reports with those objects, find them.
+ */
+DeviceRegistry::DeviceRegistry()
+    : m_discovery(nullptr)
+{
+    IDeckLinkIterator* iterator = CreateDeckLinkIteratorInstance();
+    if (iterator) {
+        IDeckLink* deckLink = nullptr;
+        while (iterator->Next(&deckLink) == S_OK) {
+            addDevice(deckLink);
+            deckLink->Release();
+        }
+        iterator->Release();
+    }
+
+    m_discovery = CreateDeckLinkDiscoveryInstance();
+    if (!m_discovery) {
+        LOG_WARNING("[DeviceRegistry] DeckLink discovery unavailable, devices plugged in later will not be listed");
+        return;
+    }
+    HRESULT result = m_discovery->InstallDeviceNotifications(this);
+    if (result != S_OK) {
+        LOG_WARNING("[DeviceRegistry] InstallDeviceNotifications failed. HRESULT: 0x"
+                    << std::hex << result << std::dec);
+        m_discovery->Release();
+        m_discovery = nullptr;
+    }
+}
+
+DeviceRegistry::~DeviceRegistry() {
+    if (m_discovery) {
+        m_discovery->UninstallDeviceNotifications();
+        m_discovery->Release();
+        m_discovery = nullptr;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entry : m_entries) {
+        entry.device->Release();
+    }
+    m_entries.clear();
+}
+
+int DeviceRegistry::count() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<int>(m_entries.size());
+}
+
+bool DeviceRegistry::info(int index, DeckLinkDeviceInfo& info) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (index < 0 || index >= static_cast<int>(m_entries.size())) return false;
+    info = m_entries[index].info;
+    return true;
+}
+
+std::string DeviceRegistry::displayName(int index) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (index < 0 || index >= static_cast<int>(m_entries.size())) return "";
+    return m_entries[index].info.displayName;
+}
+
+IDeckLink* DeviceRegistry::device(int index) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (index < 0 || index >= static_cast<int>(m_entries.size())) return nullptr;
+    IDeckLink* deckLink = m_entries[index].device;
+    deckLink->AddRef();
+    return deckLink;
+}
+
+HRESULT DeviceRegistry::DeckLinkDeviceArrived(IDeckLink* deckLink) {
+    if (deckLink) {
+        addDevice(deckLink);
+    }
+    return S_OK;
+}
+
+HRESULT DeviceRegistry::DeckLinkDeviceRemoved(IDeckLink* deckLink) {
+    if (!deckLink) return S_OK;
+
+    // Discovery reports removal with the object it reported on arrival,
+    // which addDevice() stored; attributes may no longer be readable
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto match = m_entries.begin();
+    while (match != m_entries.end() && match->device != deckLink) {
+        ++match;
+    }
+    if (match != m_entries.end()) {
+        LOG_INFO("[DeviceRegistry] Device removed: " << match->info.displayName);
+        match->device->Release();
+        m_entries.erase(match);
+    }
+    return S_OK;
+}
+
+HRESULT DeviceRegistry::QueryInterface(REFIID iid, LPVOID* ppv) {
+    // Only ever handed to InstallDeviceNotifications, which does not query
+    *ppv = nullptr;
+    return E_NOINTERFACE;
+}
+
+ULONG DeviceRegistry::AddRef() {
+    return 1;
+}
+
+ULONG DeviceRegistry::Release() {
+    return 1;
+}
+
+// Reads every cached attribute of a device
+DeckLinkDeviceInfo DeviceRegistry::describe(IDeckLink* deckLink) {
+    DeckLinkDeviceInfo info;
+    std::memset(&info, 0, sizeof(info));
+
+    CFStringRef name = nullptr;
+    if (deckLink->GetDisplayName(&name) == S_OK) {
+        copy_cf_string(name, info.displayName, sizeof(info.displayName));
+    }
+    name = nullptr;
+    if (deckLink->GetModelName(&name) == S_OK) {
+        copy_cf_string(name, info.modelName, sizeof(info.modelName));
+    }
+
+    IDeckLinkProfileAttributes* attributes = nullptr;
+    if (deckLink->QueryInterface(IID_IDeckLinkProfileAttributes, (void**)&attributes) != S_OK || !attributes) {
+        return info;
+    }
+    int64_t value = 0;
+    if (attributes->GetInt(BMDDeckLinkPersistentID, &value) == S_OK) {
+        info.persistentId = value;
+    }
+    if (attributes->GetInt(BMDDeckLinkTopologicalID, &value) == S_OK) {
+        info.topologicalId = value;
+    }
+    if (attributes->GetInt(BMDDeckLinkVideoIOSupport, &value) == S_OK) {
+        info.supportsPlayback = (value & bmdDeviceSupportsPlayback) ? 1 : 0;
+    }
+    bool flag = false;
+    if (attributes->GetFlag(BMDDeckLinkSupportsHDRMetadata, &flag) == S_OK) {
+        info.supportsHDR = flag ? 1 : 0;
+    }
+    attributes->Release();
+    return info;
+}
+
+// Iterator and discovery hand out different objects for the same device,
+// so devices are matched on their IDs and, lacking those, on their name
+bool DeviceRegistry::sameDevice(const DeckLinkDeviceInfo& a, const DeckLinkDeviceInfo& b) {
+    if (a.persistentId != 0 && b.persistentId != 0) return a.persistentId == b.persistentId;
+    if (a.topologicalId != 0 && b.topologicalId != 0) return a.topologicalId == b.topologicalId;
+    return a.displayName[0] != '\0' && std::strcmp(a.displayName, b.displayName) == 0;
+}
+
+// Adds a device, or if it is already listed stores deckLink and its
+// attributes in that entry. Returns true if it was added.
+bool DeviceRegistry::addDevice(IDeckLink* deckLink) {
+    DeckLinkDeviceInfo info = describe(deckLink);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entry : m_entries) {
+        if (entry.device != deckLink && !sameDevice(entry.info, info)) continue;
+        deckLink->AddRef();
+        entry.device->Release();
+        entry.device = deckLink;
+        entry.info = info;
+        return false;
+    }
+    deckLink->AddRef();
+    m_entries.push_back({deckLink, info});
+    LOG_INFO("[DeviceRegistry] Device added: " << info.displayName);
+    return true;
+}
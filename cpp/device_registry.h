@@ -0,0 +1,68 @@
+#pragma once
+
+#include "DeckLinkAPI.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Attributes of one device, read once when it arrives and reported by
+// decklink_get_device_info()
+struct DeckLinkDeviceInfo
+{
+    char displayName[256];
+    char modelName[256];
+    int64_t persistentId;  // 0 if the device does not report one
+    int64_t topologicalId; // 0 if the device does not report one
+    int32_t supportsPlayback;
+    int32_t supportsHDR;
+};
+
+// Process-wide list of DeckLink devices. It is filled once from
+// IDeckLinkIterator and then kept current by IDeckLinkDiscovery arrival and
+// removal notifications, so counting devices and reading their names or
+// attributes never walks the driver again. Indices follow arrival order and
+// shift down when a device is removed.
+class DeviceRegistry : public IDeckLinkDeviceNotificationCallback
+{
+public:
+    static DeviceRegistry &instance();
+
+    DeviceRegistry(const DeviceRegistry &) = delete;
+    DeviceRegistry &operator=(const DeviceRegistry &) = delete;
+
+    int count() const;
+    // Both return false for an index out of range
+    bool info(int index, DeckLinkDeviceInfo &info) const;
+    std::string displayName(int index) const;
+    // Returns the device with a reference the caller must release, or nullptr
+    IDeckLink *device(int index) const;
+
+    // IDeckLinkDeviceNotificationCallback, called on a driver thread
+    HRESULT DeckLinkDeviceArrived(IDeckLink *deckLink) override;
+    HRESULT DeckLinkDeviceRemoved(IDeckLink *deckLink) override;
+
+    // IUnknown. The registry lives for the whole process, so references
+    // are not counted.
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) override;
+    ULONG AddRef() override;
+    ULONG Release() override;
+
+private:
+    struct Entry
+    {
+        IDeckLink *device;
+        DeckLinkDeviceInfo info;
+    };
+
+    DeviceRegistry();
+    virtual ~DeviceRegistry();
+
+    static DeckLinkDeviceInfo describe(IDeckLink *deckLink);
+    static bool sameDevice(const DeckLinkDeviceInfo &a, const DeckLinkDeviceInfo &b);
+    bool addDevice(IDeckLink *deckLink);
+
+    std::vector<Entry> m_entries;
+    IDeckLinkDiscovery *m_discovery;
+    mutable std::mutex m_mutex;
+};
@@ -0,0 +1,237 @@
+#include "frame_cache.h"
+#include "logger.h"
+#include <cstring>
+
+static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+static constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+
+static inline uint64_t rotl64(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t read64(const uint8_t* bytes) {
+    uint64_t value;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+static inline uint64_t hash_round(uint64_t acc, uint64_t input) {
+    return rotl64(acc + input * kPrime2, 31) * kPrime1;
+}
+
+/**
+ * @brief Hashes a block of memory for cache lookups
+ * 
+ * Four independent lanes consume 32 bytes per step so the loop runs at close
+ * to memory bandwidth on whole frames. Not suitable for anything security
+ * related.
+ */
+uint64_t hash_frame_bytes(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t lanes[4] = {seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1};
+    
+    size_t offset = 0;
+    for (; offset + 32 <= size; offset += 32) {
+        for (int i = 0; i < 4; i++) {
+            lanes[i] = hash_round(lanes[i], read64(bytes + offset + 8 * i));
+        }
+    }
+    
+    uint64_t hash = rotl64(lanes[0], 1) + rotl64(lanes[1], 7) + rotl64(lanes[2], 12) + rotl64(lanes[3], 18);
+    hash += size;
+    for (; offset + 8 <= size; offset += 8) {
+        hash = rotl64(hash ^ hash_round(0, read64(bytes + offset)), 27) * kPrime1 + kPrime3;
+    }
+    for (; offset < size; offset++) {
+        hash = rotl64(hash ^ (bytes[offset] * kPrime3), 11) * kPrime1;
+    }
+    
+    // Final avalanche
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+FrameCache::FrameCache()
+    : m_budget(0)
+    , m_bytes(0)
+    , m_hits(0)
+    , m_misses(0)
+    , m_evictions(0)
+{
+}
+
+FrameCache::~FrameCache() {
+    clear();
+}
+
+void FrameCache::setBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budget = bytes;
+    // Shrink to the new budget; frames still in use stay until released
+    for (auto it = m_entries.end(); it != m_entries.begin() && m_bytes > m_budget;) {
+        --it;
+        if (it->users == 0) {
+            eraseLocked(it++);
+            m_evictions++;
+        }
+    }
+}
+
+size_t FrameCache::budget() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budget;
+}
+
+bool FrameCache::enabled() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budget > 0;
+}
+
+IDeckLinkMutableVideoFrame* FrameCache::lookup(const FrameCacheKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_index.find(key);
+    if (found == m_index.end()) {
+        m_misses++;
+        return nullptr;
+    }
+    m_hits++;
+    EntryIterator entry = found->second;
+    m_entries.splice(m_entries.begin(), m_entries, entry);
+    entry->users++;
+    return entry->frame;
+}
+
+IDeckLinkMutableVideoFrame* FrameCache::insert(IDeckLinkOutput* output, const FrameCacheKey& key,
+                                               const FrameGeometry& geometry) {
+    if (!output) return nullptr;
+    size_t bytes = static_cast<size_t>(geometry.rowBytes) * geometry.height;
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (bytes == 0 || bytes > m_budget) return nullptr;
+    
+    auto existing = m_index.find(key);
+    if (existing != m_index.end() && existing->second->users == 0) {
+        eraseLocked(existing->second);
+    } else if (existing != m_index.end()) {
+        // Still in use under the same key; keep it and do not cache this one
+        return nullptr;
+    }
+    
+    IDeckLinkMutableVideoFrame* frame = evictToFitLocked(bytes, geometry);
+    if (m_bytes + bytes > m_budget) {
+        // Everything left is in use
+        if (frame) frame->Release();
+        return nullptr;
+    }
+    if (!frame) {
+        HRESULT result = output->CreateVideoFrame(
+            geometry.width, geometry.height, geometry.rowBytes,
+            geometry.pixelFormat,
+            bmdFrameFlagDefault,
+            &frame);
+        if (result != S_OK || !frame) {
+            LOG_ERROR("[FrameCache] CreateVideoFrame failed. HRESULT: 0x"
+                      << std::hex << result << std::dec);
+            return nullptr;
+        }
+    }
+    
+    m_entries.push_front({key, geometry, frame, bytes, 1, 0});
+    m_index[key] = m_entries.begin();
+    m_bytes += bytes;
+    return frame;
+}
+
+// Evicts idle LRU entries until `bytes` more fit in the budget. The first
+// evicted frame with a matching geometry is handed back for reuse instead of
+// being released.
+IDeckLinkMutableVideoFrame* FrameCache::evictToFitLocked(size_t bytes, const FrameGeometry& geometry) {
+    IDeckLinkMutableVideoFrame* reusable = nullptr;
+    for (auto it = m_entries.end(); it != m_entries.begin() && m_bytes + bytes > m_budget;) {
+        --it;
+        if (it->users != 0) continue;
+        
+        if (!reusable && it->geometry == geometry) {
+            reusable = it->frame;
+            it->frame = nullptr;
+        }
+        eraseLocked(it++);
+        m_evictions++;
+    }
+    return reusable;
+}
+
+void FrameCache::eraseLocked(EntryIterator entry) {
+    if (entry->frame) {
+        entry->frame->Release();
+    }
+    m_bytes -= entry->bytes;
+    m_index.erase(entry->key);
+    m_entries.erase(entry);
+}
+
+void FrameCache::discard(IDeckLinkVideoFrame* frame) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->frame == frame) {
+            eraseLocked(it);
+            return;
+        }
+    }
+}
+
+// May be called from the DeckLink completion thread
+bool FrameCache::release(IDeckLinkVideoFrame* frame) {
+    if (!frame) return false;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entry : m_entries) {
+        if (entry.frame == frame) {
+            if (entry.users > 0) entry.users--;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FrameCache::metadataStamp(IDeckLinkVideoFrame* frame, uint64_t& stamp) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& entry : m_entries) {
+        if (entry.frame == frame) {
+            stamp = entry.metadataStamp;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FrameCache::setMetadataStamp(IDeckLinkVideoFrame* frame, uint64_t stamp) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entry : m_entries) {
+        if (entry.frame == frame) {
+            entry.metadataStamp = stamp;
+            return true;
+        }
+    }
+    return false;
+}
+
+void FrameCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entry : m_entries) {
+        entry.frame->Release();
+    }
+    m_entries.clear();
+    m_index.clear();
+    m_bytes = 0;
+}
+
+FrameCacheStats FrameCache::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return {m_hits, m_misses, m_evictions, static_cast<uint64_t>(m_entries.size()),
+            static_cast<uint64_t>(m_bytes), static_cast<uint64_t>(m_budget)};
+}
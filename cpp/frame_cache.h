@@ -0,0 +1,109 @@
+#pragma once
+
+#include "DeckLinkAPI.h"
+#include "frame_pool.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+// Identifies the packed result of one source image: a hash of the source
+// content plus a hash of every setting that changes the packed bytes or the
+// frame's metadata (pixel format, display mode, size, HDR metadata).
+struct FrameCacheKey
+{
+    uint64_t contentHash;
+    uint64_t settingsHash;
+
+    bool operator==(const FrameCacheKey &other) const
+    {
+        return contentHash == other.contentHash && settingsHash == other.settingsHash;
+    }
+};
+
+// Counters reported through decklink_get_frame_cache_stats()
+struct FrameCacheStats
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t entries;
+    uint64_t bytes;
+    uint64_t budgetBytes;
+};
+
+// Fast non-cryptographic 64-bit hash, used for FrameCacheKey
+uint64_t hash_frame_bytes(const void *data, size_t size, uint64_t seed = 0);
+
+// LRU cache of already-packed frames, so a repeated patch skips packing and
+// goes straight to display. Frames handed out by lookup() or insert() count
+// as in use until release(); only idle frames are evicted. Cached frames are
+// allocated separately from the FramePool and are owned by the cache.
+class FrameCache
+{
+public:
+    FrameCache();
+    ~FrameCache();
+
+    FrameCache(const FrameCache &) = delete;
+    FrameCache &operator=(const FrameCache &) = delete;
+
+    // Memory budget in bytes of frame data. 0 disables the cache.
+    void setBudget(size_t bytes);
+    size_t budget() const;
+    bool enabled() const;
+
+    // Returns the cached frame for key, marked in use, or nullptr on a miss
+    IDeckLinkMutableVideoFrame *lookup(const FrameCacheKey &key);
+    // Makes room and returns a frame for a new entry, marked in use. Idle
+    // evicted frames of the same geometry are recycled. Returns nullptr if
+    // the frame cannot fit in the budget.
+    IDeckLinkMutableVideoFrame *insert(IDeckLinkOutput *output, const FrameCacheKey &key,
+                                       const FrameGeometry &geometry);
+    // Drops an entry whose frame could not be filled
+    void discard(IDeckLinkVideoFrame *frame);
+    // Marks one use of a cached frame as finished. Returns false if the
+    // frame does not belong to the cache.
+    bool release(IDeckLinkVideoFrame *frame);
+
+    // Same as FramePool: metadata generation last applied to a cached frame,
+    // 0 for a new entry, even one that reuses an evicted frame
+    bool metadataStamp(IDeckLinkVideoFrame *frame, uint64_t &stamp) const;
+    bool setMetadataStamp(IDeckLinkVideoFrame *frame, uint64_t stamp);
+
+    void clear();
+    FrameCacheStats stats() const;
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const FrameCacheKey &key) const
+        {
+            return static_cast<size_t>(key.contentHash ^ (key.settingsHash * 0x9E3779B97F4A7C15ull));
+        }
+    };
+
+    struct Entry
+    {
+        FrameCacheKey key;
+        FrameGeometry geometry;
+        IDeckLinkMutableVideoFrame *frame;
+        size_t bytes;
+        int users;
+        uint64_t metadataStamp;
+    };
+    typedef std::list<Entry>::iterator EntryIterator;
+
+    void eraseLocked(EntryIterator entry);
+    IDeckLinkMutableVideoFrame *evictToFitLocked(size_t bytes, const FrameGeometry &geometry);
+
+    std::list<Entry> m_entries; // most recently used first
+    std::unordered_map<FrameCacheKey, EntryIterator, KeyHash> m_index;
+    size_t m_budget;
+    size_t m_bytes;
+    uint64_t m_hits;
+    uint64_t m_misses;
+    uint64_t m_evictions;
+    mutable std::mutex m_mutex;
+};
@@ -0,0 +1,258 @@
+#include "frame_compare.h"
+#include "pixel_packing_simd.h"
+#include "worker_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <vector>
+
+/*
+ * Every format pack_pixel_format() writes is a run of fixed-size groups of
+ * 32-bit words. After each word is loaded in its byte order, a group is a
+ * little-endian bitstream, and each component it holds is a field of that
+ * stream: R12L's value k starts at bit 12 * k across word boundaries, the
+ * other formats keep every field inside one word. The tables below list the
+ * fields with the source channel and pixel they were packed from (see the
+ * Format structs in pixel_packing.cpp); alpha and padding bits are left out.
+ */
+
+struct PackedField
+{
+    uint16_t bit;
+    uint8_t bits;
+    uint8_t channel;
+    uint8_t pixel; // within the group
+};
+
+struct PackedLayout
+{
+    BMDPixelFormat pixelFormat;
+    int pixelsPerGroup;
+    int groupBytes;
+    std::endian wordOrder;
+    int fieldCount;
+    PackedField fields[24];
+};
+
+static constexpr int kMaxGroupWords = 9;
+
+// One pixel per word: R, G and B from the given bit
+static constexpr PackedLayout rgb_word_layout(BMDPixelFormat pixelFormat, std::endian wordOrder, int bits,
+                                              int rBit, int gBit, int bBit) {
+    PackedLayout layout{pixelFormat, 1, 4, wordOrder, 3, {}};
+    layout.fields[0] = {static_cast<uint16_t>(rBit), static_cast<uint8_t>(bits), 0, 0};
+    layout.fields[1] = {static_cast<uint16_t>(gBit), static_cast<uint8_t>(bits), 1, 0};
+    layout.fields[2] = {static_cast<uint16_t>(bBit), static_cast<uint8_t>(bits), 2, 0};
+    return layout;
+}
+
+static constexpr PackedLayout r12_layout(BMDPixelFormat pixelFormat, std::endian wordOrder) {
+    PackedLayout layout{pixelFormat, 8, 36, wordOrder, 24, {}};
+    for (int k = 0; k < 24; k++) {
+        layout.fields[k] = {static_cast<uint16_t>(12 * k), 12, static_cast<uint8_t>(k % 3),
+                            static_cast<uint8_t>(k / 3)};
+    }
+    return layout;
+}
+
+static constexpr PackedLayout v210_layout() {
+    // Source value behind each field, as kV210Fields in pixel_packing.cpp
+    constexpr int sources[4][3] = {{1, 0, 2}, {3, 7, 6}, {8, 9, 13}, {12, 14, 15}};
+    PackedLayout layout{bmdFormat10BitYUV, 6, 16, std::endian::little, 12, {}};
+    for (int word = 0; word < 4; word++) {
+        for (int f = 0; f < 3; f++) {
+            int v = sources[word][f];
+            layout.fields[word * 3 + f] = {static_cast<uint16_t>(32 * word + 10 * f), 10,
+                                           static_cast<uint8_t>(v % 3), static_cast<uint8_t>(v / 3)};
+        }
+    }
+    return layout;
+}
+
+static constexpr PackedLayout kLayouts[] = {
+    rgb_word_layout(bmdFormat8BitBGRA, std::endian::little, 8, 16, 8, 0),
+    rgb_word_layout(bmdFormat8BitARGB, std::endian::little, 8, 0, 8, 16),
+    rgb_word_layout(bmdFormat10BitRGB, std::endian::big, 10, 20, 10, 0),
+    rgb_word_layout(bmdFormat10BitRGBXLE, std::endian::little, 10, 22, 12, 2),
+    rgb_word_layout(bmdFormat10BitRGBX, std::endian::big, 10, 22, 12, 2),
+    r12_layout(bmdFormat12BitRGBLE, std::endian::little),
+    r12_layout(bmdFormat12BitRGB, std::endian::big),
+    // Cb0 Y0 Cr0 Y1
+    {bmdFormat8BitYUV, 2, 4, std::endian::little, 4, {{0, 8, 1, 0}, {8, 8, 0, 0}, {16, 8, 2, 0}, {24, 8, 0, 1}}},
+    v210_layout(),
+    // Cb0 Y0 A0 | Cr0 Y1 A1
+    {bmdFormat10BitYUVA, 2, 8, std::endian::little, 4, {{0, 10, 1, 0}, {10, 10, 0, 0}, {32, 10, 2, 0}, {42, 10, 0, 1}}},
+};
+
+static const PackedLayout* find_layout(BMDPixelFormat pixelFormat) {
+    for (const PackedLayout& layout : kLayouts) {
+        if (layout.pixelFormat == pixelFormat) return &layout;
+    }
+    return nullptr;
+}
+
+// Bytes of a row that hold pixels: whole groups, except that formats
+// without padding end a row in the middle of its last group
+static int payload_bytes(const PackedLayout& layout, const PackedFrameView& a, const PackedFrameView& b) {
+    int groups = (a.width + layout.pixelsPerGroup - 1) / layout.pixelsPerGroup;
+    return std::min({groups * layout.groupBytes, a.rowBytes, b.rowBytes});
+}
+
+// Returns the layout both frames share, or nullptr
+static const PackedLayout* shared_layout(const PackedFrameView& a, const PackedFrameView& b) {
+    if (!a.data || !b.data || a.width <= 0 || a.height <= 0) return nullptr;
+    if (a.width != b.width || a.height != b.height || a.pixelFormat != b.pixelFormat) return nullptr;
+    const PackedLayout* layout = find_layout(a.pixelFormat);
+    if (!layout) return nullptr;
+    int minimumBytes = (a.width * layout->groupBytes + layout->pixelsPerGroup - 1) / layout->pixelsPerGroup;
+    if (payload_bytes(*layout, a, b) < minimumBytes) return nullptr;
+    return layout;
+}
+
+// Bytes at the start of a and b that are equal
+static int matching_prefix(const uint8_t* a, const uint8_t* b, int bytes, MatchingPrefixKernel kernel) {
+    int x = kernel ? kernel(a, b, bytes) : 0;
+    for (; x + 8 <= bytes; x += 8) {
+        uint64_t wordA, wordB;
+        std::memcpy(&wordA, a + x, sizeof(wordA));
+        std::memcpy(&wordB, b + x, sizeof(wordB));
+        if (wordA != wordB) break;
+    }
+    while (x < bytes && a[x] == b[x]) x++;
+    return x;
+}
+
+// Loads the first `bytes` bytes of a group, zero-filling the rest
+static void load_group(uint32_t* words, const uint8_t* src, int bytes, const PackedLayout& layout) {
+    int count = layout.groupBytes / 4;
+    std::memset(words, 0, layout.groupBytes);
+    std::memcpy(words, src, bytes);
+    if (layout.wordOrder != std::endian::native) {
+        for (int w = 0; w < count; w++) words[w] = __builtin_bswap32(words[w]);
+    }
+    words[count] = 0;
+}
+
+static inline uint32_t field_value(const uint32_t* words, const PackedField& field) {
+    int word = field.bit / 32;
+    uint64_t pair = words[word] | (static_cast<uint64_t>(words[word + 1]) << 32);
+    return static_cast<uint32_t>(pair >> (field.bit % 32)) & ((1u << field.bits) - 1);
+}
+
+// Adds the differences of one group holding `pixels` pixels of the row in
+// its first `bytes` bytes
+static void compare_group(const uint8_t* a, const uint8_t* b, int bytes, const PackedLayout& layout, int pixels,
+                          FrameCompareResult& result) {
+    uint32_t wordsA[kMaxGroupWords + 1];
+    uint32_t wordsB[kMaxGroupWords + 1];
+    load_group(wordsA, a, bytes, layout);
+    load_group(wordsB, b, bytes, layout);
+    for (int f = 0; f < layout.fieldCount; f++) {
+        const PackedField& field = layout.fields[f];
+        if (field.pixel >= pixels) continue;
+        uint32_t valueA = field_value(wordsA, field);
+        uint32_t valueB = field_value(wordsB, field);
+        if (valueA == valueB) continue;
+        uint16_t error = static_cast<uint16_t>(valueA > valueB ? valueA - valueB : valueB - valueA);
+        result.mismatchedSamples++;
+        result.maxError[field.channel] = std::max(result.maxError[field.channel], error);
+    }
+}
+
+// Compares rows [firstRow, lastRow). With stopAtDifference it returns as
+// soon as a byte of the payload differs, without unpacking anything.
+// Returns false if a difference was found.
+static bool compare_rows(const PackedFrameView& a, const PackedFrameView& b, const PackedLayout& layout,
+                         int firstRow, int lastRow, bool stopAtDifference, FrameCompareResult& result) {
+    MatchingPrefixKernel kernel = simd_row_kernels().matchingPrefix;
+    int payloadBytes = payload_bytes(layout, a, b);
+    bool equal = true;
+
+    for (int y = firstRow; y < lastRow; y++) {
+        const uint8_t* rowA = static_cast<const uint8_t*>(a.data) + static_cast<size_t>(y) * a.rowBytes;
+        const uint8_t* rowB = static_cast<const uint8_t*>(b.data) + static_cast<size_t>(y) * b.rowBytes;
+        uint64_t samplesBefore = result.mismatchedSamples;
+        int x = 0;
+        while (true) {
+            x += matching_prefix(rowA + x, rowB + x, payloadBytes - x, kernel);
+            if (x == payloadBytes) break;
+            if (stopAtDifference) return false;
+            // Unpack the group holding the first differing byte, then look
+            // for the next difference after it. A byte that only differs in
+            // padding or alpha bits counts no samples.
+            int groupStart = x / layout.groupBytes * layout.groupBytes;
+            int groupBytes = std::min(layout.groupBytes, payloadBytes - groupStart);
+            int pixels = std::min(layout.pixelsPerGroup, a.width - groupStart / layout.groupBytes * layout.pixelsPerGroup);
+            compare_group(rowA + groupStart, rowB + groupStart, groupBytes, layout, pixels, result);
+            x = groupStart + groupBytes;
+        }
+        if (result.mismatchedSamples != samplesBefore) {
+            result.mismatchedRows++;
+            equal = false;
+        }
+    }
+    return equal;
+}
+
+// Frames split into row bands the way pack_pixel_format() splits them
+static constexpr size_t kParallelMinPixels = 256 * 1024;
+static constexpr int kMinRowsPerBand = 16;
+
+static int band_count(const PackedFrameView& frame) {
+    if (static_cast<size_t>(frame.width) * frame.height < kParallelMinPixels) return 1;
+    return std::clamp(frame.height / kMinRowsPerBand, 1, WorkerPool::instance().threadCount());
+}
+
+int packed_frames_equal(const PackedFrameView& a, const PackedFrameView& b) {
+    const PackedLayout* layout = shared_layout(a, b);
+    if (!layout) return -1;
+
+    int bands = band_count(a);
+    if (bands == 1) {
+        FrameCompareResult unused = {};
+        return compare_rows(a, b, *layout, 0, a.height, true, unused) ? 1 : 0;
+    }
+    // Bands that start after a difference was found skip their rows
+    std::atomic<bool> differs(false);
+    int rowsPerBand = (a.height + bands - 1) / bands;
+    WorkerPool::instance().run(bands, [&](int band) {
+        if (differs.load(std::memory_order_relaxed)) return;
+        int firstRow = band * rowsPerBand;
+        int lastRow = std::min(a.height, firstRow + rowsPerBand);
+        FrameCompareResult unused = {};
+        if (firstRow < lastRow && !compare_rows(a, b, *layout, firstRow, lastRow, true, unused)) {
+            differs.store(true, std::memory_order_relaxed);
+        }
+    });
+    return differs.load() ? 0 : 1;
+}
+
+int compare_packed_frames(const PackedFrameView& a, const PackedFrameView& b, FrameCompareResult& result) {
+    result = {};
+    const PackedLayout* layout = shared_layout(a, b);
+    if (!layout) return -1;
+
+    int bands = band_count(a);
+    if (bands == 1) {
+        compare_rows(a, b, *layout, 0, a.height, false, result);
+        return 0;
+    }
+    std::vector<FrameCompareResult> bandResults(bands, FrameCompareResult{});
+    int rowsPerBand = (a.height + bands - 1) / bands;
+    WorkerPool::instance().run(bands, [&](int band) {
+        int firstRow = band * rowsPerBand;
+        int lastRow = std::min(a.height, firstRow + rowsPerBand);
+        if (firstRow < lastRow) {
+            compare_rows(a, b, *layout, firstRow, lastRow, false, bandResults[band]);
+        }
+    });
+    for (const FrameCompareResult& band : bandResults) {
+        result.mismatchedSamples += band.mismatchedSamples;
+        result.mismatchedRows += band.mismatchedRows;
+        for (int c = 0; c < 3; c++) {
+            result.maxError[c] = std::max(result.maxError[c], band.maxError[c]);
+        }
+    }
+    return 0;
+}
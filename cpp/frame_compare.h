@@ -0,0 +1,40 @@
+#pragma once
+
+#include "DeckLinkAPI.h"
+#include <cstdint>
+
+// Layout of one packed frame buffer
+struct PackedFrameView
+{
+    const void *data;
+    int32_t width;
+    int32_t height;
+    int32_t rowBytes;
+    BMDPixelFormat pixelFormat;
+};
+
+// Difference between two packed frames of the same format, per source
+// channel: R, G, B for RGB formats and Y, Cb, Cr for the 4:2:2 formats, in
+// codes of the format. Alpha and padding bits are not compared.
+struct FrameCompareResult
+{
+    uint64_t mismatchedSamples; // components that differ
+    uint32_t mismatchedRows;    // rows with at least one of them
+    uint16_t maxError[3];
+};
+
+// Compares the payload of two packed frames, skipping the padding at the
+// end of each row. Unchanged stretches are found with the SIMD kernel of
+// simd_row_kernels() and only the pixel groups in a differing block are
+// unpacked, so a bit-exact frame costs one pass over both buffers. Large
+// frames are split into row bands on the shared WorkerPool.
+//
+// Both return -1 if the two frames do not share size and pixel format or
+// the format is not one pack_pixel_format() writes.
+
+// Returns 1 if the frames are bit-exact, 0 if not; stops at the first
+// difference
+int packed_frames_equal(const PackedFrameView &a, const PackedFrameView &b);
+
+// Returns 0 and fills result, which is all zeros for bit-exact frames
+int compare_packed_frames(const PackedFrameView &a, const PackedFrameView &b, FrameCompareResult &result);
@@ -0,0 +1,205 @@
+#include "frame_library.h"
+#include "logger.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char kMagic[8] = {'B', 'M', 'D', 'F', 'L', 'I', 'B', '\0'};
+
+// Payloads start on a boundary of the largest page size of supported Macs
+// (16 KiB on Apple silicon), so each one maps onto whole pages
+static const uint64_t kPayloadAlignment = 16384;
+
+static_assert(sizeof(FrameLibraryEntry) == 200, "FrameLibraryEntry is part of the file format");
+static_assert(sizeof(FrameLibraryHeader) == 32, "FrameLibraryHeader is part of the file format");
+
+static uint64_t align_up(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+FrameLibraryWriter::FrameLibraryWriter()
+    : m_file(nullptr)
+    , m_offset(0)
+    , m_failed(false)
+{
+}
+
+// A writer that was never finished leaves no file behind
+FrameLibraryWriter::~FrameLibraryWriter() {
+    if (m_file) {
+        std::fclose(m_file);
+        std::remove(m_path.c_str());
+    }
+}
+
+int FrameLibraryWriter::open(const char* path) {
+    if (m_file || !path) return -1;
+    m_file = std::fopen(path, "wb");
+    if (!m_file) {
+        LOG_ERROR("[FrameLibrary] Cannot create " << path);
+        return -1;
+    }
+    m_path = path;
+    m_entries.clear();
+    m_failed = false;
+
+    // Zeroed until finish(), so an unfinished file is never taken for a library
+    std::vector<uint8_t> headerPage(kPayloadAlignment, 0);
+    m_failed = std::fwrite(headerPage.data(), 1, headerPage.size(), m_file) != headerPage.size();
+    m_offset = kPayloadAlignment;
+    return m_failed ? -1 : 0;
+}
+
+int FrameLibraryWriter::addFrame(const FrameLibraryEntry& entry, const void* data) {
+    if (!m_file) return -1;
+    if (!data || entry.width <= 0 || entry.height <= 0 || entry.rowBytes <= 0) return -2;
+    if (m_failed) return -3;
+
+    uint64_t payloadOffset = align_up(m_offset, kPayloadAlignment);
+    size_t padding = static_cast<size_t>(payloadOffset - m_offset);
+    static const uint8_t kZeros[kPayloadAlignment] = {};
+    uint64_t payloadSize = static_cast<uint64_t>(entry.rowBytes) * entry.height;
+    if (std::fwrite(kZeros, 1, padding, m_file) != padding ||
+        std::fwrite(data, 1, payloadSize, m_file) != payloadSize) {
+        LOG_ERROR("[FrameLibrary] Writing frame " << m_entries.size() << " to " << m_path << " failed");
+        m_failed = true;
+        return -3;
+    }
+    m_offset = payloadOffset + payloadSize;
+
+    FrameLibraryEntry stored = entry;
+    stored.payloadOffset = payloadOffset;
+    stored.payloadSize = payloadSize;
+    stored.name[sizeof(stored.name) - 1] = '\0';
+    m_entries.push_back(stored);
+    return static_cast<int>(m_entries.size() - 1);
+}
+
+/**
+ * @brief Writes the index and header and closes the file
+ *
+ * @return int Returns 0 on success, -1 when not open, -3 if any write
+ *         failed, in which case the file is removed
+ */
+int FrameLibraryWriter::finish() {
+    if (!m_file) return -1;
+
+    FrameLibraryHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFrameLibraryVersion;
+    header.entrySize = sizeof(FrameLibraryEntry);
+    header.frameCount = m_entries.size();
+    header.indexOffset = align_up(m_offset, alignof(FrameLibraryEntry));
+
+    static const uint8_t kZeros[alignof(FrameLibraryEntry)] = {};
+    size_t padding = static_cast<size_t>(header.indexOffset - m_offset);
+    bool ok = !m_failed &&
+              std::fwrite(kZeros, 1, padding, m_file) == padding &&
+              std::fwrite(m_entries.data(), sizeof(FrameLibraryEntry), m_entries.size(), m_file) == m_entries.size() &&
+              std::fseek(m_file, 0, SEEK_SET) == 0 &&
+              std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+    ok = std::fclose(m_file) == 0 && ok;
+    m_file = nullptr;
+    if (!ok) {
+        LOG_ERROR("[FrameLibrary] Writing " << m_path << " failed");
+        std::remove(m_path.c_str());
+        return -3;
+    }
+    LOG_INFO("[FrameLibrary] Wrote " << m_entries.size() << " frames to " << m_path);
+    return 0;
+}
+
+FrameLibrary::FrameLibrary()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_frameCount(0)
+    , m_entries(nullptr)
+{
+}
+
+FrameLibrary::~FrameLibrary() {
+    close();
+}
+
+int FrameLibrary::open(const char* path) {
+    close();
+    if (!path) return -1;
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("[FrameLibrary] Cannot open " << path);
+        return -1;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(FrameLibraryHeader))) {
+        LOG_ERROR("[FrameLibrary] " << path << " is not a frame library");
+        ::close(fd);
+        return -2;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping keeps the file alive on its own
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        LOG_ERROR("[FrameLibrary] mmap of " << path << " failed");
+        return -1;
+    }
+    m_data = static_cast<const uint8_t*>(mapping);
+    m_size = size;
+
+    FrameLibraryHeader header;
+    std::memcpy(&header, m_data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kFrameLibraryVersion ||
+        header.entrySize != sizeof(FrameLibraryEntry)) {
+        LOG_ERROR("[FrameLibrary] " << path << " is not a version " << kFrameLibraryVersion << " frame library");
+        close();
+        return -2;
+    }
+    if (header.indexOffset % alignof(FrameLibraryEntry) != 0 || header.indexOffset > size ||
+        header.frameCount > (size - header.indexOffset) / sizeof(FrameLibraryEntry)) {
+        LOG_ERROR("[FrameLibrary] Index of " << path << " lies outside the file");
+        close();
+        return -3;
+    }
+    const FrameLibraryEntry* entries = reinterpret_cast<const FrameLibraryEntry*>(m_data + header.indexOffset);
+    for (uint64_t i = 0; i < header.frameCount; i++) {
+        const FrameLibraryEntry& entry = entries[i];
+        if (entry.width <= 0 || entry.height <= 0 || entry.rowBytes <= 0 ||
+            entry.payloadSize < static_cast<uint64_t>(entry.rowBytes) * entry.height ||
+            entry.payloadOffset > size || entry.payloadSize > size - entry.payloadOffset) {
+            LOG_ERROR("[FrameLibrary] Frame " << i << " of " << path << " lies outside the file");
+            close();
+            return -3;
+        }
+    }
+    m_entries = entries;
+    m_frameCount = header.frameCount;
+
+    // Start reading ahead now, so the first frames are in memory by the time
+    // they are shown
+    posix_madvise(mapping, size, POSIX_MADV_WILLNEED);
+    LOG_INFO("[FrameLibrary] Mapped " << m_frameCount << " frames from " << path);
+    return 0;
+}
+
+void FrameLibrary::close() {
+    if (m_data) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_frameCount = 0;
+    m_entries = nullptr;
+}
+
+const FrameLibraryEntry* FrameLibrary::entry(int index) const {
+    if (index < 0 || static_cast<uint64_t>(index) >= m_frameCount) return nullptr;
+    return &m_entries[index];
+}
+
+const uint8_t* FrameLibrary::payload(int index) const {
+    const FrameLibraryEntry* frame = entry(index);
+    return frame ? m_data + frame->payloadOffset : nullptr;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Version written by FrameLibraryWriter; FrameLibrary only opens this one
+static const uint32_t kFrameLibraryVersion = 1;
+
+// Index entry of one packed frame, stored as is in the file and reported by
+// decklink_library_get_frame_info()
+struct FrameLibraryEntry
+{
+    uint64_t payloadOffset; // from the start of the file, page aligned
+    uint64_t payloadSize;   // rowBytes * height
+    uint32_t pixelFormat;   // BMDPixelFormat the payload is packed in
+    int32_t width;
+    int32_t height;
+    int32_t rowBytes;
+    // HDR metadata the frame was packed with, laid out like HDRMetadata
+    int64_t eotf;
+    double primaries[8]; // red, green, blue and white point, x then y
+    double maxDisplayMasteringLuminance;
+    double minDisplayMasteringLuminance;
+    double maxCLL;
+    double maxFALL;
+    char name[64]; // caller's label, NUL terminated
+};
+
+// Library file layout, all in host byte order:
+//   FrameLibraryHeader, padded to one page
+//   payloads, each starting on a page boundary
+//   frameCount FrameLibraryEntry records at indexOffset
+// The header is written last, so a file whose writer did not finish has no
+// index and is rejected.
+struct FrameLibraryHeader
+{
+    char magic[8]; // "BMDFLIB\0"
+    uint32_t version;
+    uint32_t entrySize; // sizeof(FrameLibraryEntry)
+    uint64_t frameCount;
+    uint64_t indexOffset;
+};
+
+// Appends already packed frames to a new library file. Payloads are written
+// as they are added; finish() writes the index and the header.
+class FrameLibraryWriter
+{
+public:
+    FrameLibraryWriter();
+    ~FrameLibraryWriter();
+
+    FrameLibraryWriter(const FrameLibraryWriter &) = delete;
+    FrameLibraryWriter &operator=(const FrameLibraryWriter &) = delete;
+
+    // Returns 0 on success, -1 if the file cannot be created
+    int open(const char *path);
+    // Copies height rows of entry.rowBytes bytes. The payload fields of the
+    // entry are filled in by the writer. Returns the frame's index, -1 when
+    // not open, -2 for an invalid entry, -3 if writing failed.
+    int addFrame(const FrameLibraryEntry &entry, const void *data);
+    int finish();
+
+private:
+    std::FILE *m_file;
+    std::string m_path;
+    std::vector<FrameLibraryEntry> m_entries;
+    uint64_t m_offset;
+    bool m_failed;
+};
+
+// Read-only view of a library file, mapped with mmap so payloads are paged
+// in from disk as they are copied to output frames and never go through a
+// separate read buffer.
+class FrameLibrary
+{
+public:
+    FrameLibrary();
+    ~FrameLibrary();
+
+    FrameLibrary(const FrameLibrary &) = delete;
+    FrameLibrary &operator=(const FrameLibrary &) = delete;
+
+    // Returns 0 on success, -1 if the file cannot be opened or mapped, -2 for
+    // a file that is not a finished library of this version, -3 for an index
+    // that points outside the file
+    int open(const char *path);
+    void close();
+
+    int frameCount() const { return static_cast<int>(m_frameCount); }
+    // Both return nullptr for an index out of range
+    const FrameLibraryEntry *entry(int index) const;
+    const uint8_t *payload(int index) const;
+
+private:
+    const uint8_t *m_data;
+    size_t m_size;
+    uint64_t m_frameCount;
+    const FrameLibraryEntry *m_entries;
+};
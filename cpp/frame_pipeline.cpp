@@ -0,0 +1,178 @@
+#include "frame_pipeline.h"
+
+// Idle threads recheck their ring at least this often, as a backstop to the
+// wakeups from the other side
+static const std::chrono::milliseconds kIdleWait(100);
+
+FramePipeline::FramePipeline(PackFunction pack, DisplayFunction display, DiscardFunction discard)
+    : m_pack(std::move(pack))
+    , m_display(std::move(display))
+    , m_discard(std::move(discard))
+    , m_submitted(0)
+    , m_displayed(0)
+    , m_failed(0)
+    , m_producerStalls(0)
+    , m_lastError(0)
+    , m_sleepers(0)
+    , m_stopping(false)
+{
+    m_packThread = std::thread(&FramePipeline::packLoop, this);
+    m_displayThread = std::thread(&FramePipeline::displayLoop, this);
+}
+
+FramePipeline::~FramePipeline() {
+    stop();
+}
+
+/**
+ * @brief Queues a copy of one RGB image for packing and display
+ *
+ * The image is copied into a slot that keeps its buffer between frames, so
+ * the caller may reuse its memory as soon as this returns.
+ *
+ * @param data Interleaved RGB image, width * height * 3 values
+ * @param timeout How long to wait for a free slot while the ring is full
+ * @return int Returns 0 on success, -1 once stopped, -3 if the ring stayed full
+ */
+int FramePipeline::submit(const uint16_t* data, int width, int height, std::chrono::milliseconds timeout) {
+    if (m_stopping.load(std::memory_order_acquire)) return -1;
+
+    Source* slot = m_sources.back();
+    if (!slot) {
+        m_producerStalls++;
+        if (!waitUntil([this]() { return m_sources.back() != nullptr; },
+                       std::chrono::steady_clock::now() + timeout)) {
+            return m_stopping.load(std::memory_order_acquire) ? -1 : -3;
+        }
+        slot = m_sources.back();
+    }
+
+    slot->data.assign(data, data + static_cast<size_t>(width) * height * 3);
+    slot->width = width;
+    slot->height = height;
+    m_submitted++;
+    m_sources.push();
+    wakeWaiters();
+    return 0;
+}
+
+int FramePipeline::flush(std::chrono::milliseconds timeout) {
+    bool drained = waitUntil([this]() { return m_displayed.load() + m_failed.load() >= m_submitted.load(); },
+                             std::chrono::steady_clock::now() + timeout);
+    return drained ? 0 : -3;
+}
+
+void FramePipeline::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping.store(true, std::memory_order_release);
+    }
+    m_wake.notify_all();
+    if (m_packThread.joinable()) {
+        m_packThread.join();
+    }
+    if (m_displayThread.joinable()) {
+        m_displayThread.join();
+    }
+
+    // Both threads are gone, so this thread may take either side of the rings
+    while (IDeckLinkMutableVideoFrame** frame = m_frames.front()) {
+        m_discard(*frame);
+        m_frames.pop();
+    }
+    while (m_sources.front()) {
+        m_sources.pop();
+    }
+}
+
+FramePipelineStats FramePipeline::stats() const {
+    FramePipelineStats stats;
+    stats.submitted = m_submitted.load();
+    stats.displayed = m_displayed.load();
+    stats.failed = m_failed.load();
+    stats.producerStalls = m_producerStalls.load();
+    stats.sourceDepth = static_cast<uint32_t>(m_sources.size());
+    stats.frameDepth = static_cast<uint32_t>(m_frames.size());
+    stats.capacity = static_cast<uint32_t>(kDepth);
+    stats.lastError = m_lastError.load();
+    return stats;
+}
+
+void FramePipeline::packLoop() {
+    while (!m_stopping.load(std::memory_order_acquire)) {
+        Source* source = m_sources.front();
+        if (!source) {
+            waitUntil([this]() { return m_sources.front() != nullptr; }, std::chrono::steady_clock::now() + kIdleWait);
+            continue;
+        }
+
+        IDeckLinkMutableVideoFrame* frame = nullptr;
+        int err = m_pack(source->data.data(), source->width, source->height, &frame);
+        m_sources.pop();
+        wakeWaiters();
+        if (err) {
+            finishFrame(err);
+            continue;
+        }
+
+        IDeckLinkMutableVideoFrame** slot = nullptr;
+        while (!(slot = m_frames.back())) {
+            if (m_stopping.load(std::memory_order_acquire)) {
+                m_discard(frame);
+                return;
+            }
+            waitUntil([this]() { return m_frames.back() != nullptr; }, std::chrono::steady_clock::now() + kIdleWait);
+        }
+        *slot = frame;
+        m_frames.push();
+        wakeWaiters();
+    }
+}
+
+void FramePipeline::displayLoop() {
+    while (!m_stopping.load(std::memory_order_acquire)) {
+        IDeckLinkMutableVideoFrame** slot = m_frames.front();
+        if (!slot) {
+            waitUntil([this]() { return m_frames.front() != nullptr; }, std::chrono::steady_clock::now() + kIdleWait);
+            continue;
+        }
+
+        // Free the slot before the blocking display so the pack thread
+        // can queue the next frame meanwhile
+        IDeckLinkMutableVideoFrame* frame = *slot;
+        m_frames.pop();
+        wakeWaiters();
+        finishFrame(m_display(frame));
+    }
+}
+
+void FramePipeline::finishFrame(int err) {
+    if (err) {
+        m_lastError = err;
+        m_failed++;
+    } else {
+        m_displayed++;
+    }
+    wakeWaiters();
+}
+
+bool FramePipeline::waitUntil(const std::function<bool()>& ready, std::chrono::steady_clock::time_point deadline) {
+    if (ready()) return true;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // Announce the sleep before the last check, so the other side either
+    // sees the count and wakes us or made the change that the check finds
+    m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    m_wake.wait_until(lock, deadline, [&]() { return m_stopping.load(std::memory_order_acquire) || ready(); });
+    m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+    return ready();
+}
+
+void FramePipeline::wakeWaiters() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleepers.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wake.notify_all();
+    }
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "DeckLinkAPI.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Bounded single-producer/single-consumer ring. The producer fills the slot
+// returned by back() and publishes it with push(); the consumer reads front()
+// and frees it with pop(). Neither side locks or allocates, and slots are
+// reused in place, so a slot can own a buffer that keeps its capacity.
+template <typename T, size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscRing() : m_head(0), m_tail(0) {}
+
+    // Producer side: the next free slot, or nullptr when the ring is full
+    T *back()
+    {
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity) return nullptr;
+        return &m_slots[tail & (Capacity - 1)];
+    }
+    void push() { m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst); }
+
+    // Consumer side: the oldest published slot, or nullptr when empty
+    T *front()
+    {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return nullptr;
+        return &m_slots[head & (Capacity - 1)];
+    }
+    void pop() { m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst); }
+
+    size_t size() const
+    {
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        return static_cast<size_t>(m_tail.load(std::memory_order_acquire) - head);
+    }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    T m_slots[Capacity];
+    alignas(64) std::atomic<uint64_t> m_head;
+    alignas(64) std::atomic<uint64_t> m_tail;
+};
+
+// Counters and queue depths of a frame pipeline, reported by
+// decklink_get_frame_pipeline_stats()
+struct FramePipelineStats
+{
+    uint64_t submitted;      // frames accepted by submit()
+    uint64_t displayed;
+    uint64_t failed;         // frames that failed to pack or display
+    uint64_t producerStalls; // submits that had to wait for a free slot
+    uint32_t sourceDepth;    // submitted frames waiting to be packed
+    uint32_t frameDepth;     // packed frames waiting to be displayed
+    uint32_t capacity;       // slots in each of the two queues
+    int32_t lastError;       // code of the last failed pack or display, 0 if none
+};
+
+// Two-stage frame pipeline. submit() copies a source image into a free slot
+// of the source ring and returns; a pack thread turns each source into an
+// output frame and a display thread shows the packed frames in order, so
+// packing frame N + 1 overlaps the display of frame N. submit() blocks while
+// the source ring is full, which paces the caller to the display rate.
+class FramePipeline
+{
+public:
+    // Packs one source image into a frame the caller then owns
+    using PackFunction = std::function<int(const uint16_t *, int, int, IDeckLinkMutableVideoFrame **)>;
+    // Shows a packed frame and takes ownership of it, also on failure
+    using DisplayFunction = std::function<int(IDeckLinkMutableVideoFrame *)>;
+    // Returns a packed frame that will not be displayed
+    using DiscardFunction = std::function<void(IDeckLinkMutableVideoFrame *)>;
+
+    FramePipeline(PackFunction pack, DisplayFunction display, DiscardFunction discard);
+    ~FramePipeline();
+
+    FramePipeline(const FramePipeline &) = delete;
+    FramePipeline &operator=(const FramePipeline &) = delete;
+
+    // Returns 0 on success, -1 once stopped, -3 if no slot freed up in time
+    int submit(const uint16_t *data, int width, int height, std::chrono::milliseconds timeout);
+    // Waits until every submitted frame was displayed or failed.
+    // Returns 0 on success, -3 on timeout.
+    int flush(std::chrono::milliseconds timeout);
+    // Stops both threads after their current frame; queued frames are dropped
+    void stop();
+
+    FramePipelineStats stats() const;
+
+private:
+    static constexpr size_t kDepth = 2;
+
+    struct Source
+    {
+        std::vector<uint16_t> data;
+        int width;
+        int height;
+    };
+
+    void packLoop();
+    void displayLoop();
+    void finishFrame(int err);
+    // Sleeps until ready() holds, the pipeline stops or the deadline passes
+    bool waitUntil(const std::function<bool()> &ready, std::chrono::steady_clock::time_point deadline);
+    void wakeWaiters();
+
+    PackFunction m_pack;
+    DisplayFunction m_display;
+    DiscardFunction m_discard;
+
+    SpscRing<Source, kDepth> m_sources;
+    SpscRing<IDeckLinkMutableVideoFrame *, kDepth> m_frames;
+
+    std::atomic<uint64_t> m_submitted;
+    std::atomic<uint64_t> m_displayed;
+    std::atomic<uint64_t> m_failed;
+    std::atomic<uint64_t> m_producerStalls;
+    std::atomic<int32_t> m_lastError;
+
+    // Sleeping side of the rings: a thread that finds its ring empty or full
+    // announces itself in m_sleepers, so the other side only takes the mutex
+    // to wake it when someone is actually asleep
+    std::atomic<int> m_sleepers;
+    std::atomic<bool> m_stopping;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+
+    std::thread m_packThread;
+    std::thread m_displayThread;
+};
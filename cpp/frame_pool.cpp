@@ -0,0 +1,153 @@
+#include "frame_pool.h"
+#include "logger.h"
+#include <utility>
+
+FramePool::FramePool()
+    : m_geometry{0, 0, 0, bmdFormatUnspecified}
+{
+}
+
+FramePool::~FramePool() {
+    clear();
+}
+
+/**
+ * @brief Preallocates the frames backing the pool
+ *
+ * If the pool already holds at least `count` frames with the same geometry
+ * this is a no-op, so it is cheap to call whenever the output configuration
+ * might have changed. A matching pool that is too small is grown without
+ * touching frames already handed out. For any other geometry all existing
+ * frames are released and `count` new frames are created with
+ * IDeckLinkOutput::CreateVideoFrame.
+ *
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Invalid output interface or frame count
+ *         - -2: CreateVideoFrame failed (pool is left empty)
+ */
+int FramePool::allocate(IDeckLinkOutput* output, const FrameGeometry& geometry, size_t count) {
+    if (!output || count == 0) return -1;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool sameGeometry = !m_slots.empty() && m_geometry == geometry;
+    if (sameGeometry && m_slots.size() >= count) return 0;
+
+    if (!sameGeometry) {
+        clearLocked();
+    }
+    m_slots.reserve(count);
+    for (size_t i = m_slots.size(); i < count; i++) {
+        IDeckLinkMutableVideoFrame* frame = nullptr;
+        HRESULT result = output->CreateVideoFrame(
+            geometry.width, geometry.height, geometry.rowBytes,
+            geometry.pixelFormat,
+            bmdFrameFlagDefault,
+            &frame);
+        if (result != S_OK || !frame) {
+            LOG_ERROR("[FramePool] CreateVideoFrame failed for slot " << i
+                      << ". HRESULT: 0x" << std::hex << result << std::dec);
+            clearLocked();
+            return -2;
+        }
+        m_slots.push_back({frame, false, 0});
+    }
+    m_geometry = geometry;
+    m_released.notify_all();
+
+    LOG_INFO("[FramePool] Allocated " << count << " frames: " << geometry.width << "x"
+             << geometry.height << ", rowBytes: " << geometry.rowBytes);
+    return 0;
+}
+
+void FramePool::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    clearLocked();
+}
+
+void FramePool::swap(FramePool& other) {
+    if (this == &other) return;
+    std::scoped_lock lock(m_mutex, other.m_mutex);
+    m_slots.swap(other.m_slots);
+    std::swap(m_geometry, other.m_geometry);
+}
+
+void FramePool::clearLocked() {
+    for (auto& slot : m_slots) {
+        slot.frame->Release();
+    }
+    m_slots.clear();
+    m_geometry = {0, 0, 0, bmdFormatUnspecified};
+}
+
+IDeckLinkMutableVideoFrame* FramePool::acquire(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    IDeckLinkMutableVideoFrame* frame = nullptr;
+    auto findFree = [this, &frame]() {
+        for (auto& slot : m_slots) {
+            if (!slot.inUse) {
+                slot.inUse = true;
+                frame = slot.frame;
+                return true;
+            }
+        }
+        return false;
+    };
+    if (!findFree() && timeout.count() > 0) {
+        m_released.wait_for(lock, timeout, findFree);
+    }
+    return frame;
+}
+
+// May be called from the DeckLink completion thread
+void FramePool::release(IDeckLinkVideoFrame* frame) {
+    if (!frame) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& slot : m_slots) {
+        if (slot.frame == frame) {
+            slot.inUse = false;
+            m_released.notify_one();
+            return;
+        }
+    }
+}
+
+bool FramePool::metadataStamp(IDeckLinkVideoFrame* frame, uint64_t& stamp) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& slot : m_slots) {
+        if (slot.frame == frame) {
+            stamp = slot.metadataStamp;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FramePool::setMetadataStamp(IDeckLinkVideoFrame* frame, uint64_t stamp) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& slot : m_slots) {
+        if (slot.frame == frame) {
+            slot.metadataStamp = stamp;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FramePool::matches(const FrameGeometry& geometry) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_slots.empty() && m_geometry == geometry;
+}
+
+size_t FramePool::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slots.size();
+}
+
+size_t FramePool::available() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = 0;
+    for (const auto& slot : m_slots) {
+        if (!slot.inUse) count++;
+    }
+    return count;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "DeckLinkAPI.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Geometry that every frame in a pool shares. A pool is only reused when the
+// requested geometry matches exactly.
+struct FrameGeometry
+{
+    int32_t width;
+    int32_t height;
+    int32_t rowBytes;
+    BMDPixelFormat pixelFormat;
+
+    bool operator==(const FrameGeometry &other) const
+    {
+        return width == other.width && height == other.height &&
+               rowBytes == other.rowBytes && pixelFormat == other.pixelFormat;
+    }
+    bool operator!=(const FrameGeometry &other) const { return !(*this == other); }
+};
+
+// Fixed set of preallocated DeckLink frames that are handed out and returned
+// instead of calling CreateVideoFrame for every patch. The pool holds the only
+// owning reference to each frame; callers borrow them between acquire() and
+// release().
+class FramePool
+{
+public:
+    FramePool();
+    ~FramePool();
+
+    FramePool(const FramePool &) = delete;
+    FramePool &operator=(const FramePool &) = delete;
+
+    // Make sure at least `count` frames exist for `geometry`. A matching pool
+    // is grown in place; a different geometry reallocates every frame.
+    // Returns 0 on success, negative on failure.
+    int allocate(IDeckLinkOutput *output, const FrameGeometry &geometry, size_t count);
+    void clear();
+    // Exchanges frames and geometry with another pool. Neither pool may have
+    // a caller waiting in acquire().
+    void swap(FramePool &other);
+
+    // Borrow a free frame. Waits up to `timeout` for one to be released and
+    // returns nullptr if every frame is still in use.
+    IDeckLinkMutableVideoFrame *acquire(std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+    // Return a borrowed frame. Frames not owned by this pool are ignored.
+    void release(IDeckLinkVideoFrame *frame);
+
+    // Generation of the frame metadata last applied to a pooled frame, 0 for
+    // a frame that was never stamped. Both return false for frames not
+    // owned by this pool.
+    bool metadataStamp(IDeckLinkVideoFrame *frame, uint64_t &stamp) const;
+    bool setMetadataStamp(IDeckLinkVideoFrame *frame, uint64_t stamp);
+
+    bool matches(const FrameGeometry &geometry) const;
+    size_t size() const;
+    size_t available() const;
+
+private:
+    struct Slot
+    {
+        IDeckLinkMutableVideoFrame *frame;
+        bool inUse;
+        uint64_t metadataStamp;
+    };
+
+    void clearLocked();
+
+    std::vector<Slot> m_slots;
+    FrameGeometry m_geometry;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_released;
+};
@@ -0,0 +1,162 @@
+#include "frame_telemetry.h"
+#include <algorithm>
+
+FrameTelemetry::FrameTelemetry()
+    : m_ring(kCapacity)
+    , m_head(0)
+    , m_count(0)
+    , m_samplesDropped(0)
+    , m_displayedFrames(0)
+    , m_lateFrames(0)
+    , m_droppedFrames(0)
+    , m_flushedFrames(0)
+    , m_lastScanout(0)
+    , m_lastFrameNumber(0)
+{
+}
+
+void FrameTelemetry::frameScheduled(IDeckLinkVideoFrame* frame, uint64_t frameNumber, int64_t submitTimestamp,
+                                    int64_t streamTime, int64_t queueLead, int64_t frameDuration) {
+    FrameTelemetrySample sample = {};
+    sample.frameNumber = static_cast<int64_t>(frameNumber);
+    sample.submitTimestamp = submitTimestamp;
+    sample.streamTime = streamTime;
+    sample.queueLead = queueLead;
+    sample.frameDuration = frameDuration;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_scheduled.push_back({frame, sample});
+    if (m_scheduled.size() > kMaxScheduled) {
+        m_scheduled.pop_front();
+    }
+}
+
+void FrameTelemetry::scheduleFailed(IDeckLinkVideoFrame* frame) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_scheduled.rbegin(), m_scheduled.rend(),
+                           [frame](const ScheduledFrame& scheduled) { return scheduled.frame == frame; });
+    if (it != m_scheduled.rend()) {
+        m_scheduled.erase(std::next(it).base());
+    }
+}
+
+void FrameTelemetry::frameCompleted(IDeckLinkVideoFrame* frame, BMDOutputFrameCompletionResult result,
+                                    int64_t completionTimestamp) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_scheduled.begin(), m_scheduled.end(),
+                           [frame](const ScheduledFrame& scheduled) { return scheduled.frame == frame; });
+    if (it == m_scheduled.end()) return;
+    FrameTelemetrySample sample = it->sample;
+    m_scheduled.erase(it);
+
+    sample.result = static_cast<int32_t>(result);
+    sample.completionTimestamp = completionTimestamp;
+    switch (result) {
+        case bmdOutputFrameDropped:
+            m_droppedFrames++;
+            break;
+        case bmdOutputFrameFlushed:
+            m_flushedFrames++;
+            break;
+        default:
+            if (result == bmdOutputFrameDisplayedLate) m_lateFrames++;
+            if (completionTimestamp != 0) {
+                sample.scanoutTimestamp = completionTimestamp - sample.frameDuration;
+            }
+            // Directly following on the output means the next frame number
+            if (m_lastFrameNumber == sample.frameNumber - 1 && m_lastScanout != 0 &&
+                sample.scanoutTimestamp != 0) {
+                sample.interval = sample.scanoutTimestamp - m_lastScanout;
+            }
+            break;
+    }
+    recordLocked(sample);
+}
+
+void FrameTelemetry::frameDisplayed(int64_t submitTimestamp, int64_t scanoutTimestamp, int64_t frameDuration) {
+    FrameTelemetrySample sample = {};
+    sample.frameNumber = -1;
+    sample.submitTimestamp = submitTimestamp;
+    sample.scanoutTimestamp = scanoutTimestamp;
+    sample.frameDuration = frameDuration;
+    sample.result = static_cast<int32_t>(bmdOutputFrameCompleted);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // A display directly follows the previous one if it was submitted while
+    // that frame was still in its first frame period on screen, so it
+    // competed for the very next slot; pauses by the caller are not jitter
+    if (m_lastFrameNumber == -1 && m_lastScanout != 0 && submitTimestamp != 0 && scanoutTimestamp != 0 &&
+        submitTimestamp <= m_lastScanout + frameDuration) {
+        sample.interval = scanoutTimestamp - m_lastScanout;
+    }
+    recordLocked(sample);
+}
+
+// Adds a sample to the ring buffer and, for frames that reached the
+// output, to the summary
+void FrameTelemetry::recordLocked(FrameTelemetrySample& sample) {
+    bool displayed = sample.result == bmdOutputFrameCompleted || sample.result == bmdOutputFrameDisplayedLate;
+    if (displayed) {
+        m_displayedFrames++;
+        if (sample.submitTimestamp != 0 && sample.scanoutTimestamp != 0) {
+            sample.latency = sample.scanoutTimestamp - sample.submitTimestamp;
+            // A frame that was already late when submitted can start scanout
+            // before its submit time is taken; that counts as no latency
+            m_submitToScanout.record(static_cast<uint64_t>(std::max<int64_t>(sample.latency, 0)));
+        }
+        if (sample.interval != 0) {
+            int64_t deviation = sample.interval - sample.frameDuration;
+            m_scanoutJitter.record(static_cast<uint64_t>(deviation < 0 ? -deviation : deviation));
+        }
+        m_lastScanout = sample.scanoutTimestamp;
+        m_lastFrameNumber = sample.frameNumber;
+    }
+
+    if (m_count == kCapacity) {
+        m_head = (m_head + 1) % kCapacity;
+        m_count--;
+        m_samplesDropped++;
+    }
+    m_ring[(m_head + m_count) % kCapacity] = sample;
+    m_count++;
+}
+
+int FrameTelemetry::read(FrameTelemetrySample* samples, int capacity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    int count = 0;
+    while (count < capacity && m_count > 0) {
+        samples[count++] = m_ring[m_head];
+        m_head = (m_head + 1) % kCapacity;
+        m_count--;
+    }
+    return count;
+}
+
+FrameTelemetryStats FrameTelemetry::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FrameTelemetryStats stats;
+    stats.displayedFrames = m_displayedFrames;
+    stats.lateFrames = m_lateFrames;
+    stats.droppedFrames = m_droppedFrames;
+    stats.flushedFrames = m_flushedFrames;
+    stats.pendingSamples = m_count;
+    stats.samplesDropped = m_samplesDropped;
+    stats.submitToScanout = m_submitToScanout.snapshot();
+    stats.scanoutJitter = m_scanoutJitter.snapshot();
+    return stats;
+}
+
+void FrameTelemetry::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_head = 0;
+    m_count = 0;
+    m_samplesDropped = 0;
+    m_displayedFrames = 0;
+    m_lateFrames = 0;
+    m_droppedFrames = 0;
+    m_flushedFrames = 0;
+    m_lastScanout = 0;
+    m_lastFrameNumber = 0;
+    m_submitToScanout.reset();
+    m_scanoutJitter.reset();
+}
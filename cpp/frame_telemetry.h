@@ -0,0 +1,112 @@
+#pragma once
+
+#include "DeckLinkAPI.h"
+#include "latency_stats.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// Output timing of one frame, as returned by decklink_read_frame_telemetry().
+// Timestamps are on the device's hardware reference clock in nanoseconds, 0
+// where the driver could not provide them.
+struct FrameTelemetrySample
+{
+    int64_t frameNumber;         // number of the scheduled frame, as in FrameCompletionEvent; -1 for synchronous displays
+    int64_t submitTimestamp;     // when the frame was handed to the driver
+    int64_t scanoutTimestamp;    // when scanout of the frame started
+    int64_t completionTimestamp; // reported by the driver for scheduled frames, 0 for synchronous displays
+    int64_t streamTime;          // stream time the frame was scheduled at, in ns; 0 for synchronous displays
+    int64_t queueLead;           // streamTime minus the playback position at submit, negative if already late
+    int64_t latency;             // scanoutTimestamp - submitTimestamp, 0 if either is unknown
+    int64_t interval;            // since the scanout of the previous frame, 0 unless it directly preceded this one
+    int64_t frameDuration;       // of the display mode, in ns
+    int32_t result;              // BMDOutputFrameCompletionResult, bmdOutputFrameCompleted for synchronous displays
+    int32_t reserved;
+};
+
+// Summary since the last reset, as returned by decklink_get_frame_telemetry()
+struct FrameTelemetryStats
+{
+    uint64_t displayedFrames; // frames that reached the output, on time or late
+    uint64_t lateFrames;
+    uint64_t droppedFrames;
+    uint64_t flushedFrames;
+    uint64_t pendingSamples;  // recorded and not read yet
+    uint64_t samplesDropped;  // overwritten before they were read
+    StageLatencyStats submitToScanout;
+    StageLatencyStats scanoutJitter; // |interval - frameDuration| of directly following frames
+};
+
+// Hardware-timed record of when frames actually reached the output, to
+// measure patch latency without host loop overhead.
+//
+// Scheduled frames are stamped with the hardware reference clock when they
+// are handed to ScheduleVideoFrame and matched with the completion
+// timestamp of GetFrameCompletionReferenceTimestamp. A frame completes
+// when it is replaced, so its scanout started one frame duration earlier.
+// Synchronous displays are stamped around DisplayVideoFrameSync, which
+// returns once the frame is on the output.
+//
+// Samples go into a ring buffer that keeps the newest kCapacity of them;
+// latency and jitter also go into histograms that see every frame, so the
+// summary stays complete when nobody reads the samples.
+class FrameTelemetry
+{
+public:
+    static constexpr size_t kCapacity = 4096;
+
+    FrameTelemetry();
+
+    FrameTelemetry(const FrameTelemetry &) = delete;
+    FrameTelemetry &operator=(const FrameTelemetry &) = delete;
+
+    // Scheduling side, called before the frame is handed to the driver.
+    // Times are in ns; queueLead is 0 if playback is not running.
+    void frameScheduled(IDeckLinkVideoFrame *frame, uint64_t frameNumber, int64_t submitTimestamp,
+                        int64_t streamTime, int64_t queueLead, int64_t frameDuration);
+    // Takes back the latest frameScheduled() of a frame the driver refused
+    void scheduleFailed(IDeckLinkVideoFrame *frame);
+    // Driver's completion thread
+    void frameCompleted(IDeckLinkVideoFrame *frame, BMDOutputFrameCompletionResult result,
+                        int64_t completionTimestamp);
+    // A DisplayVideoFrameSync call that succeeded
+    void frameDisplayed(int64_t submitTimestamp, int64_t scanoutTimestamp, int64_t frameDuration);
+
+    // Moves up to capacity of the oldest samples to samples and returns how
+    // many, 0 if none are pending
+    int read(FrameTelemetrySample *samples, int capacity);
+    FrameTelemetryStats stats() const;
+    // Clears samples and summary; frames still queued are reported later
+    void reset();
+
+private:
+    // Far more than any frame pool; only exceeded if completions stop coming
+    static constexpr size_t kMaxScheduled = 1024;
+
+    struct ScheduledFrame
+    {
+        IDeckLinkVideoFrame *frame;
+        FrameTelemetrySample sample;
+    };
+
+    void recordLocked(FrameTelemetrySample &sample);
+
+    mutable std::mutex m_mutex;
+    // In the order they were scheduled, completing oldest first
+    std::deque<ScheduledFrame> m_scheduled;
+    std::vector<FrameTelemetrySample> m_ring;
+    size_t m_head; // oldest unread sample
+    size_t m_count;
+    uint64_t m_samplesDropped;
+    uint64_t m_displayedFrames;
+    uint64_t m_lateFrames;
+    uint64_t m_droppedFrames;
+    uint64_t m_flushedFrames;
+    // Scanout of the last frame that reached the output
+    int64_t m_lastScanout;
+    int64_t m_lastFrameNumber;
+    LatencyHistogram m_submitToScanout;
+    LatencyHistogram m_scanoutJitter;
+};
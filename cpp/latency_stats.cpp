@@ -0,0 +1,98 @@
+#include "latency_stats.h"
+#include <algorithm>
+#include <bit>
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+int LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < kLinearBuckets) return static_cast<int>(value);
+    int exponent = 63 - std::countl_zero(value); // >= 4
+    int subBucket = static_cast<int>((value >> (exponent - kSubBucketBits)) & ((1 << kSubBucketBits) - 1));
+    return kLinearBuckets + (exponent - 4) * (1 << kSubBucketBits) + subBucket;
+}
+
+// Largest value that falls into bucket `index`
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < kLinearBuckets) return static_cast<uint64_t>(index);
+    int exponent = (index - kLinearBuckets) / (1 << kSubBucketBits) + 4;
+    uint64_t subBucket = static_cast<uint64_t>((index - kLinearBuckets) % (1 << kSubBucketBits));
+    uint64_t width = uint64_t(1) << (exponent - kSubBucketBits);
+    return (uint64_t(1) << exponent) + (subBucket + 1) * width - 1;
+}
+
+void LatencyHistogram::record(uint64_t nanoseconds) {
+    m_buckets[bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_total.fetch_add(nanoseconds, std::memory_order_relaxed);
+    
+    uint64_t currentMax = m_max.load(std::memory_order_relaxed);
+    while (nanoseconds > currentMax &&
+           !m_max.compare_exchange_weak(currentMax, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_total.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Summarizes the recorded samples
+ * 
+ * Percentiles are reported as the upper bound of the bucket holding the
+ * requested rank, capped at the exact maximum.
+ */
+StageLatencyStats LatencyHistogram::snapshot() const {
+    StageLatencyStats stats = {0, 0, 0, 0, 0};
+    uint64_t counts[kBucketCount];
+    for (int i = 0; i < kBucketCount; i++) {
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+        stats.count += counts[i];
+    }
+    stats.totalNs = m_total.load(std::memory_order_relaxed);
+    stats.maxNs = m_max.load(std::memory_order_relaxed);
+    if (stats.count == 0) return stats;
+    
+    // Ranks are 1-based: p50 of 4 samples is the 2nd, p99 of 100 the 99th
+    uint64_t p50Rank = (stats.count * 50 + 99) / 100;
+    uint64_t p99Rank = (stats.count * 99 + 99) / 100;
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; i++) {
+        if (counts[i] == 0) continue;
+        seen += counts[i];
+        if (stats.p50Ns == 0 && seen >= p50Rank) {
+            stats.p50Ns = std::min(bucketUpperBound(i), stats.maxNs);
+        }
+        if (seen >= p99Rank) {
+            stats.p99Ns = std::min(bucketUpperBound(i), stats.maxNs);
+            break;
+        }
+    }
+    return stats;
+}
+
+DeckLinkStats StageLatencyHistograms::snapshot() const {
+    DeckLinkStats stats;
+    stats.setFrameData = setFrameData.snapshot();
+    stats.pack = pack.snapshot();
+    stats.createFrame = createFrame.snapshot();
+    stats.applyHDRMetadata = applyHDRMetadata.snapshot();
+    stats.displayFrameSync = displayFrameSync.snapshot();
+    stats.scheduleFrame = scheduleFrame.snapshot();
+    return stats;
+}
+
+void StageLatencyHistograms::reset() {
+    setFrameData.reset();
+    pack.reset();
+    createFrame.reset();
+    applyHDRMetadata.reset();
+    displayFrameSync.reset();
+    scheduleFrame.reset();
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Summary of one stage, as returned through decklink_get_stats()
+struct StageLatencyStats
+{
+    uint64_t count;
+    uint64_t p50Ns;
+    uint64_t p99Ns;
+    uint64_t maxNs;
+    uint64_t totalNs;
+};
+
+// Latency of every instrumented stage of the frame path
+struct DeckLinkStats
+{
+    StageLatencyStats setFrameData;    // copy of caller data into the pending buffer
+    StageLatencyStats pack;            // pack_pixel_format / pack_rect_pattern
+    StageLatencyStats createFrame;     // whole createFrame(), including pack and metadata
+    StageLatencyStats applyHDRMetadata; // only frames stamped with new metadata
+    StageLatencyStats displayFrameSync; // DisplayVideoFrameSync wait
+    StageLatencyStats scheduleFrame;
+};
+
+// Lock-free latency histogram with log-linear buckets: exact below 16 ns,
+// then 8 buckets per power of two, so percentiles are within 12.5%.
+// record() may be called from any thread; snapshots are not atomic across
+// buckets, which only matters while samples are being added.
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void record(uint64_t nanoseconds);
+    void reset();
+    StageLatencyStats snapshot() const;
+
+private:
+    static constexpr int kLinearBuckets = 16;
+    static constexpr int kSubBucketBits = 3;
+    static constexpr int kBucketCount = kLinearBuckets + (64 - 4) * (1 << kSubBucketBits);
+
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(int index);
+
+    std::atomic<uint64_t> m_buckets[kBucketCount];
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_total;
+    std::atomic<uint64_t> m_max;
+};
+
+// One histogram per instrumented stage of a DeckLinkSignalGen
+struct StageLatencyHistograms
+{
+    LatencyHistogram setFrameData;
+    LatencyHistogram pack;
+    LatencyHistogram createFrame;
+    LatencyHistogram applyHDRMetadata;
+    LatencyHistogram displayFrameSync;
+    LatencyHistogram scheduleFrame;
+
+    DeckLinkStats snapshot() const;
+    void reset();
+};
+
+// Records the time from construction to destruction into a histogram
+class ScopedLatency
+{
+public:
+    explicit ScopedLatency(LatencyHistogram &histogram)
+        : m_histogram(histogram), m_start(std::chrono::steady_clock::now()) {}
+    ~ScopedLatency()
+    {
+        auto elapsed = std::chrono::steady_clock::now() - m_start;
+        m_histogram.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    ScopedLatency(const ScopedLatency &) = delete;
+    ScopedLatency &operator=(const ScopedLatency &) = delete;
+
+private:
+    LatencyHistogram &m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+};
@@ -0,0 +1,135 @@
+#include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+std::atomic<int> Logger::s_level{static_cast<int>(LogLevel::Info)};
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger()
+    : m_writePosition(0), m_readPosition(0), m_written(0), m_dropped(0),
+      m_sleeping(false), m_stopping(false) {
+    for (size_t i = 0; i < kSlotCount; i++) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        m_slots[i].length = 0;
+    }
+    m_thread = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+/**
+ * @brief Queues one line for the logging thread
+ * 
+ * Claims the next slot of the ring with a compare-and-swap, so concurrent
+ * producers never wait for each other. Lines longer than a slot are
+ * truncated. When the ring is full the line is dropped and counted, except
+ * errors, which are written synchronously.
+ */
+void Logger::write(LogLevel level, const std::string& message) {
+    uint64_t position = m_writePosition.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+        slot = &m_slots[position & (kSlotCount - 1)];
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+        if (diff == 0) {
+            if (m_writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Errors are never lost; they bypass the full ring instead
+            if (level == LogLevel::Error) {
+                std::fprintf(stderr, "%s\n", message.c_str());
+                return;
+            }
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            position = m_writePosition.load(std::memory_order_relaxed);
+        }
+    }
+    
+    size_t length = std::min(message.size(), kMaxMessageLength - 1);
+    std::memcpy(slot->text, message.data(), length);
+    slot->text[length++] = '\n';
+    slot->length = static_cast<uint32_t>(length);
+    slot->sequence.store(position + 1, std::memory_order_seq_cst);
+    
+    // Only the first line after the thread went idle pays for a wakeup
+    if (m_sleeping.exchange(false, std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wake.notify_one();
+    }
+}
+
+void Logger::flush() {
+    uint64_t target = m_writePosition.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_sleeping.store(false, std::memory_order_seq_cst);
+    m_wake.notify_one();
+    m_drained.wait(lock, [&] {
+        return m_written.load(std::memory_order_acquire) >= target || m_stopping;
+    });
+}
+
+// Oldest published slot, or null when the ring is empty (consumer thread only)
+Logger::Slot* Logger::front() {
+    Slot* slot = &m_slots[m_readPosition & (kSlotCount - 1)];
+    if (slot->sequence.load(std::memory_order_seq_cst) != m_readPosition + 1) {
+        return nullptr;
+    }
+    return slot;
+}
+
+void Logger::run() {
+    for (;;) {
+        bool wroteAny = false;
+        while (Slot* slot = front()) {
+            std::fwrite(slot->text, 1, slot->length, stderr);
+            // Hand the slot back to producers for the next lap of the ring
+            slot->sequence.store(m_readPosition + kSlotCount, std::memory_order_release);
+            m_readPosition++;
+            m_written.fetch_add(1, std::memory_order_release);
+            wroteAny = true;
+        }
+        uint64_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped) {
+            std::fprintf(stderr, "[Logger] %llu messages dropped\n", static_cast<unsigned long long>(dropped));
+            wroteAny = true;
+        }
+        if (wroteAny) {
+            std::fflush(stderr);
+        }
+        
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_drained.notify_all();
+        
+        // Announce the sleep before the last check, so a producer either sees
+        // the flag and wakes us or published a slot that the check finds
+        m_sleeping.store(true, std::memory_order_seq_cst);
+        if (front()) {
+            m_sleeping.store(false, std::memory_order_relaxed);
+            continue;
+        }
+        if (m_stopping) break;
+        m_wake.wait_for(lock, std::chrono::milliseconds(100), [&] {
+            return !m_sleeping.load(std::memory_order_relaxed) || m_stopping;
+        });
+        m_sleeping.store(false, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+// Log levels, in the order used by decklink_set_log_level()
+enum class LogLevel : int
+{
+    None = 0,
+    Error = 1,
+    Warning = 2,
+    Info = 3,
+    Debug = 4,
+};
+
+// Debug messages are compiled out of release (NDEBUG) builds unless
+// DECKLINK_LOG_DEBUG is set explicitly
+#ifndef DECKLINK_LOG_DEBUG
+#ifdef NDEBUG
+#define DECKLINK_LOG_DEBUG 0
+#else
+#define DECKLINK_LOG_DEBUG 1
+#endif
+#endif
+
+/*
+ * Process-wide asynchronous logger
+ *
+ * Producers format a line and push it into a fixed ring of message slots
+ * without taking a lock; a background thread drains the ring to stderr.
+ * When the ring is full the message is dropped and counted instead of
+ * blocking the caller; errors are written synchronously instead. A
+ * disabled level costs a single relaxed load, and the message expression
+ * is not evaluated.
+ */
+class Logger
+{
+public:
+    static Logger &instance();
+
+    static bool enabled(LogLevel level)
+    {
+        return static_cast<int>(level) <= s_level.load(std::memory_order_relaxed);
+    }
+    static void setLevel(LogLevel level) { s_level.store(static_cast<int>(level), std::memory_order_relaxed); }
+    static LogLevel level() { return static_cast<LogLevel>(s_level.load(std::memory_order_relaxed)); }
+
+    void write(LogLevel level, const std::string &message);
+    // Blocks until every message pushed so far has been written
+    void flush();
+
+    Logger(const Logger &) = delete;
+    Logger &operator=(const Logger &) = delete;
+
+private:
+    Logger();
+    ~Logger();
+
+    static constexpr size_t kSlotCount = 1024; // power of two
+    static constexpr size_t kMaxMessageLength = 240;
+
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence;
+        uint32_t length;
+        char text[kMaxMessageLength];
+    };
+
+    Slot *front();
+    void run();
+
+    static std::atomic<int> s_level;
+
+    Slot m_slots[kSlotCount];
+    std::atomic<uint64_t> m_writePosition;
+    uint64_t m_readPosition; // consumer thread only
+    std::atomic<uint64_t> m_written;
+    std::atomic<uint64_t> m_dropped;
+
+    std::atomic<bool> m_sleeping;
+    bool m_stopping;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_drained;
+    std::thread m_thread;
+};
+
+#define DECKLINK_LOG(level, message)                                \
+    do {                                                            \
+        if (Logger::enabled(level)) {                               \
+            std::ostringstream logStream_;                          \
+            logStream_ << message;                                  \
+            Logger::instance().write(level, logStream_.str());      \
+        }                                                           \
+    } while (0)
+
+#define LOG_ERROR(message) DECKLINK_LOG(LogLevel::Error, message)
+#define LOG_WARNING(message) DECKLINK_LOG(LogLevel::Warning, message)
+#define LOG_INFO(message) DECKLINK_LOG(LogLevel::Info, message)
+#if DECKLINK_LOG_DEBUG
+#define LOG_DEBUG(message) DECKLINK_LOG(LogLevel::Debug, message)
+#else
+// Still type-checks the message, so variables it uses are not reported unused
+#define LOG_DEBUG(message)                                          \
+    do {                                                            \
+        if (false) {                                                \
+            std::ostringstream logStream_;                          \
+            logStream_ << message;                                  \
+        }                                                           \
+    } while (0)
+#endif
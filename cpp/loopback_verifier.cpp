@@ -0,0 +1,517 @@
+#include "loopback_verifier.h"
+#include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// Units of the capture timestamps in results
+static const BMDTimeScale kNanosecondTimeScale = 1000000000;
+
+// Hands captured frames from the driver's input thread to the verifier
+class LoopbackInputCallback : public IDeckLinkInputCallback
+{
+public:
+    explicit LoopbackInputCallback(LoopbackVerifier *owner) : m_refCount(1), m_owner(owner) {}
+
+    HRESULT VideoInputFormatChanged(BMDVideoInputFormatChangedEvents, IDeckLinkDisplayMode *newDisplayMode,
+                                    BMDDetectedVideoInputFormatFlags) override
+    {
+        // The input stays in the output's mode, so the captures that follow
+        // are reported as format mismatches
+        BMDDisplayMode mode = newDisplayMode ? newDisplayMode->GetDisplayMode() : 0;
+        LOG_WARNING("[Loopback] Input signal changed to display mode 0x" << std::hex << mode << std::dec);
+        return S_OK;
+    }
+
+    HRESULT VideoInputFrameArrived(IDeckLinkVideoInputFrame *videoFrame, IDeckLinkAudioInputPacket *) override
+    {
+        if (videoFrame) m_owner->frameArrived(videoFrame);
+        return S_OK;
+    }
+
+    // Only ever handed to SetCallback, which does not query
+    HRESULT QueryInterface(REFIID, LPVOID *ppv) override
+    {
+        *ppv = nullptr;
+        return E_NOINTERFACE;
+    }
+    ULONG AddRef() override { return ++m_refCount; }
+    ULONG Release() override
+    {
+        ULONG refCount = --m_refCount;
+        if (refCount == 0) delete this;
+        return refCount;
+    }
+
+private:
+    virtual ~LoopbackInputCallback() = default;
+
+    std::atomic<ULONG> m_refCount;
+    LoopbackVerifier *m_owner;
+};
+
+LoopbackVerifier::LoopbackVerifier()
+    : m_input(nullptr)
+    , m_callback(nullptr)
+    , m_running(false)
+    , m_stopping(false)
+    , m_references(kReferenceSlots)
+    , m_copying(nullptr)
+    , m_nextReference(0)
+    , m_lastMatched(-1)
+    , m_nextCapture(0)
+    , m_results(kMaxResults)
+    , m_head(0)
+    , m_count(0)
+    , m_resultsDropped(0)
+    , m_capturedFrames(0)
+    , m_matchedFrames(0)
+    , m_mismatchedFrames(0)
+    , m_uncomparedFrames(0)
+    , m_skippedFrames(0)
+    , m_maxError{0, 0, 0}
+    , m_lastStatus(-1)
+{
+    for (Reference& reference : m_references) {
+        reference.view = {};
+        reference.number = -1;
+        reference.ready = false;
+        reference.inUse = false;
+    }
+}
+
+LoopbackVerifier::~LoopbackVerifier() {
+    stop();
+}
+
+int LoopbackVerifier::start(IDeckLinkInput* input, BMDDisplayMode displayMode, BMDPixelFormat pixelFormat) {
+    stop();
+
+    BMDDisplayMode actualMode;
+    bool supported = false;
+    if (input->DoesSupportVideoMode(bmdVideoConnectionUnspecified, displayMode, pixelFormat,
+                                    bmdNoVideoInputConversion, bmdSupportedVideoModeDefault, &actualMode,
+                                    &supported) != S_OK ||
+        !supported) {
+        LOG_ERROR("[Loopback] Input does not support display mode 0x" << std::hex << displayMode
+                  << " with pixel format 0x" << pixelFormat << std::dec);
+        return -1;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Reference& reference : m_references) {
+            reference.number = -1;
+            reference.ready = false;
+        }
+        m_nextReference = 0;
+        m_lastMatched = -1;
+        m_nextCapture = 0;
+        m_stopping = false;
+    }
+
+    input->AddRef();
+    m_input = input;
+    m_callback = new LoopbackInputCallback(this);
+    if (m_input->SetCallback(m_callback) != S_OK ||
+        m_input->EnableVideoInput(displayMode, pixelFormat, bmdVideoInputFlagDefault) != S_OK) {
+        LOG_ERROR("[Loopback] Could not enable video input");
+        stop();
+        return -2;
+    }
+
+    // Running before the first capture so every frame output from here on
+    // becomes a reference
+    m_running.store(true, std::memory_order_release);
+    m_compareThread = std::thread(&LoopbackVerifier::compareLoop, this);
+    if (m_input->StartStreams() != S_OK) {
+        LOG_ERROR("[Loopback] Could not start input streams");
+        stop();
+        return -2;
+    }
+    LOG_INFO("[Loopback] Verifying output against input captures");
+    return 0;
+}
+
+int LoopbackVerifier::restart(BMDDisplayMode displayMode, BMDPixelFormat pixelFormat) {
+    if (!m_input) return 0;
+    // start() stops first, which drops the verifier's reference to the input
+    IDeckLinkInput* input = m_input;
+    input->AddRef();
+    int result = start(input, displayMode, pixelFormat);
+    input->Release();
+    return result;
+}
+
+void LoopbackVerifier::stop() {
+    if (!m_input) return;
+    m_running.store(false, std::memory_order_release);
+    m_input->StopStreams();
+    m_input->DisableVideoInput();
+    m_input->SetCallback(nullptr);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    if (m_compareThread.joinable()) {
+        m_compareThread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& pending : m_pending) {
+        pending.first->Release();
+    }
+    m_pending.clear();
+    for (QueuedOutput& output : m_outputs) {
+        output.frame->Release();
+    }
+    m_outputs.clear();
+    m_input->Release();
+    m_input = nullptr;
+    m_callback->Release();
+    m_callback = nullptr;
+}
+
+void LoopbackVerifier::frameOutput(IDeckLinkVideoFrame* frame) {
+    if (!running()) return;
+    IDeckLinkVideoFrame* dropped = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) return;
+        // Only the newest kReferenceSlots could become references anyway
+        if (m_outputs.size() >= kReferenceSlots) {
+            dropped = m_outputs.front().frame;
+            m_outputs.pop_front();
+        }
+        // Numbered now so references stay in output order
+        frame->AddRef();
+        m_outputs.push_back({frame, m_nextReference++});
+    }
+    m_wake.notify_one();
+    if (dropped) dropped->Release();
+}
+
+void LoopbackVerifier::frameReleased(IDeckLinkVideoFrame* frame) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_copied.wait(lock, [this, frame] { return m_copying != frame; });
+    // The same frame may have been output more than once
+    auto queued = m_outputs.begin();
+    while (queued != m_outputs.end()) {
+        if (queued->frame != frame) {
+            ++queued;
+            continue;
+        }
+        int64_t number = queued->number;
+        m_outputs.erase(queued);
+        lock.unlock();
+        copyReference(frame, number);
+        frame->Release();
+        lock.lock();
+        queued = m_outputs.begin();
+    }
+}
+
+// Copies an output frame into the oldest reference nobody is reading
+void LoopbackVerifier::copyReference(IDeckLinkVideoFrame* frame, int64_t number) {
+    ScopedLatency timer(m_referenceCopy);
+
+    IDeckLinkVideoBuffer* videoBuffer = nullptr;
+    if (frame->QueryInterface(IID_IDeckLinkVideoBuffer, (void**)&videoBuffer) != S_OK) return;
+    if (videoBuffer->StartAccess(bmdBufferAccessRead) != S_OK) {
+        videoBuffer->Release();
+        return;
+    }
+    void* frameData = nullptr;
+    if (videoBuffer->GetBytes(&frameData) == S_OK) {
+        Reference* reference = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            int64_t oldest = INT64_MAX;
+            for (Reference& candidate : m_references) {
+                if (!candidate.inUse && candidate.number < oldest) {
+                    oldest = candidate.number;
+                    reference = &candidate;
+                }
+            }
+            if (reference) {
+                reference->number = number;
+                reference->ready = false;
+                reference->inUse = true;
+            }
+        }
+
+        // Every slot is being read or written; the frame is lost as a reference
+        if (reference) {
+            size_t bytes = static_cast<size_t>(frame->GetRowBytes()) * frame->GetHeight();
+            reference->bytes.resize(bytes);
+            std::memcpy(reference->bytes.data(), frameData, bytes);
+            reference->view = {reference->bytes.data(), static_cast<int32_t>(frame->GetWidth()),
+                               static_cast<int32_t>(frame->GetHeight()), static_cast<int32_t>(frame->GetRowBytes()),
+                               frame->GetPixelFormat()};
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            reference->ready = true;
+            reference->inUse = false;
+        }
+    }
+    videoBuffer->EndAccess(bmdBufferAccessRead);
+    videoBuffer->Release();
+}
+
+void LoopbackVerifier::frameArrived(IDeckLinkVideoInputFrame* frame) {
+    bool noSignal = (frame->GetFlags() & bmdFrameHasNoInputSource) != 0;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stopping) return;
+    m_capturedFrames++;
+    uint64_t captureNumber = m_nextCapture++;
+    if (noSignal) {
+        LoopbackResult result = {};
+        result.captureNumber = captureNumber;
+        result.referenceNumber = -1;
+        result.status = static_cast<int32_t>(LoopbackStatus::NoSignal);
+        recordLocked(result);
+        return;
+    }
+    if (m_pending.size() >= kMaxPendingCaptures) {
+        m_skippedFrames++;
+        return;
+    }
+    frame->AddRef();
+    m_pending.push_back({frame, captureNumber});
+    m_wake.notify_one();
+}
+
+void LoopbackVerifier::compareLoop() {
+    while (true) {
+        std::pair<IDeckLinkVideoInputFrame*, uint64_t> pending;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stopping || !m_outputs.empty() || !m_pending.empty(); });
+            if (m_stopping) return;
+            // Output frames first, so each capture sees everything output before it
+            if (!m_outputs.empty()) {
+                QueuedOutput output = m_outputs.front();
+                m_outputs.pop_front();
+                m_copying = output.frame;
+                lock.unlock();
+                copyReference(output.frame, output.number);
+                lock.lock();
+                m_copying = nullptr;
+                lock.unlock();
+                m_copied.notify_all();
+                output.frame->Release();
+                continue;
+            }
+            pending = m_pending.front();
+            m_pending.pop_front();
+        }
+
+        LoopbackResult result = {};
+        result.captureNumber = pending.second;
+        result.referenceNumber = -1;
+        BMDTimeValue frameTime = 0;
+        BMDTimeValue frameDuration = 0;
+        if (pending.first->GetHardwareReferenceTimestamp(kNanosecondTimeScale, &frameTime, &frameDuration) == S_OK) {
+            result.captureTimestamp = frameTime;
+        }
+
+        auto started = std::chrono::steady_clock::now();
+        verify(pending.first, result);
+        pending.first->Release();
+        result.compareDuration =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count();
+        m_compare.record(static_cast<uint64_t>(result.compareDuration));
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        recordLocked(result);
+    }
+}
+
+// Matches one capture against the references, see the class comment
+void LoopbackVerifier::verify(IDeckLinkVideoInputFrame* frame, LoopbackResult& result) {
+    result.status = static_cast<int32_t>(LoopbackStatus::NoSignal);
+    IDeckLinkVideoBuffer* videoBuffer = nullptr;
+    if (frame->QueryInterface(IID_IDeckLinkVideoBuffer, (void**)&videoBuffer) != S_OK) return;
+    if (videoBuffer->StartAccess(bmdBufferAccessRead) != S_OK) {
+        videoBuffer->Release();
+        return;
+    }
+    void* frameData = nullptr;
+    if (videoBuffer->GetBytes(&frameData) != S_OK) {
+        videoBuffer->EndAccess(bmdBufferAccessRead);
+        videoBuffer->Release();
+        return;
+    }
+    PackedFrameView capture = {frameData, static_cast<int32_t>(frame->GetWidth()),
+                               static_cast<int32_t>(frame->GetHeight()), static_cast<int32_t>(frame->GetRowBytes()),
+                               frame->GetPixelFormat()};
+
+    // Candidates from the last match on, oldest first
+    std::vector<std::pair<int64_t, size_t>> candidates;
+    int64_t lastMatched;
+    bool anyReference = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        lastMatched = m_lastMatched;
+        for (size_t i = 0; i < m_references.size(); i++) {
+            const Reference& reference = m_references[i];
+            if (!reference.ready) continue;
+            anyReference = true;
+            if (reference.number < lastMatched) continue;
+            if (reference.view.width != capture.width || reference.view.height != capture.height ||
+                reference.view.pixelFormat != capture.pixelFormat) {
+                continue;
+            }
+            candidates.push_back({reference.number, i});
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    if (candidates.empty()) {
+        result.status = static_cast<int32_t>(anyReference ? LoopbackStatus::FormatMismatch
+                                                          : LoopbackStatus::NoReference);
+    } else {
+        bool matched = false;
+        for (const auto& candidate : candidates) {
+            if (compareWithReference(candidate.second, candidate.first, capture, nullptr) == 1) {
+                result.status = static_cast<int32_t>(LoopbackStatus::Match);
+                result.referenceNumber = candidate.first;
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_lastMatched = candidate.first;
+                matched = true;
+                break;
+            }
+        }
+
+        if (!matched) {
+            // The frame after the last match, or the last match while
+            // nothing newer was output; the newest before any match
+            auto expected = candidates.back();
+            if (lastMatched >= 0) {
+                auto next = std::upper_bound(candidates.begin(), candidates.end(),
+                                             std::make_pair(lastMatched, SIZE_MAX));
+                expected = next != candidates.end() ? *next : candidates.front();
+            }
+            FrameCompareResult diff = {};
+            result.referenceNumber = expected.first;
+            if (compareWithReference(expected.second, expected.first, capture, &diff) != 0) {
+                // Replaced by newer output while the exact pass ran
+                result.status = static_cast<int32_t>(LoopbackStatus::NoReference);
+            } else if (diff.mismatchedSamples == 0) {
+                // Only alpha or padding bits differ, which the input need
+                // not reproduce
+                result.status = static_cast<int32_t>(LoopbackStatus::Match);
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_lastMatched = expected.first;
+            } else {
+                result.status = static_cast<int32_t>(LoopbackStatus::Mismatch);
+                result.mismatchedSamples = diff.mismatchedSamples;
+                result.mismatchedRows = diff.mismatchedRows;
+                std::memcpy(result.maxError, diff.maxError, sizeof(result.maxError));
+            }
+        }
+    }
+
+    videoBuffer->EndAccess(bmdBufferAccessRead);
+    videoBuffer->Release();
+}
+
+// Pins the reference in slot while it still holds output frame number and
+// compares it with the capture: in full into diff, or only for equality
+// when diff is null. Returns 1 if equal, 0 if not, -1 if the reference was
+// replaced or has another layout.
+int LoopbackVerifier::compareWithReference(size_t slot, int64_t number, const PackedFrameView& capture,
+                                           FrameCompareResult* diff) {
+    Reference& reference = m_references[slot];
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!reference.ready || reference.number != number) return -1;
+        reference.inUse = true;
+    }
+
+    int result;
+    if (diff) {
+        result = compare_packed_frames(reference.view, capture, *diff);
+    } else {
+        result = packed_frames_equal(reference.view, capture);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    reference.inUse = false;
+    return result;
+}
+
+// Adds a result to the ring buffer and the summary
+void LoopbackVerifier::recordLocked(const LoopbackResult& result) {
+    switch (static_cast<LoopbackStatus>(result.status)) {
+        case LoopbackStatus::Match:
+            m_matchedFrames++;
+            break;
+        case LoopbackStatus::Mismatch:
+            m_mismatchedFrames++;
+            for (int c = 0; c < 3; c++) {
+                m_maxError[c] = std::max(m_maxError[c], result.maxError[c]);
+            }
+            break;
+        default:
+            m_uncomparedFrames++;
+            break;
+    }
+    m_lastStatus = result.status;
+
+    if (m_count == kMaxResults) {
+        m_head = (m_head + 1) % kMaxResults;
+        m_count--;
+        m_resultsDropped++;
+    }
+    m_results[(m_head + m_count) % kMaxResults] = result;
+    m_count++;
+}
+
+int LoopbackVerifier::read(LoopbackResult* results, int capacity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    int count = 0;
+    while (count < capacity && m_count > 0) {
+        results[count++] = m_results[m_head];
+        m_head = (m_head + 1) % kMaxResults;
+        m_count--;
+    }
+    return count;
+}
+
+LoopbackStats LoopbackVerifier::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    LoopbackStats stats = {};
+    stats.capturedFrames = m_capturedFrames;
+    stats.matchedFrames = m_matchedFrames;
+    stats.mismatchedFrames = m_mismatchedFrames;
+    stats.uncomparedFrames = m_uncomparedFrames;
+    stats.skippedFrames = m_skippedFrames;
+    stats.pendingResults = m_count;
+    stats.resultsDropped = m_resultsDropped;
+    std::memcpy(stats.maxError, m_maxError, sizeof(stats.maxError));
+    stats.running = running() ? 1 : 0;
+    stats.lastStatus = m_lastStatus;
+    stats.compare = m_compare.snapshot();
+    stats.referenceCopy = m_referenceCopy.snapshot();
+    return stats;
+}
+
+void LoopbackVerifier::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_head = 0;
+    m_count = 0;
+    m_resultsDropped = 0;
+    m_capturedFrames = 0;
+    m_matchedFrames = 0;
+    m_mismatchedFrames = 0;
+    m_uncomparedFrames = 0;
+    m_skippedFrames = 0;
+    std::fill(std::begin(m_maxError), std::end(m_maxError), 0);
+    m_lastStatus = -1;
+    m_compare.reset();
+    m_referenceCopy.reset();
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "DeckLinkAPI.h"
+#include "frame_compare.h"
+#include "latency_stats.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class LoopbackInputCallback;
+
+enum class LoopbackStatus : int32_t
+{
+    Match = 0,          // bit-exact copy of an output frame
+    Mismatch = 1,       // differs from the expected output frame by maxError
+    NoReference = 2,    // nothing was output since the verifier started
+    FormatMismatch = 3, // captured in another size or pixel format than the output
+    NoSignal = 4,       // the input reported no signal
+};
+
+// One captured frame, as returned by decklink_read_loopback_results()
+struct LoopbackResult
+{
+    uint64_t captureNumber;     // position among every frame captured since the start, from 0
+    int64_t referenceNumber;    // output frame it was compared with, numbered from 0 at the start; -1 if none
+    int64_t captureTimestamp;   // hardware reference time of the capture in ns, 0 if unavailable
+    int64_t compareDuration;    // ns spent matching and comparing
+    uint64_t mismatchedSamples; // components that differ from the reference
+    uint32_t mismatchedRows;
+    int32_t status;             // LoopbackStatus
+    uint16_t maxError[3];       // R, G, B or Y, Cb, Cr, in codes of the pixel format
+    uint16_t reserved;
+};
+
+// Summary since the start or last reset, as returned by decklink_get_loopback_stats()
+struct LoopbackStats
+{
+    uint64_t capturedFrames;   // every frame the input delivered
+    uint64_t matchedFrames;
+    uint64_t mismatchedFrames;
+    uint64_t uncomparedFrames; // without a reference, in another format or without signal
+    uint64_t skippedFrames;    // arrived while the comparison queue was full
+    uint64_t pendingResults;   // recorded and not read yet
+    uint64_t resultsDropped;   // overwritten before they were read
+    uint16_t maxError[3];      // worst of every mismatched frame
+    uint16_t reserved;
+    int32_t running;
+    int32_t lastStatus;        // LoopbackStatus of the newest result, -1 before the first
+    StageLatencyStats compare;       // matching and comparing one capture
+    StageLatencyStats referenceCopy; // copying an output frame into a reference, off the output path
+};
+
+// Continuous check of an output looped back into an input.
+//
+// Every frame handed to the output while the verifier runs is copied into a
+// small ring of references. The output side only queues the frame; a
+// background thread copies it, unless the frame goes back to its pool or
+// cache first, which copies it on the way. Captured frames are queued for
+// the same thread, which matches each one against the references from the
+// last match on with the SIMD compare of frame_compare.h: the first
+// bit-exact reference is a match. Without one, the capture is compared in
+// full with the frame the output should have delivered next, the one after
+// the last match (or the last match itself while nothing newer was output),
+// which gives the per-channel error; if only alpha or padding bits differ,
+// the capture still counts as a match. Matching moves forward only, as
+// frames come back in the order they went out.
+//
+// The queue holds kMaxPendingCaptures input frames without copying them;
+// captures that arrive while it is full are counted as skipped rather than
+// delaying the driver. Results go into a ring buffer of the newest
+// kMaxResults.
+class LoopbackVerifier
+{
+public:
+    static constexpr size_t kMaxResults = 1024;
+
+    LoopbackVerifier();
+    ~LoopbackVerifier();
+
+    LoopbackVerifier(const LoopbackVerifier &) = delete;
+    LoopbackVerifier &operator=(const LoopbackVerifier &) = delete;
+
+    // Captures from input in displayMode and pixelFormat, restarting if
+    // running already. Returns 0 on success, -1 if the input does not
+    // support the mode, -2 if it could not be started.
+    int start(IDeckLinkInput *input, BMDDisplayMode displayMode, BMDPixelFormat pixelFormat);
+    // Starts again on the same input in a new displayMode and pixelFormat,
+    // with codes like start(); stopped if that fails. Does nothing and
+    // returns 0 while stopped.
+    int restart(BMDDisplayMode displayMode, BMDPixelFormat pixelFormat);
+    // Stops the input and the compare thread; results stay readable
+    void stop();
+    bool running() const { return m_running.load(std::memory_order_acquire); }
+
+    // Output side, after the frame was handed to the driver; does nothing
+    // while stopped. Keeps a reference to the frame until it is copied.
+    void frameOutput(IDeckLinkVideoFrame *frame);
+    // Before a frame goes back to its pool or cache to be refilled: copies
+    // it now if it is still queued, or waits while the compare thread copies it
+    void frameReleased(IDeckLinkVideoFrame *frame);
+    // Input callback thread
+    void frameArrived(IDeckLinkVideoInputFrame *frame);
+
+    // Moves up to capacity of the oldest results to results and returns
+    // how many, 0 if none are pending
+    int read(LoopbackResult *results, int capacity);
+    LoopbackStats stats() const;
+    // Clears results and summary
+    void reset();
+
+private:
+    static constexpr size_t kReferenceSlots = 8;
+    static constexpr size_t kMaxPendingCaptures = 2;
+
+    struct Reference
+    {
+        std::vector<uint8_t> bytes;
+        PackedFrameView view; // data points into bytes
+        int64_t number;       // -1 while empty
+        bool ready;           // false while a frame is copied into it
+        bool inUse;           // pinned by the compare thread or being copied into
+    };
+
+    // Output frame waiting to be copied into a reference
+    struct QueuedOutput
+    {
+        IDeckLinkVideoFrame *frame; // holds a reference
+        int64_t number;
+    };
+
+    void compareLoop();
+    void copyReference(IDeckLinkVideoFrame *frame, int64_t number);
+    void verify(IDeckLinkVideoInputFrame *frame, LoopbackResult &result);
+    int compareWithReference(size_t slot, int64_t number, const PackedFrameView &capture, FrameCompareResult *diff);
+    void recordLocked(const LoopbackResult &result);
+
+    IDeckLinkInput *m_input;
+    LoopbackInputCallback *m_callback;
+    std::atomic<bool> m_running;
+    std::thread m_compareThread;
+
+    // References, queued output frames, pending captures and results
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_copied;
+    bool m_stopping;
+    std::vector<Reference> m_references;
+    std::deque<QueuedOutput> m_outputs; // oldest first
+    IDeckLinkVideoFrame *m_copying;     // copied by the compare thread right now
+    int64_t m_nextReference;
+    int64_t m_lastMatched; // -1 before the first match
+    std::deque<std::pair<IDeckLinkVideoInputFrame *, uint64_t>> m_pending;
+    uint64_t m_nextCapture;
+
+    std::vector<LoopbackResult> m_results;
+    size_t m_head; // oldest unread result
+    size_t m_count;
+    uint64_t m_resultsDropped;
+    uint64_t m_capturedFrames;
+    uint64_t m_matchedFrames;
+    uint64_t m_mismatchedFrames;
+    uint64_t m_uncomparedFrames;
+    uint64_t m_skippedFrames;
+    uint16_t m_maxError[3];
+    int32_t m_lastStatus;
+    LatencyHistogram m_compare;
+    LatencyHistogram m_referenceCopy;
+};
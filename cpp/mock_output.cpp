@@ -0,0 +1,762 @@
+#include "mock_output.h"
+#include "logger.h"
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+static const char* const kMockDeviceName = "DeckLink Mock Output";
+static const BMDTimeScale kNanosecondsPerSecond = 1000000000;
+
+struct MockDisplayModeInfo
+{
+    BMDDisplayMode mode;
+    const char* name;
+    int32_t width;
+    int32_t height;
+    BMDTimeValue frameDuration;
+    BMDTimeScale timeScale;
+    BMDFieldDominance fieldDominance;
+};
+
+static const MockDisplayModeInfo kDisplayModes[] = {
+    {bmdModeNTSC, "NTSC", 720, 486, 1001, 30000, bmdLowerFieldFirst},
+    {bmdModePAL, "PAL", 720, 576, 1000, 25000, bmdUpperFieldFirst},
+    {bmdModeHD720p50, "720p50", 1280, 720, 1000, 50000, bmdProgressiveFrame},
+    {bmdModeHD720p5994, "720p59.94", 1280, 720, 1001, 60000, bmdProgressiveFrame},
+    {bmdModeHD720p60, "720p60", 1280, 720, 1000, 60000, bmdProgressiveFrame},
+    {bmdModeHD1080p2398, "1080p23.98", 1920, 1080, 1001, 24000, bmdProgressiveFrame},
+    {bmdModeHD1080p24, "1080p24", 1920, 1080, 1000, 24000, bmdProgressiveFrame},
+    {bmdModeHD1080p25, "1080p25", 1920, 1080, 1000, 25000, bmdProgressiveFrame},
+    {bmdModeHD1080p2997, "1080p29.97", 1920, 1080, 1001, 30000, bmdProgressiveFrame},
+    {bmdModeHD1080p30, "1080p30", 1920, 1080, 1000, 30000, bmdProgressiveFrame},
+    {bmdModeHD1080p50, "1080p50", 1920, 1080, 1000, 50000, bmdProgressiveFrame},
+    {bmdModeHD1080p5994, "1080p59.94", 1920, 1080, 1001, 60000, bmdProgressiveFrame},
+    {bmdModeHD1080p6000, "1080p60", 1920, 1080, 1000, 60000, bmdProgressiveFrame},
+    {bmdMode4K2160p2398, "2160p23.98", 3840, 2160, 1001, 24000, bmdProgressiveFrame},
+    {bmdMode4K2160p24, "2160p24", 3840, 2160, 1000, 24000, bmdProgressiveFrame},
+    {bmdMode4K2160p25, "2160p25", 3840, 2160, 1000, 25000, bmdProgressiveFrame},
+    {bmdMode4K2160p2997, "2160p29.97", 3840, 2160, 1001, 30000, bmdProgressiveFrame},
+    {bmdMode4K2160p30, "2160p30", 3840, 2160, 1000, 30000, bmdProgressiveFrame},
+    {bmdMode4K2160p50, "2160p50", 3840, 2160, 1000, 50000, bmdProgressiveFrame},
+    {bmdMode4K2160p5994, "2160p59.94", 3840, 2160, 1001, 60000, bmdProgressiveFrame},
+    {bmdMode4K2160p60, "2160p60", 3840, 2160, 1000, 60000, bmdProgressiveFrame},
+    {bmdMode8K4320p2398, "4320p23.98", 7680, 4320, 1001, 24000, bmdProgressiveFrame},
+    {bmdMode8K4320p24, "4320p24", 7680, 4320, 1000, 24000, bmdProgressiveFrame},
+    {bmdMode8K4320p25, "4320p25", 7680, 4320, 1000, 25000, bmdProgressiveFrame},
+    {bmdMode8K4320p2997, "4320p29.97", 7680, 4320, 1001, 30000, bmdProgressiveFrame},
+    {bmdMode8K4320p30, "4320p30", 7680, 4320, 1000, 30000, bmdProgressiveFrame},
+    {bmdMode8K4320p50, "4320p50", 7680, 4320, 1000, 50000, bmdProgressiveFrame},
+    {bmdMode8K4320p5994, "4320p59.94", 7680, 4320, 1001, 60000, bmdProgressiveFrame},
+    {bmdMode8K4320p60, "4320p60", 7680, 4320, 1000, 60000, bmdProgressiveFrame},
+};
+
+static const MockDisplayModeInfo* find_display_mode(BMDDisplayMode mode) {
+    for (const auto& info : kDisplayModes) {
+        if (info.mode == mode) return &info;
+    }
+    return nullptr;
+}
+
+// Row bytes as the SDK documents them for each pixel format; 0 if unsupported
+static int32_t row_bytes_for_format(BMDPixelFormat pixelFormat, int32_t width) {
+    switch (pixelFormat) {
+        case bmdFormat8BitYUV: return ((width + 1) / 2) * 4;
+        case bmdFormat10BitYUV: return ((width + 47) / 48) * 128;
+        case bmdFormat10BitYUVA: return width * 4;
+        case bmdFormat8BitARGB:
+        case bmdFormat8BitBGRA: return width * 4;
+        case bmdFormat10BitRGB:
+        case bmdFormat10BitRGBXLE:
+        case bmdFormat10BitRGBX: return ((width + 63) / 64) * 256;
+        case bmdFormat12BitRGB:
+        case bmdFormat12BitRGBLE: return ((width + 7) / 8) * 36;
+        default: return 0;
+    }
+}
+
+// Converts `value` ticks of `from` per second to ticks of `to` per second
+static int64_t rescale(int64_t value, int64_t from, int64_t to) {
+    if (from == to) return value;
+    return value / from * to + value % from * to / from;
+}
+
+static bool same_iid(REFIID a, REFIID b) {
+    return std::memcmp(&a, &b, sizeof(REFIID)) == 0;
+}
+
+static bool is_iunknown(REFIID iid) {
+    return same_iid(iid, CFUUIDGetUUIDBytes(IUnknownUUID));
+}
+
+// Frame backed by ordinary memory. The buffer and metadata interfaces the
+// wrapper queries for are implemented on the frame itself.
+class MockVideoFrame : public IDeckLinkMutableVideoFrame,
+                       public IDeckLinkVideoBuffer,
+                       public IDeckLinkVideoFrameMutableMetadataExtensions
+{
+public:
+    MockVideoFrame(int32_t width, int32_t height, int32_t rowBytes, BMDPixelFormat pixelFormat, BMDFrameFlags flags)
+        : m_refCount(1)
+        , m_width(width)
+        , m_height(height)
+        , m_rowBytes(rowBytes)
+        , m_pixelFormat(pixelFormat)
+        , m_flags(flags)
+        , m_bytes(static_cast<size_t>(rowBytes) * height)
+    {
+    }
+
+    // IDeckLinkVideoFrame
+    long GetWidth() override { return m_width; }
+    long GetHeight() override { return m_height; }
+    long GetRowBytes() override { return m_rowBytes; }
+    BMDPixelFormat GetPixelFormat() override { return m_pixelFormat; }
+    BMDFrameFlags GetFlags() override { return m_flags; }
+    HRESULT GetTimecode(BMDTimecodeFormat, IDeckLinkTimecode** timecode) override {
+        if (timecode) *timecode = nullptr;
+        return S_FALSE;
+    }
+    HRESULT GetAncillaryData(IDeckLinkVideoFrameAncillary** ancillary) override {
+        if (ancillary) *ancillary = nullptr;
+        return S_FALSE;
+    }
+
+    // IDeckLinkMutableVideoFrame
+    HRESULT SetFlags(BMDFrameFlags newFlags) override {
+        m_flags = newFlags;
+        return S_OK;
+    }
+    HRESULT SetTimecode(BMDTimecodeFormat, IDeckLinkTimecode*) override { return E_NOTIMPL; }
+    HRESULT SetTimecodeFromComponents(BMDTimecodeFormat, uint8_t, uint8_t, uint8_t, uint8_t,
+                                      BMDTimecodeFlags) override { return E_NOTIMPL; }
+    HRESULT SetAncillaryData(IDeckLinkVideoFrameAncillary*) override { return E_NOTIMPL; }
+    HRESULT SetTimecodeUserBits(BMDTimecodeFormat, BMDTimecodeUserBits) override { return E_NOTIMPL; }
+    HRESULT SetInterfaceProvider(REFIID, IUnknown*) override { return E_NOTIMPL; }
+
+    // IDeckLinkVideoBuffer. Nothing reads the memory, so access needs no locking.
+    HRESULT GetBytes(void** buffer) override {
+        if (!buffer) return E_POINTER;
+        *buffer = m_bytes.data();
+        return S_OK;
+    }
+    HRESULT StartAccess(BMDBufferAccessFlags) override { return S_OK; }
+    HRESULT EndAccess(BMDBufferAccessFlags) override { return S_OK; }
+
+    // IDeckLinkVideoFrameMetadataExtensions
+    HRESULT GetInt(BMDDeckLinkFrameMetadataID metadataID, int64_t* value) override {
+        auto it = m_intMetadata.find(metadataID);
+        if (!value || it == m_intMetadata.end()) return E_INVALIDARG;
+        *value = it->second;
+        return S_OK;
+    }
+    HRESULT GetFloat(BMDDeckLinkFrameMetadataID metadataID, double* value) override {
+        auto it = m_floatMetadata.find(metadataID);
+        if (!value || it == m_floatMetadata.end()) return E_INVALIDARG;
+        *value = it->second;
+        return S_OK;
+    }
+    HRESULT GetFlag(BMDDeckLinkFrameMetadataID metadataID, bool* value) override {
+        auto it = m_flagMetadata.find(metadataID);
+        if (!value || it == m_flagMetadata.end()) return E_INVALIDARG;
+        *value = it->second;
+        return S_OK;
+    }
+    HRESULT GetString(BMDDeckLinkFrameMetadataID, CFStringRef*) override { return E_NOTIMPL; }
+    HRESULT GetBytes(BMDDeckLinkFrameMetadataID, void*, uint32_t*) override { return E_NOTIMPL; }
+
+    // IDeckLinkVideoFrameMutableMetadataExtensions
+    HRESULT SetInt(BMDDeckLinkFrameMetadataID metadataID, int64_t value) override {
+        m_intMetadata[metadataID] = value;
+        return S_OK;
+    }
+    HRESULT SetFloat(BMDDeckLinkFrameMetadataID metadataID, double value) override {
+        m_floatMetadata[metadataID] = value;
+        return S_OK;
+    }
+    HRESULT SetFlag(BMDDeckLinkFrameMetadataID metadataID, bool value) override {
+        m_flagMetadata[metadataID] = value;
+        return S_OK;
+    }
+    HRESULT SetString(BMDDeckLinkFrameMetadataID, CFStringRef) override { return E_NOTIMPL; }
+    HRESULT SetBytes(BMDDeckLinkFrameMetadataID, void*, uint32_t) override { return E_NOTIMPL; }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID* ppv) override {
+        if (!ppv) return E_POINTER;
+        if (is_iunknown(iid) || same_iid(iid, IID_IDeckLinkVideoFrame) ||
+            same_iid(iid, IID_IDeckLinkMutableVideoFrame)) {
+            *ppv = static_cast<IDeckLinkMutableVideoFrame*>(this);
+        } else if (same_iid(iid, IID_IDeckLinkVideoBuffer)) {
+            *ppv = static_cast<IDeckLinkVideoBuffer*>(this);
+        } else if (same_iid(iid, IID_IDeckLinkVideoFrameMutableMetadataExtensions)) {
+            *ppv = static_cast<IDeckLinkVideoFrameMutableMetadataExtensions*>(this);
+        } else {
+            *ppv = nullptr;
+            return E_NOINTERFACE;
+        }
+        AddRef();
+        return S_OK;
+    }
+    ULONG AddRef() override { return ++m_refCount; }
+    ULONG Release() override {
+        ULONG refCount = --m_refCount;
+        if (refCount == 0) {
+            delete this;
+        }
+        return refCount;
+    }
+
+private:
+    virtual ~MockVideoFrame() = default;
+
+    std::atomic<ULONG> m_refCount;
+    int32_t m_width;
+    int32_t m_height;
+    int32_t m_rowBytes;
+    BMDPixelFormat m_pixelFormat;
+    BMDFrameFlags m_flags;
+    std::vector<uint8_t> m_bytes;
+    std::map<BMDDeckLinkFrameMetadataID, int64_t> m_intMetadata;
+    std::map<BMDDeckLinkFrameMetadataID, double> m_floatMetadata;
+    std::map<BMDDeckLinkFrameMetadataID, bool> m_flagMetadata;
+};
+
+class MockDisplayMode : public IDeckLinkDisplayMode
+{
+public:
+    explicit MockDisplayMode(const MockDisplayModeInfo& info)
+        : m_refCount(1)
+        , m_info(info)
+    {
+    }
+
+    HRESULT GetName(CFStringRef* name) override {
+        if (!name) return E_POINTER;
+        *name = CFStringCreateWithCString(kCFAllocatorDefault, m_info.name, kCFStringEncodingUTF8);
+        return *name ? S_OK : E_OUTOFMEMORY;
+    }
+    BMDDisplayMode GetDisplayMode() override { return m_info.mode; }
+    long GetWidth() override { return m_info.width; }
+    long GetHeight() override { return m_info.height; }
+    HRESULT GetFrameRate(BMDTimeValue* frameDuration, BMDTimeScale* timeScale) override {
+        if (!frameDuration || !timeScale) return E_POINTER;
+        *frameDuration = m_info.frameDuration;
+        *timeScale = m_info.timeScale;
+        return S_OK;
+    }
+    BMDFieldDominance GetFieldDominance() override { return m_info.fieldDominance; }
+    BMDDisplayModeFlags GetFlags() override { return 0; }
+
+    HRESULT QueryInterface(REFIID, LPVOID* ppv) override {
+        if (ppv) *ppv = nullptr;
+        return E_NOINTERFACE;
+    }
+    ULONG AddRef() override { return ++m_refCount; }
+    ULONG Release() override {
+        ULONG refCount = --m_refCount;
+        if (refCount == 0) {
+            delete this;
+        }
+        return refCount;
+    }
+
+private:
+    virtual ~MockDisplayMode() = default;
+
+    std::atomic<ULONG> m_refCount;
+    const MockDisplayModeInfo& m_info;
+};
+
+class MockDisplayModeIterator : public IDeckLinkDisplayModeIterator
+{
+public:
+    MockDisplayModeIterator()
+        : m_refCount(1)
+        , m_next(0)
+    {
+    }
+
+    HRESULT Next(IDeckLinkDisplayMode** displayMode) override {
+        if (!displayMode) return E_POINTER;
+        if (m_next >= sizeof(kDisplayModes) / sizeof(kDisplayModes[0])) {
+            *displayMode = nullptr;
+            return S_FALSE;
+        }
+        *displayMode = new MockDisplayMode(kDisplayModes[m_next++]);
+        return S_OK;
+    }
+
+    HRESULT QueryInterface(REFIID, LPVOID* ppv) override {
+        if (ppv) *ppv = nullptr;
+        return E_NOINTERFACE;
+    }
+    ULONG AddRef() override { return ++m_refCount; }
+    ULONG Release() override {
+        ULONG refCount = --m_refCount;
+        if (refCount == 0) {
+            delete this;
+        }
+        return refCount;
+    }
+
+private:
+    virtual ~MockDisplayModeIterator() = default;
+
+    std::atomic<ULONG> m_refCount;
+    size_t m_next;
+};
+
+MockDeckLinkOutput::MockDeckLinkOutput()
+    : m_refCount(1)
+    , m_outputEnabled(false)
+    , m_displayMode(bmdModeUnknown)
+    , m_frameDuration(0)
+    , m_timeScale(0)
+    , m_callback(nullptr)
+    , m_onScreen{nullptr, bmdOutputFrameCompleted, 0}
+    , m_reporting{nullptr, bmdOutputFrameCompleted, 0}
+    , m_playbackRunning(false)
+    , m_stopRequested(false)
+    , m_playbackStartTime(0)
+    , m_playbackFrame(0)
+{
+}
+
+MockDeckLinkOutput::~MockDeckLinkOutput() {
+    DisableVideoOutput();
+    if (m_callback) {
+        m_callback->Release();
+        m_callback = nullptr;
+    }
+}
+
+const char* MockDeckLinkOutput::deviceName() {
+    return kMockDeviceName;
+}
+
+HRESULT MockDeckLinkOutput::DoesSupportVideoMode(BMDVideoConnection, BMDDisplayMode requestedMode,
+                                                 BMDPixelFormat requestedPixelFormat, BMDVideoOutputConversionMode,
+                                                 BMDSupportedVideoModeFlags, BMDDisplayMode* actualMode,
+                                                 bool* supported) {
+    if (!supported) return E_POINTER;
+    *supported = find_display_mode(requestedMode) && row_bytes_for_format(requestedPixelFormat, 1) > 0;
+    if (actualMode) {
+        *actualMode = *supported ? requestedMode : static_cast<BMDDisplayMode>(bmdModeUnknown);
+    }
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::GetDisplayMode(BMDDisplayMode displayMode, IDeckLinkDisplayMode** resultDisplayMode) {
+    if (!resultDisplayMode) return E_POINTER;
+    const MockDisplayModeInfo* info = find_display_mode(displayMode);
+    if (!info) {
+        *resultDisplayMode = nullptr;
+        return E_INVALIDARG;
+    }
+    *resultDisplayMode = new MockDisplayMode(*info);
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::GetDisplayModeIterator(IDeckLinkDisplayModeIterator** iterator) {
+    if (!iterator) return E_POINTER;
+    *iterator = new MockDisplayModeIterator();
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::SetScreenPreviewCallback(IDeckLinkScreenPreviewCallback*) {
+    return E_NOTIMPL;
+}
+
+HRESULT MockDeckLinkOutput::EnableVideoOutput(BMDDisplayMode displayMode, BMDVideoOutputFlags) {
+    const MockDisplayModeInfo* info = find_display_mode(displayMode);
+    if (!info) return E_INVALIDARG;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_outputEnabled) return E_ACCESSDENIED;
+    m_outputEnabled = true;
+    m_displayMode = displayMode;
+    m_frameDuration = info->frameDuration;
+    m_timeScale = info->timeScale;
+    m_outputEpoch = Clock::now();
+
+    LOG_INFO("[MockOutput] Video output enabled: " << info->name << ", "
+             << info->width << "x" << info->height);
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::DisableVideoOutput() {
+    StopScheduledPlayback(0, nullptr, 0);
+
+    // Frames prerolled without ever starting playback are flushed too
+    std::vector<Completion> flushed;
+    IDeckLinkVideoOutputCallback* callback = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_outputEnabled) return S_OK;
+        takeFramesLocked(flushed);
+        callback = m_callback;
+        if (callback) callback->AddRef();
+        m_outputEnabled = false;
+    }
+    complete(callback, flushed);
+    if (callback) callback->Release();
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::CreateVideoFrame(int32_t width, int32_t height, int32_t rowBytes,
+                                             BMDPixelFormat pixelFormat, BMDFrameFlags flags,
+                                             IDeckLinkMutableVideoFrame** outFrame) {
+    if (!outFrame) return E_POINTER;
+    *outFrame = nullptr;
+    if (width <= 0 || height <= 0 || rowBytes < row_bytes_for_format(pixelFormat, width) ||
+        row_bytes_for_format(pixelFormat, 1) == 0) {
+        return E_INVALIDARG;
+    }
+    *outFrame = new MockVideoFrame(width, height, rowBytes, pixelFormat, flags);
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::CreateVideoFrameWithBuffer(int32_t, int32_t, int32_t, BMDPixelFormat, BMDFrameFlags,
+                                                       IDeckLinkVideoBuffer*, IDeckLinkMutableVideoFrame** outFrame) {
+    if (outFrame) *outFrame = nullptr;
+    return E_NOTIMPL;
+}
+
+HRESULT MockDeckLinkOutput::RowBytesForPixelFormat(BMDPixelFormat pixelFormat, int32_t width, int32_t* rowBytes) {
+    if (!rowBytes) return E_POINTER;
+    if (width <= 0) return E_INVALIDARG;
+    *rowBytes = row_bytes_for_format(pixelFormat, width);
+    return *rowBytes > 0 ? S_OK : E_INVALIDARG;
+}
+
+HRESULT MockDeckLinkOutput::CreateAncillaryData(BMDPixelFormat, IDeckLinkVideoFrameAncillary** outBuffer) {
+    if (outBuffer) *outBuffer = nullptr;
+    return E_NOTIMPL;
+}
+
+/**
+ * @brief Blocks until the next frame boundary of the enabled display mode
+ *
+ * Stands in for the copy to the card and the wait for scanout, so a caller
+ * that displays frames back to back runs at the mode's frame rate.
+ */
+HRESULT MockDeckLinkOutput::DisplayVideoFrameSync(IDeckLinkVideoFrame* theFrame) {
+    if (!theFrame) return E_INVALIDARG;
+
+    Clock::time_point boundary;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_outputEnabled || m_playbackRunning) return E_ACCESSDENIED;
+        boundary = frameBoundary(m_outputEpoch, framesSince(m_outputEpoch, Clock::now()) + 1);
+    }
+    std::this_thread::sleep_until(boundary);
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::ScheduleVideoFrame(IDeckLinkVideoFrame* theFrame, BMDTimeValue displayTime,
+                                               BMDTimeValue, BMDTimeScale timeScale) {
+    if (!theFrame || timeScale <= 0) return E_INVALIDARG;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_outputEnabled) return E_ACCESSDENIED;
+
+    ScheduledFrame scheduled{theFrame, rescale(displayTime, timeScale, m_timeScale)};
+    auto position = std::upper_bound(m_scheduled.begin(), m_scheduled.end(), scheduled,
+                                     [](const ScheduledFrame& a, const ScheduledFrame& b) {
+                                         return a.displayTime < b.displayTime;
+                                     });
+    theFrame->AddRef();
+    m_scheduled.insert(position, scheduled);
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::SetScheduledFrameCompletionCallback(IDeckLinkVideoOutputCallback* theCallback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (theCallback) theCallback->AddRef();
+    if (m_callback) m_callback->Release();
+    m_callback = theCallback;
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::GetBufferedVideoFrameCount(uint32_t* bufferedFrameCount) {
+    if (!bufferedFrameCount) return E_POINTER;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    *bufferedFrameCount = static_cast<uint32_t>(m_scheduled.size());
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::EnableAudioOutput(BMDAudioSampleRate, BMDAudioSampleType, uint32_t,
+                                              BMDAudioOutputStreamType) {
+    return E_NOTIMPL;
+}
+
+HRESULT MockDeckLinkOutput::DisableAudioOutput() {
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::WriteAudioSamplesSync(void*, uint32_t, uint32_t* sampleFramesWritten) {
+    if (sampleFramesWritten) *sampleFramesWritten = 0;
+    return E_NOTIMPL;
+}
+
+HRESULT MockDeckLinkOutput::BeginAudioPreroll() {
+    return E_NOTIMPL;
+}
+
+HRESULT MockDeckLinkOutput::EndAudioPreroll() {
+    return E_NOTIMPL;
+}
+
+HRESULT MockDeckLinkOutput::ScheduleAudioSamples(void*, uint32_t, BMDTimeValue, BMDTimeScale,
+                                                 uint32_t* sampleFramesWritten) {
+    if (sampleFramesWritten) *sampleFramesWritten = 0;
+    return E_NOTIMPL;
+}
+
+HRESULT MockDeckLinkOutput::GetBufferedAudioSampleFrameCount(uint32_t* bufferedSampleFrameCount) {
+    if (!bufferedSampleFrameCount) return E_POINTER;
+    *bufferedSampleFrameCount = 0;
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::FlushBufferedAudioSamples() {
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::SetAudioCallback(IDeckLinkAudioOutputCallback*) {
+    return E_NOTIMPL;
+}
+
+HRESULT MockDeckLinkOutput::StartScheduledPlayback(BMDTimeValue playbackStartTime, BMDTimeScale timeScale,
+                                                   double playbackSpeed) {
+    if (timeScale <= 0 || playbackSpeed != 1.0) return E_INVALIDARG;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_outputEnabled) return E_ACCESSDENIED;
+    if (m_playbackRunning) return E_ACCESSDENIED;
+
+    m_playbackStartTime = rescale(playbackStartTime, timeScale, m_timeScale);
+    m_playbackEpoch = Clock::now();
+    m_playbackFrame = 0;
+    m_stopRequested = false;
+    m_playbackRunning = true;
+    m_playbackThread = std::thread(&MockDeckLinkOutput::playbackLoop, this);
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::StopScheduledPlayback(BMDTimeValue, BMDTimeValue* actualStopTime,
+                                                  BMDTimeScale timeScale) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_playbackRunning) return S_OK;
+        if (actualStopTime && timeScale > 0) {
+            *actualStopTime = rescale(streamTimeLocked(Clock::now()), m_timeScale, timeScale);
+        }
+        m_stopRequested = true;
+    }
+    m_wake.notify_all();
+    // Stops immediately; a stop time in the future is not emulated
+    m_playbackThread.join();
+
+    std::vector<Completion> flushed;
+    IDeckLinkVideoOutputCallback* callback = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        takeFramesLocked(flushed);
+        m_playbackRunning = false;
+        m_stopRequested = false;
+        callback = m_callback;
+        if (callback) callback->AddRef();
+    }
+    complete(callback, flushed);
+    if (callback) {
+        callback->ScheduledPlaybackHasStopped();
+        callback->Release();
+    }
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::IsScheduledPlaybackRunning(bool* active) {
+    if (!active) return E_POINTER;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    *active = m_playbackRunning;
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::GetScheduledStreamTime(BMDTimeScale desiredTimeScale, BMDTimeValue* streamTime,
+                                                   double* playbackSpeed) {
+    if (!streamTime || !playbackSpeed) return E_POINTER;
+    if (desiredTimeScale <= 0) return E_INVALIDARG;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_playbackRunning) {
+        *streamTime = 0;
+        *playbackSpeed = 0.0;
+        return S_OK;
+    }
+    *streamTime = rescale(streamTimeLocked(Clock::now()), m_timeScale, desiredTimeScale);
+    *playbackSpeed = 1.0;
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::GetReferenceStatus(BMDReferenceStatus* referenceStatus) {
+    if (!referenceStatus) return E_POINTER;
+    *referenceStatus = 0;
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::GetHardwareReferenceClock(BMDTimeScale desiredTimeScale, BMDTimeValue* hardwareTime,
+                                                      BMDTimeValue* timeInFrame, BMDTimeValue* ticksPerFrame) {
+    if (!hardwareTime || !timeInFrame || !ticksPerFrame) return E_POINTER;
+    if (desiredTimeScale <= 0) return E_INVALIDARG;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_outputEnabled) return E_ACCESSDENIED;
+    BMDTimeValue frameTicks = rescale(m_frameDuration, m_timeScale, desiredTimeScale);
+    *hardwareTime = rescale(hardwareTimeLocked(Clock::now()), kNanosecondsPerSecond, desiredTimeScale);
+    *ticksPerFrame = frameTicks;
+    *timeInFrame = frameTicks > 0 ? *hardwareTime % frameTicks : 0;
+    return S_OK;
+}
+
+// Known for the frame being reported to ScheduledFrameCompleted: the frame
+// boundary at which it left the screen, or when it was flushed
+HRESULT MockDeckLinkOutput::GetFrameCompletionReferenceTimestamp(IDeckLinkVideoFrame* theFrame,
+                                                                 BMDTimeScale desiredTimeScale,
+                                                                 BMDTimeValue* frameCompletionTimestamp) {
+    if (!frameCompletionTimestamp) return E_POINTER;
+    *frameCompletionTimestamp = 0;
+    if (!theFrame || desiredTimeScale <= 0) return E_INVALIDARG;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (theFrame != m_reporting.frame) return E_FAIL;
+    *frameCompletionTimestamp = rescale(m_reporting.completedAt, kNanosecondsPerSecond, desiredTimeScale);
+    return S_OK;
+}
+
+HRESULT MockDeckLinkOutput::QueryInterface(REFIID iid, LPVOID* ppv) {
+    if (!ppv) return E_POINTER;
+    if (is_iunknown(iid) || same_iid(iid, IID_IDeckLinkOutput)) {
+        *ppv = static_cast<IDeckLinkOutput*>(this);
+        AddRef();
+        return S_OK;
+    }
+    *ppv = nullptr;
+    return E_NOINTERFACE;
+}
+
+ULONG MockDeckLinkOutput::AddRef() {
+    return ++m_refCount;
+}
+
+ULONG MockDeckLinkOutput::Release() {
+    ULONG refCount = --m_refCount;
+    if (refCount == 0) {
+        delete this;
+    }
+    return refCount;
+}
+
+// Wall-clock time at which frame `frameIndex` after `epoch` starts
+MockDeckLinkOutput::Clock::time_point MockDeckLinkOutput::frameBoundary(Clock::time_point epoch,
+                                                                       int64_t frameIndex) const {
+    int64_t nanoseconds = rescale(frameIndex * m_frameDuration, m_timeScale, kNanosecondsPerSecond);
+    return epoch + std::chrono::nanoseconds(nanoseconds);
+}
+
+// Whole frames elapsed between `epoch` and `now`
+int64_t MockDeckLinkOutput::framesSince(Clock::time_point epoch, Clock::time_point now) const {
+    int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - epoch).count();
+    if (elapsed <= 0 || m_frameDuration <= 0) return 0;
+    return rescale(elapsed, kNanosecondsPerSecond, m_timeScale) / m_frameDuration;
+}
+
+// Hardware reference clock, which runs from when video output was enabled
+int64_t MockDeckLinkOutput::hardwareTimeLocked(Clock::time_point time) const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_outputEpoch).count();
+}
+
+BMDTimeValue MockDeckLinkOutput::streamTimeLocked(Clock::time_point now) const {
+    int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_playbackEpoch).count();
+    return m_playbackStartTime + rescale(std::max<int64_t>(elapsed, 0), kNanosecondsPerSecond, m_timeScale);
+}
+
+// Hands every frame still held back: the one on screen has been displayed,
+// the queued ones never will be.
+void MockDeckLinkOutput::takeFramesLocked(std::vector<Completion>& completions) {
+    int64_t now = hardwareTimeLocked(Clock::now());
+    if (m_onScreen.frame) {
+        completions.push_back({m_onScreen.frame, m_onScreen.result, now});
+        m_onScreen = {nullptr, bmdOutputFrameCompleted, 0};
+    }
+    for (const auto& scheduled : m_scheduled) {
+        completions.push_back({scheduled.frame, bmdOutputFrameFlushed, now});
+    }
+    m_scheduled.clear();
+}
+
+/**
+ * @brief Emulates scanout while scheduled playback runs
+ *
+ * Wakes at every frame boundary. The frame that was on screen is completed
+ * and the latest queued frame due by the end of the new frame slot goes on
+ * screen: on time if it was due in this slot, late if its slot had already
+ * passed. Due frames it replaces are dropped. With nothing due the last
+ * frame keeps repeating on the output, as the hardware does on underrun.
+ */
+void MockDeckLinkOutput::playbackLoop() {
+    std::vector<Completion> completions;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopRequested) {
+        m_wake.wait_until(lock, frameBoundary(m_playbackEpoch, m_playbackFrame), [this]() {
+            return m_stopRequested || Clock::now() >= frameBoundary(m_playbackEpoch, m_playbackFrame);
+        });
+        if (m_stopRequested) break;
+
+        // Catch up on boundaries missed while the thread was not scheduled
+        int64_t frameIndex = std::max(m_playbackFrame, framesSince(m_playbackEpoch, Clock::now()));
+        BMDTimeValue slotStart = m_playbackStartTime + frameIndex * m_frameDuration;
+        m_playbackFrame = frameIndex + 1;
+        int64_t boundary = hardwareTimeLocked(frameBoundary(m_playbackEpoch, frameIndex));
+
+        if (m_onScreen.frame) {
+            completions.push_back({m_onScreen.frame, m_onScreen.result, boundary});
+            m_onScreen = {nullptr, bmdOutputFrameCompleted, 0};
+        }
+        while (!m_scheduled.empty() && m_scheduled.front().displayTime < slotStart + m_frameDuration) {
+            ScheduledFrame due = m_scheduled.front();
+            m_scheduled.pop_front();
+            if (m_onScreen.frame) {
+                completions.push_back({m_onScreen.frame, bmdOutputFrameDropped, boundary});
+            }
+            m_onScreen = {due.frame, due.displayTime < slotStart ? bmdOutputFrameDisplayedLate
+                                                                 : bmdOutputFrameCompleted, 0};
+        }
+        if (completions.empty()) continue;
+
+        IDeckLinkVideoOutputCallback* callback = m_callback;
+        if (callback) callback->AddRef();
+        lock.unlock();
+        complete(callback, completions);
+        if (callback) callback->Release();
+        completions.clear();
+        lock.lock();
+    }
+}
+
+// Reports each frame to the callback, then drops the reference taken when it
+// was scheduled. Called without m_mutex held so the callback may call back in.
+void MockDeckLinkOutput::complete(IDeckLinkVideoOutputCallback* callback, const std::vector<Completion>& completions) {
+    for (const auto& completion : completions) {
+        if (callback) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_reporting = completion;
+            }
+            callback->ScheduledFrameCompleted(completion.frame, completion.result);
+        }
+        completion.frame->Release();
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_reporting = {nullptr, bmdOutputFrameCompleted, 0};
+}
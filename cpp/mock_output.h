@@ -0,0 +1,133 @@
+#pragma once
+
+#include "DeckLinkAPI.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Hardware-free stand-in for a DeckLink output. Frames are plain memory and
+// nothing is shown anywhere, but the timing follows the enabled display
+// mode: DisplayVideoFrameSync() blocks until the next frame boundary and
+// scheduled frames complete one frame duration after they were displayed,
+// stamped with that frame boundary on the hardware reference clock, so the
+// real packing, pooling and scheduling code can be measured at the
+// cadence of a device. Opened with DECKLINK_MOCK_DEVICE_INDEX.
+class MockDeckLinkOutput : public IDeckLinkOutput
+{
+public:
+    MockDeckLinkOutput();
+
+    static const char *deviceName();
+
+    // IDeckLinkOutput
+    HRESULT DoesSupportVideoMode(BMDVideoConnection connection, BMDDisplayMode requestedMode,
+                                 BMDPixelFormat requestedPixelFormat, BMDVideoOutputConversionMode conversionMode,
+                                 BMDSupportedVideoModeFlags flags, BMDDisplayMode *actualMode,
+                                 bool *supported) override;
+    HRESULT GetDisplayMode(BMDDisplayMode displayMode, IDeckLinkDisplayMode **resultDisplayMode) override;
+    HRESULT GetDisplayModeIterator(IDeckLinkDisplayModeIterator **iterator) override;
+    HRESULT SetScreenPreviewCallback(IDeckLinkScreenPreviewCallback *previewCallback) override;
+
+    HRESULT EnableVideoOutput(BMDDisplayMode displayMode, BMDVideoOutputFlags flags) override;
+    HRESULT DisableVideoOutput() override;
+    HRESULT CreateVideoFrame(int32_t width, int32_t height, int32_t rowBytes, BMDPixelFormat pixelFormat,
+                             BMDFrameFlags flags, IDeckLinkMutableVideoFrame **outFrame) override;
+    HRESULT CreateVideoFrameWithBuffer(int32_t width, int32_t height, int32_t rowBytes, BMDPixelFormat pixelFormat,
+                                       BMDFrameFlags flags, IDeckLinkVideoBuffer *buffer,
+                                       IDeckLinkMutableVideoFrame **outFrame) override;
+    HRESULT RowBytesForPixelFormat(BMDPixelFormat pixelFormat, int32_t width, int32_t *rowBytes) override;
+    HRESULT CreateAncillaryData(BMDPixelFormat pixelFormat, IDeckLinkVideoFrameAncillary **outBuffer) override;
+    HRESULT DisplayVideoFrameSync(IDeckLinkVideoFrame *theFrame) override;
+    HRESULT ScheduleVideoFrame(IDeckLinkVideoFrame *theFrame, BMDTimeValue displayTime,
+                               BMDTimeValue displayDuration, BMDTimeScale timeScale) override;
+    HRESULT SetScheduledFrameCompletionCallback(IDeckLinkVideoOutputCallback *theCallback) override;
+    HRESULT GetBufferedVideoFrameCount(uint32_t *bufferedFrameCount) override;
+
+    HRESULT EnableAudioOutput(BMDAudioSampleRate sampleRate, BMDAudioSampleType sampleType,
+                              uint32_t channelCount, BMDAudioOutputStreamType streamType) override;
+    HRESULT DisableAudioOutput() override;
+    HRESULT WriteAudioSamplesSync(void *buffer, uint32_t sampleFrameCount, uint32_t *sampleFramesWritten) override;
+    HRESULT BeginAudioPreroll() override;
+    HRESULT EndAudioPreroll() override;
+    HRESULT ScheduleAudioSamples(void *buffer, uint32_t sampleFrameCount, BMDTimeValue streamTime,
+                                 BMDTimeScale timeScale, uint32_t *sampleFramesWritten) override;
+    HRESULT GetBufferedAudioSampleFrameCount(uint32_t *bufferedSampleFrameCount) override;
+    HRESULT FlushBufferedAudioSamples() override;
+    HRESULT SetAudioCallback(IDeckLinkAudioOutputCallback *theCallback) override;
+
+    HRESULT StartScheduledPlayback(BMDTimeValue playbackStartTime, BMDTimeScale timeScale,
+                                   double playbackSpeed) override;
+    HRESULT StopScheduledPlayback(BMDTimeValue stopPlaybackAtTime, BMDTimeValue *actualStopTime,
+                                  BMDTimeScale timeScale) override;
+    HRESULT IsScheduledPlaybackRunning(bool *active) override;
+    HRESULT GetScheduledStreamTime(BMDTimeScale desiredTimeScale, BMDTimeValue *streamTime,
+                                   double *playbackSpeed) override;
+    HRESULT GetReferenceStatus(BMDReferenceStatus *referenceStatus) override;
+
+    HRESULT GetHardwareReferenceClock(BMDTimeScale desiredTimeScale, BMDTimeValue *hardwareTime,
+                                      BMDTimeValue *timeInFrame, BMDTimeValue *ticksPerFrame) override;
+    HRESULT GetFrameCompletionReferenceTimestamp(IDeckLinkVideoFrame *theFrame, BMDTimeScale desiredTimeScale,
+                                                 BMDTimeValue *frameCompletionTimestamp) override;
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) override;
+    ULONG AddRef() override;
+    ULONG Release() override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct ScheduledFrame
+    {
+        IDeckLinkVideoFrame *frame;
+        BMDTimeValue displayTime; // in the mode's time scale
+    };
+
+    struct Completion
+    {
+        IDeckLinkVideoFrame *frame;
+        BMDOutputFrameCompletionResult result;
+        int64_t completedAt; // hardware reference time in ns
+    };
+
+    virtual ~MockDeckLinkOutput();
+
+    Clock::time_point frameBoundary(Clock::time_point epoch, int64_t frameIndex) const;
+    int64_t framesSince(Clock::time_point epoch, Clock::time_point now) const;
+    int64_t hardwareTimeLocked(Clock::time_point time) const;
+    BMDTimeValue streamTimeLocked(Clock::time_point now) const;
+    void takeFramesLocked(std::vector<Completion> &completions);
+    void playbackLoop();
+    void complete(IDeckLinkVideoOutputCallback *callback, const std::vector<Completion> &completions);
+
+    std::atomic<ULONG> m_refCount;
+
+    // Output state, guarded by m_mutex. The time scale and frame duration
+    // are those of the enabled display mode.
+    mutable std::mutex m_mutex;
+    bool m_outputEnabled;
+    BMDDisplayMode m_displayMode;
+    BMDTimeValue m_frameDuration;
+    BMDTimeScale m_timeScale;
+    Clock::time_point m_outputEpoch;
+    IDeckLinkVideoOutputCallback *m_callback;
+
+    // Scheduled playback. Frames wait in m_scheduled ordered by display
+    // time; m_onScreen is displayed until the next frame boundary replaces it.
+    std::deque<ScheduledFrame> m_scheduled;
+    Completion m_onScreen;
+    // Completion being reported, for GetFrameCompletionReferenceTimestamp()
+    Completion m_reporting;
+    bool m_playbackRunning;
+    bool m_stopRequested;
+    BMDTimeValue m_playbackStartTime;
+    Clock::time_point m_playbackEpoch;
+    int64_t m_playbackFrame;
+    std::condition_variable m_wake;
+    std::thread m_playbackThread;
+};
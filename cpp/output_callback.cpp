@@ -0,0 +1,36 @@
+#include "output_callback.h"
+#include "decklink_wrapper.h"
+
+OutputCallback::OutputCallback(DeckLinkSignalGen* owner)
+    : m_refCount(1)
+    , m_owner(owner)
+{
+}
+
+// Called on the driver's completion thread
+HRESULT OutputCallback::ScheduledFrameCompleted(IDeckLinkVideoFrame* completedFrame, BMDOutputFrameCompletionResult result) {
+    m_owner->onScheduledFrameCompleted(completedFrame, result);
+    return S_OK;
+}
+
+HRESULT OutputCallback::ScheduledPlaybackHasStopped() {
+    return S_OK;
+}
+
+HRESULT OutputCallback::QueryInterface(REFIID iid, LPVOID* ppv) {
+    // Only ever handed to SetScheduledFrameCompletionCallback, which does not query
+    *ppv = nullptr;
+    return E_NOINTERFACE;
+}
+
+ULONG OutputCallback::AddRef() {
+    return ++m_refCount;
+}
+
+ULONG OutputCallback::Release() {
+    ULONG refCount = --m_refCount;
+    if (refCount == 0) {
+        delete this;
+    }
+    return refCount;
+}
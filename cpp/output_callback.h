@@ -0,0 +1,29 @@
+#pragma once
+
+#include "DeckLinkAPI.h"
+#include <atomic>
+
+class DeckLinkSignalGen;
+
+// Receives scheduled playback completions from the driver and hands them back
+// to the owning DeckLinkSignalGen so finished frames return to its pool.
+class OutputCallback : public IDeckLinkVideoOutputCallback
+{
+public:
+    explicit OutputCallback(DeckLinkSignalGen *owner);
+
+    // IDeckLinkVideoOutputCallback
+    HRESULT ScheduledFrameCompleted(IDeckLinkVideoFrame *completedFrame, BMDOutputFrameCompletionResult result) override;
+    HRESULT ScheduledPlaybackHasStopped() override;
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) override;
+    ULONG AddRef() override;
+    ULONG Release() override;
+
+private:
+    virtual ~OutputCallback() = default;
+
+    std::atomic<ULONG> m_refCount;
+    DeckLinkSignalGen *m_owner;
+};
@@ -0,0 +1,286 @@
+#include "output_group.h"
+#include "decklink_wrapper.h"
+#include "logger.h"
+#include <algorithm>
+#include <atomic>
+
+// DeckLink playback group IDs handed out to groups, unique per process
+static std::atomic<int64_t> s_nextPlaybackGroupId(1);
+
+OutputGroup::OutputGroup()
+    : m_packCount(0)
+    , m_playbackGroupId(s_nextPlaybackGroupId++)
+    , m_inPlaybackGroup(false)
+    , m_task(nullptr)
+    , m_generation(0)
+    , m_pending(0)
+    , m_stopping(false)
+{
+}
+
+OutputGroup::~OutputGroup() {
+    leavePlaybackGroup();
+    stopLanes();
+    for (auto* output : m_outputs) {
+        output->setOutputGroup(nullptr);
+    }
+}
+
+/**
+ * @brief Adds an open output to the group
+ *
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Null output
+ *         - -2: The output already belongs to a group
+ */
+int OutputGroup::add(DeckLinkSignalGen* output) {
+    if (!output) return -1;
+    if (output->outputGroup()) {
+        LOG_ERROR("[OutputGroup] Output already belongs to a group");
+        return -2;
+    }
+    stopLanes();
+    m_outputs.push_back(output);
+    output->setOutputGroup(this);
+    startLanes();
+    return 0;
+}
+
+// Returns -1 if the output is not a member
+int OutputGroup::remove(DeckLinkSignalGen* output) {
+    auto it = std::find(m_outputs.begin(), m_outputs.end(), output);
+    if (it == m_outputs.end()) return -1;
+    if (m_inPlaybackGroup) {
+        output->setPlaybackGroup(0);
+    }
+    stopLanes();
+    m_outputs.erase(it);
+    output->setOutputGroup(nullptr);
+    startLanes();
+    return 0;
+}
+
+int OutputGroup::count() const {
+    return static_cast<int>(m_outputs.size());
+}
+
+int OutputGroup::packCount() const {
+    return m_packCount;
+}
+
+/**
+ * @brief Builds the next frame of every member from one RGB image
+ *
+ * The first member of each pixel format and Y'CbCr conversion packs the
+ * image; members that would produce the same bytes copy that packed frame
+ * instead. A member whose frame layout still differs (such as row padding)
+ * packs for itself.
+ *
+ * @return int Returns 0 on success, -1 for an empty group, or the first
+ *         failing member's createFrameFromBuffer() code
+ */
+int OutputGroup::createFrameFromBuffer(const uint16_t* data, int width, int height) {
+    if (m_outputs.empty()) return -1;
+
+    std::vector<DeckLinkSignalGen*> packed;
+    for (auto* output : m_outputs) {
+        int err = -1;
+        for (auto* source : packed) {
+            if (output->sharesPackedFrames(*source) && output->copyFrameFrom(*source) == 0) {
+                err = 0;
+                break;
+            }
+        }
+        if (err) {
+            err = output->createFrameFromBuffer(data, width, height);
+            if (err) return err;
+            packed.push_back(output);
+        }
+    }
+    m_packCount = static_cast<int>(packed.size());
+    return 0;
+}
+
+int OutputGroup::displayFrameSync() {
+    return runOnEach([](DeckLinkSignalGen* output) { return output->displayFrameSync(); });
+}
+
+/**
+ * @brief Queues the current frame of every member at one common stream time
+ *
+ * Each member would normally queue one frame after its previous frame, or
+ * skip ahead if it fell behind scanout. The group uses the latest of those
+ * times for every member so the outputs keep showing the same frame.
+ *
+ * @return int Returns 0 on success, -1 for an empty group, -5 if the members
+ *         run different frame rates, or the first failing member's
+ *         scheduleFrame() code
+ */
+int OutputGroup::scheduleFrame() {
+    if (m_outputs.empty()) return -1;
+
+    BMDTimeValue streamTime = 0;
+    BMDTimeValue frameDuration = 0;
+    BMDTimeScale timeScale = 0;
+    for (size_t i = 0; i < m_outputs.size(); i++) {
+        BMDTimeValue memberTime = 0;
+        BMDTimeValue memberDuration = 0;
+        BMDTimeScale memberScale = 0;
+        int err = m_outputs[i]->nextStreamTime(memberTime, memberDuration, memberScale);
+        if (err) return err;
+        if (i > 0 && (memberDuration != frameDuration || memberScale != timeScale)) {
+            LOG_ERROR("[OutputGroup] Scheduled playback needs the same frame rate on every output");
+            return -5;
+        }
+        streamTime = std::max(streamTime, memberTime);
+        frameDuration = memberDuration;
+        timeScale = memberScale;
+    }
+
+    for (auto* output : m_outputs) {
+        int err = output->scheduleFrameAt(streamTime);
+        if (err) return err;
+    }
+    return 0;
+}
+
+/**
+ * @brief Starts scheduled playback on every member together
+ *
+ * If every member supports DeckLink playback groups they join this group's
+ * playback group, which starts them on the same hardware frame. Otherwise
+ * each member is started from its own thread at the same moment, which
+ * leaves them within a thread wake-up of each other.
+ *
+ * @return int Returns 0 on success, -1 for an empty group, or the first
+ *         failing member's startScheduledPlayback() code
+ */
+int OutputGroup::startScheduledPlayback() {
+    if (m_outputs.empty()) return -1;
+
+    if (!m_inPlaybackGroup && m_outputs.size() > 1) {
+        m_inPlaybackGroup = true;
+        for (auto* output : m_outputs) {
+            if (output->setPlaybackGroup(m_playbackGroupId) != 0) {
+                leavePlaybackGroup();
+                break;
+            }
+        }
+        LOG_INFO("[OutputGroup] Starting " << m_outputs.size() << " outputs "
+                 << (m_inPlaybackGroup ? "in a hardware playback group" : "individually"));
+    }
+
+    if (m_inPlaybackGroup) {
+        // Starting one member starts the whole playback group; the others
+        // then find playback already running
+        for (auto* output : m_outputs) {
+            int err = output->startScheduledPlayback();
+            if (err) return err;
+        }
+        return 0;
+    }
+    return runOnEach([](DeckLinkSignalGen* output) { return output->startScheduledPlayback(); });
+}
+
+int OutputGroup::stopScheduledPlayback() {
+    if (m_outputs.empty()) return -1;
+    int result = 0;
+    for (auto* output : m_outputs) {
+        int err = output->stopScheduledPlayback();
+        if (err && !result) result = err;
+    }
+    leavePlaybackGroup();
+    return result;
+}
+
+/**
+ * @brief Reads the hardware queue depth of every member
+ *
+ * @param counts Receives one count per member, in the order they were added
+ * @param maxCount Capacity of counts
+ * @return int Number of members on success, or the first failing member's
+ *         getBufferedFrameCount() code
+ */
+int OutputGroup::getBufferedFrameCounts(int* counts, int maxCount) {
+    int n = std::min(count(), maxCount);
+    for (int i = 0; i < n; i++) {
+        int buffered = m_outputs[i]->getBufferedFrameCount();
+        if (buffered < 0) return buffered;
+        counts[i] = buffered;
+    }
+    return count();
+}
+
+void OutputGroup::leavePlaybackGroup() {
+    if (!m_inPlaybackGroup) return;
+    for (auto* output : m_outputs) {
+        output->setPlaybackGroup(0);
+    }
+    m_inPlaybackGroup = false;
+}
+
+// Runs task for every member at once and returns the first member's error
+int OutputGroup::runOnEach(const Task& task) {
+    if (m_outputs.empty()) return -1;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_results.assign(m_outputs.size(), 0);
+        m_pending = m_lanes.size();
+        m_generation++;
+    }
+    m_wake.notify_all();
+
+    int first = task(m_outputs[0]);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this]() { return m_pending == 0; });
+    m_task = nullptr;
+    m_results[0] = first;
+    for (int result : m_results) {
+        if (result) return result;
+    }
+    return 0;
+}
+
+void OutputGroup::startLanes() {
+    m_stopping = false;
+    for (size_t lane = 0; lane + 1 < m_outputs.size(); lane++) {
+        m_lanes.emplace_back(&OutputGroup::laneLoop, this, lane, m_generation);
+    }
+}
+
+void OutputGroup::stopLanes() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& lane : m_lanes) {
+        lane.join();
+    }
+    m_lanes.clear();
+}
+
+void OutputGroup::laneLoop(size_t lane, uint64_t generation) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    uint64_t seen = generation;
+    for (;;) {
+        m_wake.wait(lock, [this, seen]() { return m_stopping || m_generation != seen; });
+        if (m_stopping) return;
+        seen = m_generation;
+
+        const Task* task = m_task;
+        DeckLinkSignalGen* output = m_outputs[lane + 1];
+        lock.unlock();
+
+        int result = (*task)(output);
+
+        lock.lock();
+        m_results[lane + 1] = result;
+        if (--m_pending == 0) {
+            m_done.notify_all();
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class DeckLinkSignalGen;
+
+// Several open outputs driven in lockstep from one caller. A source image is
+// packed once for each distinct pixel format and conversion among the
+// members and the packed frame is copied to the others. Synchronous display
+// runs on every member at once, one persistent thread per member after the
+// first, so the outputs flip on the same frame instead of one after another.
+// Scheduled playback queues every member at the same stream time and, when
+// the hardware supports it, joins them in one DeckLink playback group so
+// they start together on a shared clock.
+//
+// The group does not own its outputs. Closing an output removes it from its
+// group. Like DeckLinkSignalGen, a group is driven from one thread at a time.
+class OutputGroup
+{
+public:
+    OutputGroup();
+    ~OutputGroup();
+
+    OutputGroup(const OutputGroup &) = delete;
+    OutputGroup &operator=(const OutputGroup &) = delete;
+
+    // Membership. An output belongs to at most one group.
+    int add(DeckLinkSignalGen *output);
+    int remove(DeckLinkSignalGen *output);
+    int count() const;
+
+    // Frame management, with the same codes as the DeckLinkSignalGen calls.
+    // On failure the first failing member's code is returned.
+    int createFrameFromBuffer(const uint16_t *data, int width, int height);
+    int displayFrameSync();
+
+    // Scheduled playback
+    int scheduleFrame();
+    int startScheduledPlayback();
+    int stopScheduledPlayback();
+    int getBufferedFrameCounts(int *counts, int maxCount);
+
+    // Frames packed by the last createFrameFromBuffer(); the other members
+    // received copies
+    int packCount() const;
+
+private:
+    using Task = std::function<int(DeckLinkSignalGen *)>;
+
+    int runOnEach(const Task &task);
+    void startLanes();
+    void stopLanes();
+    void laneLoop(size_t lane, uint64_t generation);
+    void leavePlaybackGroup();
+
+    std::vector<DeckLinkSignalGen *> m_outputs;
+    int m_packCount;
+
+    // DeckLink playback group joined by every member while scheduled
+    // playback runs, or 0 if the members are started individually
+    int64_t m_playbackGroupId;
+    bool m_inPlaybackGroup;
+
+    // Lane i runs the current task for m_outputs[i + 1]; the caller takes
+    // m_outputs[0]
+    std::vector<std::thread> m_lanes;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const Task *m_task;
+    std::vector<int> m_results;
+    uint64_t m_generation;
+    size_t m_pending;
+    bool m_stopping;
+};
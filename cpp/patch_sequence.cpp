@@ -0,0 +1,341 @@
+#include "patch_sequence.h"
+#include "logger.h"
+#include <algorithm>
+
+PatchSequence::PatchSequence(PackFunction pack, ScheduleFunction schedule, RecycleFunction recycle)
+    : m_pack(std::move(pack))
+    , m_schedule(std::move(schedule))
+    , m_recycle(std::move(recycle))
+    , m_width(0)
+    , m_height(0)
+    , m_loop(false)
+    , m_queueDepth(0)
+    , m_frameDuration(0)
+    , m_timeScale(0)
+    , m_nextStreamTime(0)
+    , m_patchStart(0)
+    , m_packed(nullptr)
+    , m_patchIndex(0)
+    , m_pass(0)
+    , m_repeat(0)
+    , m_fedAll(false)
+    , m_running(false)
+    , m_stopping(false)
+    , m_completedPatches(0)
+    , m_lateFrames(0)
+    , m_droppedFrames(0)
+    , m_eventsDropped(0)
+    , m_lastError(0)
+{
+}
+
+PatchSequence::~PatchSequence() {
+    stop();
+}
+
+/**
+ * @brief Replaces the patch list
+ *
+ * Images are copied, so the caller's buffers may be freed right away.
+ *
+ * @param width Frame width of every patch
+ * @param height Frame height of every patch
+ * @param patches Patch descriptors, image patches holding width * height * 3 values
+ * @param count Number of patches
+ * @return int Returns 0 on success, -1 for invalid arguments, -2 while playing
+ */
+int PatchSequence::load(int width, int height, const SequencePatch* patches, int count) {
+    if (running()) return -2;
+    if (width <= 0 || height <= 0 || !patches || count <= 0) return -1;
+    for (int i = 0; i < count; i++) {
+        if (patches[i].dwellFrames <= 0) {
+            LOG_ERROR("[PatchSequence] Patch " << i << " needs a dwell time of at least one frame");
+            return -1;
+        }
+    }
+
+    size_t imageSize = static_cast<size_t>(width) * height * 3;
+    m_patches.resize(count);
+    for (int i = 0; i < count; i++) {
+        Patch& patch = m_patches[i];
+        if (patches[i].image) {
+            patch.image.assign(patches[i].image, patches[i].image + imageSize);
+        } else {
+            patch.image.clear();
+        }
+        std::copy(patches[i].rgb, patches[i].rgb + 3, patch.rgb);
+        patch.dwellFrames = patches[i].dwellFrames;
+    }
+    m_width = width;
+    m_height = height;
+    return 0;
+}
+
+/**
+ * @brief Queues the first frames and starts the feeder thread
+ *
+ * @param loop Start over with the first patch after the last one
+ * @param startTime Stream time of the first patch
+ * @param queueDepth Frames kept handed to the hardware, including the one
+ *        on screen
+ * @return int Returns 0 on success, -1 if no patches are loaded, -2 if
+ *         already running, or the failing pack or schedule code
+ */
+int PatchSequence::start(bool loop, BMDTimeValue startTime, BMDTimeValue frameDuration,
+                         BMDTimeScale timeScale, size_t queueDepth) {
+    if (m_patches.empty()) return -1;
+    if (running()) return -2;
+    if (m_feedThread.joinable()) {
+        m_feedThread.join();
+    }
+
+    m_loop = loop;
+    m_queueDepth = std::max<size_t>(queueDepth, 1);
+    m_frameDuration = frameDuration;
+    m_timeScale = timeScale;
+    m_nextStreamTime = startTime;
+    m_patchStart = startTime;
+    m_packed = nullptr;
+    m_patchIndex = 0;
+    m_pass = 0;
+    m_repeat = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fedAll = false;
+        m_events.clear();
+        m_completedPatches = 0;
+        m_lateFrames = 0;
+        m_droppedFrames = 0;
+        m_eventsDropped = 0;
+        m_lastError = 0;
+        m_stopping = false;
+        m_running = true;
+    }
+
+    // Preroll, so playback starts with frames already queued
+    for (size_t i = 0; i < m_queueDepth && !m_fedAll; i++) {
+        int err = queueNextFrame();
+        if (err) {
+            stop();
+            return err;
+        }
+    }
+    m_feedThread = std::thread(&PatchSequence::feedLoop, this);
+    return 0;
+}
+
+void PatchSequence::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    if (m_feedThread.joinable()) {
+        m_feedThread.join();
+    }
+
+    IDeckLinkMutableVideoFrame* recycle = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_packed) {
+            // The patch was cut short: its last queued showing gives the
+            // frame back, or nothing does if none was queued
+            auto last = std::find_if(m_queued.rbegin(), m_queued.rend(), [this](const QueuedFrame& queued) {
+                return queued.frame == m_packed && queued.patchIndex == m_patchIndex && queued.pass == m_pass;
+            });
+            if (last != m_queued.rend()) {
+                last->lastOfPatch = true;
+            } else {
+                recycle = m_packed;
+            }
+            m_packed = nullptr;
+        }
+        if (m_running) {
+            finishLocked();
+        }
+    }
+    if (recycle) {
+        m_recycle(recycle);
+    }
+}
+
+bool PatchSequence::running() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+// Called on the driver's completion thread
+bool PatchSequence::frameCompleted(IDeckLinkVideoFrame* frame, BMDOutputFrameCompletionResult result,
+                                   BMDTimeValue completionTimestamp) {
+    IDeckLinkVideoFrame* recycle = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Completions arrive in queue order, so the oldest showing of the
+        // frame is the one that completed
+        auto it = std::find_if(m_queued.begin(), m_queued.end(),
+                               [frame](const QueuedFrame& queued) { return queued.frame == frame; });
+        if (it == m_queued.end()) return false;
+        QueuedFrame queued = *it;
+        m_queued.erase(it);
+
+        if (result == bmdOutputFrameDisplayedLate) {
+            m_lateFrames++;
+        } else if (result == bmdOutputFrameDropped) {
+            m_droppedFrames++;
+        }
+
+        if (queued.lastOfPatch) {
+            recycle = queued.frame;
+            m_completedPatches++;
+            if (m_running) {
+                SequenceEvent event;
+                event.startTime = queued.patchStart;
+                event.endTime = queued.streamTime + m_frameDuration;
+                event.timeScale = m_timeScale;
+                event.completionTimestamp = completionTimestamp;
+                event.patchIndex = queued.patchIndex;
+                event.pass = queued.pass;
+                event.result = static_cast<int32_t>(result);
+                m_events.push_back(event);
+                if (m_events.size() > kMaxEvents) {
+                    m_events.pop_front();
+                    m_eventsDropped++;
+                }
+            }
+        }
+        if (m_running && m_fedAll && m_queued.empty()) {
+            finishLocked();
+        }
+    }
+    m_wake.notify_all();
+    if (recycle) {
+        m_recycle(recycle);
+    }
+    return true;
+}
+
+// Frames still listed after the output stopped went away with its pool
+void PatchSequence::dropQueuedFrames() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queued.clear();
+}
+
+int PatchSequence::waitEvent(SequenceEvent& event, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_wake.wait_for(lock, timeout, [this]() { return !m_events.empty() || !m_running; });
+    if (!m_events.empty()) {
+        event = m_events.front();
+        m_events.pop_front();
+        return 0;
+    }
+    return m_running ? -3 : -1;
+}
+
+SequenceStatus PatchSequence::status() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SequenceStatus status;
+    status.completedPatches = m_completedPatches;
+    status.lateFrames = m_lateFrames;
+    status.droppedFrames = m_droppedFrames;
+    status.eventsDropped = m_eventsDropped;
+    status.patchCount = static_cast<int32_t>(m_patches.size());
+    status.running = m_running ? 1 : 0;
+    status.queuedFrames = static_cast<int32_t>(m_queued.size());
+    status.lastError = m_lastError;
+    return status;
+}
+
+void PatchSequence::feedLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_fedAll) {
+        m_wake.wait(lock, [this]() { return m_stopping || m_queued.size() < m_queueDepth; });
+        if (m_stopping) return;
+
+        lock.unlock();
+        int err = queueNextFrame();
+        lock.lock();
+        if (err) {
+            LOG_ERROR("[PatchSequence] Stopped feeding at patch " << m_patchIndex << " (error " << err << ")");
+            m_lastError = err;
+            // Playback ends once the frames already queued have completed
+            m_fedAll = true;
+            if (m_queued.empty()) {
+                finishLocked();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Queues one more frame of the sequence
+ *
+ * Packs the current patch on its first frame, then schedules one frame
+ * duration of it and moves on to the next patch after its dwell time.
+ * Runs on one feeding thread at a time without m_mutex held.
+ */
+int PatchSequence::queueNextFrame() {
+    const Patch& patch = m_patches[m_patchIndex];
+    if (!m_packed) {
+        int err = m_pack(patch.image.empty() ? nullptr : patch.image.data(), patch.rgb, &m_packed);
+        if (err) {
+            m_packed = nullptr;
+            return err;
+        }
+        m_patchStart = m_nextStreamTime;
+    }
+
+    bool last = m_repeat + 1 == patch.dwellFrames;
+    {
+        // Listed before scheduling so the completion always finds it
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queued.push_back({m_packed, m_patchStart, m_nextStreamTime, m_patchIndex, m_pass, last});
+    }
+    int err = m_schedule(m_packed, m_nextStreamTime);
+    if (err) {
+        bool queuedBefore = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto failed = std::find_if(m_queued.rbegin(), m_queued.rend(), [this](const QueuedFrame& queued) {
+                return queued.frame == m_packed && queued.streamTime == m_nextStreamTime;
+            });
+            if (failed != m_queued.rend()) {
+                m_queued.erase(std::next(failed).base());
+            }
+            // An earlier showing of the patch still queued gives the frame back
+            auto earlier = std::find_if(m_queued.rbegin(), m_queued.rend(), [this](const QueuedFrame& queued) {
+                return queued.frame == m_packed && queued.patchIndex == m_patchIndex && queued.pass == m_pass;
+            });
+            if (earlier != m_queued.rend()) {
+                earlier->lastOfPatch = true;
+                queuedBefore = true;
+            }
+        }
+        if (!queuedBefore) {
+            m_recycle(m_packed);
+        }
+        m_packed = nullptr;
+        return err;
+    }
+    m_nextStreamTime += m_frameDuration;
+
+    if (!last) {
+        m_repeat++;
+        return 0;
+    }
+    m_packed = nullptr;
+    m_repeat = 0;
+    if (++m_patchIndex == static_cast<int>(m_patches.size())) {
+        m_patchIndex = 0;
+        m_pass++;
+        if (!m_loop) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_fedAll = true;
+        }
+    }
+    return 0;
+}
+
+void PatchSequence::finishLocked() {
+    m_running = false;
+    m_wake.notify_all();
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "DeckLinkAPI.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// One entry of a sequence uploaded with decklink_load_sequence(): a solid
+// color, or an RGB image when image is set, shown for dwellFrames frames
+struct SequencePatch
+{
+    const uint16_t *image; // width * height * 3 values, or null for a solid color
+    uint16_t rgb[3];       // solid color, used when image is null
+    int32_t dwellFrames;
+};
+
+// Reported by decklink_wait_sequence_event() once the last frame of a patch
+// has left the screen
+struct SequenceEvent
+{
+    int64_t startTime;           // stream time the patch went on screen
+    int64_t endTime;             // stream time it was replaced
+    int64_t timeScale;           // units of startTime and endTime per second
+    int64_t completionTimestamp; // hardware reference time in ns, 0 if unavailable
+    int32_t patchIndex;
+    int32_t pass;   // how often the sequence had looped before this patch
+    int32_t result; // BMDOutputFrameCompletionResult of the patch's last frame
+};
+
+// Playback state reported by decklink_get_sequence_status()
+struct SequenceStatus
+{
+    uint64_t completedPatches;
+    uint64_t lateFrames;
+    uint64_t droppedFrames;
+    uint64_t eventsDropped; // events lost because nobody read them in time
+    int32_t patchCount;
+    int32_t running;      // 1 until the last patch completed or stop()
+    int32_t queuedFrames; // frames handed to the hardware and not completed yet
+    int32_t lastError;    // code of a failed pack or schedule, 0 if none
+};
+
+// A list of patches played out by the library on scheduled frame timing.
+// start() packs each patch once and queues one scheduled frame per frame of
+// its dwell time, so a patch is on screen for exactly dwellFrames frames. A
+// feeder thread keeps a few frames queued ahead of scanout and packs the
+// next patch while the current one dwells, so the caller only waits for
+// events. Completions come back from the driver through frameCompleted(),
+// which also returns each packed frame once its last showing completed.
+class PatchSequence
+{
+public:
+    // Packs a solid color or an image (image may be null) into a frame the
+    // sequence then owns
+    using PackFunction = std::function<int(const uint16_t *, const uint16_t *, IDeckLinkMutableVideoFrame **)>;
+    // Queues one frame duration of a frame at the given stream time
+    using ScheduleFunction = std::function<int(IDeckLinkMutableVideoFrame *, BMDTimeValue)>;
+    // Gives a packed frame back once nothing shows it any more
+    using RecycleFunction = std::function<void(IDeckLinkVideoFrame *)>;
+
+    PatchSequence(PackFunction pack, ScheduleFunction schedule, RecycleFunction recycle);
+    ~PatchSequence();
+
+    PatchSequence(const PatchSequence &) = delete;
+    PatchSequence &operator=(const PatchSequence &) = delete;
+
+    int load(int width, int height, const SequencePatch *patches, int count);
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    bool empty() const { return m_patches.empty(); }
+
+    // Queues the first frames on the calling thread, then hands over to the
+    // feeder thread. Playback itself is started by the caller.
+    int start(bool loop, BMDTimeValue startTime, BMDTimeValue frameDuration, BMDTimeScale timeScale,
+              size_t queueDepth);
+    // Stops feeding; frames already queued complete or are flushed as usual
+    void stop();
+    bool running() const;
+
+    // Driver side. Returns false if the frame was not queued by the sequence.
+    bool frameCompleted(IDeckLinkVideoFrame *frame, BMDOutputFrameCompletionResult result,
+                        BMDTimeValue completionTimestamp);
+    // Forgets queued frames once the output that held them is gone
+    void dropQueuedFrames();
+
+    // Returns 0 with the oldest event, -1 once the sequence ended and every
+    // event was read, -3 on timeout
+    int waitEvent(SequenceEvent &event, std::chrono::milliseconds timeout);
+    SequenceStatus status() const;
+
+private:
+    static constexpr size_t kMaxEvents = 1024;
+
+    struct Patch
+    {
+        std::vector<uint16_t> image;
+        uint16_t rgb[3];
+        int dwellFrames;
+    };
+
+    // One scheduled showing of a packed frame, in the order it was queued
+    struct QueuedFrame
+    {
+        IDeckLinkMutableVideoFrame *frame;
+        BMDTimeValue patchStart;
+        BMDTimeValue streamTime;
+        int patchIndex;
+        int pass;
+        bool lastOfPatch;
+    };
+
+    void feedLoop();
+    int queueNextFrame();
+    void finishLocked();
+
+    PackFunction m_pack;
+    ScheduleFunction m_schedule;
+    RecycleFunction m_recycle;
+
+    int m_width;
+    int m_height;
+    std::vector<Patch> m_patches;
+
+    // Feeder position, only touched by the thread that is feeding
+    bool m_loop;
+    size_t m_queueDepth;
+    BMDTimeValue m_frameDuration;
+    BMDTimeScale m_timeScale;
+    BMDTimeValue m_nextStreamTime;
+    BMDTimeValue m_patchStart;
+    IDeckLinkMutableVideoFrame *m_packed;
+    int m_patchIndex;
+    int m_pass;
+    int m_repeat;
+    bool m_fedAll;
+
+    // Shared with the driver's completion thread, guarded by m_mutex
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<QueuedFrame> m_queued;
+    std::deque<SequenceEvent> m_events;
+    bool m_running;
+    bool m_stopping;
+    uint64_t m_completedPatches;
+    uint64_t m_lateFrames;
+    uint64_t m_droppedFrames;
+    uint64_t m_eventsDropped;
+    int m_lastError;
+
+    std::thread m_feedThread;
+};
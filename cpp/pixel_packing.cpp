@@ -1,84 +1,127 @@
 #include "pixel_packing.h"
+#include "pixel_packing_simd.h"
+#include "worker_pool.h"
+#include "logger.h"
 #include <algorithm>
-#include <iostream>
 #include <cstring>
-#include <vector>
 #include <bit>
-#include <numeric>
+#include <cmath>
 #include <cstdint>
+#include <map>
+#include <vector>
 
 /*
  * Pixel Packing for Blackmagic DeckLink API
  * 
  * This file contains the implementation of various pixel packing schemes
- * used by Blackmagic DeckLink devices. Each function handles the specific
- * bit depth and packing requirements per the DeckLink SDK documentation
- * section 3.4.
+ * used by Blackmagic DeckLink devices. Each format's traits struct handles
+ * the specific bit depth and packing requirements per the DeckLink SDK
+ * documentation section 3.4.
  * 
  * INPUT RANGES:
  * - 8-bit functions: Expect 8-bit values (0-255) in a 16-bit container
  * - 10-bit functions: Expect 10-bit values (0-1023) in a 16-bit container
  * - 12-bit function: Expect 12-bit values (0-4095) in a 16-bit container
  * 
- * All functions include range checking and will clamp values to valid ranges.
+ * All packers include range checking and will clamp values to valid ranges.
  * These functions are focused purely on packing existing image data.
  * Specifically, the YUV packing functions simply pack the data, they do not
- * perform any RGB to YUV conversion
+ * perform any RGB to YUV conversion: their source triples are Y, Cb, Cr.
  */
 
-/**
- * Pack 8-bit RGB image data into BGRA/ARGB format
+/*
+ * Each pixel format is a traits struct describing one packing group: how
+ * many pixels it holds, how many 32-bit words it packs into and in which
+ * byte order those words are stored, plus packGroup() building the words
+ * from already loaded components. pack_band<Format, Range>() turns a traits
+ * struct into a complete row loop, so every format compiles to its own
+ * straight-line loop with no per-pixel flags, and adding a format means
+ * adding a traits struct and a kPackers entry.
  * 
- * Packs existing 8-bit RGB image data into BGRA or ARGB format.
+ * Traits members:
+ * - kPixelFormat, kMaxValue: the SDK format and the largest component value
+ * - kYCbCrBitDepth: bit depth of a 4:2:2 Y'CbCr format, 0 for RGB formats
+ * - kPixelsPerGroup, kWordsPerGroup, kWordOrder: group geometry
+ * - kPadPartialGroup: whether a trailing partial group is written in full
+ *   (zero padded) or only up to its last pixel
+ * - kSimdKernel: optional vector row kernel (see pixel_packing_simd.h)
+ * - SimdBase, fromSimdBaseWord(): optional; reuse another format's kernel
+ *   and convert its words in place while they are still in cache
+ */
+
+// Whether source components have to be clamped before packing. InRange is
+// used for rows produced internally that are already clamped to kMaxValue.
+enum class SourceRange
+{
+    Clamp,
+    InRange,
+};
+
+static inline uint32_t byteswap32(uint32_t value) {
+#if defined(__cpp_lib_byteswap)
+    return std::byteswap(value);
+#else
+    return __builtin_bswap32(value);
+#endif
+}
+
+template <std::endian Order>
+static inline void store_word(uint8_t* dest, uint32_t value) {
+    if constexpr (Order != std::endian::native) value = byteswap32(value);
+    std::memcpy(dest, &value, sizeof(value));
+}
+
+template <std::endian Order>
+static inline uint32_t load_word(const uint8_t* src) {
+    uint32_t value;
+    std::memcpy(&value, src, sizeof(value));
+    if constexpr (Order != std::endian::native) value = byteswap32(value);
+    return value;
+}
+
+/**
+ * bmdFormat8BitBGRA : 'BGRA' 4:4:4:4 raw
  * 
- * @param destData Pointer to destination frame buffer
- * @param srcR Pointer to source red channel data (8-bit, 0-255)
- * @param srcG Pointer to source green channel data (8-bit, 0-255)
- * @param srcB Pointer to source blue channel data (8-bit, 0-255)
- * @param width Frame width in pixels
- * @param height Frame height in pixels
- * @param rowBytes Bytes per row (including padding)
- * @param isBGRA true for BGRA format, false for ARGB format
+ * One little-endian word per pixel, AARRGGBB, so the bytes read B G R A.
+ * Alpha is always opaque.
  */
-void pack_8bpc_rgb_image(
-    void* destData,
-    const uint16_t* srcR, const uint16_t* srcG, const uint16_t* srcB,
-    uint16_t width, uint16_t height,
-    uint16_t rowBytes,
-    bool isBGRA) {
-    /*
-     * Pack 8-bit RGB image data into BGRA/ARGB format
-     * 
-     * Packs existing 8-bit RGB image data into BGRA or ARGB format.
-     */
+struct FormatBGRA
+{
+    static constexpr BMDPixelFormat kPixelFormat = bmdFormat8BitBGRA;
+    static constexpr uint16_t kMaxValue = 0xFF;
+    static constexpr int kYCbCrBitDepth = 0;
+    static constexpr int kPixelsPerGroup = 1;
+    static constexpr int kWordsPerGroup = 1;
+    static constexpr std::endian kWordOrder = std::endian::little;
+    static constexpr bool kPadPartialGroup = false;
+    static constexpr PackRowKernel SimdRowKernels::*kSimdKernel = nullptr;
     
-    uint32_t* pixels = static_cast<uint32_t*>(destData);
-    
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            int srcIndex = y * width + x;
-            int destIndex = y * (rowBytes / 4) + x;
-            
-            uint8_t r = srcR[srcIndex];
-            uint8_t g = srcG[srcIndex];
-            uint8_t b = srcB[srcIndex];
-            
-            uint32_t color;
-            if (isBGRA) {
-                // BGRA format: AABBGGRR
-                color = (0xFF << 24) | (r << 16) | (g << 8) | b;
-            } else {
-                // ARGB format: AARRGGBB  
-                color = (0xFF << 24) | (b << 16) | (g << 8) | r;
-            }
-            
-            pixels[destIndex] = color;
-        }
+    static void packGroup(uint32_t* words, const uint32_t (*px)[3]) {
+        words[0] = (0xFFu << 24) | (px[0][0] << 16) | (px[0][1] << 8) | px[0][2];
     }
+};
+
+/**
+ * bmdFormat8BitARGB : 'ARGB' 4:4:4:4 raw
+ * 
+ * One little-endian word per pixel with R in the low byte and B in bits
+ * 16-23. Alpha is always opaque.
+ */
+struct FormatARGB
+{
+    static constexpr BMDPixelFormat kPixelFormat = bmdFormat8BitARGB;
+    static constexpr uint16_t kMaxValue = 0xFF;
+    static constexpr int kYCbCrBitDepth = 0;
+    static constexpr int kPixelsPerGroup = 1;
+    static constexpr int kWordsPerGroup = 1;
+    static constexpr std::endian kWordOrder = std::endian::little;
+    static constexpr bool kPadPartialGroup = false;
+    static constexpr PackRowKernel SimdRowKernels::*kSimdKernel = nullptr;
     
-    std::cerr << "[PixelPacking] 8-bit RGB image packed: " << width << "x" << height 
-              << " into " << (isBGRA ? "BGRA" : "ARGB") << " format" << std::endl;
-}
+    static void packGroup(uint32_t* words, const uint32_t (*px)[3]) {
+        words[0] = (0xFFu << 24) | (px[0][2] << 16) | (px[0][1] << 8) | px[0][0];
+    }
+};
 
 /**
  * bmdFormat10BitRGB : 'r210' 4:4:4 raw
@@ -96,54 +139,59 @@ void pack_8bpc_rgb_image(
  * 
  * For the frame size calculation, the row bytes are simply multiplied by the
  * number of rows in the frame. 
+ */
+struct FormatR210
+{
+    static constexpr BMDPixelFormat kPixelFormat = bmdFormat10BitRGB;
+    static constexpr uint16_t kMaxValue = 0x3FF;
+    static constexpr int kYCbCrBitDepth = 0;
+    static constexpr int kPixelsPerGroup = 1;
+    static constexpr int kWordsPerGroup = 1;
+    static constexpr std::endian kWordOrder = std::endian::big;
+    static constexpr bool kPadPartialGroup = false;
+    static constexpr PackRowKernel SimdRowKernels::*kSimdKernel = &SimdRowKernels::pack10BitRGB;
+    
+    // Pack using Blackmagic's reference implementation in ColorBars.cpp
+    // Refer to DeckLink SDK Manual, section 2.7.4 for packing structure:
+    // R, G, B from the most significant bits, the top 2 bits are unused
+    static void packGroup(uint32_t* words, const uint32_t (*px)[3]) {
+        words[0] = (px[0][0] << 20) | (px[0][1] << 10) | px[0][2];
+    }
+};
+
+/**
+ * bmdFormat10BitRGBX : 'R10b' and bmdFormat10BitRGBXLE : 'R10l'
  * 
- * @param destData Pointer to destination frame buffer
- * @param srcR Pointer to source red channel data (10-bit, 0-1023)
- * @param srcG Pointer to source green channel data (10-bit, 0-1023)
- * @param srcB Pointer to source blue channel data (10-bit, 0-1023)
- * @param width Frame width in pixels
- * @param height Frame height in pixels
- * @param rowBytes Bytes per row (including padding)
+ * Three 10-bit components in the top 30 bits of a 32-bit word, R in bits
+ * 22-31, G in 12-21 and B in 2-11, with two padding bits at the bottom.
+ * R10b stores the word big-endian, R10l little-endian. Rows are aligned to
+ * 256 bytes like r210.
+ * 
+ * The word is the r210 word shifted left by two, so both reuse the r210
+ * vector kernel.
  */
-void pack_10bpc_rgb_image(
-    void* destData,
-    const uint16_t* srcR, const uint16_t* srcG, const uint16_t* srcB,
-    uint16_t width, uint16_t height,
-    uint16_t rowBytes) {
+template <BMDPixelFormat PixelFormat, std::endian Order>
+struct FormatR10x
+{
+    static constexpr BMDPixelFormat kPixelFormat = PixelFormat;
+    static constexpr uint16_t kMaxValue = 0x3FF;
+    static constexpr int kYCbCrBitDepth = 0;
+    static constexpr int kPixelsPerGroup = 1;
+    static constexpr int kWordsPerGroup = 1;
+    static constexpr std::endian kWordOrder = Order;
+    static constexpr bool kPadPartialGroup = false;
     
-    uint32_t* pixels = static_cast<uint32_t*>(destData);
+    using SimdBase = FormatR210;
+    static constexpr PackRowKernel SimdRowKernels::*kSimdKernel = SimdBase::kSimdKernel;
+    static uint32_t fromSimdBaseWord(uint32_t word) { return word << 2; }
     
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            int srcIndex = y * width + x;
-            int destIndex = y * (rowBytes / 4) + x;
-            
-            uint16_t r = srcR[srcIndex];
-            uint16_t g = srcG[srcIndex];
-            uint16_t b = srcB[srcIndex];
-            
-            // Pack using Blackmagic's reference implementation in ColorBars.cpp
-            // Refer to DeckLink SDK Manual, section 2.7.4 for packing structure
-            uint32_t r_10 = r & 0x3FF;
-            uint32_t g_10 = g & 0x3FF;
-            uint32_t b_10 = b & 0x3FF;
-            
-            // r210 is big-endian, so we pack the 10-bit components into a 32-bit integer
-            // in R, G, B order from the most significant bits. The top 2 bits are unused.
-            uint32_t pixel = (r_10 << 20) | (g_10 << 10) | b_10;
-            
-            // If the system is little-endian, we need to byte-swap the result.
-            if (std::endian::native == std::endian::little) {
-                pixel = ((pixel & 0xFF000000) >> 24) | ((pixel & 0x00FF0000) >> 8) | ((pixel & 0x0000FF00) << 8) | ((pixel & 0x000000FF) << 24);
-            }
-
-            pixels[destIndex] = pixel;
-        }
+    static void packGroup(uint32_t* words, const uint32_t (*px)[3]) {
+        words[0] = (px[0][0] << 22) | (px[0][1] << 12) | (px[0][2] << 2);
     }
-    
-    std::cerr << "[PixelPacking] big-endian 10-bit RGB image packed: "
-              << width << "x" << height << std::endl;
-}
+};
+
+using FormatR10l = FormatR10x<bmdFormat10BitRGBXLE, std::endian::little>;
+using FormatR10b = FormatR10x<bmdFormat10BitRGBX, std::endian::big>;
 
 /**
  * bmdFormat12BitRGBLE : 'R12L'
@@ -157,124 +205,754 @@ void pack_10bpc_rgb_image(
  * int framesize = ((Width * 36) / 8) * Height
  *               = rowBytes * Height
  * 
- * In this format, 8 pixels fit into 36 bytes.
- *
- * @param destData Pointer to destination frame buffer
- * @param srcR Pointer to source red channel data (12-bit, 0-4095)
- * @param srcG Pointer to source green channel data (12-bit, 0-4095)
- * @param srcB Pointer to source blue channel data (12-bit, 0-4095)
+ * In this format, 8 pixels fit into 36 bytes. A trailing partial group at the
+ * end of a row is padded with black.
+ */
+struct FormatR12L
+{
+    static constexpr BMDPixelFormat kPixelFormat = bmdFormat12BitRGBLE;
+    static constexpr uint16_t kMaxValue = 0xFFF;
+    static constexpr int kYCbCrBitDepth = 0;
+    static constexpr int kPixelsPerGroup = 8;
+    static constexpr int kWordsPerGroup = 9;
+    static constexpr std::endian kWordOrder = std::endian::little;
+    static constexpr bool kPadPartialGroup = true;
+    static constexpr PackRowKernel SimdRowKernels::*kSimdKernel = &SimdRowKernels::pack12BitRGBLE;
+    
+    // Based on Blackmagic's reference implementation in ColorBars.cpp. Shifts
+    // into the top bits of a word drop the bits carried into the next word.
+    static void packGroup(uint32_t* words, const uint32_t (*px)[3]) {
+        words[0] = (px[0][2] << 24) | (px[0][1] << 12) | px[0][0];
+        words[1] = (px[1][2] << 28) | (px[1][1] << 16) | (px[1][0] << 4) | (px[0][2] >> 8);
+        words[2] = (px[2][1] << 20) | (px[2][0] << 8) | (px[1][2] >> 4);
+        words[3] = (px[3][1] << 24) | (px[3][0] << 12) | px[2][2];
+        words[4] = (px[4][1] << 28) | (px[4][0] << 16) | (px[3][2] << 4) | (px[3][1] >> 8);
+        words[5] = (px[5][0] << 20) | (px[4][2] << 8) | (px[4][1] >> 4);
+        words[6] = (px[6][0] << 24) | (px[5][2] << 12) | px[5][1];
+        words[7] = (px[7][0] << 28) | (px[6][2] << 16) | (px[6][1] << 4) | (px[6][0] >> 8);
+        words[8] = (px[7][2] << 20) | (px[7][1] << 8) | (px[7][0] >> 4);
+    }
+};
+
+/**
+ * bmdFormat12BitRGB : 'R12B'
+ * 
+ * Big-endian RGB 12-bit per component with full range (0-4095). The 36-byte
+ * group of 8 pixels holds the same nine 32-bit words as R12L, each stored
+ * big-endian.
+ */
+struct FormatR12B : FormatR12L
+{
+    static constexpr BMDPixelFormat kPixelFormat = bmdFormat12BitRGB;
+    static constexpr std::endian kWordOrder = std::endian::big;
+    
+    using SimdBase = FormatR12L;
+    static uint32_t fromSimdBaseWord(uint32_t word) { return word; }
+};
+
+/*
+ * 4:2:2 Y'CbCr formats
+ * 
+ * The source holds one Y'CbCr triple per pixel (Y, Cb, Cr in place of R, G,
+ * B). Each pair of pixels shares the chroma of its first pixel (co-sited
+ * with the even luma sample, as in Rec. 709 and Rec. 2020). A trailing
+ * odd pixel or partial group at the end of a row is padded with zeros.
+ */
+
+/**
+ * bmdFormat8BitYUV : '2vuy' 4:2:2
+ * 
+ * Two pixels in four bytes: Cb0 Y0 Cr0 Y1. rowBytes = width * 2.
+ */
+struct Format2vuy
+{
+    static constexpr BMDPixelFormat kPixelFormat = bmdFormat8BitYUV;
+    static constexpr uint16_t kMaxValue = 0xFF;
+    static constexpr int kYCbCrBitDepth = 8;
+    static constexpr int kPixelsPerGroup = 2;
+    static constexpr int kWordsPerGroup = 1;
+    static constexpr std::endian kWordOrder = std::endian::little;
+    static constexpr bool kPadPartialGroup = true;
+    static constexpr PackRowKernel SimdRowKernels::*kSimdKernel = nullptr;
+    
+    static void packGroup(uint32_t* words, const uint32_t (*px)[3]) {
+        words[0] = px[0][1] | (px[0][0] << 8) | (px[0][2] << 16) | (px[1][0] << 24);
+    }
+};
+
+// Source value (pixel * 3 + component) behind each 10-bit field of the four
+// words of a v210 group: {bits 0-9, bits 10-19, bits 20-29}
+static constexpr int kV210Fields[4][3] = {
+    {1, 0, 2},    // Cb0 Y0 Cr0
+    {3, 7, 6},    // Y1 Cb2 Y2
+    {8, 9, 13},   // Cr2 Y3 Cb4
+    {12, 14, 15}, // Y4 Cr4 Y5
+};
+
+/**
+ * bmdFormat10BitYUV : 'v210' 4:2:2
+ * 
+ * Six pixels in four little-endian 32-bit words (16 bytes), three 10-bit
+ * components per word:
+ * 
+ *   Cb0 Y0 Cr0 | Y1 Cb2 Y2 | Cr2 Y3 Cb4 | Y4 Cr4 Y5
+ * 
+ * int rowBytes = ((Width + 47) / 48) * 128
+ */
+struct FormatV210
+{
+    static constexpr BMDPixelFormat kPixelFormat = bmdFormat10BitYUV;
+    static constexpr uint16_t kMaxValue = 0x3FF;
+    static constexpr int kYCbCrBitDepth = 10;
+    static constexpr int kPixelsPerGroup = 6;
+    static constexpr int kWordsPerGroup = 4;
+    static constexpr std::endian kWordOrder = std::endian::little;
+    static constexpr bool kPadPartialGroup = true;
+    static constexpr PackRowKernel SimdRowKernels::*kSimdKernel = &SimdRowKernels::pack10BitYUV;
+    
+    static void packGroup(uint32_t* words, const uint32_t (*px)[3]) {
+        const uint32_t* values = px[0];
+        for (int word = 0; word < 4; word++) {
+            words[word] = values[kV210Fields[word][0]] |
+                          (values[kV210Fields[word][1]] << 10) |
+                          (values[kV210Fields[word][2]] << 20);
+        }
+    }
+};
+
+/**
+ * bmdFormat10BitYUVA : 'Ay10' 4:2:2 with alpha
+ * 
+ * One little-endian 32-bit word per pixel holding its chroma sample, luma
+ * and alpha at bits 0, 10 and 20. Even pixels carry Cb and odd pixels Cr of
+ * the pair, so a pair reads Cb0 Y0 A0 | Cr0 Y1 A1. Alpha is always opaque.
+ */
+struct FormatAy10
+{
+    static constexpr BMDPixelFormat kPixelFormat = bmdFormat10BitYUVA;
+    static constexpr uint16_t kMaxValue = 0x3FF;
+    static constexpr int kYCbCrBitDepth = 10;
+    static constexpr int kPixelsPerGroup = 2;
+    static constexpr int kWordsPerGroup = 2;
+    static constexpr std::endian kWordOrder = std::endian::little;
+    static constexpr bool kPadPartialGroup = false;
+    static constexpr PackRowKernel SimdRowKernels::*kSimdKernel = nullptr;
+    
+    static void packGroup(uint32_t* words, const uint32_t (*px)[3]) {
+        const uint32_t alpha = 0x3FFu << 20;
+        words[0] = px[0][1] | (px[0][0] << 10) | alpha;
+        words[1] = px[0][2] | (px[1][0] << 10) | alpha;
+    }
+};
+
+// Loads, clamps and packs one group of `pixels` pixels, zero-filling past the
+// row end. Full groups pass kPixelsPerGroup, which folds the checks away.
+template <typename Format, SourceRange Range>
+static inline void pack_group(uint8_t* dest, const uint16_t* src, int pixels) {
+    uint32_t px[Format::kPixelsPerGroup][3];
+    for (int i = 0; i < Format::kPixelsPerGroup; i++) {
+        for (int c = 0; c < 3; c++) {
+            uint32_t value = i < pixels ? src[i * 3 + c] : 0;
+            if constexpr (Range == SourceRange::Clamp) {
+                value = std::min<uint32_t>(value, Format::kMaxValue);
+            }
+            px[i][c] = value;
+        }
+    }
+    
+    uint32_t words[Format::kWordsPerGroup];
+    Format::packGroup(words, px);
+    
+    int wordCount = Format::kWordsPerGroup;
+    if (!Format::kPadPartialGroup && pixels < Format::kPixelsPerGroup) {
+        wordCount = pixels * Format::kWordsPerGroup / Format::kPixelsPerGroup;
+    }
+    for (int w = 0; w < wordCount; w++) {
+        store_word<Format::kWordOrder>(dest + w * 4, words[w]);
+    }
+}
+
+/**
+ * @brief Packs a band of rows of interleaved source triples into one format
+ * 
+ * @param destData Pointer to the first destination row
+ * @param srcData Pointer to interleaved source data (3 uint16_t per pixel)
  * @param width Frame width in pixels
- * @param height Frame height in pixels
- * @param rowBytes Bytes per row (including padding)
+ * @param height Number of rows in the band
+ * @param rowBytes Bytes per destination row (including padding)
  */
-void pack_12bpc_rgble_image(
+template <typename Format, SourceRange Range>
+static void pack_band(
     void* destData,
-    const uint16_t* srcR, const uint16_t* srcG, const uint16_t* srcB,
+    const uint16_t* srcData,
     uint16_t width, uint16_t height,
     uint16_t rowBytes) {
     
-    uint32_t* pixels = static_cast<uint32_t*>(destData);
+    constexpr int kGroupPixels = Format::kPixelsPerGroup;
+    constexpr int kGroupBytes = Format::kWordsPerGroup * 4;
     
-    if (std::endian::native != std::endian::little) {
-        std::cerr << "[PixelPacking] System is not little endian, but 12b packing implementation likely depends on it for byte ordering. Proceed with caution" << std::endl;
-    } 
-
-    std::cerr << "[PixelPacking] Packing little-endian 12-bit RGB image: " << width << "x"
-              << height << ", rowBytes: " << rowBytes << std::endl;
+    uint8_t* dest = static_cast<uint8_t*>(destData);
+    PackRowKernel simdKernel = nullptr;
+    if constexpr (Format::kSimdKernel != nullptr) {
+        simdKernel = simd_row_kernels().*Format::kSimdKernel;
+    }
     
     for (int y = 0; y < height; y++) {
-        uint32_t* row = pixels + (y * (rowBytes / 4));
-        for (int x = 0; x < width; x += 8) {
-            uint32_t* groupPtr = row + ((x / 8) * 9);
-            // Based on Blackmagic's reference implementation in ColorBars.cpp
-            int base = y * width + x;
-            groupPtr[0] = ((srcB[base + 0] & 0x0FF) << 24) | ((srcG[base + 0] & 0xFFF) << 12) | (srcR[base + 0] & 0xFFF);
-            groupPtr[1] = ((srcB[base + 1] & 0x00F) << 28) | ((srcG[base + 1] & 0xFFF) << 16) | ((srcR[base + 1] & 0xFFF) << 4) | ((srcB[base + 0] & 0xF00) >> 8);
-            groupPtr[2] = ((srcG[base + 2] & 0xFFF) << 20) | ((srcR[base + 2] & 0xFFF) << 8) | ((srcB[base + 1] & 0xFF0) >> 4);
-            groupPtr[3] = ((srcG[base + 3] & 0x0FF) << 24) | ((srcR[base + 3] & 0xFFF) << 12) | (srcB[base + 2] & 0xFFF);
-            groupPtr[4] = ((srcG[base + 4] & 0x00F) << 28) | ((srcR[base + 4] & 0xFFF) << 16) | ((srcB[base + 3] & 0xFFF) << 4) | ((srcG[base + 3] & 0xF00) >> 8);
-            groupPtr[5] = ((srcR[base + 5] & 0xFFF) << 20) | ((srcB[base + 4] & 0xFFF) << 8) | ((srcG[base + 4] & 0xFF0) >> 4);
-            groupPtr[6] = ((srcR[base + 6] & 0x0FF) << 24) | ((srcB[base + 5] & 0xFFF) << 12) | (srcG[base + 5] & 0xFFF);
-            groupPtr[7] = ((srcR[base + 7] & 0x00F) << 28) | ((srcB[base + 6] & 0xFFF) << 16) | ((srcG[base + 6] & 0xFFF) << 4) | ((srcR[base + 6] & 0xF00) >> 8);
-            groupPtr[8] = ((srcB[base + 7] & 0xFFF) << 20) | ((srcG[base + 7] & 0xFFF) << 8) | ((srcR[base + 7] & 0xFF0) >> 4);
+        const uint16_t* src = srcData + static_cast<size_t>(y) * width * 3;
+        uint8_t* row = dest + static_cast<size_t>(y) * rowBytes;
+        
+        // Vector kernel packs whole groups, the scalar loop finishes the row
+        int x = simdKernel ? simdKernel(row, src, width) : 0;
+        uint8_t* out = row + (x / kGroupPixels) * kGroupBytes;
+        if constexpr (requires { typename Format::SimdBase; }) {
+            for (uint8_t* word = row; word < out; word += 4) {
+                uint32_t value = load_word<Format::SimdBase::kWordOrder>(word);
+                store_word<Format::kWordOrder>(word, Format::fromSimdBaseWord(value));
+            }
+        }
+        
+        src += x * 3;
+        for (; x + kGroupPixels <= width; x += kGroupPixels, src += kGroupPixels * 3, out += kGroupBytes) {
+            pack_group<Format, Range>(out, src, kGroupPixels);
+        }
+        if (x < width) {
+            pack_group<Format, Range>(out, src, width - x);
         }
     }
-    
-    std::cerr << "[PixelPacking] little-endian 12-bit RGB image packed successfully" << std::endl;
 }
 
-// Clamp a channel buffer to a given bit depth
-static void clamp_channel(std::vector<uint16_t>& channel, int bits) {
-    uint16_t maxval = (1u << bits) - 1;
-    for (auto& v : channel) {
-        if (v > maxval) v = maxval;
+// Frames smaller than this are packed on the calling thread; below it the
+// hand-off to the workers costs more than it saves
+static constexpr size_t kParallelMinPixels = 256 * 1024;
+static constexpr int kMinRowsPerBand = 16;
+
+typedef void (*PackBandFunction)(void* destData, const uint16_t* srcData,
+                                 uint16_t width, uint16_t height, uint16_t rowBytes);
+
+struct PackerEntry
+{
+    BMDPixelFormat pixelFormat;
+    PackBandFunction packBand;        // clamps every source component
+    PackBandFunction packInRangeBand; // source already within the format's range
+    int ycbcrBitDepth;                // 0 for RGB formats
+    int pixelsPerGroup;               // pixels packed together into groupBytes
+    int groupBytes;
+    int maxValue;                     // largest source component value
+};
+
+template <typename Format>
+static constexpr PackerEntry make_packer_entry() {
+    return {Format::kPixelFormat,
+            pack_band<Format, SourceRange::Clamp>,
+            pack_band<Format, SourceRange::InRange>,
+            Format::kYCbCrBitDepth,
+            Format::kPixelsPerGroup,
+            Format::kWordsPerGroup * 4,
+            Format::kMaxValue};
+}
+
+static constexpr PackerEntry kPackers[] = {
+    make_packer_entry<FormatBGRA>(),
+    make_packer_entry<FormatARGB>(),
+    make_packer_entry<FormatR210>(),
+    make_packer_entry<FormatR12L>(),
+    make_packer_entry<FormatR12B>(),
+    make_packer_entry<FormatR10l>(),
+    make_packer_entry<FormatR10b>(),
+    make_packer_entry<Format2vuy>(),
+    make_packer_entry<FormatV210>(),
+    make_packer_entry<FormatAy10>(),
+};
+
+// Band packer plus the optional LUT and RGB to Y'CbCr stages in front of it.
+// With either stage, rows are transformed one at a time into scratch rows
+// that stay in cache and packed from there. Transformed rows are clamped
+// already, so they go through the format's InRange packer.
+struct BandPacker
+{
+    PackBandFunction packBand;
+    bool convert;
+    YCbCrCoefficients coefficients;
+    const ColorLut* lut;
+    int maxValue;
+    
+    bool transforms() const { return convert || lut; }
+    
+    // Runs the stages over one row; returns the row to pack from
+    const uint16_t* transformRow(const uint16_t* src, int width) const {
+        thread_local std::vector<uint16_t> lutScratch;
+        thread_local std::vector<uint16_t> convertScratch;
+        if (lut) {
+            lutScratch.resize(static_cast<size_t>(width) * 3);
+            lut->applyRow(src, lutScratch.data(), width, maxValue);
+            src = lutScratch.data();
+        }
+        if (convert) {
+            convertScratch.resize(static_cast<size_t>(width) * 3);
+            convert_rgb_row_to_ycbcr(src, convertScratch.data(), width, coefficients);
+            src = convertScratch.data();
+        }
+        return src;
+    }
+    
+    void operator()(void* destData, const uint16_t* srcData,
+                    uint16_t width, uint16_t height, uint16_t rowBytes) const {
+        if (!transforms()) {
+            packBand(destData, srcData, width, height, rowBytes);
+            return;
+        }
+        uint8_t* dest = static_cast<uint8_t*>(destData);
+        for (int y = 0; y < height; y++) {
+            const uint16_t* row = transformRow(srcData + static_cast<size_t>(y) * width * 3, width);
+            packBand(dest + static_cast<size_t>(y) * rowBytes, row, width, 1, rowBytes);
+        }
     }
+};
+
+// Returns the kPackers entry of a pixel format, or nullptr if unsupported
+static const PackerEntry* find_packer(BMDPixelFormat pixelFormat) {
+    for (const PackerEntry& entry : kPackers) {
+        if (entry.pixelFormat == pixelFormat) return &entry;
+    }
+    LOG_ERROR("[DeckLink] Unsupported pixel format: 0x" << std::hex << pixelFormat << std::dec);
+    return nullptr;
 }
 
-// Clamp all channels to a given bit depth
-static void clamp_image_channels(std::vector<uint16_t>& r, std::vector<uint16_t>& g, std::vector<uint16_t>& b, int bits) {
-    clamp_channel(r, bits);
-    clamp_channel(g, bits);
-    clamp_channel(b, bits);
+// The LUT is an RGB correction, so it is skipped for Y'CbCr sources
+static BandPacker make_band_packer(const PackerEntry& entry, const YCbCrConversion* rgbToYCbCr,
+                                   const ColorLut* lut) {
+    BandPacker packer = {entry.packBand, false, {}, nullptr, entry.maxValue};
+    if (rgbToYCbCr && rgbToYCbCr->matrix != YCbCrMatrix::None && entry.ycbcrBitDepth > 0) {
+        packer.packBand = entry.packInRangeBand;
+        packer.convert = true;
+        packer.coefficients = make_ycbcr_coefficients(rgbToYCbCr->matrix, rgbToYCbCr->fullRange,
+                                                      rgbToYCbCr->chromaFilter, entry.ycbcrBitDepth);
+    }
+    if (lut && (entry.ycbcrBitDepth == 0 || packer.convert)) {
+        packer.packBand = entry.packInRangeBand;
+        packer.lut = lut;
+    }
+    return packer;
 }
 
+/**
+ * @brief Packs one frame, splitting it into row bands across the worker pool
+ * 
+ * Every supported format packs each row independently of the others, so a
+ * band is just a sub-frame starting at a row offset in both buffers. Bands
+ * are kept at least kMinRowsPerBand rows tall, and small frames are packed
+ * on the calling thread.
+ * 
+ * With rgbToYCbCr set, RGB sources of the Y'CbCr formats are converted row
+ * by row inside each band, so the frame is still read and written once.
+ * 
+ * @return int Returns 0 on success, -8 for an unsupported pixel format
+ */
 int pack_pixel_format(
     void* destData,
     BMDPixelFormat pixelFormat,
     const uint16_t* srcData,
     uint16_t width, uint16_t height,
-    uint16_t rowBytes
+    uint16_t rowBytes,
+    const YCbCrConversion* rgbToYCbCr,
+    const ColorLut* lut
+ ) {
+    // Source is interleaved RGB (3 uint16_t per pixel); each packer clamps
+    // inline while streaming straight into the destination buffer
+    const PackerEntry* packer = find_packer(pixelFormat);
+    if (!packer) return -8;
+    BandPacker packBand = make_band_packer(*packer, rgbToYCbCr, lut);
+    
+    WorkerPool& pool = WorkerPool::instance();
+    int bands = 1;
+    if (static_cast<size_t>(width) * height >= kParallelMinPixels) {
+        bands = std::clamp(height / kMinRowsPerBand, 1, pool.threadCount());
+    }
+    
+    if (bands == 1) {
+        packBand(destData, srcData, width, height, rowBytes);
+    } else {
+        int rowsPerBand = (height + bands - 1) / bands;
+        uint8_t* dest = static_cast<uint8_t*>(destData);
+        pool.run(bands, [=](int band) {
+            int firstRow = band * rowsPerBand;
+            int lastRow = std::min<int>(height, firstRow + rowsPerBand);
+            if (firstRow >= lastRow) return;
+            packBand(dest + static_cast<size_t>(firstRow) * rowBytes,
+                     srcData + static_cast<size_t>(firstRow) * width * 3,
+                     width, static_cast<uint16_t>(lastRow - firstRow), rowBytes);
+        });
+    }
+    
+    LOG_DEBUG("[PixelPacking] Packed " << width << "x" << height << " image, rowBytes: "
+              << rowBytes << ", bands: " << bands);
+    return 0;
+ }
+
+/**
+ * @brief Repacks one rectangle of a frame that holds the previous source
+ * 
+ * destData must already contain the packed previous source, and srcData is
+ * the full new source, which differs from the previous one only inside the
+ * rectangle. Every row the rectangle crosses is repacked from the first to
+ * the last packing group it touches (6 pixels for v210, 8 for R12L), so the
+ * cost follows the rectangle's size rather than the frame's. With
+ * rgbToYCbCr set the span also takes in the pixel pair to its right, since
+ * the triangle chroma filter reads one pixel into it, and each row is
+ * converted from one pair earlier so the filter sees the same neighbours as
+ * a full pack. The result matches pack_pixel_format() of the new source.
+ * 
+ * @return int Returns 0 on success, -8 for an unsupported pixel format
+ */
+int pack_pixel_region(
+    void* destData,
+    BMDPixelFormat pixelFormat,
+    const uint16_t* srcData,
+    uint16_t width, uint16_t height,
+    uint16_t rowBytes,
+    int regionX, int regionY, int regionWidth, int regionHeight,
+    const YCbCrConversion* rgbToYCbCr,
+    const ColorLut* lut
+ ) {
+    const PackerEntry* packer = find_packer(pixelFormat);
+    if (!packer) return -8;
+    BandPacker packBand = make_band_packer(*packer, rgbToYCbCr, lut);
+    
+    int64_t x0 = std::max<int64_t>(0, regionX);
+    int64_t x1 = std::min<int64_t>(width, static_cast<int64_t>(regionX) + std::max(regionWidth, 0));
+    int y0 = static_cast<int>(std::max<int64_t>(0, regionY));
+    int y1 = static_cast<int>(std::min<int64_t>(height, static_cast<int64_t>(regionY) + std::max(regionHeight, 0)));
+    if (x0 >= x1 || y0 >= y1) return 0;
+    if (packBand.convert) {
+        x1 = std::min<int64_t>(width, x1 + 1);
+    }
+    
+    // Widen to whole packing groups
+    const int group = packer->pixelsPerGroup;
+    x0 = x0 / group * group;
+    x1 = std::min<int64_t>(width, (x1 + group - 1) / group * group);
+    const int spanX = static_cast<int>(x0);
+    const uint16_t spanWidth = static_cast<uint16_t>(x1 - x0);
+    const size_t destOffset = static_cast<size_t>(x0 / group) * packer->groupBytes;
+    uint8_t* dest = static_cast<uint8_t*>(destData);
+    
+    auto packRows = [=](int firstRow, int lastRow) {
+        if (!packBand.transforms()) {
+            for (int y = firstRow; y < lastRow; y++) {
+                packBand.packBand(dest + static_cast<size_t>(y) * rowBytes + destOffset,
+                                  srcData + (static_cast<size_t>(y) * width + spanX) * 3, spanWidth, 1, rowBytes);
+            }
+            return;
+        }
+        // Y'CbCr groups hold whole pixel pairs, so spanX is even and the
+        // conversion can start one pair earlier to seed the filter
+        int convertX = packBand.convert ? std::max(0, spanX - 2) : spanX;
+        int convertWidth = static_cast<int>(x1) - convertX;
+        for (int y = firstRow; y < lastRow; y++) {
+            const uint16_t* row = packBand.transformRow(srcData + (static_cast<size_t>(y) * width + convertX) * 3,
+                                                        convertWidth);
+            packBand.packBand(dest + static_cast<size_t>(y) * rowBytes + destOffset,
+                              row + (spanX - convertX) * 3, spanWidth, 1, rowBytes);
+        }
+    };
+    
+    WorkerPool& pool = WorkerPool::instance();
+    int rows = y1 - y0;
+    int bands = 1;
+    if (static_cast<size_t>(spanWidth) * rows >= kParallelMinPixels) {
+        bands = std::clamp(rows / kMinRowsPerBand, 1, pool.threadCount());
+    }
+    if (bands == 1) {
+        packRows(y0, y1);
+    } else {
+        int rowsPerBand = (rows + bands - 1) / bands;
+        pool.run(bands, [=](int band) {
+            int firstRow = y0 + band * rowsPerBand;
+            int lastRow = std::min(y1, firstRow + rowsPerBand);
+            if (firstRow < lastRow) packRows(firstRow, lastRow);
+        });
+    }
+    
+    LOG_DEBUG("[PixelPacking] Repacked " << spanWidth << "x" << rows << " at " << spanX << "," << y0
+              << " of a " << width << "x" << height << " frame");
+    return 0;
+ }
+
+/**
+ * @brief Packs a frame made of flat or 2x2-tiled rectangles over a background
+ * 
+ * A row's packed bytes depend only on which rectangles cross it and on the
+ * row's parity inside each of them. That only changes where a rectangle
+ * starts or ends, so the rows between two such edges repeat every second
+ * row and are copied. Every distinct combination is packed once from a
+ * single generated source row, with each rectangle filling its own span, and
+ * later rows with the same combination are copied from the first one. A
+ * solid frame is packed as one row.
+ * 
+ * @return int Returns 0 on success, negative values on failure:
+ *         - -1: Invalid rectangle list
+ *         - -8: Unsupported pixel format
+ */
+int pack_rect_pattern(
+    void* destData,
+    BMDPixelFormat pixelFormat,
+    const uint16_t background[3],
+    const PatternRect* rects, int rectCount,
+    uint16_t width, uint16_t height,
+    uint16_t rowBytes,
+    const YCbCrConversion* rgbToYCbCr,
+    const ColorLut* lut
  ) {
-    // Extract RGB channels from the raw data (3 uint16_t per pixel: R, G, B)
-    std::vector<uint16_t> r_channel(width * height);
-    std::vector<uint16_t> g_channel(width * height);
-    std::vector<uint16_t> b_channel(width * height);
-    
-    for (int i = 0; i < width * height; i++) {
-        r_channel[i] = srcData[i * 3 + 0];
-        g_channel[i] = srcData[i * 3 + 1];
-        b_channel[i] = srcData[i * 3 + 2];
+    if (!background || rectCount < 0 || (rectCount > 0 && !rects)) return -1;
+    const PackerEntry* packer = find_packer(pixelFormat);
+    if (!packer) return -8;
+    BandPacker packBand = make_band_packer(*packer, rgbToYCbCr, lut);
+    
+    uint8_t* dest = static_cast<uint8_t*>(destData);
+    std::vector<uint16_t> rowSrc(static_cast<size_t>(width) * 3);
+    
+    // Rows where a rect starts or ends. Between two of them the same rects
+    // cross every row, so rows repeat with a period of two.
+    std::vector<int> breaks = {0, static_cast<int>(height)};
+    for (int i = 0; i < rectCount; i++) {
+        const PatternRect& rect = rects[i];
+        if (rect.width <= 0 || rect.height <= 0) continue;
+        int64_t top = rect.y;
+        int64_t bottom = top + rect.height;
+        breaks.push_back(static_cast<int>(std::clamp<int64_t>(top, 0, height)));
+        breaks.push_back(static_cast<int>(std::clamp<int64_t>(bottom, 0, height)));
+    }
+    std::sort(breaks.begin(), breaks.end());
+    breaks.erase(std::unique(breaks.begin(), breaks.end()), breaks.end());
+    
+    // Row layouts packed so far: (rect index << 1 | row parity) per crossing
+    // rect, and the first destination row packed with that layout
+    std::map<std::vector<int>, int> packedRows;
+    std::vector<int> crossing;
+    std::vector<int> layout;
+    
+    for (size_t b = 0; b + 1 < breaks.size(); b++) {
+        int firstRow = breaks[b];
+        int endRow = breaks[b + 1];
+        crossing.clear();
+        for (int i = 0; i < rectCount; i++) {
+            const PatternRect& rect = rects[i];
+            if (rect.width > 0 && firstRow >= rect.y && firstRow < static_cast<int64_t>(rect.y) + rect.height) {
+                crossing.push_back(i);
+            }
+        }
+        
+        for (int y = firstRow; y < endRow; y++) {
+            uint8_t* row = dest + static_cast<size_t>(y) * rowBytes;
+            if (y >= firstRow + 2) {
+                std::memcpy(row, row - 2 * static_cast<size_t>(rowBytes), rowBytes);
+                continue;
+            }
+            
+            layout.clear();
+            for (int i : crossing) {
+                layout.push_back((i << 1) | ((y - rects[i].y) & 1));
+            }
+            auto found = packedRows.find(layout);
+            if (found != packedRows.end()) {
+                std::memcpy(row, dest + static_cast<size_t>(found->second) * rowBytes, rowBytes);
+                continue;
+            }
+            
+            // Background first, then each crossing rect's span in list order
+            for (int x = 0; x < width; x++) {
+                std::memcpy(&rowSrc[x * 3], background, 3 * sizeof(uint16_t));
+            }
+            for (int entry : layout) {
+                const PatternRect& rect = rects[entry >> 1];
+                int rowParity = entry & 1;
+                int x0 = std::max(0, rect.x);
+                int x1 = static_cast<int>(std::min<int64_t>(width, static_cast<int64_t>(rect.x) + rect.width));
+                for (int x = x0; x < x1; x++) {
+                    // Same cell order as PatternGenerator: column parity selects 0/1 vs 2/3
+                    const uint16_t* color = rect.colors[rowParity + 2 * ((x - rect.x) & 1)];
+                    std::memcpy(&rowSrc[x * 3], color, 3 * sizeof(uint16_t));
+                }
+            }
+            packBand(row, rowSrc.data(), width, 1, rowBytes);
+            packedRows.emplace(layout, y);
+        }
+    }
+    
+    LOG_DEBUG("[PixelPacking] Packed " << width << "x" << height << " pattern of " << rectCount
+              << " rects from " << packedRows.size() << " distinct rows");
+    return 0;
+ }
+
+// Splits rows [0, height) into bands the way pack_pixel_format() does and
+// runs bandTask(firstRow, lastRow) for each. Returns the number of bands.
+template <typename BandTask>
+static int run_row_bands(uint16_t width, uint16_t height, const BandTask& bandTask) {
+    WorkerPool& pool = WorkerPool::instance();
+    int bands = 1;
+    if (static_cast<size_t>(width) * height >= kParallelMinPixels) {
+        bands = std::clamp(height / kMinRowsPerBand, 1, pool.threadCount());
     }
+    
+    if (bands == 1) {
+        bandTask(0, static_cast<int>(height));
+    } else {
+        int rowsPerBand = (height + bands - 1) / bands;
+        pool.run(bands, [&](int band) {
+            int firstRow = band * rowsPerBand;
+            int lastRow = std::min<int>(height, firstRow + rowsPerBand);
+            if (firstRow < lastRow) {
+                bandTask(firstRow, lastRow);
+            }
+        });
+    }
+    return bands;
+}
+
+static constexpr double kPi = 3.14159265358979323846;
 
-    // Pack the data according to the pixel format
-    switch (pixelFormat) {
-        case bmdFormat8BitBGRA:
-            clamp_image_channels(r_channel, g_channel, b_channel, 8);
-            pack_8bpc_rgb_image(
-                destData,
-                r_channel.data(), g_channel.data(), b_channel.data(),
-                width, height,
-                rowBytes,
-                true);
-            break;
-        case bmdFormat8BitARGB:
-            clamp_image_channels(r_channel, g_channel, b_channel, 8);
-            pack_8bpc_rgb_image(
-                destData,
-                r_channel.data(), g_channel.data(), b_channel.data(),
-                width, height,
-                rowBytes,
-                false);
-            break;
-        case bmdFormat10BitRGB:
-            clamp_image_channels(r_channel, g_channel, b_channel, 10);
-            pack_10bpc_rgb_image(
-                destData,
-                r_channel.data(), g_channel.data(), b_channel.data(),
-                width, height,
-                rowBytes);
-            break;
-        case bmdFormat12BitRGBLE:
-            clamp_image_channels(r_channel, g_channel, b_channel, 12);
-            pack_12bpc_rgble_image(
-                destData,
-                r_channel.data(), g_channel.data(), b_channel.data(),
-                width, height,
-                rowBytes);
-            break;
-        default:
-            std::cerr << "[DeckLink] Unsupported pixel format: 0x" << std::hex << pixelFormat << std::dec << std::endl;
-            return -8;
+// Position of column or row index among count along a ramp, 0 to 1
+static double ramp_position(int index, int count, int steps) {
+    if (steps >= 2) {
+        int step = static_cast<int>(static_cast<int64_t>(index) * steps / count);
+        return static_cast<double>(step) / (steps - 1);
     }
+    return count > 1 ? static_cast<double>(index) / (count - 1) : 0.0;
+}
+
+// Rounds to the nearest code; never below the smaller of the two colors
+static inline uint16_t ramp_level(uint16_t start, uint16_t end, double t) {
+    return static_cast<uint16_t>(start + (static_cast<double>(end) - start) * t + 0.5);
+}
+
+/**
+ * @brief Packs a ramp or zone plate computed on the fly
+ * 
+ * No source frame exists at any point: each band computes its rows into a
+ * scratch row that stays in cache and packs them from there.
+ * - Horizontal ramps have identical rows, so one row is packed and copied.
+ * - Vertical ramps have flat rows; a row equal to the one above it, as
+ *   within one step, is copied from it.
+ * - Zone plates use cos(a + b) = cos a cos b - sin a sin b with the column
+ *   terms a computed once per frame, so each pixel costs a few multiplies
+ *   and no trigonometry, 8 pixels at a time in the SIMD kernel.
+ * 
+ * @return int Returns 0 on success, -1 for an invalid pattern, -8 for an
+ *         unsupported pixel format
+ */
+int pack_generated_pattern(
+    void* destData,
+    BMDPixelFormat pixelFormat,
+    const GeneratedPattern& pattern,
+    uint16_t width, uint16_t height,
+    uint16_t rowBytes,
+    const YCbCrConversion* rgbToYCbCr,
+    const ColorLut* lut
+ ) {
+    if (pattern.steps < 0) return -1;
+    const auto kind = static_cast<GeneratedPatternKind>(pattern.kind);
+    if (kind != GeneratedPatternKind::HorizontalRamp && kind != GeneratedPatternKind::VerticalRamp &&
+        kind != GeneratedPatternKind::ZonePlate) {
+        LOG_ERROR("[PixelPacking] Unknown generated pattern kind " << pattern.kind);
+        return -1;
+    }
+    if (kind == GeneratedPatternKind::ZonePlate && !(std::isfinite(pattern.frequency) && pattern.frequency >= 0)) {
+        return -1;
+    }
+    const PackerEntry* packer = find_packer(pixelFormat);
+    if (!packer) return -8;
+    BandPacker packBand = make_band_packer(*packer, rgbToYCbCr, lut);
+    
+    uint8_t* dest = static_cast<uint8_t*>(destData);
+    const uint16_t* start = pattern.startColor;
+    const uint16_t* end = pattern.endColor;
+    int bands = 1;
+    
+    if (kind == GeneratedPatternKind::HorizontalRamp) {
+        std::vector<uint16_t> rowSrc(static_cast<size_t>(width) * 3);
+        for (int x = 0; x < width; x++) {
+            double t = ramp_position(x, width, pattern.steps);
+            for (int c = 0; c < 3; c++) {
+                rowSrc[x * 3 + c] = ramp_level(start[c], end[c], t);
+            }
+        }
+        packBand(dest, rowSrc.data(), width, 1, rowBytes);
+        bands = run_row_bands(width, height, [=](int firstRow, int lastRow) {
+            for (int y = std::max(firstRow, 1); y < lastRow; y++) {
+                std::memcpy(dest + static_cast<size_t>(y) * rowBytes, dest, rowBytes);
+            }
+        });
+    } else if (kind == GeneratedPatternKind::VerticalRamp) {
+        bands = run_row_bands(width, height, [&](int firstRow, int lastRow) {
+            thread_local std::vector<uint16_t> scratch;
+            scratch.resize(static_cast<size_t>(width) * 3);
+            uint16_t previous[3] = {0, 0, 0};
+            for (int y = firstRow; y < lastRow; y++) {
+                double t = ramp_position(y, height, pattern.steps);
+                uint16_t color[3];
+                for (int c = 0; c < 3; c++) {
+                    color[c] = ramp_level(start[c], end[c], t);
+                }
+                uint8_t* row = dest + static_cast<size_t>(y) * rowBytes;
+                if (y > firstRow && std::equal(color, color + 3, previous)) {
+                    std::memcpy(row, row - rowBytes, rowBytes);
+                    continue;
+                }
+                uint16_t* out = scratch.data();
+                for (int x = 0; x < width; x++) {
+                    out[x * 3 + 0] = color[0];
+                    out[x * 3 + 1] = color[1];
+                    out[x * 3 + 2] = color[2];
+                }
+                packBand(row, out, width, 1, rowBytes);
+                std::copy(color, color + 3, previous);
+            }
+        });
+    } else {
+        // Phase k * (dx^2 + dy^2) at pixel centers, split into column and row terms
+        const double k = kPi * pattern.frequency / width;
+        std::vector<float> columnCos(width);
+        std::vector<float> columnSin(width);
+        for (int x = 0; x < width; x++) {
+            double dx = x + 0.5 - width / 2.0;
+            columnCos[x] = static_cast<float>(std::cos(k * dx * dx));
+            columnSin[x] = static_cast<float>(std::sin(k * dx * dx));
+        }
+        const float base[3] = {start[0] + 0.5f, start[1] + 0.5f, start[2] + 0.5f};
+        const float span[3] = {static_cast<float>(end[0] - start[0]), static_cast<float>(end[1] - start[1]),
+                               static_cast<float>(end[2] - start[2])};
+        ZonePlateRowKernel zonePlateRow = simd_row_kernels().zonePlateRow;
+        
+        bands = run_row_bands(width, height, [&](int firstRow, int lastRow) {
+            thread_local std::vector<uint16_t> scratch;
+            thread_local std::vector<float> level;
+            scratch.resize(static_cast<size_t>(width) * 3);
+            level.resize(width);
+            const float* cosA = columnCos.data();
+            const float* sinA = columnSin.data();
+            float* levelRow = level.data();
+            uint16_t* out = scratch.data();
+            for (int y = firstRow; y < lastRow; y++) {
+                double dy = y + 0.5 - height / 2.0;
+                const float cosB = static_cast<float>(std::cos(k * dy * dy));
+                const float sinB = static_cast<float>(std::sin(k * dy * dy));
+                // Vector kernel computes whole blocks, the scalar loops the rest
+                int x0 = zonePlateRow ? zonePlateRow(out, cosA, sinA, cosB, sinB, base, span, width) : 0;
+                // 0 where the cosine is -1 (startColor), 1 where it is 1 (endColor)
+                for (int x = x0; x < width; x++) {
+                    levelRow[x] = 0.5f + 0.5f * (cosA[x] * cosB - sinA[x] * sinB);
+                }
+                for (int x = x0; x < width; x++) {
+                    out[x * 3 + 0] = static_cast<uint16_t>(base[0] + span[0] * levelRow[x]);
+                    out[x * 3 + 1] = static_cast<uint16_t>(base[1] + span[1] * levelRow[x]);
+                    out[x * 3 + 2] = static_cast<uint16_t>(base[2] + span[2] * levelRow[x]);
+                }
+                packBand(dest + static_cast<size_t>(y) * rowBytes, out, width, 1, rowBytes);
+            }
+        });
+    }
+    
+    LOG_DEBUG("[PixelPacking] Generated " << width << "x" << height << " pattern of kind " << pattern.kind
+              << ", bands: " << bands);
     return 0;
- }
\ No newline at end of file
+ }
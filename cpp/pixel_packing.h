@@ -3,6 +3,8 @@
 
 #include <cstdint>
 #include "DeckLinkAPI.h"
+#include "color_conversion.h"
+#include "color_lut.h"
 
 /*
  * Pixel Packing Schemes for Blackmagic DeckLink API
@@ -17,18 +19,105 @@
  * - 10-bit functions: Expect 10-bit values (0-1023) in a 16-bit container
  * - 12-bit function: Expect 12-bit values (0-4095) in a 16-bit container
  * 
- * All functions include range checking and will clamp values to valid ranges.
- * These functions are focused purely on packing existing image data.
- * Specifically, the YUV packing functions simply pack the data, they do not
- * perform any RGB to YUV conversion
+ * The source is interleaved, three uint16_t per pixel. Packers read it
+ * directly and clamp inline, writing the destination in a single pass.
+ * Large frames are split into row bands packed in parallel on the shared
+ * WorkerPool (see worker_pool.h); small frames stay on the calling thread.
+ *
+ * For the RGB formats the source, and the colors of patterns, are RGB. For
+ * 2vuy, v210 and Ay10 they depend on rgbToYCbCr (see color_conversion.h):
+ * with a conversion they are RGB and are converted to Y'CbCr row by row
+ * while packing; without one they are Y, Cb, Cr triples packed as they are,
+ * and every pixel pair takes the chroma of its first (even) pixel. RGB
+ * formats ignore the conversion.
+ *
+ * A ColorLut (see color_lut.h) maps RGB sources row by row ahead of the
+ * conversion and the packer, in the same pass. It is skipped when the
+ * source of a 4:2:2 format is Y'CbCr already.
  */
 
+// Axis-aligned rectangle of a pattern frame, filled with a 2x2 tile of colors.
+// Pixel (x, y) takes colors[((y - this.y) & 1) + 2 * ((x - this.x) & 1)], so a
+// flat rectangle repeats one color four times. Parts outside the frame are
+// ignored.
+struct PatternRect
+{
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+    uint16_t colors[4][3];
+};
+
+enum class GeneratedPatternKind : int32_t
+{
+    HorizontalRamp = 0, // startColor at the left edge to endColor at the right
+    VerticalRamp = 1,   // startColor at the top to endColor at the bottom
+    ZonePlate = 2,      // circular zone plate, endColor at the center
+};
+
+// Procedural test pattern computed row by row while packing. Colors are in
+// the source range of the pixel format (see INPUT RANGES above), so ramps
+// step through every code of a 10- or 12-bit format when the frame is wide
+// enough. A zone plate swings between the two colors along
+// cos(pi * frequency * r^2 / width), r measured from the frame center, so a
+// frequency of 1 reaches the Nyquist limit at the left and right edges.
+struct GeneratedPattern
+{
+    int32_t kind;  // GeneratedPatternKind
+    int32_t steps; // ramps: number of flat steps, 0 or 1 for a continuous ramp
+    uint16_t startColor[3];
+    uint16_t endColor[3];
+    double frequency; // zone plate only
+};
+
  int pack_pixel_format(
     void* destData,
     BMDPixelFormat pixelFormat,
     const uint16_t* srcData,
     uint16_t width, uint16_t height,
-    uint16_t rowBytes
+    uint16_t rowBytes,
+    const YCbCrConversion* rgbToYCbCr = nullptr,
+    const ColorLut* lut = nullptr
+ );
+
+// Repacks the groups of one changed rectangle into a frame that holds the
+// packed previous source; srcData is the full new source frame.
+ int pack_pixel_region(
+    void* destData,
+    BMDPixelFormat pixelFormat,
+    const uint16_t* srcData,
+    uint16_t width, uint16_t height,
+    uint16_t rowBytes,
+    int regionX, int regionY, int regionWidth, int regionHeight,
+    const YCbCrConversion* rgbToYCbCr = nullptr,
+    const ColorLut* lut = nullptr
+ );
+
+// Packs rects (later ones on top) over a flat background without a full
+// source frame. Colors are RGB or Y'CbCr like the source of
+// pack_pixel_format(), depending on the format and rgbToYCbCr.
+ int pack_rect_pattern(
+    void* destData,
+    BMDPixelFormat pixelFormat,
+    const uint16_t background[3],
+    const PatternRect* rects, int rectCount,
+    uint16_t width, uint16_t height,
+    uint16_t rowBytes,
+    const YCbCrConversion* rgbToYCbCr = nullptr,
+    const ColorLut* lut = nullptr
+ );
+
+// Computes each row of a generated pattern into a scratch row and packs it
+// from there, without a full source frame. Rows that repeat are copied.
+ int pack_generated_pattern(
+    void* destData,
+    BMDPixelFormat pixelFormat,
+    const GeneratedPattern& pattern,
+    uint16_t width, uint16_t height,
+    uint16_t rowBytes,
+    const YCbCrConversion* rgbToYCbCr = nullptr,
+    const ColorLut* lut = nullptr
  );
 
 #endif // PIXEL_PACKING_H 
\ No newline at end of file
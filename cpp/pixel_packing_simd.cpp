@@ -0,0 +1,580 @@
+#include "pixel_packing_simd.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PIXEL_PACKING_HAVE_AVX2 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#define PIXEL_PACKING_HAVE_NEON 1
+#endif
+
+/*
+ * Both vectorized formats clamp every source component before any
+ * rearranging, because clamping is independent of which channel a value
+ * belongs to.
+ *
+ * r210: each pixel becomes (R << 20) | (G << 10) | B, stored big-endian.
+ *
+ * R12L: the 8-pixel / 36-byte group is a little-endian bitstream of 12-bit
+ * values in source order (R0 G0 B0 R1 ...), value k starting at bit 12 * k.
+ * Two consecutive values therefore form one 24-bit little-endian triple
+ * (lo | hi << 12), which is how the kernels below build it.
+ *
+ * v210: a 6-pixel group is four little-endian words of three 10-bit fields.
+ * Every field comes from the first 16 source values of the group, so the
+ * kernels byte-shuffle two 8-value registers into the three field vectors
+ * and combine them as a | b << 10 | c << 20.
+ */
+
+// Source value behind each field of the four v210 words (see pixel_packing.cpp)
+static constexpr int kV210FieldSources[4][3] = {
+    {1, 0, 2}, {3, 7, 6}, {8, 9, 13}, {12, 14, 15},
+};
+
+// Byte shuffle controls for one v210 group: field f of word w reads 16-bit
+// source value v, from the low register (values 0-7) or the high one (8-15).
+// Unused bytes hold `none`, which the shuffle instructions turn into zero.
+struct V210ShuffleMasks
+{
+    uint8_t fromLow[3][16];
+    uint8_t fromHigh[3][16];
+    uint8_t fromBoth[3][16]; // indices into the 32-byte low:high pair
+};
+
+static constexpr V210ShuffleMasks make_v210_masks(uint8_t none) {
+    V210ShuffleMasks masks{};
+    for (int f = 0; f < 3; f++) {
+        for (int i = 0; i < 16; i++) {
+            masks.fromLow[f][i] = none;
+            masks.fromHigh[f][i] = none;
+            masks.fromBoth[f][i] = none;
+        }
+        for (int w = 0; w < 4; w++) {
+            int v = kV210FieldSources[w][f];
+            uint8_t* part = v < 8 ? masks.fromLow[f] : masks.fromHigh[f];
+            int local = v < 8 ? v : v - 8;
+            part[w * 4 + 0] = static_cast<uint8_t>(local * 2);
+            part[w * 4 + 1] = static_cast<uint8_t>(local * 2 + 1);
+            masks.fromBoth[f][w * 4 + 0] = static_cast<uint8_t>(v * 2);
+            masks.fromBoth[f][w * 4 + 1] = static_cast<uint8_t>(v * 2 + 1);
+        }
+    }
+    return masks;
+}
+
+// Byte shuffle controls that interleave 8 R, 8 G and 8 B values into three
+// 8-value registers of triples: output register o takes the bytes of
+// channel c from component c of the pixels it covers, zero (`none`) elsewhere
+struct TripleInterleaveMasks
+{
+    uint8_t fromChannel[3][3][16]; // [output register][channel]
+};
+
+static constexpr TripleInterleaveMasks make_triple_interleave_masks(uint8_t none) {
+    TripleInterleaveMasks masks{};
+    for (int v = 0; v < 24; v++) {
+        int o = v / 8;
+        int lane = v % 8;
+        for (int c = 0; c < 3; c++) {
+            bool own = v % 3 == c;
+            masks.fromChannel[o][c][lane * 2 + 0] = own ? static_cast<uint8_t>((v / 3) * 2) : none;
+            masks.fromChannel[o][c][lane * 2 + 1] = own ? static_cast<uint8_t>((v / 3) * 2 + 1) : none;
+        }
+    }
+    return masks;
+}
+
+// The reverse: channel c of 8 pixels gathered from the three registers
+// holding their triples
+struct TripleDeinterleaveMasks
+{
+    uint8_t fromRegister[3][3][16]; // [channel][input register]
+};
+
+static constexpr TripleDeinterleaveMasks make_triple_deinterleave_masks(uint8_t none) {
+    TripleDeinterleaveMasks masks{};
+    for (int c = 0; c < 3; c++) {
+        for (int pixel = 0; pixel < 8; pixel++) {
+            int v = pixel * 3 + c;
+            for (int o = 0; o < 3; o++) {
+                bool own = v / 8 == o;
+                masks.fromRegister[c][o][pixel * 2 + 0] = own ? static_cast<uint8_t>((v % 8) * 2) : none;
+                masks.fromRegister[c][o][pixel * 2 + 1] = own ? static_cast<uint8_t>((v % 8) * 2 + 1) : none;
+            }
+        }
+    }
+    return masks;
+}
+
+#if defined(PIXEL_PACKING_HAVE_AVX2)
+
+// pshufb controls that gather the R, G and B components of 8 r210 pixels into
+// 32-bit lanes. Lane L (pixels 4L..4L+3) reads source values 8L..8L+7 from the
+// first load and 8L+8..8L+15 from the second load, offset by 8 values.
+struct R210ShuffleMasks
+{
+    alignas(32) uint8_t fromFirst[3][32];
+    alignas(32) uint8_t fromSecond[3][32];
+};
+
+static constexpr R210ShuffleMasks make_r210_masks() {
+    R210ShuffleMasks masks{};
+    for (int c = 0; c < 3; c++) {
+        for (int i = 0; i < 32; i++) {
+            masks.fromFirst[c][i] = 0x80;
+            masks.fromSecond[c][i] = 0x80;
+        }
+        for (int lane = 0; lane < 2; lane++) {
+            for (int slot = 0; slot < 4; slot++) {
+                int value = 3 * (4 * lane + slot) + c;
+                int outByte = lane * 16 + slot * 4;
+                int firstIndex = value - 8 * lane;
+                if (firstIndex < 8) {
+                    masks.fromFirst[c][outByte + 0] = static_cast<uint8_t>(firstIndex * 2);
+                    masks.fromFirst[c][outByte + 1] = static_cast<uint8_t>(firstIndex * 2 + 1);
+                } else {
+                    masks.fromSecond[c][outByte + 0] = static_cast<uint8_t>((firstIndex - 8) * 2);
+                    masks.fromSecond[c][outByte + 1] = static_cast<uint8_t>((firstIndex - 8) * 2 + 1);
+                }
+            }
+        }
+    }
+    return masks;
+}
+
+static constexpr R210ShuffleMasks kR210Masks = make_r210_masks();
+
+alignas(32) static constexpr uint8_t kByteswap32Mask[32] = {
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+};
+
+// Drops the top byte of each 24-bit triple, leaving 12 packed bytes per lane
+alignas(32) static constexpr uint8_t kTripleCompactMask[32] = {
+    0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 0x80, 0x80, 0x80, 0x80,
+    0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 0x80, 0x80, 0x80, 0x80,
+};
+
+__attribute__((target("avx2")))
+static int pack_10bpc_rgb_row_avx2(void* dest, const uint16_t* src, int width) {
+    uint32_t* out = static_cast<uint32_t*>(dest);
+    const __m256i maxval = _mm256_set1_epi16(0x3FF);
+    const __m256i byteswap = _mm256_load_si256(reinterpret_cast<const __m256i*>(kByteswap32Mask));
+    __m256i fromFirst[3], fromSecond[3];
+    for (int c = 0; c < 3; c++) {
+        fromFirst[c] = _mm256_load_si256(reinterpret_cast<const __m256i*>(kR210Masks.fromFirst[c]));
+        fromSecond[c] = _mm256_load_si256(reinterpret_cast<const __m256i*>(kR210Masks.fromSecond[c]));
+    }
+
+    int x = 0;
+    for (; x + 8 <= width; x += 8, src += 24) {
+        __m256i first = _mm256_min_epu16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)), maxval);
+        __m256i second = _mm256_min_epu16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 8)), maxval);
+
+        __m256i r = _mm256_or_si256(_mm256_shuffle_epi8(first, fromFirst[0]), _mm256_shuffle_epi8(second, fromSecond[0]));
+        __m256i g = _mm256_or_si256(_mm256_shuffle_epi8(first, fromFirst[1]), _mm256_shuffle_epi8(second, fromSecond[1]));
+        __m256i b = _mm256_or_si256(_mm256_shuffle_epi8(first, fromFirst[2]), _mm256_shuffle_epi8(second, fromSecond[2]));
+
+        __m256i pixels = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(r, 20), _mm256_slli_epi32(g, 10)), b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + x), _mm256_shuffle_epi8(pixels, byteswap));
+    }
+    return x;
+}
+
+__attribute__((target("avx2")))
+static int pack_12bpc_rgble_row_avx2(void* dest, const uint16_t* src, int width) {
+    uint8_t* out = static_cast<uint8_t*>(dest);
+    const __m256i maxval = _mm256_set1_epi16(0xFFF);
+    const __m256i pairWeights = _mm256_set1_epi32(0x10000001); // lo * 1 + hi * 4096
+    const __m256i compact = _mm256_load_si256(reinterpret_cast<const __m256i*>(kTripleCompactMask));
+
+    // 16 pixels (two R12L groups) per iteration: 48 values in, 72 bytes out
+    int x = 0;
+    for (; x + 16 <= width; x += 16, src += 48, out += 72) {
+        __m128i packed[6];
+        for (int i = 0; i < 3; i++) {
+            __m256i values = _mm256_min_epu16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 16 * i)), maxval);
+            __m256i triples = _mm256_shuffle_epi8(_mm256_madd_epi16(values, pairWeights), compact);
+            packed[2 * i + 0] = _mm256_castsi256_si128(triples);
+            packed[2 * i + 1] = _mm256_extracti128_si256(triples, 1);
+        }
+        // Each 16-byte store carries 12 useful bytes; the next store overwrites
+        // the spare 4, and the last one is written exactly
+        for (int i = 0; i < 5; i++) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12 * i), packed[i]);
+        }
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 60), packed[5]);
+        uint32_t tail = static_cast<uint32_t>(_mm_extract_epi32(packed[5], 2));
+        std::memcpy(out + 68, &tail, sizeof(tail));
+    }
+    return x;
+}
+
+__attribute__((target("avx2")))
+static int pack_10bpc_yuv_row_avx2(void* dest, const uint16_t* src, int width) {
+    static constexpr V210ShuffleMasks kMasks = make_v210_masks(0x80);
+    uint8_t* out = static_cast<uint8_t*>(dest);
+    const __m256i maxval = _mm256_set1_epi16(0x3FF);
+    __m256i fromLow[3], fromHigh[3];
+    for (int f = 0; f < 3; f++) {
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kMasks.fromLow[f]));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kMasks.fromHigh[f]));
+        fromLow[f] = _mm256_broadcastsi128_si256(low);
+        fromHigh[f] = _mm256_broadcastsi128_si256(high);
+    }
+    
+    // Two groups (12 pixels, 36 values) per iteration, one per 128-bit lane
+    int x = 0;
+    for (; x + 12 <= width; x += 12, src += 36, out += 32) {
+        __m256i low = _mm256_min_epu16(_mm256_set_m128i(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 18)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src))), maxval);
+        __m256i high = _mm256_min_epu16(_mm256_set_m128i(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 26)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 8))), maxval);
+        
+        __m256i fields[3];
+        for (int f = 0; f < 3; f++) {
+            fields[f] = _mm256_or_si256(_mm256_shuffle_epi8(low, fromLow[f]), _mm256_shuffle_epi8(high, fromHigh[f]));
+        }
+        __m256i words = _mm256_or_si256(_mm256_or_si256(fields[0], _mm256_slli_epi32(fields[1], 10)),
+                                        _mm256_slli_epi32(fields[2], 20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), words);
+    }
+    return x;
+}
+
+// Same operations in the same order as the scalar loop, so the result is
+// bit-identical; 8 pixels per iteration
+__attribute__((target("avx2")))
+static int zone_plate_row_avx2(uint16_t* out, const float* cosA, const float* sinA, float cosB, float sinB,
+                               const float base[3], const float span[3], int width) {
+    static constexpr TripleInterleaveMasks kMasks = make_triple_interleave_masks(0x80);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 rowCos = _mm256_set1_ps(cosB);
+    const __m256 rowSin = _mm256_set1_ps(sinB);
+    __m256 channelBase[3], channelSpan[3];
+    __m128i interleave[3][3];
+    for (int c = 0; c < 3; c++) {
+        channelBase[c] = _mm256_set1_ps(base[c]);
+        channelSpan[c] = _mm256_set1_ps(span[c]);
+        for (int o = 0; o < 3; o++) {
+            interleave[o][c] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kMasks.fromChannel[o][c]));
+        }
+    }
+    
+    int x = 0;
+    for (; x + 8 <= width; x += 8, out += 24) {
+        __m256 phase = _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(cosA + x), rowCos),
+                                     _mm256_mul_ps(_mm256_loadu_ps(sinA + x), rowSin));
+        __m256 level = _mm256_add_ps(half, _mm256_mul_ps(half, phase));
+        __m128i channels[3];
+        for (int c = 0; c < 3; c++) {
+            __m256i values = _mm256_cvttps_epi32(_mm256_add_ps(channelBase[c], _mm256_mul_ps(channelSpan[c], level)));
+            channels[c] = _mm_packus_epi32(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1));
+        }
+        for (int o = 0; o < 3; o++) {
+            __m128i triples = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(channels[0], interleave[o][0]),
+                                                        _mm_shuffle_epi8(channels[1], interleave[o][1])),
+                                           _mm_shuffle_epi8(channels[2], interleave[o][2]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8 * o), triples);
+        }
+    }
+    return x;
+}
+
+// Tetrahedral interpolation of 8 pixels (see color_lut.cpp), gathering the
+// per-code tables and the vertices
+__attribute__((target("avx2")))
+static int lut_cube_row_avx2(uint16_t* out, const uint16_t* src, int width, const LutCubeTables& tables) {
+    static constexpr TripleInterleaveMasks kInterleave = make_triple_interleave_masks(0x80);
+    static constexpr TripleDeinterleaveMasks kDeinterleave = make_triple_deinterleave_masks(0x80);
+    __m128i interleave[3][3], deinterleave[3][3];
+    __m256i stride[3];
+    for (int c = 0; c < 3; c++) {
+        stride[c] = _mm256_set1_epi32(tables.stride[c]);
+        for (int o = 0; o < 3; o++) {
+            interleave[o][c] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kInterleave.fromChannel[o][c]));
+            deinterleave[c][o] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kDeinterleave.fromRegister[c][o]));
+        }
+    }
+    const __m256i maxCode = _mm256_set1_epi32(tables.maxValue);
+    const __m256i allSteps = _mm256_set1_epi32(tables.stride[0] + tables.stride[1] + tables.stride[2]);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 scale = _mm256_set1_ps(static_cast<float>(tables.maxValue));
+    
+    int x = 0;
+    for (; x + 8 <= width; x += 8, src += 24, out += 24) {
+        __m128i triples[3];
+        for (int o = 0; o < 3; o++) {
+            triples[o] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 8 * o));
+        }
+        __m256 fraction[3];
+        __m256i base = _mm256_setzero_si256();
+        for (int c = 0; c < 3; c++) {
+            __m128i values = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(triples[0], deinterleave[c][0]),
+                                                       _mm_shuffle_epi8(triples[1], deinterleave[c][1])),
+                                          _mm_shuffle_epi8(triples[2], deinterleave[c][2]));
+            __m256i codes = _mm256_min_epi32(_mm256_cvtepu16_epi32(values), maxCode);
+            fraction[c] = _mm256_i32gather_ps(tables.fraction[c], codes, 4);
+            base = _mm256_add_epi32(base, _mm256_i32gather_epi32(tables.cell[c], codes, 4));
+        }
+        const __m256 fr = fraction[0], fg = fraction[1], fb = fraction[2];
+        __m256 hi = _mm256_max_ps(_mm256_max_ps(fr, fg), fb);
+        __m256 lo = _mm256_min_ps(_mm256_min_ps(fr, fg), fb);
+        __m256 mid = _mm256_max_ps(_mm256_min_ps(fr, fg), _mm256_min_ps(_mm256_max_ps(fr, fg), fb));
+        
+        // Same axis choice as the scalar code: R, else G over B
+        __m256i redHi = _mm256_castps_si256(_mm256_and_ps(_mm256_cmp_ps(fr, fg, _CMP_GE_OQ), _mm256_cmp_ps(fr, fb, _CMP_GE_OQ)));
+        __m256i greenHi = _mm256_castps_si256(_mm256_cmp_ps(fg, fb, _CMP_GE_OQ));
+        __m256i redLo = _mm256_castps_si256(_mm256_and_ps(_mm256_cmp_ps(fr, fg, _CMP_LE_OQ), _mm256_cmp_ps(fr, fb, _CMP_LE_OQ)));
+        __m256i greenLo = _mm256_castps_si256(_mm256_cmp_ps(fg, fb, _CMP_LE_OQ));
+        __m256i hiStep = _mm256_blendv_epi8(_mm256_blendv_epi8(stride[2], stride[1], greenHi), stride[0], redHi);
+        __m256i loStep = _mm256_blendv_epi8(_mm256_blendv_epi8(stride[2], stride[1], greenLo), stride[0], redLo);
+        
+        const __m256 weight[4] = {_mm256_sub_ps(one, hi), _mm256_sub_ps(hi, mid), _mm256_sub_ps(mid, lo), lo};
+        // Float offsets of the four vertices
+        const __m256i vertex[4] = {
+            _mm256_slli_epi32(base, 2),
+            _mm256_slli_epi32(_mm256_add_epi32(base, hiStep), 2),
+            _mm256_slli_epi32(_mm256_sub_epi32(_mm256_add_epi32(base, allSteps), loStep), 2),
+            _mm256_slli_epi32(_mm256_add_epi32(base, allSteps), 2),
+        };
+        
+        __m128i channels[3];
+        for (int c = 0; c < 3; c++) {
+            const float* component = tables.vertices + c;
+            __m256 value = _mm256_mul_ps(_mm256_i32gather_ps(component, vertex[0], 4), weight[0]);
+            for (int v = 1; v < 4; v++) {
+                value = _mm256_add_ps(value, _mm256_mul_ps(_mm256_i32gather_ps(component, vertex[v], 4), weight[v]));
+            }
+            value = _mm256_min_ps(_mm256_max_ps(value, zero), one);
+            __m256i codes = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(value, scale), half));
+            channels[c] = _mm_packus_epi32(_mm256_castsi256_si128(codes), _mm256_extracti128_si256(codes, 1));
+        }
+        for (int o = 0; o < 3; o++) {
+            __m128i packed = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(channels[0], interleave[o][0]),
+                                                       _mm_shuffle_epi8(channels[1], interleave[o][1])),
+                                          _mm_shuffle_epi8(channels[2], interleave[o][2]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8 * o), packed);
+        }
+    }
+    return x;
+}
+
+// 64 bytes per iteration while both halves match, then the 32-byte block
+// that differs
+__attribute__((target("avx2")))
+static int matching_prefix_avx2(const uint8_t* a, const uint8_t* b, int bytes) {
+    int x = 0;
+    for (; x + 64 <= bytes; x += 64) {
+        __m256i low = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + x)),
+                                       _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + x)));
+        __m256i high = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + x + 32)),
+                                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + x + 32)));
+        if (!_mm256_testz_si256(_mm256_or_si256(low, high), _mm256_or_si256(low, high))) {
+            return _mm256_testz_si256(low, low) ? x + 32 : x;
+        }
+    }
+    for (; x + 32 <= bytes; x += 32) {
+        __m256i diff = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + x)),
+                                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + x)));
+        if (!_mm256_testz_si256(diff, diff)) break;
+    }
+    return x;
+}
+
+#endif // PIXEL_PACKING_HAVE_AVX2
+
+#if defined(PIXEL_PACKING_HAVE_NEON)
+
+static int pack_10bpc_rgb_row_neon(void* dest, const uint16_t* src, int width) {
+    uint32_t* out = static_cast<uint32_t*>(dest);
+    const uint16x8_t maxval = vdupq_n_u16(0x3FF);
+
+    int x = 0;
+    for (; x + 8 <= width; x += 8, src += 24) {
+        uint16x8x3_t rgb = vld3q_u16(src);
+        uint16x8_t r = vminq_u16(rgb.val[0], maxval);
+        uint16x8_t g = vminq_u16(rgb.val[1], maxval);
+        uint16x8_t b = vminq_u16(rgb.val[2], maxval);
+
+        uint32x4_t lo = vorrq_u32(vorrq_u32(vshlq_n_u32(vmovl_u16(vget_low_u16(r)), 20),
+                                            vshlq_n_u32(vmovl_u16(vget_low_u16(g)), 10)),
+                                  vmovl_u16(vget_low_u16(b)));
+        uint32x4_t hi = vorrq_u32(vorrq_u32(vshlq_n_u32(vmovl_u16(vget_high_u16(r)), 20),
+                                            vshlq_n_u32(vmovl_u16(vget_high_u16(g)), 10)),
+                                  vmovl_u16(vget_high_u16(b)));
+
+        vst1q_u32(out + x, vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(lo))));
+        vst1q_u32(out + x + 4, vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(hi))));
+    }
+    return x;
+}
+
+// Writes 4 triples (12 bytes) from the low 24 bits of each lane
+static inline void store_triples_neon(uint8_t* out, uint32x4_t triples, uint8x16_t compact) {
+    uint8x16_t bytes = vqtbl1q_u8(vreinterpretq_u8_u32(triples), compact);
+    vst1_u8(out, vget_low_u8(bytes));
+    uint32_t tail = vgetq_lane_u32(vreinterpretq_u32_u8(bytes), 2);
+    std::memcpy(out + 8, &tail, sizeof(tail));
+}
+
+static int pack_12bpc_rgble_row_neon(void* dest, const uint16_t* src, int width) {
+    uint8_t* out = static_cast<uint8_t*>(dest);
+    const uint16x8_t maxval = vdupq_n_u16(0xFFF);
+    static const uint8_t kCompact[16] = {0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 0xFF, 0xFF, 0xFF, 0xFF};
+    const uint8x16_t compact = vld1q_u8(kCompact);
+
+    // 16 pixels (two R12L groups) per iteration: 48 values in, 72 bytes out
+    int x = 0;
+    for (; x + 16 <= width; x += 16, src += 48, out += 72) {
+        for (int i = 0; i < 3; i++) {
+            uint16x8x2_t pairs = vld2q_u16(src + 16 * i);
+            uint16x8_t lo = vminq_u16(pairs.val[0], maxval);
+            uint16x8_t hi = vminq_u16(pairs.val[1], maxval);
+            uint32x4_t first = vorrq_u32(vmovl_u16(vget_low_u16(lo)), vshll_n_u16(vget_low_u16(hi), 12));
+            uint32x4_t second = vorrq_u32(vmovl_u16(vget_high_u16(lo)), vshll_n_u16(vget_high_u16(hi), 12));
+            store_triples_neon(out + 24 * i, first, compact);
+            store_triples_neon(out + 24 * i + 12, second, compact);
+        }
+    }
+    return x;
+}
+
+static int pack_10bpc_yuv_row_neon(void* dest, const uint16_t* src, int width) {
+    static constexpr V210ShuffleMasks kMasks = make_v210_masks(0xFF);
+    uint32_t* out = static_cast<uint32_t*>(dest);
+    const uint16x8_t maxval = vdupq_n_u16(0x3FF);
+    uint8x16_t fromBoth[3];
+    for (int f = 0; f < 3; f++) {
+        fromBoth[f] = vld1q_u8(kMasks.fromBoth[f]);
+    }
+    
+    // One group (6 pixels, 18 values) per iteration
+    int x = 0;
+    for (; x + 6 <= width; x += 6, src += 18, out += 4) {
+        uint8x16x2_t values = {{
+            vreinterpretq_u8_u16(vminq_u16(vld1q_u16(src), maxval)),
+            vreinterpretq_u8_u16(vminq_u16(vld1q_u16(src + 8), maxval)),
+        }};
+        uint32x4_t a = vreinterpretq_u32_u8(vqtbl2q_u8(values, fromBoth[0]));
+        uint32x4_t b = vreinterpretq_u32_u8(vqtbl2q_u8(values, fromBoth[1]));
+        uint32x4_t c = vreinterpretq_u32_u8(vqtbl2q_u8(values, fromBoth[2]));
+        vst1q_u32(out, vorrq_u32(vorrq_u32(a, vshlq_n_u32(b, 10)), vshlq_n_u32(c, 20)));
+    }
+    return x;
+}
+
+static int zone_plate_row_neon(uint16_t* out, const float* cosA, const float* sinA, float cosB, float sinB,
+                               const float base[3], const float span[3], int width) {
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t rowCos = vdupq_n_f32(cosB);
+    const float32x4_t rowSin = vdupq_n_f32(sinB);
+
+    // 8 pixels per iteration, written as triples by vst3q
+    int x = 0;
+    for (; x + 8 <= width; x += 8, out += 24) {
+        float32x4_t level[2];
+        for (int i = 0; i < 2; i++) {
+            float32x4_t phase = vsubq_f32(vmulq_f32(vld1q_f32(cosA + x + 4 * i), rowCos),
+                                          vmulq_f32(vld1q_f32(sinA + x + 4 * i), rowSin));
+            level[i] = vaddq_f32(half, vmulq_f32(half, phase));
+        }
+        uint16x8x3_t triples;
+        for (int c = 0; c < 3; c++) {
+            float32x4_t channelBase = vdupq_n_f32(base[c]);
+            float32x4_t channelSpan = vdupq_n_f32(span[c]);
+            uint32x4_t low = vcvtq_u32_f32(vaddq_f32(channelBase, vmulq_f32(channelSpan, level[0])));
+            uint32x4_t high = vcvtq_u32_f32(vaddq_f32(channelBase, vmulq_f32(channelSpan, level[1])));
+            triples.val[c] = vcombine_u16(vqmovn_u32(low), vqmovn_u32(high));
+        }
+        vst3q_u16(out, triples);
+    }
+    return x;
+}
+
+// Without gathers the cell lookup stays scalar; the four vertices are
+// weighted as 4-lane vectors, R, G and B at once
+static int lut_cube_row_neon(uint16_t* out, const uint16_t* src, int width, const LutCubeTables& tables) {
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t scale = vdupq_n_f32(static_cast<float>(tables.maxValue));
+    const int32_t allSteps = tables.stride[0] + tables.stride[1] + tables.stride[2];
+
+    for (int x = 0; x < width; x++, src += 3, out += 3) {
+        int r = std::min<int>(src[0], tables.maxValue);
+        int g = std::min<int>(src[1], tables.maxValue);
+        int b = std::min<int>(src[2], tables.maxValue);
+        float fr = tables.fraction[0][r];
+        float fg = tables.fraction[1][g];
+        float fb = tables.fraction[2][b];
+        int32_t base = tables.cell[0][r] + tables.cell[1][g] + tables.cell[2][b];
+
+        float hi = std::max(std::max(fr, fg), fb);
+        float lo = std::min(std::min(fr, fg), fb);
+        float mid = std::max(std::min(fr, fg), std::min(std::max(fr, fg), fb));
+        int32_t hiStep = (fr >= fg && fr >= fb) ? tables.stride[0] : (fg >= fb) ? tables.stride[1] : tables.stride[2];
+        int32_t loStep = (fr <= fg && fr <= fb) ? tables.stride[0] : (fg <= fb) ? tables.stride[1] : tables.stride[2];
+
+        const float* vertices = tables.vertices;
+        float32x4_t value = vmulq_n_f32(vld1q_f32(vertices + static_cast<size_t>(base) * 4), 1.0f - hi);
+        value = vaddq_f32(value, vmulq_n_f32(vld1q_f32(vertices + static_cast<size_t>(base + hiStep) * 4), hi - mid));
+        value = vaddq_f32(value, vmulq_n_f32(vld1q_f32(vertices + static_cast<size_t>(base + allSteps - loStep) * 4),
+                                             mid - lo));
+        value = vaddq_f32(value, vmulq_n_f32(vld1q_f32(vertices + static_cast<size_t>(base + allSteps) * 4), lo));
+        value = vminq_f32(vmaxq_f32(value, zero), one);
+        uint32x4_t codes = vcvtq_u32_f32(vaddq_f32(vmulq_f32(value, scale), half));
+        out[0] = static_cast<uint16_t>(vgetq_lane_u32(codes, 0));
+        out[1] = static_cast<uint16_t>(vgetq_lane_u32(codes, 1));
+        out[2] = static_cast<uint16_t>(vgetq_lane_u32(codes, 2));
+    }
+    return width;
+}
+
+// 64 bytes per iteration while all four quarters match, then the 16-byte
+// block that differs
+static int matching_prefix_neon(const uint8_t* a, const uint8_t* b, int bytes) {
+    int x = 0;
+    for (; x + 64 <= bytes; x += 64) {
+        uint8x16_t diff = vorrq_u8(vorrq_u8(veorq_u8(vld1q_u8(a + x), vld1q_u8(b + x)),
+                                            veorq_u8(vld1q_u8(a + x + 16), vld1q_u8(b + x + 16))),
+                                   vorrq_u8(veorq_u8(vld1q_u8(a + x + 32), vld1q_u8(b + x + 32)),
+                                            veorq_u8(vld1q_u8(a + x + 48), vld1q_u8(b + x + 48))));
+        if (vmaxvq_u8(diff) != 0) break;
+    }
+    for (; x + 16 <= bytes; x += 16) {
+        if (vmaxvq_u8(veorq_u8(vld1q_u8(a + x), vld1q_u8(b + x))) != 0) break;
+    }
+    return x;
+}
+
+#endif // PIXEL_PACKING_HAVE_NEON
+
+static SimdRowKernels select_row_kernels() {
+#if defined(PIXEL_PACKING_HAVE_NEON)
+    // NEON is part of the AArch64 baseline
+    return {"neon", pack_10bpc_rgb_row_neon, pack_12bpc_rgble_row_neon, pack_10bpc_yuv_row_neon,
+            zone_plate_row_neon, lut_cube_row_neon, matching_prefix_neon};
+#elif defined(PIXEL_PACKING_HAVE_AVX2)
+    if (__builtin_cpu_supports("avx2")) {
+        return {"avx2", pack_10bpc_rgb_row_avx2, pack_12bpc_rgble_row_avx2, pack_10bpc_yuv_row_avx2,
+                zone_plate_row_avx2, lut_cube_row_avx2, matching_prefix_avx2};
+    }
+    return {"scalar", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+#else
+    return {"scalar", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+#endif
+}
+
+const SimdRowKernels& simd_row_kernels() {
+    static const SimdRowKernels kernels = select_row_kernels();
+    return kernels;
+}
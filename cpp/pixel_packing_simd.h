@@ -0,0 +1,51 @@
+#ifndef PIXEL_PACKING_SIMD_H
+#define PIXEL_PACKING_SIMD_H
+
+#include "color_lut.h"
+#include <cstdint>
+
+/*
+ * Vectorized row kernels for the pixel packers (internal to pixel_packing.cpp,
+ * color_lut.cpp and frame_compare.cpp)
+ *
+ * Each kernel packs (or, for the pattern and LUT stages, computes) as many
+ * whole vector blocks of one row as it can and returns the number of pixels
+ * it wrote. The scalar code finishes the rest of the row, so a kernel never
+ * has to handle partial blocks. Output must be bit-identical to the scalar
+ * code, which bench/pack_bench.cpp checks for the packing, zone plate and
+ * LUT kernels. Float kernels use separate multiplies and adds, and the build
+ * turns off FMA contraction so the scalar code rounds the same way.
+ *
+ * Kernels are selected once at runtime: AVX2 on x86-64 CPUs that support it,
+ * NEON on AArch64, otherwise none and the scalar path packs everything.
+ */
+
+typedef int (*PackRowKernel)(void *dest, const uint16_t *src, int width);
+
+// Source row of a zone plate (see pack_generated_pattern()): component c of
+// pixel x is base[c] + span[c] * (0.5 + 0.5 * (cosA[x] * cosB - sinA[x] * sinB)),
+// truncated to uint16_t, written as interleaved triples
+typedef int (*ZonePlateRowKernel)(uint16_t *out, const float *cosA, const float *sinA, float cosB, float sinB,
+                                  const float base[3], const float span[3], int width);
+
+// Maps a row through a 3D LUT as apply_lut_cube_row() does
+typedef int (*LutCubeRowKernel)(uint16_t *out, const uint16_t *src, int width, const LutCubeTables &tables);
+
+// Length of the common prefix of two packed rows in whole vector blocks: the
+// offset of the first block that differs, or every block if none does
+typedef int (*MatchingPrefixKernel)(const uint8_t *a, const uint8_t *b, int bytes);
+
+struct SimdRowKernels
+{
+    const char *name;
+    PackRowKernel pack10BitRGB;   // bmdFormat10BitRGB ('r210')
+    PackRowKernel pack12BitRGBLE; // bmdFormat12BitRGBLE ('R12L')
+    PackRowKernel pack10BitYUV;   // bmdFormat10BitYUV ('v210'), Y'CbCr source
+    ZonePlateRowKernel zonePlateRow;
+    LutCubeRowKernel lutCubeRow;
+    MatchingPrefixKernel matchingPrefix;
+};
+
+const SimdRowKernels &simd_row_kernels();
+
+#endif // PIXEL_PACKING_SIMD_H
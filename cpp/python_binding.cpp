@@ -0,0 +1,257 @@
+/*
+ * Native Python binding for the frame hot path
+ *
+ * The ctypes wrapper in bmd_decklink.py converts every argument through its
+ * argtypes and crosses into the library once per step, so displaying one
+ * frame takes a pack call and a display call with Python running in
+ * between. This module takes the numpy array through the buffer protocol,
+ * without a copy, and makes all the library calls of one frame in a single
+ * stretch with the GIL released. Other Python threads, such as the API
+ * server's event loop, keep running while the frame is packed and for the
+ * whole of DisplayVideoFrameSync.
+ *
+ * It is a thin layer over the C API of libdecklink, which it links against,
+ * so it shares the library state of the ctypes wrapper; handles are the
+ * integers ctypes returns. bmd_decklink.py uses it when it was built and
+ * falls back to ctypes otherwise. As with ctypes, one device or group must
+ * only be driven from one thread at a time.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "decklink_wrapper.h"
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+// One frame passed in from Python: a C-contiguous uint16 buffer of shape
+// (height, width, 3), held for the duration of the call so the memory stays
+// put while the GIL is released
+class FrameView
+{
+public:
+    FrameView() : m_held(false) { std::memset(&m_view, 0, sizeof(m_view)); }
+    ~FrameView() {
+        if (m_held) PyBuffer_Release(&m_view);
+    }
+
+    FrameView(const FrameView &) = delete;
+    FrameView &operator=(const FrameView &) = delete;
+
+    // Returns false with a Python exception set
+    bool acquire(PyObject *object) {
+        if (PyObject_GetBuffer(object, &m_view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) return false;
+        m_held = true;
+        if (m_view.itemsize != 2 || !is_uint16(m_view.format) || m_view.ndim != 3 || m_view.shape[2] != 3 ||
+            m_view.shape[0] <= 0 || m_view.shape[1] <= 0 || m_view.shape[0] > INT32_MAX ||
+            m_view.shape[1] > INT32_MAX) {
+            PyErr_SetString(PyExc_ValueError,
+                            "frame_data must be a C-contiguous uint16 array of shape (height, width, 3)");
+            return false;
+        }
+        return true;
+    }
+
+    const uint16_t *data() const { return static_cast<const uint16_t *>(m_view.buf); }
+    int height() const { return static_cast<int>(m_view.shape[0]); }
+    int width() const { return static_cast<int>(m_view.shape[1]); }
+
+private:
+    // Native or explicitly little-endian unsigned short; every supported
+    // host is little-endian
+    static bool is_uint16(const char *format) {
+        if (!format) return false;
+        return std::strcmp(format, "H") == 0 || std::strcmp(format, "@H") == 0 ||
+               std::strcmp(format, "=H") == 0 || std::strcmp(format, "<H") == 0;
+    }
+
+    Py_buffer m_view;
+    bool m_held;
+};
+
+// Rectangle of a region update, x, y, width, height
+struct Region
+{
+    bool set;
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+// The first library call that failed while the GIL was released
+struct CallResult
+{
+    const char *failed; // completes "Failed to ...", as in bmd_decklink.py
+    int err;
+};
+
+// Returns nullptr with a Python exception set
+void *handle_from(PyObject *object, const char *what) {
+    void *handle = object == Py_None ? nullptr : PyLong_AsVoidPtr(object);
+    if (!handle && !PyErr_Occurred()) {
+        PyErr_Format(PyExc_RuntimeError, "%s not open", what);
+    }
+    return handle;
+}
+
+// Accepts None or an (x, y, width, height) tuple
+bool parse_region(PyObject *object, Region &region) {
+    region.set = object && object != Py_None;
+    if (!region.set) return true;
+    return PyArg_ParseTuple(object, "iiii;region must be (x, y, width, height)", &region.x, &region.y,
+                            &region.width, &region.height) != 0;
+}
+
+PyObject *finish(const CallResult &result) {
+    if (result.err) {
+        PyErr_Format(PyExc_RuntimeError, "Failed to %s (error %d)", result.failed, result.err);
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+// Packs into the device's next frame: the whole image, or only the region
+// starting from the previous frame. Runs without the GIL.
+int pack_frame(DeckLinkHandle handle, const FrameView &frame, const Region &region) {
+    if (region.set) {
+        return decklink_update_frame_region(handle, frame.data(), frame.width(), frame.height(), region.x,
+                                            region.y, region.width, region.height);
+    }
+    return decklink_create_frame_from_buffer(handle, frame.data(), frame.width(), frame.height());
+}
+
+enum class DeviceStep
+{
+    Display,
+    Schedule,
+};
+
+// Shared body of display_frame() and schedule_frame()
+PyObject *pack_and_output(PyObject *args, PyObject *kwargs, const char *format, DeviceStep step) {
+    static const char *keywords[] = {"handle", "frame_data", "region", nullptr};
+    PyObject *handleObject;
+    PyObject *frameObject;
+    PyObject *regionObject = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, format, const_cast<char **>(keywords), &handleObject,
+                                     &frameObject, &regionObject)) {
+        return nullptr;
+    }
+    void *handle = handle_from(handleObject, "Device");
+    Region region;
+    FrameView frame;
+    if (!handle || !parse_region(regionObject, region) || !frame.acquire(frameObject)) return nullptr;
+
+    CallResult result{nullptr, 0};
+    Py_BEGIN_ALLOW_THREADS
+    result.err = pack_frame(handle, frame, region);
+    if (result.err) {
+        result.failed = "create frame";
+    } else if (step == DeviceStep::Display) {
+        result.err = decklink_display_frame_sync(handle);
+        result.failed = "display frame synchronously";
+    } else {
+        result.err = decklink_schedule_frame_for_output(handle);
+        result.failed = "schedule frame";
+    }
+    Py_END_ALLOW_THREADS
+    return finish(result);
+}
+
+PyObject *display_frame(PyObject *, PyObject *args, PyObject *kwargs) {
+    return pack_and_output(args, kwargs, "OO|O:display_frame", DeviceStep::Display);
+}
+
+PyObject *schedule_frame(PyObject *, PyObject *args, PyObject *kwargs) {
+    return pack_and_output(args, kwargs, "OO|O:schedule_frame", DeviceStep::Schedule);
+}
+
+PyObject *submit_frame(PyObject *, PyObject *args) {
+    PyObject *handleObject;
+    PyObject *frameObject;
+    if (!PyArg_ParseTuple(args, "OO:submit_frame", &handleObject, &frameObject)) return nullptr;
+    void *handle = handle_from(handleObject, "Device");
+    FrameView frame;
+    if (!handle || !frame.acquire(frameObject)) return nullptr;
+
+    // Blocks while both pipeline slots are taken, so this is where a
+    // producer thread spends most of its time
+    CallResult result{"submit frame", 0};
+    Py_BEGIN_ALLOW_THREADS
+    result.err = decklink_submit_frame(handle, frame.data(), frame.width(), frame.height());
+    Py_END_ALLOW_THREADS
+    return finish(result);
+}
+
+// Shared body of group_display_frame() and group_schedule_frame()
+PyObject *group_pack_and_output(PyObject *args, const char *format, DeviceStep step) {
+    PyObject *handleObject;
+    PyObject *frameObject;
+    if (!PyArg_ParseTuple(args, format, &handleObject, &frameObject)) return nullptr;
+    void *group = handle_from(handleObject, "Group");
+    FrameView frame;
+    if (!group || !frame.acquire(frameObject)) return nullptr;
+
+    CallResult result{nullptr, 0};
+    Py_BEGIN_ALLOW_THREADS
+    result.err = decklink_group_create_frame_from_buffer(group, frame.data(), frame.width(), frame.height());
+    if (result.err) {
+        result.failed = "create group frame";
+    } else if (step == DeviceStep::Display) {
+        result.err = decklink_group_display_frame_sync(group);
+        result.failed = "display group frame";
+    } else {
+        result.err = decklink_group_schedule_frame(group);
+        result.failed = "schedule group frame";
+    }
+    Py_END_ALLOW_THREADS
+    return finish(result);
+}
+
+PyObject *group_display_frame(PyObject *, PyObject *args) {
+    return group_pack_and_output(args, "OO:group_display_frame", DeviceStep::Display);
+}
+
+PyObject *group_schedule_frame(PyObject *, PyObject *args) {
+    return group_pack_and_output(args, "OO:group_schedule_frame", DeviceStep::Schedule);
+}
+
+PyMethodDef kMethods[] = {
+    {"display_frame", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(display_frame)),
+     METH_VARARGS | METH_KEYWORDS,
+     "display_frame(handle, frame_data, region=None)\n--\n\n"
+     "Pack frame_data, or only region of it, and display it synchronously."},
+    {"schedule_frame", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(schedule_frame)),
+     METH_VARARGS | METH_KEYWORDS,
+     "schedule_frame(handle, frame_data, region=None)\n--\n\n"
+     "Pack frame_data, or only region of it, and queue it for scheduled playback."},
+    {"submit_frame", submit_frame, METH_VARARGS,
+     "submit_frame(handle, frame_data)\n--\n\nCopy frame_data into the running frame pipeline."},
+    {"group_display_frame", group_display_frame, METH_VARARGS,
+     "group_display_frame(group, frame_data)\n--\n\n"
+     "Pack frame_data once per pixel format and display it on every device of the group."},
+    {"group_schedule_frame", group_schedule_frame, METH_VARARGS,
+     "group_schedule_frame(group, frame_data)\n--\n\n"
+     "Pack frame_data once per pixel format and queue it on every device of the group."},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyModuleDef kModule = {
+    PyModuleDef_HEAD_INIT,
+    "_decklink_native",
+    "Buffer-protocol frame calls into libdecklink that release the GIL.",
+    -1,
+    kMethods,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit__decklink_native() {
+    return PyModule_Create(&kModule);
+}
@@ -0,0 +1,119 @@
+#include "worker_pool.h"
+
+WorkerPool& WorkerPool::instance() {
+    static WorkerPool pool;
+    return pool;
+}
+
+WorkerPool::WorkerPool()
+    : m_job(nullptr)
+    , m_generation(0)
+    , m_busyWorkers(0)
+    , m_stopping(false)
+{
+    startWorkers(static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+WorkerPool::~WorkerPool() {
+    stopWorkers();
+}
+
+void WorkerPool::setThreadCount(int count) {
+    if (count <= 0) {
+        count = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    std::lock_guard<std::mutex> runLock(m_runMutex);
+    if (count == threadCount()) return;
+    stopWorkers();
+    startWorkers(count);
+}
+
+int WorkerPool::threadCount() const {
+    return static_cast<int>(m_workers.size()) + 1;
+}
+
+void WorkerPool::startWorkers(int count) {
+    m_stopping = false;
+    for (int i = 1; i < count; i++) {
+        m_workers.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+void WorkerPool::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
+/**
+ * @brief Runs a batch of independent tasks across the pool
+ * 
+ * Tasks are claimed one at a time from a shared counter, so uneven task
+ * costs balance out. The caller works through the batch as well and then
+ * waits until every worker has let go of it.
+ */
+void WorkerPool::run(int count, const std::function<void(int)>& task) {
+    if (count <= 0) return;
+    
+    std::unique_lock<std::mutex> runLock(m_runMutex, std::try_to_lock);
+    if (!runLock.owns_lock() || m_workers.empty() || count == 1) {
+        for (int i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+    
+    Job job;
+    job.task = &task;
+    job.count = count;
+    job.next = 0;
+    job.remaining = count;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_generation++;
+    }
+    m_wake.notify_all();
+    
+    job.runTasks();
+    
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this, &job]() { return job.remaining == 0 && m_busyWorkers == 0; });
+    m_job = nullptr;
+}
+
+void WorkerPool::Job::runTasks() {
+    int index;
+    while ((index = next.fetch_add(1)) < count) {
+        (*task)(index);
+        remaining.fetch_sub(1);
+    }
+}
+
+void WorkerPool::workerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    uint64_t seen = m_generation;
+    for (;;) {
+        m_wake.wait(lock, [this, seen]() { return m_stopping || m_generation != seen; });
+        if (m_stopping) return;
+        seen = m_generation;
+        
+        Job* job = m_job;
+        if (!job) continue;
+        m_busyWorkers++;
+        lock.unlock();
+        
+        job->runTasks();
+        
+        lock.lock();
+        if (--m_busyWorkers == 0) {
+            m_done.notify_all();
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Process-wide set of persistent worker threads used to split frame work
+// (such as packing) into independent row bands. The calling thread always
+// takes part, so a pool of N threads runs N - 1 workers.
+class WorkerPool
+{
+public:
+    static WorkerPool &instance();
+
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    // Total threads used per run, including the caller. 1 disables the workers;
+    // 0 selects one thread per hardware core.
+    void setThreadCount(int count);
+    int threadCount() const;
+
+    // Runs task(i) for every i in [0, count) and returns once all are done.
+    // If another run is already in progress the tasks run on the caller.
+    void run(int count, const std::function<void(int)> &task);
+
+private:
+    struct Job
+    {
+        const std::function<void(int)> *task;
+        int count;
+        std::atomic<int> next;
+        std::atomic<int> remaining;
+
+        void runTasks();
+    };
+
+    WorkerPool();
+    void startWorkers(int count);
+    void stopWorkers();
+    void workerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_runMutex;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    Job *m_job;
+    uint64_t m_generation;
+    int m_busyWorkers;
+    bool m_stopping;
+};
@@ -9,14 +9,16 @@ import time
 import numpy as np
 from numpy.random import rand
 
-from bmd_sg.decklink.bmd_decklink import BMDDeckLink
+from bmd_sg.decklink.bmd_decklink import BMDDeckLink, LogLevel, set_log_level
 from bmd_sg.image_generators.checkerboard import DEFAULT_PATTERN_GENERATOR
-from bmd_sg.utilities import suppress_cpp_output
 
 # ============================================================================
 # Device Initialization and Frame Generation
 # ============================================================================
 
+# Only report problems from the C++ library while measuring
+set_log_level(LogLevel.WARNING)
+
 # Initialize BMD DeckLink device (device 0)
 decklink = BMDDeckLink(0)
 
@@ -45,15 +47,16 @@ NUM_TESTS = 15  # Number of test iterations
 
 data = []
 
+# Start the hardware-timed measurement from the first test frame
+decklink.reset_frame_telemetry()
+
 # Run performance tests with alternating white/black frame pairs
 for _ in range(NUM_TESTS):
-    # Suppress C++ library output during frame display
-    with suppress_cpp_output():
-        t1 = time.perf_counter()
-        for _ in range(NUM_FRAME_SEQUENCES):
-            decklink.display_frame(img1)  # Show white frame
-            decklink.display_frame(img2)  # Show black frame
-        t2 = time.perf_counter()
+    t1 = time.perf_counter()
+    for _ in range(NUM_FRAME_SEQUENCES):
+        decklink.display_frame(img1)  # Show white frame
+        decklink.display_frame(img2)  # Show black frame
+    t2 = time.perf_counter()
 
     # Calculate performance metrics
     avg_fps = (NUM_FRAME_SEQUENCES * 2) / (t2 - t1)
@@ -104,3 +107,26 @@ print("\nLatency Factor (frames):")
 print(f"  Average: {latency_factor_avg:.4f}")
 print(f"  Std Dev: {latency_factor_std:.4f}")
 print(f"  +4sigma: {latency_factor_4sigma:.4f}")
+
+
+# ============================================================================
+# Hardware-Timed Latency
+# ============================================================================
+
+# Submit and scanout times on the device's reference clock, free of the
+# Python and loop overhead included in the figures above
+telemetry = decklink.frame_telemetry
+submit_to_scanout = telemetry["submit_to_scanout"]
+jitter = telemetry["scanout_jitter"]
+
+print("\n=== Hardware Frame Telemetry ===")
+print(f"Frames displayed: {telemetry['displayed_frames']}")
+print("Submit to scanout (ms):")
+print(f"  Average: {submit_to_scanout['mean_us'] / 1000:.3f}ms")
+print(f"  p50:     {submit_to_scanout['p50_us'] / 1000:.3f}ms")
+print(f"  p99:     {submit_to_scanout['p99_us'] / 1000:.3f}ms")
+print(f"  Max:     {submit_to_scanout['max_us'] / 1000:.3f}ms")
+# Only frames shown in the slot right after the previous one are counted
+print(f"Frame interval jitter ({jitter['count']} back-to-back frames):")
+print(f"  p99:     {jitter['p99_us']:.1f}us")
+print(f"  Max:     {jitter['max_us']:.1f}us")
@@ -132,6 +132,7 @@ def clean(ctx: Context) -> None:
     ctx.run("rm -rf .pytest_cache", warn=True)
     ctx.run("rm -rf .ruff_cache", warn=True)
     ctx.run("rm -f bmd_sg/decklink/libdecklink.dylib")
+    ctx.run("rm -f bmd_sg/decklink/_decklink_native*.so")
     print("🧹 Cleaned up cache files!")
 
 
@@ -0,0 +1,21 @@
+"""Shared test fixtures."""
+
+import pytest
+
+
+@pytest.fixture
+def mock_device():
+    """Open the native mock output with output started.
+
+    Skips the test when libdecklink is not built.
+    """
+    try:
+        from bmd_sg.decklink.bmd_decklink import MOCK_DEVICE_INDEX, BMDDeckLink
+    except OSError as error:
+        pytest.skip(f"libdecklink not available: {error}")
+    device = BMDDeckLink(MOCK_DEVICE_INDEX)
+    try:
+        device.start_playback()
+        yield device
+    finally:
+        device.close()
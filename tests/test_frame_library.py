@@ -0,0 +1,138 @@
+"""Frame library round trip and file validation tests.
+
+Frames are packed by the native mock output (the mock_device fixture), written
+with BMDFrameLibraryWriter, mapped again with BMDFrameLibrary and displayed
+with display_library_frame. The tests are skipped when libdecklink is not
+built.
+"""
+
+import struct
+from pathlib import Path
+
+import pytest
+
+try:
+    from bmd_sg.decklink.bmd_decklink import BMDFrameLibrary, BMDFrameLibraryWriter
+except OSError as error:
+    pytest.skip(f"libdecklink not available: {error}", allow_module_level=True)
+
+WIDTH = 1920
+HEIGHT = 1080
+
+# FrameLibraryHeader and FrameLibraryEntry of cpp/frame_library.h
+HEADER_FORMAT = "=8sIIQQ"
+ENTRY_SIZE = 200
+ENTRY_PAYLOAD_FORMAT = "=QQ"
+
+
+def read_index(path: Path) -> list[tuple[int, int]]:
+    """Read the payload offset and size of every frame in a library file.
+
+    Parameters
+    ----------
+    path : Path
+        Finished frame library
+
+    Returns
+    -------
+    list[tuple[int, int]]
+        ``(payload_offset, payload_size)`` of each frame, by index
+    """
+    data = path.read_bytes()
+    _, _, _, frame_count, index_offset = struct.unpack_from(HEADER_FORMAT, data)
+    return [
+        struct.unpack_from(ENTRY_PAYLOAD_FORMAT, data, index_offset + i * ENTRY_SIZE)
+        for i in range(frame_count)
+    ]
+
+
+def read_payload(path: Path, index: int) -> bytes:
+    """Read the packed pixels of one frame straight from the file."""
+    offset, size = read_index(path)[index]
+    return path.read_bytes()[offset : offset + size]
+
+
+def patch_file(path: Path, offset: int, value: bytes) -> None:
+    """Overwrite bytes of a file in place."""
+    data = bytearray(path.read_bytes())
+    data[offset : offset + len(value)] = value
+    path.write_bytes(bytes(data))
+
+
+@pytest.fixture
+def library_path(mock_device, tmp_path):
+    """Write a library of two solid frames named gray and red."""
+    path = tmp_path / "patches.bmdflib"
+    with BMDFrameLibraryWriter(path) as writer:
+        mock_device.display_solid_color([512, 512, 512], WIDTH, HEIGHT)
+        assert writer.add_frame(mock_device, "gray") == 0
+        mock_device.display_solid_color([1023, 0, 0], WIDTH, HEIGHT)
+        assert writer.add_frame(mock_device, "red") == 1
+    return path
+
+
+def test_library_round_trip(mock_device, library_path, tmp_path):
+    """Test that a library frame is output with exactly the stored pixels.
+
+    The frame loaded from the library is saved into a second library, whose
+    payload must equal the original one byte for byte.
+    """
+    with BMDFrameLibrary(library_path) as library:
+        assert len(library) == 2
+        assert library.index("red") == 1
+        gray = library.frames[library.index("gray")]
+        assert gray["width"] == WIDTH
+        assert gray["height"] == HEIGHT
+        assert gray["pixel_format"] == mock_device.pixel_format.sdk_format_code
+        assert gray["row_bytes"] > 0
+
+        copy_path = tmp_path / "copy.bmdflib"
+        with BMDFrameLibraryWriter(copy_path) as writer:
+            for name in ("red", "gray"):
+                mock_device.display_library_frame(library, name)
+                writer.add_frame(mock_device, name)
+
+    assert read_payload(copy_path, 0) == read_payload(library_path, 1)
+    assert read_payload(copy_path, 1) == read_payload(library_path, 0)
+    assert read_payload(library_path, 0) != read_payload(library_path, 1)
+
+
+def test_library_rejects_bad_magic(library_path):
+    """Test that a file without the library magic is not opened."""
+    patch_file(library_path, 0, b"NOTFLIB\0")
+    with pytest.raises(RuntimeError):
+        BMDFrameLibrary(library_path)
+
+
+def test_library_rejects_other_version(library_path):
+    """Test that a library of another format version is not opened."""
+    patch_file(library_path, 8, struct.pack("=I", 2))
+    with pytest.raises(RuntimeError):
+        BMDFrameLibrary(library_path)
+
+
+def test_library_rejects_other_entry_size(library_path):
+    """Test that a library with index entries of another size is not opened."""
+    patch_file(library_path, 12, struct.pack("=I", ENTRY_SIZE + 8))
+    with pytest.raises(RuntimeError):
+        BMDFrameLibrary(library_path)
+
+
+def test_library_rejects_truncated_file(library_path):
+    """Test that a library cut off inside a payload is not opened."""
+    offset, size = read_index(library_path)[1]
+    data = library_path.read_bytes()
+    library_path.write_bytes(data[: offset + size // 2])
+    with pytest.raises(RuntimeError):
+        BMDFrameLibrary(library_path)
+
+
+def test_library_rejects_payload_past_end(library_path):
+    """Test that an entry whose payload runs past the end is not opened."""
+    _, _, _, _, index_offset = struct.unpack_from(
+        HEADER_FORMAT, library_path.read_bytes()
+    )
+    size = library_path.stat().st_size
+    patch_file(library_path, index_offset + 8, struct.pack("=Q", size))
+    with pytest.raises(RuntimeError):
+        BMDFrameLibrary(library_path)
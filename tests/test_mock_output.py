@@ -0,0 +1,253 @@
+"""Frame path tests against the native mock output.
+
+These tests open MOCK_DEVICE_INDEX, which runs the real packing, pooling and
+scheduling code of libdecklink at the frame rate of the display mode
+without a DeckLink device. They are skipped when the library is not built.
+"""
+
+import select
+import time
+
+import numpy as np
+import pytest
+
+try:
+    from bmd_sg.decklink.bmd_decklink import BMDDeckLink
+except OSError as error:
+    pytest.skip(f"libdecklink not available: {error}", allow_module_level=True)
+
+WIDTH = 1920
+HEIGHT = 1080
+
+# BMDOutputFrameCompletionResult
+FRAME_COMPLETED = 0
+FRAME_DISPLAYED_LATE = 1
+
+
+def create_gray_frame(level: int) -> np.ndarray:
+    """Create a full-size gray frame.
+
+    Parameters
+    ----------
+    level : int
+        Gray level of every channel
+
+    Returns
+    -------
+    np.ndarray
+        Frame array with shape (HEIGHT, WIDTH, 3)
+    """
+    return np.full((HEIGHT, WIDTH, 3), level, dtype=np.uint16)
+
+
+def wait_for_drain(device: BMDDeckLink, timeout: float = 5.0) -> int:
+    """Wait until no scheduled frame is left waiting for the output.
+
+    Parameters
+    ----------
+    device : BMDDeckLink
+        Device in scheduled playback
+    timeout : float, optional
+        Seconds to wait, by default 5.0
+
+    Returns
+    -------
+    int
+        Frames still buffered when the wait ended, 0 unless it timed out
+    """
+    deadline = time.monotonic() + timeout
+    while (count := device.buffered_frame_count) > 0:
+        if time.monotonic() >= deadline:
+            break
+        time.sleep(0.01)
+    return count
+
+
+def read_completions(
+    device: BMDDeckLink, fd: int, count: int, timeout: float = 5.0
+) -> list[dict[str, int]]:
+    """Collect completion events by polling the completion descriptor.
+
+    Parameters
+    ----------
+    device : BMDDeckLink
+        Device with completion events enabled
+    fd : int
+        Descriptor returned by enable_completion_events()
+    count : int
+        Number of events to wait for
+    timeout : float, optional
+        Seconds to wait for all of them, by default 5.0
+
+    Returns
+    -------
+    list[dict[str, int]]
+        The events read, oldest first; fewer than count on timeout
+    """
+    events: list[dict[str, int]] = []
+    deadline = time.monotonic() + timeout
+    while len(events) < count:
+        remaining = deadline - time.monotonic()
+        if remaining <= 0:
+            break
+        readable, _, _ = select.select([fd], [], [], remaining)
+        if readable:
+            events.extend(device.read_completion_events())
+    return events
+
+
+def test_display_frame_records_each_stage(mock_device):
+    """Test that synchronous displays pass through every stage once each."""
+    mock_device.reset_latency_stats()
+    for level in (0, 512, 1023):
+        mock_device.display_frame(create_gray_frame(level))
+
+    stats = mock_device.latency_stats
+    assert stats["pack"]["count"] == 3
+    assert stats["display_frame_sync"]["count"] == 3
+    assert stats["schedule_frame"]["count"] == 0
+
+
+def test_scheduled_playback_drains(mock_device):
+    """Test that scheduled frames all go out while playback runs.
+
+    Two frames preroll the output and four more follow once it started.
+    """
+    frames = [create_gray_frame(level) for level in (0, 1023)]
+    for i in range(2):
+        mock_device.schedule_frame(frames[i % 2])
+    mock_device.start_scheduled_playback()
+    for i in range(4):
+        mock_device.schedule_frame(frames[i % 2])
+
+    remaining = wait_for_drain(mock_device)
+    stats = mock_device.latency_stats
+    mock_device.stop_scheduled_playback()
+
+    assert remaining == 0
+    assert stats["schedule_frame"]["count"] == 6
+
+
+def test_frame_pipeline_displays_every_frame(mock_device):
+    """Test that the frame pipeline displays each submitted frame once."""
+    mock_device.start_frame_pipeline()
+    try:
+        for level in (0, 256, 512, 768, 1023):
+            mock_device.submit_frame(create_gray_frame(level))
+        mock_device.flush_frame_pipeline()
+        stats = mock_device.frame_pipeline_stats
+    finally:
+        mock_device.stop_frame_pipeline()
+
+    assert stats["submitted"] == 5
+    assert stats["displayed"] == 5
+    assert stats["failed"] == 0
+    assert stats["source_depth"] == 0
+    assert stats["last_error"] == 0
+
+
+def test_sequence_reports_each_patch(mock_device):
+    """Test that a patch sequence reports its patches in order and ends.
+
+    Each patch dwells for two frames, so consecutive events must be two frame
+    durations apart on the stream clock.
+    """
+    dwell_frames = 2
+    patches = [([level] * 3, dwell_frames) for level in (0, 512, 1023)]
+    mock_device.load_sequence(WIDTH, HEIGHT, patches)
+    mock_device.start_sequence()
+
+    events = []
+    while (event := mock_device.wait_sequence_event(timeout=2.0)) is not None:
+        events.append(event)
+    status = mock_device.sequence_status
+
+    assert [event["patch_index"] for event in events] == [0, 1, 2]
+    assert all(event["pass"] == 0 for event in events)
+    durations = {event["end_time"] - event["start_time"] for event in events}
+    assert len(durations) == 1
+    frame_duration = durations.pop() // dwell_frames
+    assert frame_duration > 0
+    for previous, event in zip(events, events[1:]):
+        assert event["start_time"] == previous["end_time"]
+        assert event["start_time"] - previous["start_time"] == (
+            dwell_frames * frame_duration
+        )
+
+    assert status["running"] == 0
+    assert status["patch_count"] == 3
+    assert status["completed_patches"] == 3
+    assert status["queued_frames"] == 0
+    assert status["events_dropped"] == 0
+    assert status["last_error"] == 0
+
+
+def test_scheduled_playback_completes_in_order(mock_device):
+    """Test that scheduled frames complete once each, in schedule order.
+
+    Two frames preroll the output, four more follow while playback runs, and
+    every one of them must come back on the completion descriptor.
+    """
+    fd = mock_device.enable_completion_events()
+    frames = [create_gray_frame(level) for level in (0, 1023)]
+
+    for i in range(2):
+        mock_device.schedule_frame(frames[i % 2])
+    mock_device.start_scheduled_playback()
+    for i in range(4):
+        mock_device.schedule_frame(frames[i % 2])
+
+    assert mock_device.completion_status["scheduled_frames"] == 6
+    events = read_completions(mock_device, fd, 6)
+    mock_device.stop_scheduled_playback()
+
+    assert [event["frame_number"] for event in events] == list(range(6))
+    assert all(
+        event["result"] in (FRAME_COMPLETED, FRAME_DISPLAYED_LATE)
+        for event in events
+    )
+    timestamps = [event["completion_timestamp_ns"] for event in events]
+    assert timestamps == sorted(timestamps)
+    assert mock_device.completion_status["pending_events"] == 0
+
+
+def test_frame_telemetry_records_displays(mock_device):
+    """Test that synchronous displays leave one telemetry sample each."""
+    mock_device.reset_frame_telemetry()
+    for level in (0, 512, 1023):
+        mock_device.display_frame(create_gray_frame(level))
+
+    samples = mock_device.read_frame_telemetry()
+    summary = mock_device.frame_telemetry
+
+    assert len(samples) == 3
+    assert all(sample["frame_number"] == -1 for sample in samples)
+    assert all(sample["result"] == FRAME_COMPLETED for sample in samples)
+    assert all(sample["scanout_ns"] >= sample["submit_ns"] for sample in samples)
+    scanouts = [sample["scanout_ns"] for sample in samples]
+    assert scanouts == sorted(scanouts)
+
+    assert summary["displayed_frames"] == 3
+    assert summary["late_frames"] == 0
+    assert summary["dropped_frames"] == 0
+    assert summary["pending_samples"] == 0
+    assert summary["submit_to_scanout"]["count"] == 3
+
+
+def test_frame_telemetry_matches_scheduled_frames(mock_device):
+    """Test that scheduled frames leave samples numbered like their completions."""
+    fd = mock_device.enable_completion_events()
+    mock_device.reset_frame_telemetry()
+    for level in (0, 1023, 0):
+        mock_device.schedule_frame(create_gray_frame(level))
+    mock_device.start_scheduled_playback()
+    events = read_completions(mock_device, fd, 3)
+    mock_device.stop_scheduled_playback()
+
+    samples = mock_device.read_frame_telemetry()
+    assert len(events) == 3
+    assert [sample["frame_number"] for sample in samples] == [
+        event["frame_number"] for event in events
+    ]
+    assert all(sample["frame_duration_ns"] > 0 for sample in samples)
+    assert mock_device.frame_telemetry["displayed_frames"] == 3
@@ -39,3 +39,19 @@ def test_pattern_generator_with_roi():
     gen = PatternGenerator(bit_depth=8, width=4, height=4, roi=roi)
     pattern = gen.generate([255, 0, 0])  # Red
     assert pattern.shape == (4, 4, 3)
+
+
+def test_pattern_generator_rects_match_image():
+    """Test that generate_rects describes the same pattern as generate."""
+    roi = ROI(x=1, y=2, width=5, height=4)
+    gen = PatternGenerator(bit_depth=12, width=8, height=7, roi=roi)
+    colors = [[4095, 0, 0], [0, 4095, 0], [0, 0, 4095]]
+    pattern = gen.generate(colors)
+
+    rendered = np.zeros_like(pattern)
+    for x, y, width, height, cell_colors in gen.generate_rects(colors):
+        for row in range(y, y + height):
+            for col in range(x, x + width):
+                cell = ((row - y) & 1) + 2 * ((col - x) & 1)
+                rendered[row, col] = cell_colors[cell]
+    assert np.array_equal(rendered, pattern)